@@ -0,0 +1,107 @@
+#include "Core/Physics/BodyStore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+/*	one integration step of 1k, 10k and 50k bodies, the BodyStore SIMD integrator (and its scalar fallback) against
+*	the std::vector<std::shared_ptr<Rigidbody>> loop it replaced, the old Rigidbody is reproduced below as it was
+*	(with damping initialised), counters are bodies per millisecond */
+namespace
+{
+	class AosRigidbody
+	{
+	public:
+		AosRigidbody(const Vec& position, float mass) : position{ position }, massInverse{ 1.f / mass } {}
+
+		void applyForce(const Vec& f) { accumulatedForces += f; }
+
+		void simulate(float deltaTime)
+		{
+			position += velocity * deltaTime;
+			auto resAcc = acceleration;
+			resAcc += accumulatedForces * massInverse;
+			velocity += resAcc * deltaTime;
+			velocity *= std::pow(damping, deltaTime);
+			accumulatedForces = Vec::zero();
+		}
+
+		Vec position{};
+		Vec velocity{};
+		Vec acceleration{ 0.f, -9.81f, 0.f };
+		Vec accumulatedForces{};
+		float massInverse = 1.f;
+		float damping = BodyStore::DEFAULT_DAMPING;
+	};
+
+	constexpr float DELTA_TIME = 1.f / 60.f;
+
+	void fill(BodyStore& store, int64_t count)
+	{
+		std::mt19937 rng{ 5 };
+		std::uniform_real_distribution<float> position{ -500.f, 500.f }, mass{ .5f, 20.f };
+		for (int64_t i = 0; i < count; i++)
+		{
+			const BodyHandle h = store.create(Vec{ position(rng), position(rng), position(rng) }, mass(rng));
+			store.setAcceleration(h, Vec{ 0.f, -9.81f, 0.f });
+		}
+	}
+
+	// same bodies as fill(), allocated one at a time like the old PhysicsScene did
+	void fill(std::vector<std::shared_ptr<AosRigidbody>>& bodies, int64_t count)
+	{
+		std::mt19937 rng{ 5 };
+		std::uniform_real_distribution<float> position{ -500.f, 500.f }, mass{ .5f, 20.f };
+		for (int64_t i = 0; i < count; i++)
+		{
+			const Vec p{ position(rng), position(rng), position(rng) };
+			bodies.push_back(std::make_shared<AosRigidbody>(p, mass(rng)));
+		}
+	}
+
+	void setRate(benchmark::State& state)
+	{
+		state.counters["bodies/ms"] = benchmark::Counter(static_cast<double>(state.iterations() * state.range(0)) / 1000.,
+			benchmark::Counter::kIsRate);
+	}
+}
+
+static void BM_SharedPtrRigidbody(benchmark::State& state)
+{
+	std::vector<std::shared_ptr<AosRigidbody>> bodies{};
+	fill(bodies, state.range(0));
+	for (auto _ : state)
+	{
+		for (auto& b : bodies) { b->applyForce(Vec{ 1.f, 0.f, 0.f }); }
+		for (auto& b : bodies) { b->simulate(DELTA_TIME); }
+		benchmark::DoNotOptimize(bodies.front()->position);
+	}
+	setRate(state);
+}
+
+template<bool SIMD>
+static void BM_BodyStore(benchmark::State& state)
+{
+	BodyStore store{};
+	fill(store, state.range(0));
+	for (auto _ : state)
+	{
+		float* fx = store.array(BodyStore::FORCE_X);
+		for (size_t i = 0; i < store.size(); i++) { fx[i] += 1.f; }
+		if (SIMD) { store.integrate(DELTA_TIME); }
+		else { store.integrateScalar(DELTA_TIME); }
+		benchmark::DoNotOptimize(store.array(BodyStore::POS_X));
+	}
+	setRate(state);
+}
+
+BENCHMARK(BM_SharedPtrRigidbody)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK_TEMPLATE(BM_BodyStore, false)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK_TEMPLATE(BM_BodyStore, true)->Arg(1000)->Arg(10000)->Arg(50000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include "Core/Physics/Broadphase.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+/*	Broadphase::update against the O(n^2) pair test it replaced, 1k, 10k and 50k bodies of 0.2 to 1.5 units,
+*	"spread" scatters them over a box with about two neighbours each, "pile" packs the same bodies ten times denser,
+*	every iteration moves the bodies a little first (coherent motion, the incremental sort path) */
+namespace
+{
+	void fill(BodyStore& store, int64_t count, float density)
+	{
+		std::mt19937 rng{ 9 };
+		const float half = std::cbrt(static_cast<float>(count) / density) * .5f;
+		std::uniform_real_distribution<float> position{ -half, half }, extent{ .2f, 1.5f };
+		for (int64_t i = 0; i < count; i++)
+		{
+			const BodyHandle h = store.create(Vec{ position(rng), position(rng), position(rng) }, i % 10 == 0 ? 0.f : 1.f);
+			store.setCollider(h, i % 2 ? Collider::sphere(extent(rng)) : Collider::box(Vec{ extent(rng), extent(rng), extent(rng) }));
+		}
+	}
+
+	// a fixed pattern of small moves, back and forth so the scene stays the same
+	void move(BodyStore& store, int64_t iteration)
+	{
+		const float d = iteration % 2 ? .05f : -.05f;
+		float* x = store.array(BodyStore::POS_X);
+		float* y = store.array(BodyStore::POS_Y);
+		for (size_t i = 0; i < store.size(); i++) { x[i] += (i % 3 ? d : -d); y[i] += (i % 5 ? -d : d); }
+	}
+
+	size_t bruteForce(const BodyStore& store)
+	{
+		const float* p[3] = { store.array(BodyStore::POS_X), store.array(BodyStore::POS_Y), store.array(BodyStore::POS_Z) };
+		const float* e[3] = { store.array(BodyStore::EXTENT_X), store.array(BodyStore::EXTENT_Y), store.array(BodyStore::EXTENT_Z) };
+		const float* invMass = store.array(BodyStore::INV_MASS);
+		const size_t n = store.size();
+		size_t pairs = 0;
+		for (size_t a = 0; a < n; a++)
+		{
+			for (size_t b = a + 1; b < n; b++)
+			{
+				if (invMass[a] <= 0.f && invMass[b] <= 0.f) { continue; }
+				bool overlap = true;
+				for (int k = 0; k < 3; k++) { overlap &= std::abs(p[k][a] - p[k][b]) <= e[k][a] + e[k][b]; }
+				pairs += overlap;
+			}
+		}
+		return pairs;
+	}
+}
+
+template<int DENSITY>
+static void BM_SweepAndPrune(benchmark::State& state)
+{
+	BodyStore store{};
+	fill(store, state.range(0), DENSITY / 100.f);
+	Broadphase broadphase{};
+	broadphase.update(store);
+	int64_t iteration = 0;
+	for (auto _ : state)
+	{
+		move(store, iteration++);
+		broadphase.update(store);
+		benchmark::DoNotOptimize(broadphase.getPairs().data());
+	}
+	state.counters["pairs"] = static_cast<double>(broadphase.getStats().pairs);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SweepAndPrune, 5)->Name("BM_SweepAndPrune/spread")->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SweepAndPrune, 50)->Name("BM_SweepAndPrune/pile")->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+static void BM_BruteForce(benchmark::State& state)
+{
+	BodyStore store{};
+	fill(store, state.range(0), .05f);
+	int64_t iteration = 0;
+	size_t pairs = 0;
+	for (auto _ : state)
+	{
+		move(store, iteration++);
+		pairs = bruteForce(store);
+		benchmark::DoNotOptimize(pairs);
+	}
+	state.counters["pairs"] = static_cast<double>(pairs);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BruteForce)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
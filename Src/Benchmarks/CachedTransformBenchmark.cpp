@@ -0,0 +1,76 @@
+#include "Core/Types/CachedTransform.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+/*	model and normal matrices of 10k and 100k objects per frame, with 1% of them rotating every frame,
+*	the old path rebuilt Transform::mat4() and transpose(inverse()) for every object every frame */
+namespace
+{
+	constexpr int CHANGING_PERCENT = 1;
+
+	std::vector<Transform> makeTransforms(int64_t count)
+	{
+		std::mt19937 rng{ 1 };
+		std::uniform_real_distribution<float> position{ -100.f, 100.f }, angle{ -3.f, 3.f }, scale{ .5f, 2.f };
+		std::vector<Transform> transforms{};
+		for (int64_t i = 0; i < count; i++)
+		{
+			transforms.push_back(Transform{ Vec{ position(rng), position(rng), position(rng) }, Vec{ angle(rng), angle(rng), angle(rng) },
+				Vec{ scale(rng), scale(rng), scale(rng) } });
+		}
+		return transforms;
+	}
+
+	struct PushConstants
+	{
+		glm::mat4 transform;
+		glm::mat4 normalMatrix;
+	};
+}
+
+static void BM_TransformMat4(benchmark::State& state)
+{
+	std::vector<Transform> transforms = makeTransforms(state.range(0));
+	const size_t step = 100 / CHANGING_PERCENT;
+	PushConstants push{};
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < transforms.size(); i += step) { transforms[i].rotation.y += .01f; }
+		for (const Transform& t : transforms)
+		{
+			push.transform = t.mat4();
+			push.normalMatrix = glm::transpose(glm::inverse(push.transform));
+			benchmark::DoNotOptimize(push);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformMat4)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_CachedTransform(benchmark::State& state)
+{
+	const std::vector<Transform> source = makeTransforms(state.range(0));
+	std::vector<CachedTransform> transforms{};
+	for (const Transform& t : source) { transforms.emplace_back(t); }
+	const size_t step = 100 / CHANGING_PERCENT;
+	float angle = 0.f;
+	PushConstants push{};
+	for (auto _ : state)
+	{
+		angle += .01f;
+		for (size_t i = 0; i < transforms.size(); i += step) { transforms[i].setRotationEuler(Vec{ 0.f, angle, 0.f }); }
+		for (const CachedTransform& t : transforms)
+		{
+			push.transform = t.getMatrix();
+			push.normalMatrix = t.getNormalMatrix();
+			benchmark::DoNotOptimize(push);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CachedTransform)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,79 @@
+#include "Core/Physics/PhysicsScene.h"
+#include "Core/Physics/Rigidbody.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+/*	cost of the continuous collision pass in a 50k body scene with 0, 150, 1.8k and 8k fast bodies, the slow bodies
+*	sit still in a 200 m box, the fast ones fly at 60 m/s (four times their radius per step) and are put back to their
+*	start every step so the scene stays the same, counters are the pass's time per step, the swept bodies and hits */
+namespace
+{
+	constexpr int BODIES = 50000;
+
+	struct FastBody
+	{
+		std::shared_ptr<Rigidbody> body;
+		Vec start;
+		Vec velocity;
+	};
+
+	void buildScene(PhysicsScene& scene, int fast, std::vector<FastBody>& fastOut)
+	{
+		std::mt19937 rng{ 17 };
+		std::uniform_real_distribution<float> position{ -100.f, 100.f }, direction{ -1.f, 1.f };
+		for (int i = 0; i < BODIES; i++)
+		{
+			const Vec p{ position(rng), position(rng), position(rng) };
+			auto body = scene.createBody(p, 1.f, i % 2 ? Collider::sphere(.25f) : Collider::box(Vec{ .25f, .25f, .25f }));
+			body->setDamping(1.f);
+			if (i < fast)
+			{
+				Vec d{ direction(rng), direction(rng), direction(rng) };
+				d = d * (60.f / std::sqrt(Vec::dot(d, d)));
+				fastOut.push_back(FastBody{ body, p, d });
+			}
+		}
+	}
+}
+
+static void BM_ContinuousPass(benchmark::State& state)
+{
+	PhysicsScene scene{};
+	std::vector<FastBody> fast{};
+	buildScene(scene, static_cast<int>(state.range(0)), fast);
+	// lets the slow bodies fall asleep, as they would in a game
+	for (int step = 0; step < 60; step++) { scene.simulate(1.f / 60.f); }
+
+	double continuousMs = 0.0, stepMs = 0.0;
+	uint64_t swept = 0, hits = 0;
+	for (auto _ : state)
+	{
+		for (FastBody& f : fast)
+		{
+			f.body->setPosition(f.start);
+			f.body->setVelocity(f.velocity);
+		}
+		scene.simulate(1.f / 60.f);
+		const PhysicsScene::Stats& stats = scene.getStats();
+		continuousMs += stats.continuousMs;
+		stepMs += stats.integrateMs + stats.broadphaseMs + stats.continuousMs + stats.narrowphaseMs + stats.resolveMs + stats.sleepMs;
+		swept += stats.sweptBodies;
+		hits += scene.getContinuousCollision().getStats().hits;
+	}
+	const double steps = static_cast<double>(state.iterations());
+	state.counters["continuous_ms"] = continuousMs / steps;
+	state.counters["step_ms"] = stepMs / steps;
+	state.counters["swept"] = static_cast<double>(swept) / steps;
+	state.counters["hits"] = static_cast<double>(hits) / steps;
+}
+
+BENCHMARK(BM_ContinuousPass)->Arg(0)->Arg(150)->Arg(1800)->Arg(8000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
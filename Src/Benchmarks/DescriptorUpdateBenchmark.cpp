@@ -0,0 +1,119 @@
+#include "Core/GPU/Descriptors.h"
+#include "Core/GPU/Device.h"
+#include "Core/GPU/Image.h"
+#include "Core/GPU/Material.h"
+#include "Core/GPU/UniformRing.h"
+#include "Core/Window.h"
+
+#include <benchmark/benchmark.h>
+
+#include <exception>
+#include <memory>
+#include <vector>
+
+using namespace EngineCore;
+
+/*	rebinding one image of the engine's global set (dynamic UBO, two sampled images, a sampler) for 3 frames in flight,
+*	through a DescriptorWriter (one VkWriteDescriptorSet per binding, vkUpdateDescriptorSets) against the update template
+*	path (DescriptorSet::setArrayImage, then one vkUpdateDescriptorSetWithTemplate per frame in getDescriptorSet)
+*
+*	needs a Vulkan device, e.g. lavapipe under a virtual display:
+*	VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json xvfb-run ./DescriptorUpdateBenchmark */
+namespace
+{
+	constexpr uint32_t FRAMES = 3;
+
+	struct Fixture
+	{
+		EngineWindow window{ 64, 64, "descriptor update benchmark" };
+		EngineDevice device{ window };
+		UniformRing ring{ device, 4096, FRAMES };
+		DescriptorAllocator allocator{ device, FRAMES };
+		std::unique_ptr<Image> images[2];
+		VkSampler sampler = VK_NULL_HANDLE;
+
+		Fixture()
+		{
+			for (auto& image : images)
+			{
+				image = std::make_unique<Image>(device, Image::makeImageCreateInfo(4, 4));
+				image->updateView(VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT);
+			}
+			Image::createSampler(sampler, device);
+		}
+		~Fixture() { vkDestroySampler(device.device(), sampler, nullptr); }
+	};
+
+	// created on first use, nullptr if there is no device
+	Fixture* fixture()
+	{
+		static std::unique_ptr<Fixture> f = []() -> std::unique_ptr<Fixture>
+		{
+			try { return std::make_unique<Fixture>(); }
+			catch (const std::exception&) { return nullptr; }
+		}();
+		return f.get();
+	}
+
+	void BM_WriterRebind(benchmark::State& state)
+	{
+		Fixture* f = fixture();
+		if (!f) { state.SkipWithError("no Vulkan device"); return; }
+
+		auto layout = DescriptorSetLayout::Builder(f->device)
+			.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_ALL_GRAPHICS)
+			.addBinding(1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_SHADER_STAGE_ALL_GRAPHICS, 2)
+			.addBinding(2, VK_DESCRIPTOR_TYPE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
+			.build(f->device.getLayoutCache());
+		VkDescriptorSet sets[FRAMES];
+		DescriptorPool* pools[FRAMES];
+		for (uint32_t i = 0; i < FRAMES; i++) { f->allocator.allocate(layout->getDescriptorSetLayout(), sets[i], pools[i]); }
+
+		VkDescriptorBufferInfo buffer = f->ring.descriptorInfo(ShaderUniforms::SceneGlobal::size);
+		VkDescriptorImageInfo images[2] = {
+			{ VK_NULL_HANDLE, f->images[0]->getView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL },
+			{ VK_NULL_HANDLE, f->images[0]->getView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL } };
+		VkDescriptorImageInfo sampler{ f->sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+		uint32_t n = 0;
+		for (auto _ : state)
+		{
+			images[1].imageView = f->images[++n % 2]->getView();
+			for (uint32_t i = 0; i < FRAMES; i++)
+			{
+				DescriptorWriter(*layout).writeBuffer(0, &buffer).writeImage(1, images, 2).writeImage(2, &sampler, 1).overwrite(sets[i]);
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+		for (uint32_t i = 0; i < FRAMES; i++) { f->allocator.free(sets[i], pools[i]); }
+	}
+
+	void BM_TemplateRebind(benchmark::State& state)
+	{
+		Fixture* f = fixture();
+		if (!f) { state.SkipWithError("no Vulkan device"); return; }
+
+		DescriptorSet set{ f->device, f->allocator, FRAMES };
+		set.addUBO<ShaderUniforms::SceneGlobal>(f->ring);
+		ImageArrayDescriptor images{};
+		images.addImage(std::vector<VkImageView>(FRAMES, f->images[0]->getView()));
+		images.addImage(std::vector<VkImageView>(FRAMES, f->images[0]->getView()));
+		set.addImageArray(images);
+		set.addSampler(f->sampler);
+		set.finalize();
+
+		std::vector<VkImageView> views[2] = {
+			std::vector<VkImageView>(FRAMES, f->images[0]->getView()), std::vector<VkImageView>(FRAMES, f->images[1]->getView()) };
+		uint32_t n = 0;
+		for (auto _ : state)
+		{
+			set.setArrayImage(0, 1, views[++n % 2]);
+			for (uint32_t i = 0; i < FRAMES; i++) { benchmark::DoNotOptimize(set.getDescriptorSet(i)); }
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+}
+
+BENCHMARK(BM_WriterRebind);
+BENCHMARK(BM_TemplateRebind);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+#include "Core/Types/LinkedArraySeriesContainer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+/*	sector primitive storage, LinkedArraySeries against std::vector, std::deque and the vector<unique_ptr> it replaced,
+*	the element is about the size of a Primitive (transform, cached matrices and handles), each benchmark appends
+*	1k, 10k and 100k objects, "iterate" sums a field over all of them, "erase" removes half by swapping in the last */
+namespace
+{
+	struct Object
+	{
+		float transform[9];
+		float model[16];
+		float normal[12];
+		uint64_t handles[8];
+		float value;
+
+		explicit Object(int64_t i) : transform{}, model{}, normal{}, handles{}, value{ static_cast<float>(i & 255) } {}
+	};
+
+	template<typename C> Object& get(C& c, size_t i) { return c[i]; }
+	Object& get(std::vector<std::unique_ptr<Object>>& c, size_t i) { return *c[i]; }
+
+	template<typename C> void add(C& c, int64_t i) { c.emplace_back(i); }
+	void add(std::vector<std::unique_ptr<Object>>& c, int64_t i) { c.push_back(std::make_unique<Object>(i)); }
+
+	template<typename C> void eraseSwap(C& c, size_t i)
+	{
+		if (i + 1 != c.size()) { c[i] = std::move(c.back()); }
+		c.pop_back();
+	}
+	void eraseSwap(LinkedArraySeries<Object>& c, size_t i) { c.erase(i); }
+
+	template<typename C> void BM_Append(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			C c{};
+			for (int64_t i = 0; i < state.range(0); i++) { add(c, i); }
+			benchmark::DoNotOptimize(&get(c, 0));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename C> void BM_Iterate(benchmark::State& state)
+	{
+		C c{};
+		for (int64_t i = 0; i < state.range(0); i++) { add(c, i); }
+		for (auto _ : state)
+		{
+			float sum = 0.f;
+			for (size_t i = 0; i < c.size(); i++) { sum += get(c, i).value; }
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template<typename C> void BM_Erase(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			C c{};
+			for (int64_t i = 0; i < state.range(0); i++) { add(c, i); }
+			state.ResumeTiming();
+			for (size_t i = 0; i < c.size(); i++) { eraseSwap(c, i); }
+			benchmark::DoNotOptimize(c.size());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+	}
+
+	// range-for, the way the render and physics passes walk a sector
+	void BM_IterateSeriesRangeFor(benchmark::State& state)
+	{
+		LinkedArraySeries<Object> c{};
+		for (int64_t i = 0; i < state.range(0); i++) { c.emplace_back(i); }
+		for (auto _ : state)
+		{
+			float sum = 0.f;
+			for (const Object& o : c) { sum += o.value; }
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	using Series = LinkedArraySeries<Object>;
+	using Vector = std::vector<Object>;
+	using Deque = std::deque<Object>;
+	using PtrVector = std::vector<std::unique_ptr<Object>>;
+}
+
+BENCHMARK_TEMPLATE(BM_Append, Series)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Append, Vector)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Append, Deque)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Append, PtrVector)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Iterate, Series)->Range(1000, 100000);
+BENCHMARK(BM_IterateSeriesRangeFor)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Iterate, Vector)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Iterate, Deque)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Iterate, PtrVector)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Erase, Series)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Erase, Vector)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Erase, Deque)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Erase, PtrVector)->Range(1000, 100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+#include "Core/Types/OOBB.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+/*	OOBBBatch queries against the scalar reference, one point or ray against 1k, 10k and 100k random boxes,
+*	items are boxes tested */
+namespace
+{
+	struct Scene
+	{
+		OOBBBatch batch;
+		std::vector<Vec> points;
+		std::vector<Vec> dirs;
+	};
+
+	Scene makeScene(int64_t boxes)
+	{
+		std::mt19937 rng{ 3 };
+		std::uniform_real_distribution<float> position{ -100.f, 100.f };
+		std::uniform_real_distribution<float> size{ .5f, 10.f };
+		std::uniform_real_distribution<float> angle{ -3.14159f, 3.14159f };
+
+		Scene scene{};
+		scene.batch.reserve(static_cast<size_t>(boxes));
+		for (int64_t i = 0; i < boxes; i++)
+		{
+			Transform t{ Vec{ position(rng), position(rng), position(rng) }, Vec{ angle(rng), angle(rng), angle(rng) },
+				Vec{ size(rng), size(rng), size(rng) } };
+			scene.batch.add(OOBB::fromTransform(Vec{ -1.f }, Vec{ 1.f }, t));
+		}
+		for (int i = 0; i < 256; i++)
+		{
+			scene.points.push_back(Vec{ position(rng), position(rng), position(rng) });
+			scene.dirs.push_back(Vec{ position(rng), position(rng), position(rng) } - scene.points.back());
+		}
+		return scene;
+	}
+}
+
+template<bool SCALAR>
+static void BM_QueryPoint(benchmark::State& state)
+{
+	const Scene scene = makeScene(state.range(0));
+	std::vector<uint32_t> hits{};
+	size_t q = 0;
+	for (auto _ : state)
+	{
+		hits.clear();
+		const Vec& p = scene.points[q++ & 255];
+		if (SCALAR) { scene.batch.queryPointScalar(p, hits); }
+		else { scene.batch.queryPoint(p, hits); }
+		benchmark::DoNotOptimize(hits.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetLabel("lanes " + std::to_string(SCALAR ? 1 : OOBBBatch::getLaneWidth()));
+}
+BENCHMARK_TEMPLATE(BM_QueryPoint, false)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_QueryPoint, true)->Arg(1000)->Arg(10000)->Arg(100000);
+
+template<bool SCALAR>
+static void BM_QueryRay(benchmark::State& state)
+{
+	const Scene scene = makeScene(state.range(0));
+	std::vector<OOBBBatch::RayHit> hits{};
+	size_t q = 0;
+	for (auto _ : state)
+	{
+		hits.clear();
+		const size_t i = q++ & 255;
+		if (SCALAR) { scene.batch.queryRayScalar(scene.points[i], scene.dirs[i], hits); }
+		else { scene.batch.queryRay(scene.points[i], scene.dirs[i], hits); }
+		benchmark::DoNotOptimize(hits.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetLabel("lanes " + std::to_string(SCALAR ? 1 : OOBBBatch::getLaneWidth()));
+}
+BENCHMARK_TEMPLATE(BM_QueryRay, false)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_QueryRay, true)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_Raycast(benchmark::State& state)
+{
+	const Scene scene = makeScene(state.range(0));
+	OOBBBatch::RayHit hit{};
+	size_t q = 0;
+	for (auto _ : state)
+	{
+		const size_t i = q++ & 255;
+		benchmark::DoNotOptimize(scene.batch.raycast(scene.points[i], scene.dirs[i], hit));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Raycast)->Arg(1000)->Arg(10000)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+#include "Core/WorldSystem/FloatingOrigin.h"
+#include "Core/Types/CachedTransform.h"
+#include "Core/Types/LinkedArraySeriesContainer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace WorldSystem;
+
+/*	the rebase pass of World::rebaseOrigin over 1k, 10k and 100k loaded objects,
+*	objects stand in for Primitive, a CachedTransform between the other members, and live in a LinkedArraySeries
+*	like sector primitives do, SoA translations are the bound a separate vectorised translation array would reach */
+namespace
+{
+	constexpr uint32_t S = 50000;
+
+	struct Object
+	{
+		void* device = nullptr;
+		CachedTransform transform{};
+		// material, buffers, counts and bounds of a Primitive
+		char rest[160] = {};
+		CachedTransform& getTransform() { return transform; }
+	};
+
+	void fill(LinkedArraySeries<Object>& objects, int64_t count)
+	{
+		for (int64_t i = 0; i < count; i++)
+		{
+			Object& o = objects.emplace_back();
+			o.transform.setTranslation(Vec{ static_cast<float>(i % 1000), static_cast<float>(i / 1000), 0.f });
+			o.transform.getMatrix();
+		}
+	}
+}
+
+static void BM_RebaseObjects(benchmark::State& state)
+{
+	LinkedArraySeries<Object> objects{};
+	fill(objects, state.range(0));
+	FloatingOrigin origin{ S };
+	int direction = 1;
+	for (auto _ : state)
+	{
+		// back and forth so positions stay bounded
+		const Vec offset = origin.rebase(SectorCoord(direction, 0, 0));
+		benchmark::DoNotOptimize(FloatingOrigin::shiftTransforms(objects, offset));
+		direction = -direction;
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RebaseObjects)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_RebaseTranslationsSoA(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	std::vector<float> x(count, 1.f), y(count, 2.f), z(count, 3.f);
+	FloatingOrigin origin{ S };
+	int direction = 1;
+	for (auto _ : state)
+	{
+		const Vec offset = origin.rebase(SectorCoord(direction, 0, 0));
+		for (size_t i = 0; i < count; i++) { x[i] += offset.x; y[i] += offset.y; z[i] += offset.z; }
+		benchmark::ClobberMemory();
+		direction = -direction;
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RebaseTranslationsSoA)->Arg(1000)->Arg(10000)->Arg(100000);
+
+BENCHMARK_MAIN();
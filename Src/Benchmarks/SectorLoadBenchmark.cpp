@@ -0,0 +1,118 @@
+#include "Core/WorldSystem/SectorFile.h"
+#include "Core/Primitive.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace WorldSystem;
+using Vertex = EngineCore::Primitive::Vertex;
+
+/*	loading a mesh up to the point where its vertices sit in a staging buffer, the OBJ path (MeshBuilder::loadFromFile,
+*	then a copy out of the builder) against SectorFile::read (map, validate, prefetch, then a copy out of the mapping),
+*	the mesh is a generated UV sphere with positions, normals and uvs of 2k, 32k and 128k triangles,
+*	both files are read again every iteration and stay in the page cache, so this measures parsing, not the disk */
+namespace
+{
+	const SectorCoord COORD{ 0, 0, 0 };
+
+	std::string tempPath(const char* name) { return std::string(P_tmpdir) + "/" + name; }
+
+	// rings * segments * 2 triangles, every face corner has its own position, uv and normal index like exported meshes
+	void writeSphereObj(const std::string& path, int rings, int segments)
+	{
+		std::ofstream obj{ path };
+		const float pi = 3.14159265f;
+		for (int r = 0; r <= rings; r++)
+		{
+			for (int s = 0; s <= segments; s++)
+			{
+				const float theta = pi * r / rings, phi = 2.f * pi * s / segments;
+				const float x = std::sin(theta) * std::cos(phi), y = std::cos(theta), z = std::sin(theta) * std::sin(phi);
+				obj << "v " << x << ' ' << y << ' ' << z << '\n';
+				obj << "vn " << x << ' ' << y << ' ' << z << '\n';
+				obj << "vt " << float(s) / segments << ' ' << float(r) / rings << '\n';
+			}
+		}
+		const auto corner = [&](int r, int s) { const int i = r * (segments + 1) + s + 1; return std::to_string(i) + '/' + std::to_string(i) + '/' + std::to_string(i); };
+		for (int r = 0; r < rings; r++)
+		{
+			for (int s = 0; s < segments; s++)
+			{
+				obj << "f " << corner(r, s) << ' ' << corner(r + 1, s) << ' ' << corner(r + 1, s + 1) << '\n';
+				obj << "f " << corner(r, s) << ' ' << corner(r + 1, s + 1) << ' ' << corner(r, s + 1) << '\n';
+			}
+		}
+	}
+
+	// files for a sphere of about range(0) triangles, written on first use
+	struct Files
+	{
+		std::string obj, sector;
+		explicit Files(int64_t triangles)
+		{
+			const int segments = static_cast<int>(std::sqrt(static_cast<double>(triangles)));
+			obj = tempPath(("sector_load_benchmark_" + std::to_string(triangles) + ".obj").c_str());
+			sector = tempPath(("sector_load_benchmark_" + std::to_string(triangles) + ".vsec").c_str());
+			writeSphereObj(obj, segments / 2, segments);
+
+			// the sector file holds the same mesh, converted once by the writer
+			SectorContent content{};
+			content.primitives.emplace_back();
+			content.primitives.back().mesh.loadFromFile(obj);
+			SectorFile::write(sector, COORD, content);
+		}
+		~Files()
+		{
+			std::remove(obj.c_str());
+			std::remove(sector.c_str());
+		}
+	};
+
+	void BM_LoadObj(benchmark::State& state)
+	{
+		const Files files{ state.range(0) };
+		std::vector<uint8_t> staging{};
+		size_t vertices = 0;
+		for (auto _ : state)
+		{
+			EngineCore::Primitive::MeshBuilder builder{};
+			builder.loadFromFile(files.obj);
+			staging.resize(builder.vertices.size() * sizeof(Vertex));
+			memcpy(staging.data(), builder.vertices.data(), staging.size());
+			benchmark::DoNotOptimize(staging.data());
+			vertices = builder.vertices.size();
+		}
+		state.SetItemsProcessed(state.iterations() * vertices);
+		state.counters["vertices"] = static_cast<double>(vertices);
+	}
+
+	void BM_LoadSectorFile(benchmark::State& state)
+	{
+		const Files files{ state.range(0) };
+		std::vector<uint8_t> staging{};
+		size_t vertices = 0;
+		for (auto _ : state)
+		{
+			SectorContent content{};
+			if (!SectorFile::read(files.sector, COORD, content)) { state.SkipWithError("sector file missing"); break; }
+			const auto& p = content.primitives[0];
+			staging.resize(p.mappedVertexCount * sizeof(Vertex));
+			memcpy(staging.data(), p.mappedVertices, staging.size());
+			benchmark::DoNotOptimize(staging.data());
+			vertices = p.mappedVertexCount;
+		}
+		state.SetItemsProcessed(state.iterations() * vertices);
+		state.counters["vertices"] = static_cast<double>(vertices);
+	}
+}
+
+BENCHMARK(BM_LoadObj)->Arg(2048)->Arg(32768)->Arg(131072)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadSectorFile)->Arg(2048)->Arg(32768)->Arg(131072)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
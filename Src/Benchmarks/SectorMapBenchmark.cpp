@@ -0,0 +1,133 @@
+#include "Core/WorldSystem/SectorMap.h"
+#include "Core/Primitive.h" // destroying a Sector destroys its primitives
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace WorldSystem;
+
+/*	SectorMap against the vector registry World used before (find_if / remove_if over unique_ptrs),
+*	registries hold 10, 1k and 100k sectors laid out as a cube around the origin, inserts and evictions are
+*	measured in batches of BATCH sectors outside of it so the registry size stays fixed */
+namespace
+{
+	constexpr int BATCH = 64;
+
+	struct VectorRegistry
+	{
+		std::vector<std::unique_ptr<Sector>> sectors;
+
+		Sector* find(const SectorCoord& coord)
+		{
+			auto it = std::find_if(sectors.begin(), sectors.end(), [&coord](const std::unique_ptr<Sector>& s) { return s->coordinates == coord; });
+			return it == sectors.end() ? nullptr : it->get();
+		}
+		void insert(std::unique_ptr<Sector> sector) { sectors.push_back(std::move(sector)); }
+		void erase(const SectorCoord& coord)
+		{
+			auto it = std::remove_if(sectors.begin(), sectors.end(), [&coord](const std::unique_ptr<Sector>& s) { return s->coordinates == coord; });
+			sectors.erase(it, sectors.end());
+		}
+	};
+
+	struct MapRegistry
+	{
+		SectorMap sectors;
+
+		Sector* find(const SectorCoord& coord) { return sectors.find(coord); }
+		void insert(std::unique_ptr<Sector> sector) { sectors.insert(std::move(sector)); }
+		void erase(const SectorCoord& coord) { sectors.erase(coord); }
+	};
+
+	std::vector<SectorCoord> cubeCoords(int64_t count)
+	{
+		std::vector<SectorCoord> coords{};
+		intmax_t side = 1;
+		while (side * side * side < count) { side++; }
+		for (intmax_t i = 0; i < count; i++) { coords.emplace_back(i % side - side / 2, i / side % side - side / 2, i / (side * side) - side / 2); }
+		return coords;
+	}
+
+	// coordinates outside of the cube, so they are never present in the registry
+	std::vector<SectorCoord> outsideCoords()
+	{
+		std::vector<SectorCoord> coords{};
+		for (intmax_t i = 0; i < BATCH; i++) { coords.emplace_back(1000000 + i, 0, 0); }
+		return coords;
+	}
+
+	template<typename Registry>
+	void fill(Registry& registry, const std::vector<SectorCoord>& coords)
+	{
+		for (const SectorCoord& c : coords) { registry.insert(std::make_unique<Sector>(c)); }
+	}
+
+	template<typename Registry>
+	void BM_Lookup(benchmark::State& state)
+	{
+		Registry registry{};
+		const std::vector<SectorCoord> coords = cubeCoords(state.range(0));
+		fill(registry, coords);
+		std::vector<SectorCoord> queries = coords;
+		std::shuffle(queries.begin(), queries.end(), std::mt19937{ 1 });
+
+		size_t next = 0;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(registry.find(queries[next]));
+			if (++next == queries.size()) { next = 0; }
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// loadSector checks the registry before adding a sector, so an insert includes a failed lookup
+	template<typename Registry>
+	void BM_Insert(benchmark::State& state)
+	{
+		Registry registry{};
+		fill(registry, cubeCoords(state.range(0)));
+		const std::vector<SectorCoord> batch = outsideCoords();
+
+		for (auto _ : state)
+		{
+			for (const SectorCoord& c : batch)
+			{
+				if (!registry.find(c)) { registry.insert(std::make_unique<Sector>(c)); }
+			}
+			state.PauseTiming();
+			for (const SectorCoord& c : batch) { registry.erase(c); }
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations() * BATCH);
+	}
+
+	template<typename Registry>
+	void BM_Evict(benchmark::State& state)
+	{
+		Registry registry{};
+		fill(registry, cubeCoords(state.range(0)));
+		const std::vector<SectorCoord> batch = outsideCoords();
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			fill(registry, batch);
+			state.ResumeTiming();
+			for (const SectorCoord& c : batch) { registry.erase(c); }
+		}
+		state.SetItemsProcessed(state.iterations() * BATCH);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_Lookup, VectorRegistry)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Lookup, MapRegistry)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Insert, VectorRegistry)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Insert, MapRegistry)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Evict, VectorRegistry)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Evict, MapRegistry)->Arg(10)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN();
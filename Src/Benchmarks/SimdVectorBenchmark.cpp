@@ -0,0 +1,144 @@
+#include "Core/Types/SimdVector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+/*	the Vector3D template against Vec3A/VecBatch on arrays of 1k and 1M vectors (in cache and streaming from memory):
+*	normalize, cross, positions += velocities * dt and transforming points by an affine mat4, items are vectors */
+namespace
+{
+	constexpr float DELTA_TIME = 1.f / 60.f;
+
+	std::vector<Vec> randomVecs(size_t count, unsigned seed)
+	{
+		std::mt19937 rng{ seed };
+		std::uniform_real_distribution<float> coord{ -50.f, 50.f };
+		std::vector<Vec> out(count);
+		for (Vec& v : out) { v = Vec{ coord(rng), coord(rng), coord(rng) }; }
+		return out;
+	}
+
+	std::vector<Vec3A> toVec3A(const std::vector<Vec>& v)
+	{
+		std::vector<Vec3A> out(v.size());
+		VecBatch::toVec3A(v.data(), out.data(), v.size());
+		return out;
+	}
+
+	const glm::mat4 TRANSFORM{ glm::vec4{ 0.f, 2.f, 0.f, 0.f }, glm::vec4{ -2.f, 0.f, 0.f, 0.f }, glm::vec4{ 0.f, 0.f, 3.f, 0.f }, glm::vec4{ 10.f, -5.f, 1.f, 1.f } };
+
+	void setItems(benchmark::State& state) { state.SetItemsProcessed(state.iterations() * state.range(0)); }
+}
+
+static void BM_NormalizeVec(benchmark::State& state)
+{
+	const std::vector<Vec> in = randomVecs(static_cast<size_t>(state.range(0)), 1);
+	std::vector<Vec> out(in.size());
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < in.size(); i++) { out[i] = in[i].getNormalized(); }
+		benchmark::DoNotOptimize(out.data());
+	}
+	setItems(state);
+}
+
+static void BM_NormalizeVec3A(benchmark::State& state)
+{
+	const std::vector<Vec3A> in = toVec3A(randomVecs(static_cast<size_t>(state.range(0)), 1));
+	std::vector<Vec3A> out(in.size());
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < in.size(); i++) { out[i] = in[i].normalized(); }
+		benchmark::DoNotOptimize(out.data());
+	}
+	setItems(state);
+}
+
+static void BM_CrossVec(benchmark::State& state)
+{
+	const std::vector<Vec> a = randomVecs(static_cast<size_t>(state.range(0)), 2), b = randomVecs(a.size(), 3);
+	std::vector<Vec> out(a.size());
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < a.size(); i++) { out[i] = Vec::cross(a[i], b[i]); }
+		benchmark::DoNotOptimize(out.data());
+	}
+	setItems(state);
+}
+
+static void BM_CrossVec3A(benchmark::State& state)
+{
+	const std::vector<Vec3A> a = toVec3A(randomVecs(static_cast<size_t>(state.range(0)), 2)), b = toVec3A(randomVecs(a.size(), 3));
+	std::vector<Vec3A> out(a.size());
+	for (auto _ : state)
+	{
+		VecBatch::cross(a.data(), b.data(), out.data(), a.size());
+		benchmark::DoNotOptimize(out.data());
+	}
+	setItems(state);
+}
+
+static void BM_ScaleAddVec(benchmark::State& state)
+{
+	std::vector<Vec> position = randomVecs(static_cast<size_t>(state.range(0)), 4);
+	const std::vector<Vec> velocity = randomVecs(position.size(), 5);
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < position.size(); i++) { position[i] += velocity[i] * DELTA_TIME; }
+		benchmark::DoNotOptimize(position.data());
+	}
+	setItems(state);
+}
+
+static void BM_ScaleAddVec3A(benchmark::State& state)
+{
+	std::vector<Vec3A> position = toVec3A(randomVecs(static_cast<size_t>(state.range(0)), 4));
+	const std::vector<Vec3A> velocity = toVec3A(randomVecs(position.size(), 5));
+	for (auto _ : state)
+	{
+		VecBatch::scaleAdd(position.data(), velocity.data(), DELTA_TIME, position.data(), position.size());
+		benchmark::DoNotOptimize(position.data());
+	}
+	setItems(state);
+}
+
+static void BM_TransformVec(benchmark::State& state)
+{
+	const std::vector<Vec> in = randomVecs(static_cast<size_t>(state.range(0)), 6);
+	std::vector<Vec> out(in.size());
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < in.size(); i++)
+		{
+			const glm::vec4 p = TRANSFORM * glm::vec4{ in[i].x, in[i].y, in[i].z, 1.f };
+			out[i] = Vec{ p.x, p.y, p.z };
+		}
+		benchmark::DoNotOptimize(out.data());
+	}
+	setItems(state);
+}
+
+static void BM_TransformVec3A(benchmark::State& state)
+{
+	const std::vector<Vec3A> in = toVec3A(randomVecs(static_cast<size_t>(state.range(0)), 6));
+	std::vector<Vec3A> out(in.size());
+	for (auto _ : state)
+	{
+		VecBatch::transformPoints(TRANSFORM, in.data(), out.data(), in.size());
+		benchmark::DoNotOptimize(out.data());
+	}
+	setItems(state);
+}
+
+BENCHMARK(BM_NormalizeVec)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_NormalizeVec3A)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_CrossVec)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_CrossVec3A)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_ScaleAddVec)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_ScaleAddVec3A)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_TransformVec)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_TransformVec3A)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
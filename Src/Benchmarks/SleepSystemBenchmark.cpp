@@ -0,0 +1,62 @@
+#include "Core/Physics/PhysicsScene.h"
+#include "Core/Physics/Rigidbody.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace Physics;
+
+/*	50k bodies, 95% of them boxes resting on a static ground, the other 2.5k spheres drifting above them without
+*	touching anything, PhysicsScene steps with sleeping disabled and enabled, after 60 steps of settling (long enough
+*	for the resting boxes to fall asleep), counters are the awake bodies and the broadphase and solver time per step */
+namespace
+{
+	constexpr int BODIES = 50000;
+	constexpr int MOVING = BODIES / 20;
+
+	void buildScene(PhysicsScene& scene)
+	{
+		scene.createBody(Vec{ 0.f, -1.f, 0.f }, 0.f, Collider::box(Vec{ 150.f, 1.f, 150.f }));
+		const int resting = BODIES - MOVING;
+		const int side = 218; // 218^2 >= 47.5k
+		for (int i = 0; i < resting; i++)
+		{
+			const Vec p{ (i % side) * 1.2f - 130.f, .5f, (i / side) * 1.2f - 130.f };
+			auto box = scene.createBody(p, 1.f, Collider::box(Vec{ .5f, .5f, .5f }));
+			box->setAcceleration(Vec{ 0.f, -9.81f, 0.f });
+		}
+		// one lane per sphere, all at the same speed, so they never meet
+		for (int i = 0; i < MOVING; i++)
+		{
+			const Vec p{ (i % 50) * 5.f - 125.f, 3.f, (i / 50) * 5.f - 125.f };
+			auto sphere = scene.createBody(p, 1.f, Collider::sphere(.5f));
+			sphere->setDamping(1.f);
+			sphere->setVelocity(Vec{ 1.f, 0.f, 0.f });
+		}
+	}
+}
+
+template<bool SLEEP>
+static void BM_MostlyResting(benchmark::State& state)
+{
+	PhysicsScene scene{};
+	scene.getSleepSystem().settings.enabled = SLEEP;
+	buildScene(scene);
+	for (int step = 0; step < 60; step++) { scene.simulate(1.f / 60.f); }
+
+	double broadphaseMs = 0.0, resolveMs = 0.0;
+	for (auto _ : state)
+	{
+		scene.simulate(1.f / 60.f);
+		broadphaseMs += scene.getStats().broadphaseMs;
+		resolveMs += scene.getStats().resolveMs;
+	}
+	const double steps = static_cast<double>(state.iterations());
+	state.counters["awake"] = scene.getStats().awake;
+	state.counters["broadphase_ms"] = broadphaseMs / steps;
+	state.counters["resolve_ms"] = resolveMs / steps;
+}
+
+BENCHMARK_TEMPLATE(BM_MostlyResting, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MostlyResting, true)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+#include "Core/Physics/ForcePools.h"
+#include "Core/Physics/ForceGenerator.h"
+#include "Core/Physics/Rigidbody.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+/*	one force pass over 10k and 100k springs between randomly chosen bodies (one body per two springs),
+*	SpringPool applies both ends in one pass, the generator path needs one SpringForceGenerator per end */
+namespace
+{
+	struct Scene
+	{
+		BodyStore store;
+		std::vector<std::shared_ptr<Rigidbody>> bodies;
+		std::vector<std::pair<uint32_t, uint32_t>> springs;
+
+		explicit Scene(int64_t springCount)
+		{
+			std::mt19937 rng{ 21 };
+			std::uniform_real_distribution<float> position{ -100.f, 100.f };
+			const int64_t bodyCount = springCount / 2;
+			for (int64_t i = 0; i < bodyCount; i++) { bodies.push_back(std::make_shared<Rigidbody>(store, Vec{ position(rng), position(rng), position(rng) }, 1.f)); }
+			std::uniform_int_distribution<uint32_t> pick{ 0, static_cast<uint32_t>(bodyCount - 1) };
+			while (static_cast<int64_t>(springs.size()) < springCount)
+			{
+				const uint32_t a = pick(rng), b = pick(rng);
+				if (a != b) { springs.emplace_back(a, b); }
+			}
+		}
+	};
+}
+
+static void BM_SpringPool(benchmark::State& state)
+{
+	Scene scene{ state.range(0) };
+	SpringPool pool{};
+	for (const auto& s : scene.springs) { pool.add(scene.bodies[s.first]->getHandle(), scene.bodies[s.second]->getHandle(), 5.f, 10.f, state.range(1) ? .5f : 0.f); }
+	pool.apply(scene.store); // index lookup
+	for (auto _ : state)
+	{
+		pool.apply(scene.store);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpringPool)->ArgNames({ "springs", "damped" })->Args({ 10000, 0 })->Args({ 100000, 0 })->Args({ 100000, 1 })->Unit(benchmark::kMicrosecond);
+
+static void BM_SpringForceGenerator(benchmark::State& state)
+{
+	Scene scene{ state.range(0) };
+	std::vector<std::shared_ptr<ForceGenerator>> generators{};
+	for (const auto& s : scene.springs)
+	{
+		auto towardsB = std::make_shared<SpringForceGenerator>(scene.bodies[s.second], 5.f, 10.f);
+		towardsB->addBody(scene.bodies[s.first]);
+		auto towardsA = std::make_shared<SpringForceGenerator>(scene.bodies[s.first], 5.f, 10.f);
+		towardsA->addBody(scene.bodies[s.second]);
+		generators.push_back(towardsB);
+		generators.push_back(towardsA);
+	}
+	for (auto _ : state)
+	{
+		for (auto& g : generators) { g->applyForces(1.f / 60.f); }
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpringForceGenerator)->ArgName("springs")->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+#include "Core/GPU/Descriptors.h"
+#include "Core/GPU/Material.h"
+#include "Core/GPU/Std140.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace EngineCore;
+
+/*	writing the three SectorMaterial members into a UBO host copy, through the runtime layout (accessElement, size check
+*	and memcpy, what UBO::writeMember does) against a Std140::View (a memcpy at an offset known at compile time) */
+namespace
+{
+	using L = ShaderUniforms::SectorMaterial;
+
+	void BM_RuntimeLayoutWrite(benchmark::State& state)
+	{
+		UBO_Layout layout{ UBO_Struct::fromLayout(L{}) };
+		std::vector<uint8_t> data(layout.getBufferSize(), 0);
+		glm::vec3 camera{ 1.f, 2.f, 3.f }, light{ 4.f, 5.f, 6.f };
+		float roughness = .5f;
+		const auto write = [&](size_t member, const void* src, size_t srcSize)
+		{
+			size_t size, offset;
+			layout.accessElement(UBO_Layout::ElementAccessor{ member, 0, 0 }, size, offset);
+			if (size != srcSize) { state.SkipWithError("size mismatch"); }
+			memcpy(data.data() + offset, src, size);
+		};
+		for (auto _ : state)
+		{
+			write(L::CameraPosition, &camera, sizeof(camera));
+			write(L::LightPosition, &light, sizeof(light));
+			write(L::Roughness, &roughness, sizeof(roughness));
+			benchmark::DoNotOptimize(data.data());
+			benchmark::ClobberMemory();
+			roughness += 1.f;
+		}
+		state.SetItemsProcessed(state.iterations() * 3);
+	}
+
+	void BM_Std140ViewWrite(benchmark::State& state)
+	{
+		std::vector<uint8_t> data(L::size, 0);
+		const Std140::View<L> view{ data.data() };
+		glm::vec3 camera{ 1.f, 2.f, 3.f }, light{ 4.f, 5.f, 6.f };
+		float roughness = .5f;
+		for (auto _ : state)
+		{
+			view.set<L::CameraPosition>(camera);
+			view.set<L::LightPosition>(light);
+			view.set<L::Roughness>(roughness);
+			benchmark::DoNotOptimize(data.data());
+			benchmark::ClobberMemory();
+			roughness += 1.f;
+		}
+		state.SetItemsProcessed(state.iterations() * 3);
+	}
+}
+
+BENCHMARK(BM_RuntimeLayoutWrite);
+BENCHMARK(BM_Std140ViewWrite);
+
+BENCHMARK_MAIN();
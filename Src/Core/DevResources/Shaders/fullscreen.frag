@@ -1,18 +1,20 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier: require
 #extension GL_EXT_scalar_block_layout: require
 // input from vertex shader
 layout(location = 0) in vec2 fragUV;
 
 layout (location = 0) out vec4 outColor;
 
-layout(set = 0, binding = 2) uniform sampler _sampler;
+layout(set = 0, binding = 1) uniform sampler _sampler;
 
 layout(std430, set = 1, binding = 0) uniform UBO2
 {
 	vec2 extent;
+	uint inputImage; // texture table slot of the rendered image
 } fx;
 
-layout(set = 2, binding = 0) uniform texture2D attachment;
+layout(set = 2, binding = 0) uniform texture2D textures[]; // bindless texture table
 
 vec4 drawRectangle(vec2 res, vec2 pxPosIn, vec4 pxColorIn, float start, bool solid, float thickness) 
 {
@@ -29,7 +31,7 @@ void main()
 {
 	vec2 resolution = vec2(1920, 1080);
 	vec2 uv = fragUV; //gl_FragCoord.xy / resolution;
-	outColor = texture(sampler2D(attachment, _sampler), uv);
+	outColor = texture(sampler2D(textures[fx.inputImage], _sampler), uv);
 	outColor = drawRectangle(resolution, uv, outColor, 8.0, false, 1.0);
 	outColor = drawRectangle(resolution, uv, outColor, 12.0, false, 1.0);
 	gl_FragDepth = 0.99999;
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier: require
 #extension GL_EXT_scalar_block_layout: require
 // inputs from vertex shader
 layout(location = 0) in vec3 fragColor;
@@ -9,15 +10,16 @@ layout(location = 3) in vec2 fragUV;
 layout (location = 0) out vec4 outColor;
 
 
-layout(set = 0, binding = 2) uniform sampler _sampler;
+layout(set = 0, binding = 1) uniform sampler _sampler;
 
 layout(std430, set = 1, binding = 0) uniform UBO2
 {
 	vec2 extent;
+	uint inputImage; // texture table slot of the rendered image
 } fx;
 
 // rendered image from previous pass
-layout(set = 2, binding = 0) uniform texture2D attachment;
+layout(set = 2, binding = 0) uniform texture2D textures[]; // bindless texture table
 
 
 void main()
@@ -32,12 +34,12 @@ void main()
     vec2 Radius = Size/resolution;
 	vec2 uv = gl_FragCoord.xy / resolution;
 	uv = gl_FragCoord.xy / resolution + fragNormalWS.xy / 20.0;
-	vec4 color = texture(sampler2D(attachment, _sampler), uv);
+	vec4 color = texture(sampler2D(textures[fx.inputImage], _sampler), uv);
 	for(float d=0.0; d<Pi; d+=Pi/Directions)
     {
 		for(float i=1.0/Quality; i<=1.0; i+=1.0/Quality)
         {
-			color += texture(sampler2D(attachment, _sampler), uv+vec2(cos(d),sin(d))*Radius*i);
+			color += texture(sampler2D(textures[fx.inputImage], _sampler), uv+vec2(cos(d),sin(d))*Radius*i);
         }
     }
 
@@ -14,8 +14,7 @@ layout(std430, set = 0, binding = 0) uniform UBO1
 	mat4 projectionViewMatrix;
 } ubo1;
 
-layout(set = 0, binding = 1) uniform texture2D textures[2];
-layout(set = 0, binding = 2) uniform sampler _sampler;
+layout(set = 0, binding = 1) uniform sampler _sampler;
 
 layout(std430, set = 1, binding = 0) uniform UBO2 
 {
@@ -72,7 +71,7 @@ void main()
 
     float effectiveRoughness = ubo2.roughness;
     float indirect = 0.001;
-    //vec4 baseColor = texture(sampler2D(textures[0], _sampler), fragUV);
+    // untextured, a texture table slot does not fit into the 128 byte mesh push block and sector meshes have no textures yet
     float colorGrayscale = 1.0;
     vec4 baseColor = vec4(colorGrayscale,colorGrayscale,colorGrayscale,1.0);
 	vec3 litColor = BRDF(baseColor.xyz, normalize(fragNormalWS), viewDir, lightDir, halfwayVec, effectiveRoughness);
@@ -14,8 +14,7 @@ layout(std430, set = 0, binding = 0) uniform UBO1
 	mat4 projectionViewMatrix;
 } ubo1;
 
-layout(set = 0, binding = 1) uniform texture2D textures[2];
-layout(set = 0, binding = 2) uniform sampler _sampler;
+layout(set = 0, binding = 1) uniform sampler _sampler;
 
 layout(std430, set = 1, binding = 0) uniform UBO2 
 {
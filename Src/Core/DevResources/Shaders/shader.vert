@@ -24,8 +24,7 @@ layout(std430, set = 0, binding = 0) uniform UBO1
   //testStruct[2] test;
 } ubo1;
 
-layout(set = 0, binding = 1) uniform texture2D textures[2];
-layout(set = 0, binding = 2) uniform sampler _sampler;
+layout(set = 0, binding = 1) uniform sampler _sampler;
 
 layout(push_constant) uniform Push
 {
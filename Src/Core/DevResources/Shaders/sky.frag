@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier: require
 #extension GL_EXT_scalar_block_layout: require
 // inputs from vertex shader
 layout(location = 0) in vec3 fragColor;
@@ -10,12 +11,19 @@ layout (location = 0) out vec4 outColor;
 layout (depth_any) out float gl_FragDepth;
 
 
-layout(set = 0, binding = 1) uniform texture2D textures[2];
-layout(set = 0, binding = 2) uniform sampler _sampler;
+layout(set = 0, binding = 1) uniform sampler _sampler;
+// bindless texture table, the pipeline layout places it after the scene global set
+layout(set = 1, binding = 0) uniform texture2D textures[];
+
+layout(push_constant) uniform Push	
+{
+	mat4 transform;
+	uint textureIndex; // texture table slot
+} push;
 
 
 void main() 
 {
 	gl_FragDepth = 0.9999999;
-	outColor = texture(sampler2D(textures[1], _sampler), fragUV);
+	outColor = texture(sampler2D(textures[push.textureIndex], _sampler), fragUV);
 }
\ No newline at end of file
@@ -17,13 +17,12 @@ layout(std430, set = 0, binding = 0) uniform UBO1
 	mat4 projectionViewMatrix;
 } ubo1;
 
-layout(set = 0, binding = 1) uniform texture2D textures[2];
-layout(set = 0, binding = 2) uniform sampler _sampler;
+layout(set = 0, binding = 1) uniform sampler _sampler;
 
 layout(push_constant) uniform Push	
 {
 	mat4 transform;
-	mat4 normalMatrix;
+	uint textureIndex; // texture table slot, read by sky.frag
 } push;
 
 mat4 blenderToVulkan1()
@@ -50,7 +49,7 @@ void main()
 {
 	gl_Position = ubo1.projectionViewMatrix * push.transform * position;
 	//gl_Position.z = gl_Position.w - 0.001;
-	fragNormalWS = normalize(mat3(push.normalMatrix) * normal);
+	fragNormalWS = normalize(mat3(push.transform) * normal); // translation and uniform scale only
 	fragPositionWS = vec4( push.transform * position).xyz;
 	fragUV = uv;
 	fragColor = vec3(0.0, 0.0, 0.0); // hardcoded
@@ -49,8 +49,9 @@ namespace EngineCore
 		boxMesh->bind(cmdBuffer);
 
 		auto sets = std::vector<VkDescriptorSet>{ defaultSet.getDescriptorSet(renderer.getFrameIndex()) };
+		const auto& offsets = defaultSet.getDynamicOffsets();
 
-		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, material->getPipelineLayout(), 0, sets.size(), sets.data(), 0, nullptr);
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, material->getPipelineLayout(), 0, sets.size(), sets.data(), offsets.size(), offsets.data());
 
 		for (DDPushConstant& box : boxPushConstants)
 		{
@@ -3,31 +3,25 @@
 #include "Core/Types/CommonTypes.h"
 #include "Core/GPU/Descriptors.h"
 #include "Core/GPU/Material.h"
+#include "Core/GPU/TextureTable.h"
 #include "Core/Render/Renderer.h"
 
 namespace EngineCore
 {
-	FxDrawer::FxDrawer(EngineDevice& device, DescriptorSet& defaultSet, VkRenderPass renderpass,
+	FxDrawer::FxDrawer(EngineDevice& device, Renderer& renderer, DescriptorSet& defaultSet, VkRenderPass renderpass,
 						const std::vector<VkImageView>& inputImageViews, 
 						const std::vector<VkImageView>& inputDepthImageViews)
-		: device{ device }, defaultSet{ defaultSet }
+		: device{ device }, defaultSet{ defaultSet }, textureTable{ renderer.getTextureTable() }
 	{
 		// initialized as normal
-		uboSet = std::make_unique<DescriptorSet>(device); 
-		UBO_Struct ubo{};
-		ubo.add(uelem::vec2); // viewport extent value to be used in shader
-		uboSet->addUBO(ubo, device);
+		uboSet = std::make_unique<DescriptorSet>(device, renderer.getDescriptorAllocator()); 
+		uboSet->addUBO<ShaderUniforms::FxViewport>(renderer.getUniformRing()); // viewport extent value to be used in shader
 		uboSet->finalize();
 
-		// attachments use the same image count as the swapchain, so that number is used instead of MAX_FRAMES_IN_FLIGHT
-		attachmentSet = std::make_unique<DescriptorSet>(device, (uint32_t)inputImageViews.size()); // set 2
-		ImageArrayDescriptor inputImages{}; // rendered attachment image(s) from the previous renderpass
-		inputImages.addImage(inputImageViews);
-		//inputImages.addImage(inputDepthImageViews);
-		attachmentSet->addImageArray(inputImages);
-		attachmentSet->finalize();
+		// rendered attachment image(s) from the previous renderpass, one per swapchain image, sampled through the texture table (set 2)
+		for (VkImageView view : inputImageViews) { inputImageSlots.push_back(textureTable.add(view)); }
 
-		auto layouts = std::vector<VkDescriptorSetLayout>{ defaultSet.getLayout(), uboSet->getLayout(), attachmentSet->getLayout() };
+		auto layouts = std::vector<VkDescriptorSetLayout>{ defaultSet.getLayout(), uboSet->getLayout(), textureTable.getLayout() };
 
 		// setup material for the fullscreen shaders (no mesh)
 		ShaderFilePaths fullscreenShader(makePath("Shaders/fullscreen.vert.spv"), makePath("Shaders/fullscreen.frag.spv"));
@@ -43,34 +37,45 @@ namespace EngineCore
 		mesh = std::make_unique<Primitive>(device, builder);
 		ShaderFilePaths shader(makePath("Shaders/fx_test.vert.spv"), makePath("Shaders/fx_test.frag.spv"));
 		mesh->setMaterial(MaterialCreateInfo(shader, layouts, VK_SAMPLE_COUNT_1_BIT, renderpass, sizeof(ShaderPushConstants::MeshPushConstants)));
-		mesh->getTransform().scale = 5.f;
-		mesh->getTransform().translation = Vec{ -80.f, 0.f, 0.f };
+		mesh->getTransform().setScale(Vec{ 5.f });
+		mesh->getTransform().setTranslation(Vec{ -80.f, 0.f, 0.f });
 		
 	}
 
+	FxDrawer::~FxDrawer()
+	{
+		// the slots are reused once the frames in flight are done with them (the drawer is replaced with the swapchain)
+		for (uint32_t slot : inputImageSlots) { textureTable.remove(slot); }
+	}
+
 	void FxDrawer::render(VkCommandBuffer cmdBuffer, Renderer& renderer)
 	{
 		const auto& frameIndex = renderer.getFrameIndex();
 		const auto& imageIndex = renderer.getSwapImageIndex();
 
 		// update viewport extent descriptor value
-		VkExtent2D extent = renderer.getSwapchainExtent();
-		uboSet->writeUBOMember(0, extent, UBO_Layout::ElementAccessor{0, 0, 0}, frameIndex);
+		// the shader reads a vec2, the extent is converted instead of copying its integer bits
+		const VkExtent2D extent = renderer.getSwapchainExtent();
+		const glm::vec2 extentValue{ static_cast<float>(extent.width), static_cast<float>(extent.height) };
+		uboSet->writeUBO<ShaderUniforms::FxViewport, ShaderUniforms::FxViewport::Extent>(0, extentValue);
+		// the attachment of the current swapchain image, by slot instead of a set per swapchain image
+		uboSet->writeUBO<ShaderUniforms::FxViewport, ShaderUniforms::FxViewport::InputImage>(0, inputImageSlots[imageIndex]);
 
 		renderer.beginRenderpassFx(cmdBuffer); // FX PASS START
 
 		// draw fullscreen
-		bindDescriptorSets(cmdBuffer, fullscreenMaterial.get()->getPipelineLayout(), frameIndex, imageIndex);
+		bindDescriptorSets(cmdBuffer, fullscreenMaterial.get()->getPipelineLayout(), frameIndex);
 		fullscreenMaterial->bindToCommandBuffer(cmdBuffer);
 		vkCmdDraw(cmdBuffer, 3, 1, 0, 0);
 
 		// draw mesh
-		bindDescriptorSets(cmdBuffer, mesh->getMaterial()->getPipelineLayout(), frameIndex, imageIndex);
+		bindDescriptorSets(cmdBuffer, mesh->getMaterial()->getPipelineLayout(), frameIndex);
 		auto material = mesh->getMaterial();
 		material->bindToCommandBuffer(cmdBuffer);
 		
 		ShaderPushConstants::MeshPushConstants push{};
-		push.transform = mesh->getTransform().mat4();
+		push.transform = mesh->getTransform().getMatrix();
+		push.normalMatrix = mesh->getTransform().getNormalMatrix();
 		material->writePushConstants(cmdBuffer, push);
 
 		mesh->bind(cmdBuffer);
@@ -79,11 +84,15 @@ namespace EngineCore
 		renderer.endRenderpass(); // FX PASS END
 	}
 
-	void FxDrawer::bindDescriptorSets(VkCommandBuffer cmdBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t swapImageIndex)
+	void FxDrawer::bindDescriptorSets(VkCommandBuffer cmdBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex)
 	{
-		// note that sets 0-1 use frame index, but set 2 uses swapchain image index
-		std::array<VkDescriptorSet, 3> vkSets = { defaultSet.getDescriptorSet(frameIndex), uboSet->getDescriptorSet(frameIndex), attachmentSet->getDescriptorSet(swapImageIndex) };
-		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 3, vkSets.data(), 0, nullptr);
+		// sets 0-1 use frame index, set 2 is the texture table shared by all frames
+		std::array<VkDescriptorSet, 3> vkSets = { defaultSet.getDescriptorSet(frameIndex), uboSet->getDescriptorSet(frameIndex), textureTable.getDescriptorSet() };
+		// dynamic offsets in set order, the texture table has no UBOs
+		std::vector<uint32_t> offsets = defaultSet.getDynamicOffsets();
+		const auto& uboOffsets = uboSet->getDynamicOffsets();
+		offsets.insert(offsets.end(), uboOffsets.begin(), uboOffsets.end());
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 3, vkSets.data(), offsets.size(), offsets.data());
 	}
 
 
@@ -11,12 +11,16 @@ namespace EngineCore
 	class DescriptorSet;
 	class Primitive;
 	class Material;
+	class TextureTable;
 	
 	class FxDrawer
 	{
 	public:
-		FxDrawer(EngineDevice& device, DescriptorSet& defaultSet, VkRenderPass renderpass,
+		FxDrawer(EngineDevice& device, Renderer& renderer, DescriptorSet& defaultSet, VkRenderPass renderpass,
 				const std::vector<VkImageView>& inputImageViews, const std::vector<VkImageView>& inputDepthImageViews);
+		~FxDrawer();
+		FxDrawer(const FxDrawer&) = delete;
+		FxDrawer& operator=(const FxDrawer&) = delete;
 
 		void render(VkCommandBuffer cmdBuffer, Renderer& renderer);
 
@@ -25,11 +29,12 @@ namespace EngineCore
 		
 		DescriptorSet& defaultSet;
 		std::unique_ptr<DescriptorSet> uboSet; // additional data, treated as any other descriptor set (using frames in flight number)
-		std::unique_ptr<DescriptorSet> attachmentSet; // attachment image bindings, same number of internal sets as swapchain images
+		TextureTable& textureTable;
+		std::vector<uint32_t> inputImageSlots; // texture table slot of the attachment image of each swapchain image
 		std::unique_ptr<Primitive> mesh;
 		std::unique_ptr<Material> fullscreenMaterial;
 
-		void bindDescriptorSets(VkCommandBuffer cmdBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex, uint32_t swapImageIndex);
+		void bindDescriptorSets(VkCommandBuffer cmdBuffer, VkPipelineLayout pipelineLayout, uint32_t frameIndex);
 	};
 
 }
@@ -18,54 +18,33 @@
 namespace EngineCore
 {
 	void MeshDrawer::renderMeshes(VkCommandBuffer commandBuffer, WorldSystem::World& world,
-			const float& deltaTimeSeconds, float time, uint32_t frameIndex, VkDescriptorSet sceneGlobalDescriptorSet, 
-			const glm::mat4& viewMatrix, Transform& fakeScaleOffsets) //FakeScaleTest082
+			const float& deltaTimeSeconds, float time, uint32_t frameIndex, DescriptorSet& sceneGlobalSet, 
+			const glm::mat4& viewMatrix, const Vec& observer, Transform& fakeScaleOffsets) //FakeScaleTest082
 	{
-		auto& sectors = world.getLoadedSectors();
-		for (uint32_t s = 0; s < sectors.size(); s++)
-		{
-			auto& sector = sectors[s];
-			auto& meshes = sector->primitives;
-			if (sector->isCulled)
-				continue;
+		cullWorld(world, viewMatrix, observer);
 
-			for (uint32_t i = 0; i < meshes.size(); i++)
-			{
-				auto& mesh = meshes[i];
-				auto material = mesh->getMaterial();
+		for (const uint32_t id : culling.getVisible())
+		{
+			Primitive* mesh = drawCandidates[id];
+			auto material = mesh->getMaterial();
 
-				material->bindToCommandBuffer(commandBuffer); // bind material-specific shading pipeline
+			material->bindToCommandBuffer(commandBuffer); // bind material-specific shading pipeline
 
-				std::vector<VkDescriptorSet> sets;
-				// scene global descriptor set
-				sets.push_back(sceneGlobalDescriptorSet);
+			std::vector<VkDescriptorSet> sets;
+			// scene global descriptor set
+			sets.push_back(sceneGlobalSet.getDescriptorSet(frameIndex));
+			std::vector<uint32_t> offsets = sceneGlobalSet.getDynamicOffsets();
 
-				if (auto* matSet = material->getMaterialSpecificDescriptorSet())
-				{
-					// bind material-specific descriptor set
-					sets.push_back(matSet->getDescriptorSet(frameIndex));
-				}
-
-				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, material->getPipelineLayout(),
-										0, sets.size(), sets.data(), 0, nullptr);
-
-				// spin 3D primitive - demo
-				if (s == 1 && i == 0)
-				{
-					float spinRate = 0.1f;
-					mesh->getTransform().rotation.z = glm::mod(mesh->getTransform().rotation.z + spinRate * deltaTimeSeconds, glm::two_pi<float>());
-					mesh->getTransform().rotation.y = glm::mod(mesh->getTransform().rotation.y + spinRate * 0.8f * deltaTimeSeconds, glm::two_pi<float>());
-					continue; // TODO: this skips rendering the first mesh!!!
-				}
-
-				// spin 3D primitive - demo
-				if (s == 1 && i == 1)
-				{
+			if (auto* matSet = material->getMaterialSpecificDescriptorSet())
+			{
+				// bind material-specific descriptor set
+				sets.push_back(matSet->getDescriptorSet(frameIndex));
+				const auto& matOffsets = matSet->getDynamicOffsets();
+				offsets.insert(offsets.end(), matOffsets.begin(), matOffsets.end());
+			}
 
-					float spinRate = 0.3f;
-					mesh->getTransform().rotation.z = glm::mod(mesh->getTransform().rotation.z + spinRate * deltaTimeSeconds, glm::two_pi<float>());
-				}
-				
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, material->getPipelineLayout(),
+									0, sets.size(), sets.data(), offsets.size(), offsets.data());
 
 				/*if (camera != nullptr)
 			{
@@ -98,30 +77,60 @@ namespace EngineCore
 				VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
 				0, sizeof(SimplePushConstantData), &push);*/
 
-				//FakeScaleTest082
-				if (mesh->useFakeScale) 
-				{
-					ShaderPushConstants::MeshPushConstants push{};
-					push.transform = fakeScaleOffsets.mat4();
-					material->writePushConstants(commandBuffer, push);
-				} 
-				else 
-				{
-					// NON-TEST CODE!
-					ShaderPushConstants::MeshPushConstants push{};
-					push.transform = mesh->getTransform().mat4();
-					push.normalMatrix = glm::transpose(glm::inverse(push.transform));
-					material->writePushConstants(commandBuffer, push);
-				}
-
-				// record mesh draw command
-				mesh->bind(commandBuffer);
-				mesh->draw(commandBuffer);
+			//FakeScaleTest082
+			if (mesh->useFakeScale) 
+			{
+				ShaderPushConstants::MeshPushConstants push{};
+				push.transform = fakeScaleOffsets.mat4();
+				material->writePushConstants(commandBuffer, push);
+			} 
+			else 
+			{
+				// NON-TEST CODE!
+				ShaderPushConstants::MeshPushConstants push{};
+				push.transform = mesh->getTransform().getMatrix();
+				push.normalMatrix = mesh->getTransform().getNormalMatrix();
+				material->writePushConstants(commandBuffer, push);
 			}
+
+			// record mesh draw command
+			mesh->bind(commandBuffer);
+			mesh->draw(commandBuffer);
 		}
 
 	}
 
+	void MeshDrawer::cullWorld(WorldSystem::World& world, const glm::mat4& projectionView, const Vec& observer)
+	{
+		drawCandidates.clear();
+		culling.begin(projectionView, observer);
+
+		const auto submitSector = [this](WorldSystem::Sector& sector)
+		{
+			for (auto& primitive : sector.primitives)
+			{
+				const OOBB box = primitive.getOOBB();
+				const uint32_t id = static_cast<uint32_t>(drawCandidates.size());
+				drawCandidates.push_back(&primitive);
+				culling.submit(box.center, box.getBoundingRadius(), id);
+			}
+		};
+
+		// the persistent sector is not bound to a sector volume, only its primitives are tested
+		submitSector(world.getPersistentSector());
+
+		/*	content of a sector may reach up to one full sector size from its origin
+		*	(the same distance at which the local sector changes), so the sector box is twice the sector size */
+		const Vec halfExtent = Vec(static_cast<float>(world.getSectorSize()));
+		for (auto& sector : world.getLoadedSectors())
+		{
+			const Vec center = world.sectorToLocal(sector.coordinates);
+			sector.isCulled = !culling.testSector(center - halfExtent, center + halfExtent);
+			if (!sector.isCulled) { submitSector(sector); }
+		}
+		culling.end();
+	}
+
 	glm::mat4 MeshDrawer::lerpMat4(float t, glm::mat4 matA, glm::mat4 matB) 
 	{
 		glm::mat4 matOut{};
@@ -1,6 +1,7 @@
 #pragma once
 #include "Core/GPU/Material.h"
 #include "Core/Primitive.h"
+#include "Core/Render/CullingPass.h"
 
 #include <glm/gtc/matrix_transform.hpp> // glm
 #include <memory>
@@ -28,12 +29,22 @@ namespace EngineCore
 		MeshDrawer& operator=(const MeshDrawer&) = delete;
 
 		void renderMeshes(VkCommandBuffer commandBuffer, WorldSystem::World& world,
-						const float& deltaTimeSeconds, float time, uint32_t frameIndex, VkDescriptorSet sceneGlobalDescriptorSet,
-						const glm::mat4& viewMatrix, Transform& fakeScaleOffsets); //FakeScaleTest082
+						const float& deltaTimeSeconds, float time, uint32_t frameIndex, DescriptorSet& sceneGlobalSet,
+						const glm::mat4& viewMatrix, const Vec& observer, Transform& fakeScaleOffsets); //FakeScaleTest082
+
+		// visible counts and cull time of the last renderMeshes call
+		const CullingPass::Stats& getCullingStats() const { return culling.getStats(); }
+		CullingPass& getCullingPass() { return culling; }
 
 	private:
 		EngineDevice& device;
 
+		CullingPass culling{};
+		std::vector<Primitive*> drawCandidates; // primitives of visible sectors, indexed by the culling pass ids
+
+		// fills the culling pass with sector and primitive bounds, sets Sector::isCulled
+		void cullWorld(WorldSystem::World& world, const glm::mat4& projectionView, const Vec& observer);
+
 		static glm::mat4 orthographicMatrix(const float& n, const float& f)
 		{
 			float r = 1.f;
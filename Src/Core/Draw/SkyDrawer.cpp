@@ -3,10 +3,13 @@
 #include "Core/GPU/Device.h"
 #include "Core/Types/CommonTypes.h"
 #include "Core/GPU/Material.h"
+#include "Core/GPU/TextureTable.h"
 
 namespace EngineCore
 {
-	SkyDrawer::SkyDrawer(EngineDevice& device, DescriptorSet& defaultSet, VkRenderPass renderpass, VkSampleCountFlagBits samples)
+	SkyDrawer::SkyDrawer(EngineDevice& device, DescriptorSet& defaultSet, TextureTable& textureTable, uint32_t textureSlot,
+							VkRenderPass renderpass, VkSampleCountFlagBits samples)
+		: textureTable{ textureTable }, textureSlot{ textureSlot }
 	{
 		// TODO: hardcoded paths
 		const std::string meshPath = makePath("Meshes/skysphere.obj");
@@ -16,16 +19,16 @@ namespace EngineCore
 		Primitive::MeshBuilder builder{};
 		builder.loadFromFile(meshPath);
 		skyMesh = std::make_unique<Primitive>(device, builder);
-		skyMesh->getTransform().scale = 50.f;
+		skyMesh->getTransform().setScale(Vec{ 50.f });
 
 		// create unique material for sky, set to render backfaces, since it will be viewed from inside
-		auto layouts = std::vector<VkDescriptorSetLayout>{ defaultSet.getLayout() };
-		MaterialCreateInfo matInfo(skyShaders, layouts, samples, renderpass, sizeof(ShaderPushConstants::MeshPushConstants));
+		auto layouts = std::vector<VkDescriptorSetLayout>{ defaultSet.getLayout(), textureTable.getLayout() };
+		MaterialCreateInfo matInfo(skyShaders, layouts, samples, renderpass, sizeof(ShaderPushConstants::SkyPushConstants));
 		matInfo.shadingProperties.cullModeFlags = VK_CULL_MODE_NONE;
 		skyMesh->setMaterial(matInfo);
 	}
 
-	void SkyDrawer::renderSky(VkCommandBuffer commandBuffer, VkDescriptorSet sceneGlobalDescriptorSet, 
+	void SkyDrawer::renderSky(VkCommandBuffer commandBuffer, DescriptorSet& sceneGlobalSet, uint32_t frameIndex,
 									const glm::vec3& observerPosition)
 	{
 		// aliases for convenience
@@ -34,16 +37,19 @@ namespace EngineCore
 
 		skyMat->bindToCommandBuffer(commandBuffer); // bind sky shader pipeline
 
-		// bind scene global descriptor set
+		// bind scene global descriptor set and the texture table, the sky texture is selected by a push constant
+		const VkDescriptorSet sets[] = { sceneGlobalSet.getDescriptorSet(frameIndex), textureTable.getDescriptorSet() };
+		const auto& offsets = sceneGlobalSet.getDynamicOffsets();
 		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, skyMat->getPipelineLayout(),
-									0, 1, &sceneGlobalDescriptorSet, 0, nullptr);
+									0, 2, sets, offsets.size(), offsets.data());
 
 		// sky mesh position should be centered at the observer (camera) at all times
 		Transform otf{}; // zero init transform, only translation is relevant
 		otf.translation = observerPosition;
 		otf.scale = { skyMeshScale, skyMeshScale, skyMeshScale };
-		ShaderPushConstants::MeshPushConstants push{};
+		ShaderPushConstants::SkyPushConstants push{};
 		push.transform = otf.mat4();
+		push.textureIndex = textureSlot;
 		skyMat->writePushConstants(commandBuffer, push);
 
 		// record draw command for sky mesh
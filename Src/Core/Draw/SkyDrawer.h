@@ -11,19 +11,24 @@ namespace EngineCore
 	class EngineDevice;
 	class Primitive;
 	class DescriptorSet;
+	class TextureTable;
 
 	class SkyDrawer 
 	{
 	public:
-		SkyDrawer(EngineDevice& device, DescriptorSet& defaultSet, VkRenderPass renderpass, VkSampleCountFlagBits samples);
+		// textureSlot is the sky texture in the texture table
+		SkyDrawer(EngineDevice& device, DescriptorSet& defaultSet, TextureTable& textureTable, uint32_t textureSlot,
+					VkRenderPass renderpass, VkSampleCountFlagBits samples);
 
-		void renderSky(VkCommandBuffer commandBuffer, VkDescriptorSet sceneGlobalDescriptorSet, 
+		void renderSky(VkCommandBuffer commandBuffer, DescriptorSet& sceneGlobalSet, uint32_t frameIndex,
 						const glm::vec3& observerPosition);
 
 		float skyMeshScale = 1000.f * 10.f;
 
 	private:
 		std::unique_ptr<Primitive> skyMesh;
+		TextureTable& textureTable;
+		uint32_t textureSlot;
 		
 	};
 
@@ -70,15 +70,10 @@ namespace EngineCore
 		marsTexture = std::make_unique<Image>(device, makePath("Textures/mars6k_v2.jpg"));
 		spaceTexture = std::make_unique<Image>(device, makePath("Textures/space.png"));
 
-		UBO_Struct ubo1{};
-		ubo1.add(uelem::mat4); // MVP matrix
-		//ubo1.add(std::vector{ uelem::scalar, uelem::vec3 }, 2); // test
-		dset.addUBO(ubo1, device);
-		// as the demo textures will never be overwritten from the CPU, only one buffer is needed for each, so the view can simply be duplicated
-		ImageArrayDescriptor demoTextureArray{};
-		demoTextureArray.addImage(std::vector<VkImageView>(EngineSwapChain::MAX_FRAMES_IN_FLIGHT, marsTexture->getView()));
-		demoTextureArray.addImage(std::vector<VkImageView>(EngineSwapChain::MAX_FRAMES_IN_FLIGHT, spaceTexture->getView()));
-		dset.addImageArray(demoTextureArray);
+		dset.addUBO<ShaderUniforms::SceneGlobal>(renderer.getUniformRing()); // MVP matrix
+		// textures are sampled through the bindless texture table by slot, the global set holds the sampler they share
+		marsTextureSlot = renderer.getTextureTable().add(marsTexture->getView());
+		spaceTextureSlot = renderer.getTextureTable().add(spaceTexture->getView());
 		dset.addSampler(marsTexture->sampler);
 		dset.finalize();
 	}
@@ -89,8 +84,8 @@ namespace EngineCore
 		auto fxPass = renderer.getFxRenderpass().getRenderpass();
 
 		meshDrawer = std::make_unique<MeshDrawer>(device);
-		skyDrawer = std::make_unique<SkyDrawer>(device, dset, basePass, renderSettings.sampleCountMSAA);
-		fxDrawer = std::make_unique<FxDrawer>(device, dset, fxPass, renderer.getFxPassInputImageViews(), renderer.getFxPassInputDepthImageViews());
+		skyDrawer = std::make_unique<SkyDrawer>(device, dset, renderer.getTextureTable(), spaceTextureSlot, basePass, renderSettings.sampleCountMSAA);
+		fxDrawer = std::make_unique<FxDrawer>(device, renderer, dset, fxPass, renderer.getFxPassInputImageViews(), renderer.getFxPassInputDepthImageViews());
 		uiDrawer = std::make_unique<InterfaceDrawer>(device, basePass, renderSettings.sampleCountMSAA);
 		debugDrawer = std::make_unique<DebugDrawer>(device, dset, basePass, renderSettings.sampleCountMSAA);
 		//debugDrawer->addDebugBox(Vec(100.f), Vec::zero(), Vec(0.f, 0.f, .8f), 0.5f);
@@ -251,21 +246,23 @@ namespace EngineCore
 
 			testMoveObjectWithMouse();
 
+			physicsStepper.advance(engineClock.getDelta());
+
 			world.sectorUpdate(camera);
 			//std::cout << camera.transform.translation.x * 0.00001 << "\n";
 			debugDrawer->removeDebugBoxes();
-			debugDrawer->addDebugBox(Vec(world.getSectorSize()), world.getLocalSectorOriginAbsolute(), Vec(0.f, 0.f, .8f), 0.5f);
+			debugDrawer->addDebugBox(Vec(world.getSectorSize()), Vec::zero(), Vec(0.f, 0.f, .8f), 0.5f);
 			
-			updateDescriptors(frameIndex);
+			updateDescriptors();
 
 			renderer.beginRenderpassBase(commandBuffer);
 
 			// render sky sphere
-			skyDrawer->renderSky(commandBuffer, dset.getDescriptorSet(frameIndex), camera.transform.translation);
+			skyDrawer->renderSky(commandBuffer, dset, frameIndex, camera.transform.translation);
 			//simulateDistanceByScale(*loadedMeshes[1].get(), camera.transform); //FakeScaleTest082
 			// render meshes
 			meshDrawer->renderMeshes(commandBuffer, world, engineClock.getDelta(), engineClock.getElapsed(), frameIndex,
-										dset.getDescriptorSet(frameIndex), getProjectionViewMatrix(), simDistOffsets); //FakeScaleTest082
+										dset, getProjectionViewMatrix(), camera.transform.translation, simDistOffsets); //FakeScaleTest082
 
 			debugDrawer->render(commandBuffer, renderer);
 
@@ -319,14 +316,16 @@ namespace EngineCore
 			return;
 		}
 
-		if (world.getLoadedSectors().size() < 2 && world.getLoadedSectors()[1]->primitives.size() < 2)
+		// demo content is streamed, the object being moved lives in the sector the camera is in
+		WorldSystem::Sector* sector = world.getLoadedSectors().find(world.getLocalSectorCoordinate());
+		if (sector == nullptr || sector->primitives.size() < 2)
 			return;
 
-		auto& objectToMove = world.getLoadedSectors()[1]->primitives[1];
+		auto& objectToMove = sector->primitives[1];
 
 		if (!movingObjectWithCursor)
 		{
-			mouseMoveObjectOriginalLocation = objectToMove->getTransform().translation;
+			mouseMoveObjectOriginalLocation = objectToMove.getTransform().getTranslation();
 			movingObjectWithCursor = true;
 		}
 
@@ -353,7 +352,7 @@ namespace EngineCore
 		
 		p.x += 1800.f;// TMP!!!
 
-		objectToMove->setTranslation(p);
+		objectToMove.setTranslation(p);
 
 		std::cout << "\nfinal x:" << p.x << " y:" << p.y << " z:" << p.z;
 	}
@@ -388,17 +387,18 @@ namespace EngineCore
 		return { worldv.x, worldv.y, worldv.z };
 	}
 
-	void EngineApplication::updateDescriptors(uint32_t frameIndex)
+	void EngineApplication::updateDescriptors()
 	{
 		glm::mat4 pvm{ 1.f };
 		//pvm = camera.getProjectionMatrix() * basis conversion matrix * camera.getViewMatrix();
 		pvm = getProjectionViewMatrix();
-		dset.writeUBOMember(0, pvm, UBO_Layout::ElementAccessor{ 0, 0, 0 }, frameIndex);
+		using Global = ShaderUniforms::SceneGlobal;
+		dset.writeUBO<Global, Global::ProjectionView>(0, pvm);
 
 		//float testScalar1 = 1.f - std::sin(engineClock.getElapsed() * 10.f);
 		//float testScalar2 = 1.f - std::sin(engineClock.getElapsed() * 50.f);
-		//dset.writeUBOMember(0, testScalar1, UBO_Layout::ElementAccessor{ 1, 0, 0 }, frameIndex);
-		//dset.writeUBOMember(0, testScalar2, UBO_Layout::ElementAccessor{ 1, 1, 0 }, frameIndex);
+		//dset.writeUBOMember(0, testScalar1, UBO_Layout::ElementAccessor{ 1, 0, 0 });
+		//dset.writeUBOMember(0, testScalar2, UBO_Layout::ElementAccessor{ 1, 1, 0 });
 
 		//applyWorldOriginOffset(camera.transform); //(TODO: ) experimental
 
@@ -408,12 +408,13 @@ namespace EngineCore
 
 		lightPos.y -= 50.f * engineClock.getDelta();
 		float roughness = 0.15f;
-		if (world.getLoadedSectors().size() && world.getPersistentSector().primitives.size() > 0)
+		if (auto* sectorSet = world.getSectorMaterialSet())
 		{
-			auto& meshDset = *world.getPersistentSector().primitives[0]->getMaterial()->getMaterialSpecificDescriptorSet();
-			meshDset.writeUBOMember(0, camPos, UBO_Layout::ElementAccessor{ 0, 0, 0 }, frameIndex);
-			meshDset.writeUBOMember(0, lightPos, UBO_Layout::ElementAccessor{ 1, 0, 0 }, frameIndex);
-			meshDset.writeUBOMember(0, roughness, UBO_Layout::ElementAccessor{ 2, 0, 0 }, frameIndex);
+			using SectorUniforms = ShaderUniforms::SectorMaterial;
+			auto& meshDset = *sectorSet;
+			meshDset.writeUBO<SectorUniforms, SectorUniforms::CameraPosition>(0, camPos);
+			meshDset.writeUBO<SectorUniforms, SectorUniforms::LightPosition>(0, lightPos);
+			meshDset.writeUBO<SectorUniforms, SectorUniforms::Roughness>(0, roughness);
 		}
 	}
 
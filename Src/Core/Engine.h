@@ -6,6 +6,7 @@
 #include "Core/Draw/DrawIncludes.h"
 #include "Core/WorldSystem/World.h"
 #include "Core/Physics/PhysicsScene.h"
+#include "Core/Physics/FixedStepper.h"
 
 #include <memory>
 #include <vector>
@@ -53,6 +54,8 @@ namespace EngineCore
 		VkDescriptorSetLayout getGlobalDescriptorLayout() const { return dset.getLayout(); }
 		const EngineRenderSettings& getRenderSettings() const { return renderSettings; }
 		Renderer& getRenderer() { return renderer; }
+		Physics::PhysicsScene& getPhysicsScene() { return physicsScene; }
+		const Physics::FixedStepper& getPhysicsStepper() const { return physicsStepper; }
 
 	private:
 		void loadDemoScene();
@@ -62,7 +65,7 @@ namespace EngineCore
 		void setupDrawers();
 		void onSwapchainCreated();
 		void render();
-		void updateDescriptors(uint32_t frameIndex);
+		void updateDescriptors();
 		void moveCamera();
 		glm::mat4 getProjectionViewMatrix(bool inverse = false);
 
@@ -84,7 +87,7 @@ namespace EngineCore
 		EngineClock engineClock{};
 
 		// default global descriptor set
-		DescriptorSet dset{ device }; 
+		DescriptorSet dset{ device, renderer.getDescriptorAllocator() }; 
 
 		std::unique_ptr<DescriptorPool> globalDescriptorPool{};
 		std::vector<std::unique_ptr<Primitive>> loadedMeshes;// moved to world/sector system
@@ -92,6 +95,9 @@ namespace EngineCore
 		Camera camera;
 		std::unique_ptr<Image> spaceTexture;
 		std::unique_ptr<Image> marsTexture;
+		// texture table slots of the demo textures
+		uint32_t spaceTextureSlot = 0;
+		uint32_t marsTextureSlot = 0;
 
 		std::unique_ptr<MeshDrawer> meshDrawer;
 		std::unique_ptr<SkyDrawer> skyDrawer;
@@ -107,6 +113,10 @@ namespace EngineCore
 
 		WorldSystem::World world{ device, *this };
 
+		// simulated in fixed steps, decoupled from the frame rate
+		Physics::PhysicsScene physicsScene{};
+		Physics::FixedStepper physicsStepper{ physicsScene };
+
 	};
 
 }
\ No newline at end of file
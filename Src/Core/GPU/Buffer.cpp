@@ -22,7 +22,7 @@ namespace EngineCore
 	{
 		alignmentSize = getAlignment(instanceSize, minOffsetAlignment);
 		bufferSize = alignmentSize * instanceCount;
-		device.createBuffer(bufferSize, usageFlags, memoryPropertyFlags, buffer, memory);
+		device.createBuffer(bufferSize, usageFlags, memoryPropertyFlags, buffer, memory, &allocatedPropertyFlags);
 	}
 
 	GBuffer::~GBuffer() 
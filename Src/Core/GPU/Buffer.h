@@ -40,6 +40,8 @@ namespace EngineCore
 		VkDeviceSize getAlignmentSize() const { return alignmentSize; }
 		VkBufferUsageFlags getUsageFlags() const { return usageFlags; }
 		VkMemoryPropertyFlags getMemoryPropertyFlags() const { return memoryPropertyFlags; }
+		// flags of the memory type the buffer was allocated from, at least the requested ones
+		VkMemoryPropertyFlags getAllocatedMemoryPropertyFlags() const { return allocatedPropertyFlags; }
 		VkDeviceSize getBufferSize() const { return bufferSize; }
 
 	private:
@@ -57,6 +59,7 @@ namespace EngineCore
 		VkDeviceSize alignmentSize;
 		VkBufferUsageFlags usageFlags;
 		VkMemoryPropertyFlags memoryPropertyFlags;
+		VkMemoryPropertyFlags allocatedPropertyFlags = 0;
 	};
 
 }
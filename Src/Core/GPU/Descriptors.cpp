@@ -7,9 +7,37 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <stdexcept>
 #include <iostream>
 
+namespace
+{
+	// sets in the first pool of a chain, each new pool doubles it up to the limit
+	constexpr uint32_t FIRST_POOL_SETS = 64;
+	constexpr uint32_t MAX_POOL_SETS = 4096;
+	// pools per chain, allocations fail instead of growing a chain past it (a few hundred thousand sets)
+	constexpr size_t MAX_CHAIN_POOLS = 64;
+	// descriptors of each type per set in a pool, set layouts are small and mostly uniform buffers and images
+	constexpr std::pair<VkDescriptorType, float> POOL_RATIOS[] =
+	{
+		{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.f },
+		{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .5f },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .5f },
+		{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2.f },
+		{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 4.f },
+		{ VK_DESCRIPTOR_TYPE_SAMPLER, 1.f },
+		{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, .5f },
+	};
+
+	// the pool cannot hold the set, any other error (out of host or device memory) would fail in every pool
+	bool isPoolFull(VkResult result) { return result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL; }
+
+	void hashCombine(size_t& seed, uint64_t v) { seed ^= std::hash<uint64_t>{}(v) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2); }
+}
+
 namespace EngineCore
 {
 
@@ -17,7 +45,7 @@ namespace EngineCore
 
 	DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::addBinding(
 		uint32_t binding, VkDescriptorType descriptorType,
-		VkShaderStageFlags stageFlags, uint32_t count)
+		VkShaderStageFlags stageFlags, uint32_t count, VkDescriptorBindingFlags bindingFlags)
 	{
 		assert(bindings.count(binding) == 0 && "Binding already in use");
 		VkDescriptorSetLayoutBinding layoutBinding{};
@@ -26,30 +54,56 @@ namespace EngineCore
 		layoutBinding.descriptorCount = count; // array length
 		layoutBinding.stageFlags = stageFlags;
 		bindings[binding] = layoutBinding;
+		if (bindingFlags) { this->bindingFlags[binding] = bindingFlags; }
+		return *this;
+	}
+
+	DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::setLayoutFlags(VkDescriptorSetLayoutCreateFlags flags)
+	{
+		layoutFlags = flags;
 		return *this;
 	}
 
 	std::unique_ptr<DescriptorSetLayout> DescriptorSetLayout::Builder::build() const
 	{
-		return std::make_unique<DescriptorSetLayout>(device, bindings);
+		return std::make_unique<DescriptorSetLayout>(device, bindings, bindingFlags, layoutFlags);
+	}
+
+	std::shared_ptr<DescriptorSetLayout> DescriptorSetLayout::Builder::build(DescriptorLayoutCache& cache) const
+	{
+		std::vector<VkDescriptorSetLayoutBinding> list{};
+		for (const auto& kv : bindings) { list.push_back(kv.second); }
+		return cache.getSetLayout(std::move(list), bindingFlags, layoutFlags);
 	}
 
 	// *************** Descriptor Set Layout *********************
 
 	DescriptorSetLayout::DescriptorSetLayout(
-		EngineDevice& device, std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings)
+		EngineDevice& device, std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings,
+		const std::unordered_map<uint32_t, VkDescriptorBindingFlags>& bindingFlags, VkDescriptorSetLayoutCreateFlags flags)
 		: device{ device }, bindings{ bindings }
 	{
 		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings{};
+		std::vector<VkDescriptorBindingFlags> setLayoutBindingFlags{};
 		for (auto kv : bindings)
 		{
 			setLayoutBindings.push_back(kv.second);
+			const auto found = bindingFlags.find(kv.first);
+			setLayoutBindingFlags.push_back(found != bindingFlags.end() ? found->second : 0);
 		}
 
 		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo{};
 		descriptorSetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 		descriptorSetLayoutInfo.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
 		descriptorSetLayoutInfo.pBindings = setLayoutBindings.data();
+		descriptorSetLayoutInfo.flags = flags;
+
+		// descriptor indexing flags (partially bound, update after bind...) are chained only when some binding has them
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+		bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		bindingFlagsInfo.bindingCount = static_cast<uint32_t>(setLayoutBindingFlags.size());
+		bindingFlagsInfo.pBindingFlags = setLayoutBindingFlags.data();
+		if (!bindingFlags.empty()) { descriptorSetLayoutInfo.pNext = &bindingFlagsInfo; }
 
 		if (vkCreateDescriptorSetLayout(
 			device.device(),
@@ -59,12 +113,215 @@ namespace EngineCore
 		{
 			throw std::runtime_error("failed to create descriptor set layout!");
 		}
+		createUpdateTemplate();
 	}
 
 	DescriptorSetLayout::~DescriptorSetLayout() {
+		if (updateTemplate != VK_NULL_HANDLE) { vkDestroyDescriptorUpdateTemplate(device.device(), updateTemplate, nullptr); }
 		vkDestroyDescriptorSetLayout(device.device(), descriptorSetLayout, nullptr);
 	}
 
+	void DescriptorSetLayout::createUpdateTemplate()
+	{
+		std::vector<VkDescriptorSetLayoutBinding> sorted{};
+		for (const auto& kv : bindings) { sorted.push_back(kv.second); }
+		std::sort(sorted.begin(), sorted.end(),
+			[](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) { return a.binding < b.binding; });
+
+		// one entry per binding, its descriptors are consecutive DescriptorInfos
+		std::vector<VkDescriptorUpdateTemplateEntry> entries{};
+		for (const auto& b : sorted)
+		{
+			if (b.descriptorCount == 0) { continue; }
+			VkDescriptorUpdateTemplateEntry entry{};
+			entry.dstBinding = b.binding;
+			entry.dstArrayElement = 0;
+			entry.descriptorCount = b.descriptorCount;
+			entry.descriptorType = b.descriptorType;
+			entry.offset = descriptorCount * sizeof(DescriptorInfo);
+			entry.stride = sizeof(DescriptorInfo);
+			entries.push_back(entry);
+			dataIndices[b.binding] = descriptorCount;
+			descriptorCount += b.descriptorCount;
+		}
+		if (entries.empty()) { return; }
+
+		VkDescriptorUpdateTemplateCreateInfo templateInfo{};
+		templateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		templateInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+		templateInfo.pDescriptorUpdateEntries = entries.data();
+		templateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+		templateInfo.descriptorSetLayout = descriptorSetLayout;
+		if (vkCreateDescriptorUpdateTemplate(device.device(), &templateInfo, nullptr, &updateTemplate) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create descriptor update template!");
+		}
+	}
+
+	uint32_t DescriptorSetLayout::getDataIndex(uint32_t binding) const
+	{
+		assert(dataIndices.count(binding) == 1 && "Layout does not contain specified binding");
+		return dataIndices.at(binding);
+	}
+
+	// *************** Pipeline Layout *********************
+
+	PipelineLayout::PipelineLayout(EngineDevice& device, const std::vector<std::shared_ptr<DescriptorSetLayout>>& setLayouts,
+		const VkPushConstantRange& pushConstantRange) : device{ device }, setLayouts{ setLayouts }
+	{
+		std::vector<VkDescriptorSetLayout> handles{};
+		for (const auto& setLayout : setLayouts) { handles.push_back(setLayout->getDescriptorSetLayout()); }
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(handles.size());
+		pipelineLayoutInfo.pSetLayouts = handles.empty() ? nullptr : handles.data();
+		pipelineLayoutInfo.pushConstantRangeCount = pushConstantRange.size ? 1 : 0;
+		pipelineLayoutInfo.pPushConstantRanges = pushConstantRange.size ? &pushConstantRange : nullptr;
+		if (vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create pipeline layout!");
+		}
+	}
+
+	PipelineLayout::~PipelineLayout()
+	{
+		vkDestroyPipelineLayout(device.device(), pipelineLayout, nullptr);
+	}
+
+	// *************** Descriptor Layout Cache *********************
+
+	bool DescriptorLayoutCache::SetLayoutKey::operator==(const SetLayoutKey& other) const
+	{
+		if (bindings.size() != other.bindings.size() || flags != other.flags || bindingFlags != other.bindingFlags) { return false; }
+		for (size_t i = 0; i < bindings.size(); i++)
+		{
+			const auto& a = bindings[i];
+			const auto& b = other.bindings[i];
+			if (a.binding != b.binding || a.descriptorType != b.descriptorType || a.descriptorCount != b.descriptorCount
+				|| a.stageFlags != b.stageFlags || a.pImmutableSamplers != b.pImmutableSamplers) { return false; }
+		}
+		return true;
+	}
+
+	bool DescriptorLayoutCache::PipelineLayoutKey::operator==(const PipelineLayoutKey& other) const
+	{
+		return setLayouts == other.setLayouts && pushConstantRange.stageFlags == other.pushConstantRange.stageFlags
+			&& pushConstantRange.offset == other.pushConstantRange.offset && pushConstantRange.size == other.pushConstantRange.size;
+	}
+
+	size_t DescriptorLayoutCache::KeyHash::operator()(const SetLayoutKey& key) const
+	{
+		size_t seed = key.bindings.size();
+		hashCombine(seed, key.flags);
+		for (const VkDescriptorBindingFlags f : key.bindingFlags) { hashCombine(seed, f); }
+		for (const auto& b : key.bindings)
+		{
+			hashCombine(seed, b.binding);
+			hashCombine(seed, b.descriptorType);
+			hashCombine(seed, b.descriptorCount);
+			hashCombine(seed, b.stageFlags);
+			hashCombine(seed, reinterpret_cast<uintptr_t>(b.pImmutableSamplers));
+		}
+		return seed;
+	}
+
+	size_t DescriptorLayoutCache::KeyHash::operator()(const PipelineLayoutKey& key) const
+	{
+		size_t seed = key.setLayouts.size();
+		for (const auto& setLayout : key.setLayouts) { hashCombine(seed, (uint64_t)setLayout); }
+		hashCombine(seed, key.pushConstantRange.stageFlags);
+		hashCombine(seed, key.pushConstantRange.offset);
+		hashCombine(seed, key.pushConstantRange.size);
+		return seed;
+	}
+
+	std::shared_ptr<DescriptorSetLayout> DescriptorLayoutCache::getSetLayout(std::vector<VkDescriptorSetLayoutBinding> bindings,
+		const std::unordered_map<uint32_t, VkDescriptorBindingFlags>& bindingFlags, VkDescriptorSetLayoutCreateFlags flags)
+	{
+		// the builder keeps its bindings in a hash map, sorting makes the key independent of that order
+		std::sort(bindings.begin(), bindings.end(),
+			[](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) { return a.binding < b.binding; });
+		SetLayoutKey key{ std::move(bindings), {}, flags };
+		for (const auto& b : key.bindings)
+		{
+			const auto found = bindingFlags.find(b.binding);
+			key.bindingFlags.push_back(found != bindingFlags.end() ? found->second : 0);
+		}
+
+		stats.setLayoutLookups++;
+		auto it = setLayouts.find(key);
+		if (it != setLayouts.end())
+		{
+			if (auto layout = it->second.lock())
+			{
+				stats.setLayoutHits++;
+				return layout;
+			}
+		}
+
+		prune();
+		std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindingMap{};
+		for (const auto& b : key.bindings)
+		{
+			assert(bindingMap.count(b.binding) == 0 && "Binding already in use");
+			bindingMap[b.binding] = b;
+		}
+		auto layout = std::make_shared<DescriptorSetLayout>(device, bindingMap, bindingFlags, key.flags);
+		setLayoutsByHandle[layout->getDescriptorSetLayout()] = layout;
+		setLayouts[std::move(key)] = layout;
+		return layout;
+	}
+
+	std::shared_ptr<PipelineLayout> DescriptorLayoutCache::getPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayoutHandles,
+		const VkPushConstantRange& pushConstantRange)
+	{
+		// set layouts are deduplicated, so equal handles mean structurally equal set layouts
+		PipelineLayoutKey key{ setLayoutHandles, pushConstantRange };
+		if (!key.pushConstantRange.size) { key.pushConstantRange = VkPushConstantRange{}; } // an unused range is not part of the layout
+
+		stats.pipelineLayoutLookups++;
+		auto it = pipelineLayouts.find(key);
+		if (it != pipelineLayouts.end())
+		{
+			if (auto layout = it->second.lock())
+			{
+				stats.pipelineLayoutHits++;
+				return layout;
+			}
+		}
+
+		prune();
+		std::vector<std::shared_ptr<DescriptorSetLayout>> sharedSetLayouts{};
+		for (VkDescriptorSetLayout handle : setLayoutHandles)
+		{
+			auto found = setLayoutsByHandle.find(handle);
+			auto setLayout = found != setLayoutsByHandle.end() ? found->second.lock() : nullptr;
+			if (!setLayout) { throw std::runtime_error("pipeline layout error, descriptor set layout was not created by the layout cache"); }
+			sharedSetLayouts.push_back(std::move(setLayout));
+		}
+		auto layout = std::make_shared<PipelineLayout>(device, sharedSetLayouts, key.pushConstantRange);
+		pipelineLayouts[std::move(key)] = layout;
+		return layout;
+	}
+
+	void DescriptorLayoutCache::prune()
+	{
+		// only called before creating a layout, lookups of live layouts never pay for it
+		for (auto it = setLayouts.begin(); it != setLayouts.end();) { it = it->second.expired() ? setLayouts.erase(it) : std::next(it); }
+		for (auto it = setLayoutsByHandle.begin(); it != setLayoutsByHandle.end();) { it = it->second.expired() ? setLayoutsByHandle.erase(it) : std::next(it); }
+		for (auto it = pipelineLayouts.begin(); it != pipelineLayouts.end();) { it = it->second.expired() ? pipelineLayouts.erase(it) : std::next(it); }
+	}
+
+	DescriptorLayoutCache::Stats DescriptorLayoutCache::getStats() const
+	{
+		Stats out = stats;
+		for (const auto& kv : setLayouts) { out.setLayouts += kv.second.expired() ? 0 : 1; }
+		for (const auto& kv : pipelineLayouts) { out.pipelineLayouts += kv.second.expired() ? 0 : 1; }
+		out.entries = static_cast<uint32_t>(setLayouts.size() + pipelineLayouts.size());
+		return out;
+	}
+
 	// *************** Descriptor Pool Builder *********************
 
 	DescriptorPool::Builder& DescriptorPool::Builder::addPoolSize(
@@ -96,7 +353,7 @@ namespace EngineCore
 	DescriptorPool::DescriptorPool(EngineDevice& device, uint32_t maxSets,
 		VkDescriptorPoolCreateFlags poolFlags,
 		const std::vector<VkDescriptorPoolSize>& poolSizes)
-		: device{ device }
+		: device{ device }, maxSets{ maxSets }
 	{
 		VkDescriptorPoolCreateInfo descriptorPoolInfo{};
 		descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -116,7 +373,7 @@ namespace EngineCore
 		vkDestroyDescriptorPool(device.device(), descriptorPool, nullptr);
 	}
 
-	bool DescriptorPool::allocateDescriptor(
+	VkResult DescriptorPool::allocateDescriptor(
 		const VkDescriptorSetLayout descriptorSetLayout, VkDescriptorSet& descriptor) const
 	{
 		VkDescriptorSetAllocateInfo allocInfo{};
@@ -125,13 +382,8 @@ namespace EngineCore
 		allocInfo.pSetLayouts = &descriptorSetLayout;
 		allocInfo.descriptorSetCount = 1;
 
-		// Might want to create a "DescriptorPoolManager" class that handles this case, and builds
-		// a new pool whenever an old pool fills up. But this is beyond our current scope
-		if (vkAllocateDescriptorSets(device.device(), &allocInfo, &descriptor) != VK_SUCCESS)
-		{
-			return false;
-		}
-		return true;
+		// a full pool is handled by DescriptorAllocator, which moves on to another pool
+		return vkAllocateDescriptorSets(device.device(), &allocInfo, &descriptor);
 	}
 
 	void DescriptorPool::freeDescriptors(std::vector<VkDescriptorSet>& descriptors) const
@@ -149,7 +401,10 @@ namespace EngineCore
 	// *************** Descriptor Writer *********************
 
 	DescriptorWriter::DescriptorWriter(DescriptorSetLayout& setLayout, DescriptorPool& pool)
-		: setLayout{ setLayout }, pool{ pool } {}
+		: setLayout{ setLayout }, pool{ &pool } {}
+
+	DescriptorWriter::DescriptorWriter(DescriptorSetLayout& setLayout)
+		: setLayout{ setLayout }, pool{ nullptr } {}
 
 	DescriptorWriter& DescriptorWriter::writeBuffer(uint32_t binding, VkDescriptorBufferInfo* bufferInfo) 
 	{
@@ -191,8 +446,8 @@ namespace EngineCore
 
 	bool DescriptorWriter::build(VkDescriptorSet& set)
 	{
-		bool success = pool.allocateDescriptor(setLayout.getDescriptorSetLayout(), set);
-		if (!success) { return false; }
+		assert(pool && "descriptor writer has no pool to allocate from");
+		if (pool->allocateDescriptor(setLayout.getDescriptorSetLayout(), set) != VK_SUCCESS) { return false; }
 		overwrite(set);
 		return true;
 	}
@@ -200,7 +455,123 @@ namespace EngineCore
 	void DescriptorWriter::overwrite(VkDescriptorSet& set)
 	{
 		for (auto& write : writes) { write.dstSet = set; }
-		vkUpdateDescriptorSets(pool.device.device(), writes.size(), writes.data(), 0, nullptr);
+		vkUpdateDescriptorSets(setLayout.device.device(), writes.size(), writes.data(), 0, nullptr);
+	}
+
+	// *************** Descriptor Allocator *********************
+
+	DescriptorAllocator::DescriptorAllocator(EngineDevice& device, uint32_t framesInFlight)
+		: device{ device }, transient(framesInFlight) {}
+
+	std::unique_ptr<DescriptorPool> DescriptorAllocator::createPool(uint32_t maxSets, bool freeable)
+	{
+		DescriptorPool::Builder builder(device);
+		for (const auto& [type, ratio] : POOL_RATIOS)
+		{
+			builder.addPoolSize(type, std::max(1u, static_cast<uint32_t>(ratio * maxSets)));
+		}
+		builder.setMaxSets(maxSets);
+		if (freeable) { builder.setPoolFlags(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT); }
+		stats.pools++;
+		return builder.build();
+	}
+
+	bool DescriptorAllocator::allocateFrom(Chain& chain, VkDescriptorSetLayout layout, VkDescriptorSet& setOut, size_t& poolIndexOut, bool freeable)
+	{
+		const auto take = [&](size_t poolIndex)
+		{
+			poolIndexOut = poolIndex;
+			chain.setCounts[poolIndex]++;
+			stats.sets++;
+			return true;
+		};
+
+		// a pool that is full moves current past it, later allocations skip it until a set in it is freed
+		const size_t first = chain.current;
+		for (; chain.current < chain.pools.size(); chain.current++)
+		{
+			const VkResult result = chain.pools[chain.current]->allocateDescriptor(layout, setOut);
+			if (result == VK_SUCCESS) { return take(chain.current); }
+			if (!isPoolFull(result)) { stats.failures++; return false; }
+			stats.poolsExhausted++;
+		}
+		// pools skipped earlier were full for some set, a smaller one may still fit, so they are tried before growing
+		for (size_t i = 0; i < first; i++)
+		{
+			const VkResult result = chain.pools[i]->allocateDescriptor(layout, setOut);
+			if (result == VK_SUCCESS)
+			{
+				chain.current = i;
+				return take(i);
+			}
+			if (!isPoolFull(result)) { stats.failures++; return false; }
+		}
+
+		// every pool is full, the new one is twice as large as the last
+		while (chain.pools.size() < MAX_CHAIN_POOLS)
+		{
+			const uint32_t maxSets = chain.pools.empty() ? FIRST_POOL_SETS : std::min(MAX_POOL_SETS, 2 * chain.pools.back()->getMaxSets());
+			chain.pools.push_back(createPool(maxSets, freeable));
+			chain.setCounts.push_back(0);
+			const VkResult result = chain.pools.back()->allocateDescriptor(layout, setOut);
+			if (result == VK_SUCCESS) { return take(chain.pools.size() - 1); }
+			if (!isPoolFull(result) || maxSets == MAX_POOL_SETS)
+			{
+				// the set needs more than the largest pool holds, the empty pool is dropped so failed calls do not add pools
+				chain.pools.pop_back();
+				chain.setCounts.pop_back();
+				stats.pools--;
+				break;
+			}
+			// a larger pool may hold the set, the empty one stays (current points at it) for smaller sets
+		}
+		stats.failures++;
+		return false;
+	}
+
+	bool DescriptorAllocator::allocate(VkDescriptorSetLayout layout, VkDescriptorSet& setOut, DescriptorPool*& poolOut)
+	{
+		size_t poolIndex;
+		if (!allocateFrom(persistent, layout, setOut, poolIndex, true)) { return false; }
+		poolOut = persistent.pools[poolIndex].get();
+		return true;
+	}
+
+	void DescriptorAllocator::free(VkDescriptorSet set, DescriptorPool* pool)
+	{
+		for (size_t i = 0; i < persistent.pools.size(); i++)
+		{
+			if (persistent.pools[i].get() != pool) { continue; }
+			std::vector<VkDescriptorSet> sets{ set };
+			pool->freeDescriptors(sets);
+			persistent.setCounts[i]--;
+			stats.sets--;
+			// the pool has room again, allocations start looking from it
+			persistent.current = std::min(persistent.current, i);
+			return;
+		}
+		assert(false && "descriptor set was not allocated from this allocator");
+	}
+
+	bool DescriptorAllocator::allocateTransient(VkDescriptorSetLayout layout, uint32_t frameIndex, VkDescriptorSet& setOut)
+	{
+		assert(frameIndex < transient.size() && "frame index exceeds descriptor allocator frames");
+		size_t poolIndex;
+		return allocateFrom(transient[frameIndex], layout, setOut, poolIndex, false);
+	}
+
+	void DescriptorAllocator::resetFrame(uint32_t frameIndex)
+	{
+		assert(frameIndex < transient.size() && "frame index exceeds descriptor allocator frames");
+		Chain& chain = transient[frameIndex];
+		for (size_t i = 0; i < chain.pools.size(); i++)
+		{
+			if (chain.setCounts[i] == 0) { continue; } // pools past the ones used last frame are still empty
+			chain.pools[i]->resetPool();
+			stats.sets -= chain.setCounts[i];
+			chain.setCounts[i] = 0;
+		}
+		chain.current = 0;
 	}
 
 	/*
@@ -240,13 +611,14 @@ namespace EngineCore
 
 	//		NEW DYNAMIC UBO IMPLEMENTATION (START)
 
-	void UBO_Struct::add(uelem t, const size_t& arrayLength) { add(std::vector<uelem>{t}, arrayLength); }
+	void UBO_Struct::add(uelem t, const size_t& arrayLength) { fields.push_back(UBO_StructLeaf(std::vector<uelem>{t}, arrayLength, false)); }
 
 	void UBO_Struct::add(const std::vector<uelem>& t, const size_t& arrayLength)
-	{ fields.push_back(UBO_StructLeaf(std::vector<uelem>{t}, arrayLength)); }
+	{ fields.push_back(UBO_StructLeaf(t, arrayLength, true)); }
 	
-	UBO_Struct::UBO_StructLeaf::UBO_StructLeaf(const std::vector<uelem>& t, const size_t& arrl)
-											: elems{ t }, arrlen{ arrl } {};
+	UBO_Struct::UBO_StructLeaf::UBO_StructLeaf(const std::vector<uelem>& t, const size_t& arrayLength, bool isStruct)
+											: elems{ t }, arrlen{ std::max(arrayLength, size_t{ 1 }) }, isStruct{ isStruct }, 
+											isArray{ arrayLength > 0 } {};
 
 	// generates the correct memory offsets for the ubo data fields
 	UBO_Layout::UBO_Layout(const UBO_Struct& typeLayout) 
@@ -258,8 +630,8 @@ namespace EngineCore
 			field.arrlen = f.arrlen;
 
 			align(f, bufferSize, field.offsets, field.sizes, field.stride); // find alignments for field
+			bufferSize = field.offsets[0] + field.stride * field.arrlen; // offsets[0] is the aligned start of the field
 			fields.push_back(field);
-			bufferSize += field.stride * field.arrlen;
 		}
 	}
 
@@ -268,6 +640,7 @@ namespace EngineCore
 	{
 		sizesOut.clear();
 		std::vector<size_t> alignments{};
+		size_t baseAlignment = 1;
 
 		for (auto& e : f.elems)
 		{
@@ -276,20 +649,24 @@ namespace EngineCore
 			sizesOut.push_back(size);
 			alignments.push_back(alignment);
 			// Vulkan spec: "a structure has a base alignment equal to the largest base alignment of any of its members"
-			alignments[0] = std::max(alignment, alignments[0]);
+			baseAlignment = std::max(baseAlignment, alignment);
 		}
+		// std140: structures and array elements are aligned to, and padded up to, a multiple of a vec4
+		const bool padded = f.isStruct || f.isArray;
+		if (padded) { baseAlignment = Math::roundUpToClosestMultiple(baseAlignment, size_t{ 16 }); }
 
 		offsetsOut.clear();
-		strideOut = 0;
-		auto seek = startOffset;
+		const size_t base = Math::roundUpToClosestMultiple(startOffset, baseAlignment);
+		auto seek = base;
 
 		for (size_t i = 0; i < alignments.size(); i++)
 		{ 
 			const size_t offset = Math::roundUpToClosestMultiple(seek, alignments[i]); // calculate offset
 			offsetsOut.push_back(offset);
-			seek += (offset - seek) + sizesOut[i];
+			seek = offset + sizesOut[i];
 		}
-		strideOut = seek - startOffset;
+		// instance size, a single element is not padded so a following scalar can use the rest of a vec3
+		strideOut = padded ? Math::roundUpToClosestMultiple(seek - base, baseAlignment) : seek - base;
 	}
 
 	void UBO_Layout::getAlignmentForElementType(uelem e, size_t& sizeOut, size_t& alignmentOut) const
@@ -320,32 +697,29 @@ namespace EngineCore
 
 	// *************** Uniform Buffer wrapper *********************
 
-	UBO::UBO(const UBO_Layout& sLayout, uint32_t numBuffers, EngineDevice& device) : structLayout{ sLayout }
+	UBO::UBO(const UBO_Layout& sLayout, UniformRing& ring) 
+		: structLayout{ sLayout }, ring{ ring }, data(sLayout.getBufferSize(), 0) {}
+
+	uint32_t UBO::getOffset()
 	{
-		createBuffers(device, numBuffers);
+		// the region of an older frame is reused once its fence is signaled, so the contents are pushed again every frame
+		if (dirty || uploadedFrame != ring.getFrameNumber())
+		{
+			offset = ring.push(data.data(), data.size());
+			uploadedFrame = ring.getFrameNumber();
+			dirty = false;
+		}
+		return offset;
 	}
 
-	void UBO::writeMember(const UBO_Layout::ElementAccessor& loc, void* data, const size_t& dataSize,
-						uint32_t bufferIndex, bool flush)
+	void UBO::writeMember(const UBO_Layout::ElementAccessor& loc, void* src, const size_t& dataSize)
 	{
 		size_t dstSize, dstOffset;
 		structLayout.accessElement(loc, dstSize, dstOffset);
 
 		if (dataSize != dstSize) { throw std::runtime_error("cannot write to uniform buffer, incompatible data size"); }
-		getBuffer(bufferIndex)->writeToBuffer(data, dataSize, dstOffset);
-		if (flush) { getBuffer(bufferIndex)->flush(); }
-	}
-
-	void UBO::createBuffers(EngineDevice& device, uint32_t numBuffers)
-	{
-		auto minOffsetAlignment = device.properties.limits.minUniformBufferOffsetAlignment;
-		for (uint32_t i = 0; i < numBuffers; i++) 
-		{
-			buffers.push_back(std::make_unique<GBuffer>(device, structLayout.getBufferSize(), 1,
-						VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-						minOffsetAlignment));
-			buffers.back()->map();
-		}
+		memcpy(data.data() + dstOffset, src, dataSize);
+		dirty = true; // sets bound earlier in the frame keep their offset, the next bind uploads a new copy
 	}
 
 	// *************** Descriptor set wrapper *********************
@@ -367,15 +741,20 @@ namespace EngineCore
 		}
 	}
 
-	DescriptorSet::DescriptorSet(EngineDevice& device)
-		: device{ device }, framesInFlight{ EngineSwapChain::MAX_FRAMES_IN_FLIGHT } {};
+	DescriptorSet::DescriptorSet(EngineDevice& device, DescriptorAllocator& allocator)
+		: allocator{ allocator }, device{ device }, framesInFlight{ EngineSwapChain::MAX_FRAMES_IN_FLIGHT } {};
 
-	DescriptorSet::DescriptorSet(EngineDevice& device, uint32_t numBuffers)
-		: device{ device }, framesInFlight{ numBuffers } {};
+	DescriptorSet::DescriptorSet(EngineDevice& device, DescriptorAllocator& allocator, uint32_t numBuffers)
+		: allocator{ allocator }, device{ device }, framesInFlight{ numBuffers } {};
 
-	void DescriptorSet::addUBO(const UBO_Struct& structureLayout, EngineDevice& device)
+	DescriptorSet::~DescriptorSet()
 	{
-		ubos.push_back(std::make_unique<UBO>(UBO_Layout(structureLayout), framesInFlight, device));
+		for (size_t f = 0; f < setPools.size(); f++) { allocator.free(sets[f], setPools[f]); }
+	}
+
+	void DescriptorSet::addUBO(const UBO_Struct& structureLayout, UniformRing& ring)
+	{
+		ubos.push_back(std::make_unique<UBO>(UBO_Layout(structureLayout), ring));
 	}
 
 	void DescriptorSet::addCombinedImageSampler(const VkImageView& view, const VkSampler& sampler)
@@ -384,14 +763,13 @@ namespace EngineCore
 		info.imageView = view;
 		info.sampler = sampler;
 		info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL; // correct layout assumed
-		samplerImageInfos.push_back(std::make_unique<VkDescriptorImageInfo>(info));
+		samplerImageInfos.push_back(info);
 	}
 
 	void DescriptorSet::addImageArray(const ImageArrayDescriptor& imageArray)
 	{
 		assert(!imageArray.arrays.empty() && "tried to add empty image array descriptor");
 		imageArraysInfos.push_back(imageArray);
-		numImagesTotal += imageArray.getArrayLength() * imageArray.arrays.size();
 	}
 
 	void DescriptorSet::addSampler(const VkSampler& sampler)
@@ -400,7 +778,7 @@ namespace EngineCore
 		info.sampler = sampler;
 		info.imageView = VK_NULL_HANDLE; // just the sampler, no image assigned
 		info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		samplerInfos.push_back(std::make_unique<VkDescriptorImageInfo>(info));
+		samplerInfos.push_back(info);
 	}
 
 	void DescriptorSet::finalize()
@@ -413,18 +791,10 @@ namespace EngineCore
 		uint32_t numImageArrays = imageArraysInfos.size();
 		uint32_t numSamplers = samplerInfos.size();
 		
-		DescriptorPool::Builder poolBuilder(device);
-		if (numUBOs > 0) { poolBuilder.addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight * numUBOs); }
-		if (numSamplerImages > 0) { poolBuilder.addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, numSamplerImages); }
-		if (numImageArrays > 0) { poolBuilder.addPoolSize(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numImagesTotal); }
-		if (numSamplers > 0) { poolBuilder.addPoolSize(VK_DESCRIPTOR_TYPE_SAMPLER, numSamplers); }
-		
-		pool = poolBuilder.build();
-		
 		DescriptorSetLayout::Builder layoutBuilder(device);
 		// add uniform buffer bindings to layout
 		for (uint32_t i = 0; i < numUBOs; i++) /* UBOs start at binding index 0 */
-		{ layoutBuilder.addBinding(i, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS); }
+		{ layoutBuilder.addBinding(i, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_ALL_GRAPHICS); }
 
 		// add combined image sampler bindings to layout
 		for (uint32_t i = 0; i < numSamplerImages; i++) /* place combined sampler bindings after UBOs */
@@ -444,45 +814,93 @@ namespace EngineCore
 			VK_DESCRIPTOR_TYPE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS);
 		}
 		
-		layout = layoutBuilder.build();
+		layout = layoutBuilder.build(device.getLayoutCache()); // shared with every set that has the same bindings
+
+		dynamicOffsets.resize(numUBOs);
 
-		// create descriptors for each frame (UBOs have multiple internal buffers)
+		// pack the descriptors of each frame into its update data, the same for every frame except image arrays
+		const uint32_t perFrame = layout->getDescriptorCount();
+		descriptorData.assign(static_cast<size_t>(framesInFlight) * perFrame, DescriptorInfo{});
 		for (uint32_t f = 0; f < framesInFlight; f++)
 		{
-			DescriptorWriter writer(*layout.get(), *pool);
-			// add uniform buffers
+			DescriptorInfo* data = frameData(f);
+			// every frame binds the same ring buffer, the frame's data is selected by the dynamic offsets
 			for (uint32_t u = 0; u < numUBOs; u++)
-			{
-				// this is required because vulkan keeps a handle to the buffer info,
-				// reallocation of info objects causes bindings to fail, either silently or violently
-				const auto dBufferInfo = getUBO(u).getBuffer(f)->descriptorInfo();
-				bufferInfos.push_back(std::make_unique<VkDescriptorBufferInfo>(dBufferInfo));
-				writer.writeBuffer(u, bufferInfos.back().get()); // sending pointer
-			}
+			{ data[layout->getDataIndex(u)].buffer = getUBO(u).ring.descriptorInfo(getUBO(u).getSize()); }
 
-			// add combined image samplers
 			for (uint32_t i = 0; i < numSamplerImages; i++)
-			{
-				writer.writeImage(i + numUBOs, samplerImageInfos[i].get());
-			}
+			{ data[layout->getDataIndex(i + numUBOs)].image = samplerImageInfos[i]; }
 
-			// add image arrays
 			for (uint32_t a = 0; a < numImageArrays; a++)
 			{
-				auto& infoArray = imageArraysInfos[a].arrays[f];
-				writer.writeImage(a + numUBOs + numSamplerImages, infoArray.data(), infoArray.size());
+				const auto& infoArray = imageArraysInfos[a].arrays[f];
+				DescriptorInfo* dst = data + layout->getDataIndex(a + numUBOs + numSamplerImages);
+				for (size_t e = 0; e < infoArray.size(); e++) { dst[e].image = infoArray[e]; }
 			}
 
-			// add samplers
 			for (uint32_t i = 0; i < numSamplers; i++)
+			{ data[layout->getDataIndex(i + numUBOs + numSamplerImages + numImageArrays)].image = samplerInfos[i]; }
+		}
+
+		// create descriptors for each frame
+		pendingUpdates.assign(framesInFlight, 0);
+		for (uint32_t f = 0; f < framesInFlight; f++)
+		{
+			// make descriptor set for frame, from the pools shared with all other sets
+			DescriptorPool* setPool;
+			if (!allocator.allocate(layout->getDescriptorSetLayout(), sets[f], setPool))
 			{
-				writer.writeImage(i + numUBOs + numSamplerImages + numImageArrays, samplerInfos[i].get());
+				throw std::runtime_error("failed to allocate descriptor set, its layout does not fit into a descriptor pool");
 			}
+			setPools.push_back(setPool);
+			update(f);
+		}
+	}
+
+	void DescriptorSet::update(uint32_t frameIndex)
+	{
+		// the template reads the whole set from the frame's update data, no per-descriptor write structures
+		if (layout->getUpdateTemplate() != VK_NULL_HANDLE)
+		{ vkUpdateDescriptorSetWithTemplate(device.device(), sets[frameIndex], layout->getUpdateTemplate(), frameData(frameIndex)); }
+		pendingUpdates[frameIndex] = 0;
+	}
+
+	void DescriptorSet::setCombinedImageSampler(uint32_t index, VkImageView view, VkSampler sampler)
+	{
+		assert(index < samplerImageInfos.size() && "combined image sampler index out of range");
+		assert(!sets.empty() && "descriptor set must be finalized before rebinding");
+		samplerImageInfos[index].imageView = view;
+		samplerImageInfos[index].sampler = sampler;
+		const uint32_t dataIndex = layout->getDataIndex(static_cast<uint32_t>(ubos.size()) + index);
+		for (uint32_t f = 0; f < framesInFlight; f++)
+		{
+			frameData(f)[dataIndex].image = samplerImageInfos[index];
+			pendingUpdates[f] = 1;
+		}
+	}
 
-			writer.build(sets[f]); // make descriptor set for frame
+	void DescriptorSet::setArrayImage(uint32_t arrayIndex, uint32_t element, const std::vector<VkImageView>& views)
+	{
+		assert(arrayIndex < imageArraysInfos.size() && "image array index out of range");
+		assert(!sets.empty() && "descriptor set must be finalized before rebinding");
+		auto& imageArray = imageArraysInfos[arrayIndex];
+		assert(element < imageArray.getArrayLength() && "image array element out of range");
+		assert(views.size() == framesInFlight && "rebinding an image array element needs one view per frame");
+		const uint32_t dataIndex = layout->getDataIndex(static_cast<uint32_t>(ubos.size() + samplerImageInfos.size()) + arrayIndex) + element;
+		for (uint32_t f = 0; f < framesInFlight; f++)
+		{
+			imageArray.arrays[f][element].imageView = views[f];
+			frameData(f)[dataIndex].image = imageArray.arrays[f][element];
+			pendingUpdates[f] = 1;
 		}
 	}
 
+	VkDescriptorSet DescriptorSet::getDescriptorSet(uint32_t frameIndex)
+	{
+		if (pendingUpdates[frameIndex]) { update(frameIndex); }
+		return sets[frameIndex];
+	}
+
 	VkDescriptorSetLayout DescriptorSet::getLayout() const
 	{
 		assert(layout.get() && "tried to get layout from uninitialized descriptor set");
@@ -496,6 +914,13 @@ namespace EngineCore
 		return *ubos[uboIndex].get();
 	}
 
+	const std::vector<uint32_t>& DescriptorSet::getDynamicOffsets()
+	{
+		// dynamic offsets are consumed in binding order, UBOs occupy the first bindings
+		for (size_t u = 0; u < ubos.size(); u++) { dynamicOffsets[u] = ubos[u]->getOffset(); }
+		return dynamicOffsets;
+	}
+
 	
 
 }
\ No newline at end of file
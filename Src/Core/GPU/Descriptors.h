@@ -1,17 +1,29 @@
 #pragma once
 
 #include "Core/GPU/Buffer.h"
+#include "Core/GPU/Std140.h"
+#include "Core/GPU/UniformRing.h"
 
 #include <glm/glm.hpp>
 
 #include <vector>
 #include <memory>
+#include <cassert>
+#include <type_traits>
 #include <unordered_map>
 #include <iostream>// debug only
 
 namespace EngineCore
 {
 	class EngineDevice;
+	class DescriptorLayoutCache;
+
+	// one descriptor in the update data of a set, written through the layout's update template
+	union DescriptorInfo
+	{
+		VkDescriptorBufferInfo buffer;
+		VkDescriptorImageInfo image;
+	};
 
 	class DescriptorSetLayout
 	{
@@ -22,29 +34,132 @@ namespace EngineCore
 			Builder(EngineDevice& device) : device{ device } {}
 
 			Builder& addBinding(uint32_t binding, VkDescriptorType descriptorType,
-				VkShaderStageFlags stageFlags, uint32_t count = 1);
+				VkShaderStageFlags stageFlags, uint32_t count = 1, VkDescriptorBindingFlags bindingFlags = 0);
+			// e.g. VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT for descriptor indexing
+			Builder& setLayoutFlags(VkDescriptorSetLayoutCreateFlags flags);
 			std::unique_ptr<DescriptorSetLayout> build() const;
+			// shared layout from the cache, identical bindings give the same layout
+			std::shared_ptr<DescriptorSetLayout> build(DescriptorLayoutCache& cache) const;
 		private:
 			EngineDevice& device;
 			std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings{};
+			std::unordered_map<uint32_t, VkDescriptorBindingFlags> bindingFlags{};
+			VkDescriptorSetLayoutCreateFlags layoutFlags = 0;
 		};
 
+		// bindings without an entry in bindingFlags have no flags
 		DescriptorSetLayout(EngineDevice& device,
-			std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings);
+			std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings,
+			const std::unordered_map<uint32_t, VkDescriptorBindingFlags>& bindingFlags = {}, VkDescriptorSetLayoutCreateFlags flags = 0);
 		~DescriptorSetLayout();
 		DescriptorSetLayout(const DescriptorSetLayout&) = delete;
 		DescriptorSetLayout& operator=(const DescriptorSetLayout&) = delete;
 
 		VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout; }
 
+		/*	the update data of a set with this layout is an array of getDescriptorCount() DescriptorInfos, the bindings
+		*	in binding order with array elements next to each other, a whole set is written with one template call */
+		VkDescriptorUpdateTemplate getUpdateTemplate() const { return updateTemplate; }
+		uint32_t getDescriptorCount() const { return descriptorCount; }
+		// index of the first DescriptorInfo of a binding in the update data
+		uint32_t getDataIndex(uint32_t binding) const;
+
 	private:
 		EngineDevice& device;
 		VkDescriptorSetLayout descriptorSetLayout;
+		VkDescriptorUpdateTemplate updateTemplate = VK_NULL_HANDLE; // none for a layout without bindings
+		uint32_t descriptorCount = 0;
 		std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings;
+		std::unordered_map<uint32_t, uint32_t> dataIndices; // per binding
+
+		void createUpdateTemplate();
 
 		friend class DescriptorWriter;
 	};
 
+	// pipeline layout that may be shared by several materials, destroyed with its last owner
+	class PipelineLayout
+	{
+	public:
+		PipelineLayout(EngineDevice& device, const std::vector<std::shared_ptr<DescriptorSetLayout>>& setLayouts,
+			const VkPushConstantRange& pushConstantRange);
+		~PipelineLayout();
+		PipelineLayout(const PipelineLayout&) = delete;
+		PipelineLayout& operator=(const PipelineLayout&) = delete;
+
+		VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
+
+	private:
+		EngineDevice& device;
+		VkPipelineLayout pipelineLayout;
+		// kept alive with the pipeline layout, so their handles cannot be reused by other layouts while it is cached
+		std::vector<std::shared_ptr<DescriptorSetLayout>> setLayouts;
+	};
+
+	/*	hands out shared set layouts and pipeline layouts, structurally identical requests get the same object,
+	*	so sets and materials built from the same bindings share one layout (and compatible pipeline layouts)
+	*
+	*	set layouts are keyed by their bindings sorted by binding index, pipeline layouts by their set layout handles
+	*	and push constant range, the cache only holds weak references, a layout is destroyed with its last owner */
+	class DescriptorLayoutCache
+	{
+	public:
+		struct Stats
+		{
+			uint32_t setLayoutLookups = 0;
+			uint32_t setLayoutHits = 0;
+			uint32_t setLayouts = 0; // alive
+			uint32_t pipelineLayoutLookups = 0;
+			uint32_t pipelineLayoutHits = 0;
+			uint32_t pipelineLayouts = 0; // alive
+			uint32_t entries = 0; // set and pipeline layout entries held, including destroyed layouts not pruned yet
+			float setLayoutHitRate() const { return setLayoutLookups ? float(setLayoutHits) / setLayoutLookups : 0.f; }
+			float pipelineLayoutHitRate() const { return pipelineLayoutLookups ? float(pipelineLayoutHits) / pipelineLayoutLookups : 0.f; }
+		};
+
+		DescriptorLayoutCache(EngineDevice& device) : device{ device } {}
+		DescriptorLayoutCache(const DescriptorLayoutCache&) = delete;
+		DescriptorLayoutCache& operator=(const DescriptorLayoutCache&) = delete;
+
+		// binding order does not matter, bindings must have distinct binding indices, bindingFlags are per binding index
+		std::shared_ptr<DescriptorSetLayout> getSetLayout(std::vector<VkDescriptorSetLayoutBinding> bindings,
+			const std::unordered_map<uint32_t, VkDescriptorBindingFlags>& bindingFlags = {}, VkDescriptorSetLayoutCreateFlags flags = 0);
+		// set layouts must have been created by this cache (e.g. DescriptorSet::getLayout), pushConstantRange.size may be 0
+		std::shared_ptr<PipelineLayout> getPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+			const VkPushConstantRange& pushConstantRange);
+
+		Stats getStats() const;
+
+	private:
+		struct SetLayoutKey
+		{
+			std::vector<VkDescriptorSetLayoutBinding> bindings; // sorted by binding index
+			std::vector<VkDescriptorBindingFlags> bindingFlags; // same order
+			VkDescriptorSetLayoutCreateFlags flags;
+			bool operator==(const SetLayoutKey& other) const;
+		};
+		struct PipelineLayoutKey
+		{
+			std::vector<VkDescriptorSetLayout> setLayouts;
+			VkPushConstantRange pushConstantRange;
+			bool operator==(const PipelineLayoutKey& other) const;
+		};
+		struct KeyHash
+		{
+			size_t operator()(const SetLayoutKey& key) const;
+			size_t operator()(const PipelineLayoutKey& key) const;
+		};
+
+		EngineDevice& device;
+		std::unordered_map<SetLayoutKey, std::weak_ptr<DescriptorSetLayout>, KeyHash> setLayouts;
+		std::unordered_map<VkDescriptorSetLayout, std::weak_ptr<DescriptorSetLayout>> setLayoutsByHandle;
+		std::unordered_map<PipelineLayoutKey, std::weak_ptr<PipelineLayout>, KeyHash> pipelineLayouts;
+		Stats stats{};
+
+		// drops the entries of destroyed layouts
+		void prune();
+	};
+
 	class DescriptorPool
 	{
 	public:
@@ -71,14 +186,18 @@ namespace EngineCore
 		DescriptorPool(const DescriptorPool&) = delete;
 		DescriptorPool& operator=(const DescriptorPool&) = delete;
 
-		bool allocateDescriptor(const VkDescriptorSetLayout descriptorSetLayout, VkDescriptorSet& descriptor) const;
+		// VK_ERROR_OUT_OF_POOL_MEMORY or VK_ERROR_FRAGMENTED_POOL when the pool is full
+		VkResult allocateDescriptor(const VkDescriptorSetLayout descriptorSetLayout, VkDescriptorSet& descriptor) const;
 		void freeDescriptors(std::vector<VkDescriptorSet>& descriptors) const;
 
 		void resetPool();
 
+		uint32_t getMaxSets() const { return maxSets; }
+
 	private:
 		EngineDevice& device;
 		VkDescriptorPool descriptorPool;
+		uint32_t maxSets;
 
 		friend class DescriptorWriter;
 	};
@@ -87,6 +206,8 @@ namespace EngineCore
 	{
 	public:
 		DescriptorWriter(DescriptorSetLayout& setLayout, DescriptorPool& pool);
+		// writer for sets allocated elsewhere (e.g. by a DescriptorAllocator), only overwrite() can be used
+		DescriptorWriter(DescriptorSetLayout& setLayout);
 
 		DescriptorWriter& writeBuffer(uint32_t binding, VkDescriptorBufferInfo* bufferInfo);
 		DescriptorWriter& writeImage(uint32_t binding, VkDescriptorImageInfo* imageInfo, uint32_t arrSize = 1);
@@ -96,10 +217,58 @@ namespace EngineCore
 
 	private:
 		DescriptorSetLayout& setLayout;
-		DescriptorPool& pool;
+		DescriptorPool* pool;
 		std::vector<VkWriteDescriptorSet> writes;
 	};
 
+	/*	hands out descriptor sets from chains of shared pools instead of a pool per set, a chain moves on to its next pool
+	*	when the current one is full, retries the pools it skipped and only then creates a new one (twice as large, up to
+	*	a limit) at the end of the chain, a chain holds at most a fixed number of pools
+	*
+	*	persistent sets live until they are freed, transient sets are allocated from the chain of a frame in flight and
+	*	are all released at once by resetFrame, which resets that chain's pools (no per-set bookkeeping) */
+	class DescriptorAllocator
+	{
+	public:
+		struct Stats
+		{
+			uint32_t pools = 0; // live, persistent and transient
+			uint32_t sets = 0; // currently allocated
+			uint32_t poolsExhausted = 0; // allocations that found a pool full and moved on
+			uint32_t failures = 0; // allocations that failed (set needs more than the largest pool, chain at its limit, out of memory)
+		};
+
+		DescriptorAllocator(EngineDevice& device, uint32_t framesInFlight);
+		DescriptorAllocator(const DescriptorAllocator&) = delete;
+		DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+		// set that lives until free() is called with it and the returned pool
+		bool allocate(VkDescriptorSetLayout layout, VkDescriptorSet& setOut, DescriptorPool*& poolOut);
+		void free(VkDescriptorSet set, DescriptorPool* pool);
+		// set that is valid until the next resetFrame(frameIndex)
+		bool allocateTransient(VkDescriptorSetLayout layout, uint32_t frameIndex, VkDescriptorSet& setOut);
+		// releases all transient sets of the frame, the device must be done with them
+		void resetFrame(uint32_t frameIndex);
+
+		const Stats& getStats() const { return stats; }
+
+	private:
+		struct Chain
+		{
+			std::vector<std::unique_ptr<DescriptorPool>> pools;
+			std::vector<uint32_t> setCounts; // live sets per pool (transient chains count all sets since the reset)
+			size_t current = 0; // first pool not found full since the last free or reset
+		};
+
+		EngineDevice& device;
+		Chain persistent;
+		std::vector<Chain> transient; // per frame in flight
+		Stats stats{};
+
+		bool allocateFrom(Chain& chain, VkDescriptorSetLayout layout, VkDescriptorSet& setOut, size_t& poolIndexOut, bool freeable);
+		std::unique_ptr<DescriptorPool> createPool(uint32_t maxSets, bool freeable);
+	};
+
 	/*
 	struct SceneGlobalDataBuffer
 	{
@@ -129,10 +298,20 @@ namespace EngineCore
 	class UBO_Struct
 	{
 	public:
-		// adds a single data type to this structure (or an array containing that type)
-		void add(uelem t, const size_t& arrayLength = 1);
+		/*	adds a single data type to this structure (or an array containing that type), arrayLength 0 adds a plain member,
+		*	any other length an array, which std140 pads to a vec4 stride even with a single element */
+		void add(uelem t, const size_t& arrayLength = 0);
 		// adds a nested structure to this structure (or an array containing that structure)
-		void add(const std::vector<uelem>& t, const size_t& arrayLength = 1);
+		void add(const std::vector<uelem>& t, const size_t& arrayLength = 0);
+
+		// the runtime description of a compile-time Std140::Layout (same offsets)
+		template<typename... Ts>
+		static UBO_Struct fromLayout(const Std140::Layout<Ts...>&)
+		{
+			UBO_Struct s{};
+			(s.addMember(Ts{}, 0), ...);
+			return s;
+		}
 
 	private:
 		friend class UBO_Layout;
@@ -140,12 +319,30 @@ namespace EngineCore
 		struct UBO_StructLeaf
 		{
 			std::vector<uelem> elems{};
-			size_t arrlen;
+			size_t arrlen; // 1 for a plain member
+			bool isStruct; // std140 pads structures even if they only have one element
+			bool isArray; // and array elements even if the array only has one
 			// note that the array length is not the same as the number of elements
-			UBO_StructLeaf(const std::vector<uelem>& t, const size_t& arrl);
+			UBO_StructLeaf(const std::vector<uelem>& t, const size_t& arrayLength, bool isStruct);
 		};
 
 		std::vector<UBO_StructLeaf> fields; // elements and nested structures added to this structure
+
+		template<typename T>
+		static constexpr uelem elementOf()
+		{
+			if constexpr (std::is_same_v<T, glm::vec2>) { return uelem::vec2; }
+			else if constexpr (std::is_same_v<T, glm::vec3>) { return uelem::vec3; }
+			else if constexpr (std::is_same_v<T, glm::vec4>) { return uelem::vec4; }
+			else if constexpr (std::is_same_v<T, glm::mat4>) { return uelem::mat4; }
+			else { static_assert(Std140::Basic<T>::size == 4, "no uniform element type for this member"); return uelem::scalar; }
+		}
+		template<typename T>
+		void addMember(T, size_t arrayLength) { add(elementOf<T>(), arrayLength); }
+		template<typename... Ts>
+		void addMember(Std140::Struct<Ts...>, size_t arrayLength) { fields.push_back(UBO_StructLeaf({ elementOf<Ts>()... }, arrayLength, true)); }
+		template<typename T, size_t N>
+		void addMember(Std140::Array<T, N>, size_t) { addMember(T{}, N); }
 	};
 
 	// the actual memory layout information for a uniform buffer structure
@@ -167,6 +364,8 @@ namespace EngineCore
 				std::vector<size_t>& offsetsOut, std::vector<size_t>& sizesOut, size_t& strideOut) const;
 		void getAlignmentForElementType(uelem e, size_t& sizeOut, size_t& alignmentOut) const;
 	public:
+		/*	runtime counterpart of Std140::Layout for data-driven blocks, every write looks its offset up and is bounds checked,
+		*	blocks known at compile time are better written through a Std140::View */
 		UBO_Layout(const UBO_Struct& typeLayout);
 		const size_t& getBufferSize() const { return bufferSize; }
 		// field index, array index, element index
@@ -175,21 +374,34 @@ namespace EngineCore
 	};
 
 
-	/* uniform buffer abstraction - this represents a specialized GPU buffer for in-shader (descriptor set) use */
+	/*	uniform buffer abstraction - members are written to a host copy, which is uploaded to the uniform ring when the
+	*	owning set is bound (once per frame, or again after a write), the set binds it as a dynamic uniform buffer */
 	class UBO
 	{
 	public:
-		UBO(const UBO_Layout& sLayout, uint32_t numBuffers, EngineDevice& device);
-		GBuffer* getBuffer(uint32_t index) { return buffers[index].get(); }
+		UBO(const UBO_Layout& sLayout, UniformRing& ring);
+		// dynamic offset of the current contents, uploads them first if they are not in this frame's ring region yet
+		uint32_t getOffset();
+		VkDeviceSize getSize() const { return structLayout.getBufferSize(); }
+		// typed access to the host copy for a UBO added with a compile-time layout, marks it for upload
+		template<typename L>
+		Std140::View<L> edit()
+		{
+			assert(L::size == data.size() && "uniform buffer was not created with this layout");
+			dirty = true;
+			return Std140::View<L>(data.data());
+		}
 	private:
 		friend class DescriptorSet;
 		
 		UBO_Layout structLayout;
-		std::vector<std::unique_ptr<GBuffer>> buffers;
+		UniformRing& ring;
+		std::vector<uint8_t> data; // host copy, the whole struct is uploaded at once
+		uint32_t offset = 0;
+		uint64_t uploadedFrame = 0; // ring frame number of the upload at offset (0 = never uploaded)
+		bool dirty = true;
 
-		void createBuffers(EngineDevice& device, uint32_t numBuffers);
-		void writeMember(const UBO_Layout::ElementAccessor& loc, void* data, const size_t& dataSize,
-						uint32_t bufferIndex, bool flush);
+		void writeMember(const UBO_Layout::ElementAccessor& loc, void* data, const size_t& dataSize);
 	};
 
 	struct ImageArrayDescriptor
@@ -207,43 +419,71 @@ namespace EngineCore
 	class DescriptorSet
 	{
 	public:
-		DescriptorSet(EngineDevice& device);
-		DescriptorSet(EngineDevice& device, uint32_t numBuffers);
+		DescriptorSet(EngineDevice& device, DescriptorAllocator& allocator);
+		DescriptorSet(EngineDevice& device, DescriptorAllocator& allocator, uint32_t numBuffers);
+		~DescriptorSet();
 		DescriptorSet(const DescriptorSet&) = delete;
 		DescriptorSet& operator=(const DescriptorSet&) = delete;
 
 		// add a descriptor to the set, actual binding indices depend on the order in the finalize function
-		void addUBO(const UBO_Struct& structureLayout, EngineDevice& device);
+		void addUBO(const UBO_Struct& structureLayout, UniformRing& ring);
+		// adds a UBO with a compile-time std140 layout, to be written with writeUBO<L, member>()
+		template<typename L>
+		void addUBO(UniformRing& ring) { addUBO(UBO_Struct::fromLayout(L{}), ring); }
 		void addCombinedImageSampler(const VkImageView& view, const VkSampler& sampler);
 		void addImageArray(const ImageArrayDescriptor& imageArray);
 		void addSampler(const VkSampler& sampler);
 
-		void finalize(); // allocates descriptors, builds the set layout and VkDescriptorSets  
+		void finalize(); // builds the set layout, allocates the VkDescriptorSets and writes the descriptors
 
-		template<typename T> // user-friendly uniform buffer data push function
-		void writeUBOMember(uint32_t uboIndex, T& data, const UBO_Layout::ElementAccessor& position,
-							uint32_t frameIndex, bool flush = true)
-		{ getUBO(uboIndex).writeMember(position, (void*)&data, sizeof(T), frameIndex, flush); }
+		/*	rebinding after finalize, the update data is changed right away, each frame's set is rewritten with a single
+		*	template call when it is next fetched with getDescriptorSet (once the frame's earlier use has completed) */
+		void setCombinedImageSampler(uint32_t index, VkImageView view, VkSampler sampler);
+		// element of an image array, one view per frame as in ImageArrayDescriptor::addImage
+		void setArrayImage(uint32_t arrayIndex, uint32_t element, const std::vector<VkImageView>& views);
+
+		template<typename T> // user-friendly uniform buffer data push function, takes effect from the next bind
+		void writeUBOMember(uint32_t uboIndex, T& data, const UBO_Layout::ElementAccessor& position)
+		{ getUBO(uboIndex).writeMember(position, (void*)&data, sizeof(T)); }
+
+		// typed write of member I (or its element arrayIndex) at an offset known at compile time
+		template<typename L, size_t I>
+		void writeUBO(uint32_t uboIndex, const typename L::template Value<I>& value, size_t arrayIndex = 0)
+		{ getUBO(uboIndex).edit<L>().template set<I>(value, arrayIndex); }
+		// typed write of member J of the structure member I (or of its element arrayIndex)
+		template<typename L, size_t I, size_t J>
+		void writeUBO(uint32_t uboIndex, const typename L::template Inner<I>::template Value<J>& value, size_t arrayIndex = 0)
+		{ getUBO(uboIndex).edit<L>().template set<I, J>(value, arrayIndex); }
 
 		UBO& getUBO(uint32_t uboIndex);
 		VkDescriptorSetLayout getLayout() const;
-		VkDescriptorSet getDescriptorSet(uint32_t frameIndex) const { return sets[frameIndex]; }
+		// writes pending rebinds of the frame's set first
+		VkDescriptorSet getDescriptorSet(uint32_t frameIndex);
+		// one offset per UBO in binding order, pass to vkCmdBindDescriptorSets with the set (uploads pending UBO writes)
+		const std::vector<uint32_t>& getDynamicOffsets();
 
 	private:
-		std::unique_ptr<DescriptorPool> pool{};
-		std::unique_ptr<DescriptorSetLayout> layout; // layout of this set
+		DescriptorAllocator& allocator;
+		std::shared_ptr<DescriptorSetLayout> layout; // layout of this set, shared with identical sets through the layout cache
 		std::vector<VkDescriptorSet> sets; // per frame (identical layout)
-		std::vector<std::unique_ptr<UBO>> ubos; // managed ubo (each has internal per-frame buffers)
-		std::vector<std::unique_ptr<VkDescriptorBufferInfo>> bufferInfos; // descriptor infos necessary to preserve pointers for vulkan
-		std::vector<std::unique_ptr<VkDescriptorImageInfo>> samplerImageInfos;
+		std::vector<DescriptorPool*> setPools; // pool each set was allocated from, to free it
+		std::vector<std::unique_ptr<UBO>> ubos; // managed ubo (bound as dynamic uniform buffers into the uniform ring)
+		std::vector<uint32_t> dynamicOffsets;
+		// descriptors added before finalize, in binding order: UBOs, combined image samplers, image arrays, samplers
+		std::vector<VkDescriptorImageInfo> samplerImageInfos;
 		std::vector<ImageArrayDescriptor> imageArraysInfos;
-		uint32_t numImagesTotal = 0;
-		std::vector<std::unique_ptr<VkDescriptorImageInfo>> samplerInfos;
+		std::vector<VkDescriptorImageInfo> samplerInfos;
+		// update data of every frame's set, back to back, laid out by the set layout
+		std::vector<DescriptorInfo> descriptorData;
+		std::vector<uint8_t> pendingUpdates; // per frame, set when its update data changed since it was written
 		
 		EngineDevice& device;
 		/* num copies to create of each buffer, usually MAX_FRAMES_IN_FLIGHT, 
 		but may be set to a different number (e.g. swapchain image count, when using an attachment image) */
 		uint32_t framesInFlight;
+
+		DescriptorInfo* frameData(uint32_t frameIndex) { return descriptorData.data() + frameIndex * layout->getDescriptorCount(); }
+		void update(uint32_t frameIndex);
 	};
 
 }
@@ -1,4 +1,6 @@
 #include "Core/GPU/Device.h"
+#include "Core/GPU/Descriptors.h"
+
 #include <cstring>
 #include <iostream>
 #include <set>
@@ -51,10 +53,12 @@ namespace EngineCore
 		pickPhysicalDevice();
 		createLogicalDevice();
 		createCommandPool();
+		layoutCache = std::make_unique<DescriptorLayoutCache>(*this);
 	}
 
 	EngineDevice::~EngineDevice() 
 	{
+		layoutCache.reset(); // layouts are owned by their users, which must be gone by now
 		vkDestroyCommandPool(device_, commandPool, nullptr);
 		vkDestroyDevice(device_, nullptr);
 
@@ -177,6 +181,12 @@ namespace EngineCore
 		VkPhysicalDeviceVulkan12Features deviceFeatures12 = {};
 		deviceFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
 		deviceFeatures12.uniformBufferStandardLayout = VK_TRUE;
+		// bindless texture table (partially bound, update-after-bind array indexed from push constants or instance data)
+		deviceFeatures12.runtimeDescriptorArray = VK_TRUE;
+		deviceFeatures12.descriptorBindingPartiallyBound = VK_TRUE;
+		deviceFeatures12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		deviceFeatures12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		deviceFeatures12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
 
 		deviceFeatures2.pNext = &deviceFeatures12;
 
@@ -233,7 +243,18 @@ namespace EngineCore
 		VkPhysicalDeviceFeatures supportedFeatures;
 		vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
-		return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+		// descriptor indexing used by the bindless texture table
+		VkPhysicalDeviceVulkan12Features supportedFeatures12{};
+		supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		VkPhysicalDeviceFeatures2 supportedFeatures2{};
+		supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		supportedFeatures2.pNext = &supportedFeatures12;
+		vkGetPhysicalDeviceFeatures2(device, &supportedFeatures2);
+		const bool descriptorIndexing = supportedFeatures12.runtimeDescriptorArray && supportedFeatures12.descriptorBindingPartiallyBound
+			&& supportedFeatures12.descriptorBindingSampledImageUpdateAfterBind && supportedFeatures12.descriptorBindingUpdateUnusedWhilePending
+			&& supportedFeatures12.shaderSampledImageArrayNonUniformIndexing;
+
+		return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy && descriptorIndexing;
 	}
 
 	void EngineDevice::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo) 
@@ -449,7 +470,8 @@ namespace EngineCore
 	}
 
 	void EngineDevice::createBuffer(VkDeviceSize size,VkBufferUsageFlags usage,
-						VkMemoryPropertyFlags properties,VkBuffer& buffer,VkDeviceMemory& bufferMemory) 
+						VkMemoryPropertyFlags properties,VkBuffer& buffer,VkDeviceMemory& bufferMemory,
+						VkMemoryPropertyFlags* allocatedPropertiesOut) 
 	{
 		VkBufferCreateInfo bufferInfo{};
 		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -472,6 +494,12 @@ namespace EngineCore
 
 		if (vkAllocateMemory(device_, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) 
 		{ throw std::runtime_error("failed to allocate VkBuffer memory"); }
+		if (allocatedPropertiesOut)
+		{
+			VkPhysicalDeviceMemoryProperties memProperties;
+			vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+			*allocatedPropertiesOut = memProperties.memoryTypes[allocInfo.memoryTypeIndex].propertyFlags;
+		}
 
 		vkBindBufferMemory(device_, buffer, bufferMemory, 0);
 	}
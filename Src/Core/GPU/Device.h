@@ -3,6 +3,7 @@
 #include "Core/Window.h"
 
 // std lib headers
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -10,6 +11,7 @@ class EngineApplication; // forward-declaration
 
 namespace EngineCore 
 {
+	class DescriptorLayoutCache;
 
 	struct SwapChainSupportDetails 
 	{
@@ -59,14 +61,18 @@ namespace EngineCore
 		VkPhysicalDevice& getPhysicalDevice() { return physicalDevice; }
 		// checks device properties to get the max samples supported for both color and depth
 		VkSampleCountFlagBits getMaxSampleCount();
+		// shared descriptor set and pipeline layouts, see DescriptorLayoutCache
+		DescriptorLayoutCache& getLayoutCache() { return *layoutCache; }
 
 		// Buffer Helper Functions
+		// allocatedPropertiesOut receives the flags of the memory type actually chosen, which may be a superset of properties
 		void createBuffer(
 			VkDeviceSize size,
 			VkBufferUsageFlags usage,
 			VkMemoryPropertyFlags properties,
 			VkBuffer& buffer,
-			VkDeviceMemory& bufferMemory);
+			VkDeviceMemory& bufferMemory,
+			VkMemoryPropertyFlags* allocatedPropertiesOut = nullptr);
 		VkCommandBuffer beginSingleTimeCommands();
 		void endSingleTimeCommands(VkCommandBuffer commandBuffer);
 		void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
@@ -115,6 +121,7 @@ namespace EngineCore
 		VkSurfaceKHR surface_;
 		VkQueue graphicsQueue_;
 		VkQueue presentQueue_;
+		std::unique_ptr<DescriptorLayoutCache> layoutCache;
 
 		const std::vector<const char*> validationLayers = { "VK_LAYER_KHRONOS_validation" };
 		const std::vector<const char*> deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
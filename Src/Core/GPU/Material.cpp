@@ -21,8 +21,6 @@ namespace EngineCore
 
 	Material::~Material() 
 	{
-		vkDestroyPipelineLayout(device.device(), pipelineLayout, nullptr);
-
 		vkDestroyShaderModule(device.device(), vertexShaderModule, nullptr);
 		vkDestroyShaderModule(device.device(), fragmentShaderModule, nullptr);
 		vkDestroyPipeline(device.device(), pipeline, nullptr);
@@ -166,16 +164,9 @@ namespace EngineCore
 		pushConstRange.offset = 0;
 		pushConstRange.size = materialCreateInfo.pushConstSize;
 
-		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		const uint32_t setLayoutCount = static_cast<uint32_t>(materialCreateInfo.descriptorSetLayouts.size());
+		const size_t setLayoutCount = materialCreateInfo.descriptorSetLayouts.size();
 		assert(setLayoutCount < 5 && "some GPUs may only support 4 (max) descriptor sets per pipeline");
-		pipelineLayoutInfo.setLayoutCount = setLayoutCount;
-		pipelineLayoutInfo.pSetLayouts = setLayoutCount ? materialCreateInfo.descriptorSetLayouts.data() : nullptr;
-		pipelineLayoutInfo.pushConstantRangeCount = pushConstRange.size ? 1 : 0;
-		pipelineLayoutInfo.pPushConstantRanges = pushConstRange.size ? &pushConstRange : nullptr;
-		if (vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
-			{ throw std::runtime_error("material error, failed to create pipeline layout"); }
+		pipelineLayout = device.getLayoutCache().getPipelineLayout(materialCreateInfo.descriptorSetLayouts, pushConstRange);
 	}
 
 	void Material::createPipeline()
@@ -188,7 +179,7 @@ namespace EngineCore
 		// modify config with material shading properties
 		applyMatPropsToPipelineConfig(matInfo.shadingProperties, cfg);
 		cfg.renderPass = materialCreateInfo.renderpass;
-		cfg.pipelineLayout = pipelineLayout;
+		cfg.pipelineLayout = pipelineLayout->getPipelineLayout();
 		cfg.multisampleInfo.rasterizationSamples = matInfo.samples; // set the pipeline's multisample count
 
 		// these vertex bindings are to be used whenever rendering from a vertex buffer
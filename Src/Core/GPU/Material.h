@@ -76,7 +76,8 @@ namespace EngineCore
 		Material(const Material&) = delete;
 		Material& operator=(const Material&) = delete;
 
-		VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
+		VkPipelineLayout getPipelineLayout() const { return pipelineLayout->getPipelineLayout(); }
+		const MaterialCreateInfo& getCreateInfo() const { return materialCreateInfo; }
 
 		// binds this material's pipeline to the specified command buffer
 		void bindToCommandBuffer(VkCommandBuffer commandBuffer) const;
@@ -84,7 +85,7 @@ namespace EngineCore
 		template<typename T>
 		void writePushConstants(VkCommandBuffer cmdBuf, T& data) const 
 		{
-			vkCmdPushConstants(cmdBuf, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+			vkCmdPushConstants(cmdBuf, getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
 								sizeof(T), (void*)&data);
 		}
 
@@ -97,7 +98,7 @@ namespace EngineCore
 		EngineDevice& device;
 		VkShaderModule vertexShaderModule;
 		VkShaderModule fragmentShaderModule;
-		VkPipelineLayout pipelineLayout;
+		std::shared_ptr<PipelineLayout> pipelineLayout; // from the layout cache, shared with materials using the same set layouts
 		VkPipeline pipeline;
 
 		std::shared_ptr<DescriptorSet> descriptorSet = nullptr; // material-specific descriptor set
@@ -132,6 +133,41 @@ namespace EngineCore
 			glm::mat4 transform{ 1.f };
 			glm::vec4 color;
 		};
+
+		struct SkyPushConstants
+		{
+			glm::mat4 transform{ 1.f };
+			uint32_t textureIndex = 0; // texture table slot
+		};
+	}
+
+	// uniform blocks as the shaders declare them, the asserts hold the offsets the shader code expects
+	namespace ShaderUniforms
+	{
+		// UBO1, set 0 binding 0 of every mesh shader
+		struct SceneGlobal : Std140::Layout<glm::mat4>
+		{
+			enum { ProjectionView };
+		};
+		static_assert(SceneGlobal::offsets[SceneGlobal::ProjectionView] == 0 && SceneGlobal::size == 64, "SceneGlobal does not match UBO1");
+
+		// UBO2 of pbr.frag, set 1 binding 0
+		struct SectorMaterial : Std140::Layout<glm::vec3, glm::vec3, float>
+		{
+			enum { CameraPosition, LightPosition, Roughness };
+		};
+		static_assert(SectorMaterial::offsets[SectorMaterial::CameraPosition] == 0
+					&& SectorMaterial::offsets[SectorMaterial::LightPosition] == 16
+					&& SectorMaterial::offsets[SectorMaterial::Roughness] == 28 // packed into the vec3 padding
+					&& SectorMaterial::size == 32, "SectorMaterial does not match UBO2 of pbr.frag");
+
+		// UBO2 of fullscreen.frag and fx_test.frag, set 1 binding 0
+		struct FxViewport : Std140::Layout<glm::vec2, uint32_t>
+		{
+			enum { Extent, InputImage }; // InputImage is a texture table slot
+		};
+		static_assert(FxViewport::offsets[FxViewport::Extent] == 0 && FxViewport::offsets[FxViewport::InputImage] == 8
+					&& FxViewport::size == 12, "FxViewport does not match UBO2 of the fx shaders");
 	}
 
 }
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+
+namespace EngineCore
+{
+	/*	compile-time std140 layout of a uniform block described as a list of C++ types, e.g.
+	*	Std140::Layout<glm::mat4, glm::vec3, float, Std140::Array<glm::vec4, 4>, Std140::Struct<glm::vec3, float>>
+	*	offsets and sizes are constants, so a typed write through a View is a single memcpy at a fixed offset
+	*
+	*	std140 rules: scalars and vec2 align to their size, vec3/vec4/mat4 to 16 bytes, a vec3 leaves 4 bytes that the
+	*	next scalar may use, structures and array elements are aligned to and padded up to a multiple of 16 bytes */
+	namespace Std140
+	{
+		constexpr size_t roundUp(size_t v, size_t m) { return (v + m - 1) / m * m; }
+		constexpr size_t VEC4_ALIGNMENT = 16;
+
+		// nested structure member
+		template<typename... Ts> struct Struct {};
+		// array member, element type is a basic type or a Struct
+		template<typename T, size_t N> struct Array {};
+
+		// size and base alignment of the basic types, unsupported types fail to compile here
+		template<typename T> struct Basic;
+		template<> struct Basic<float> { static constexpr size_t size = 4, alignment = 4; };
+		template<> struct Basic<int32_t> { static constexpr size_t size = 4, alignment = 4; };
+		template<> struct Basic<uint32_t> { static constexpr size_t size = 4, alignment = 4; };
+		template<> struct Basic<glm::vec2> { static constexpr size_t size = 8, alignment = 8; };
+		template<> struct Basic<glm::vec3> { static constexpr size_t size = 12, alignment = 16; };
+		template<> struct Basic<glm::vec4> { static constexpr size_t size = 16, alignment = 16; };
+		template<> struct Basic<glm::mat4> { static constexpr size_t size = 64, alignment = 16; };
+
+		template<typename... Ts> struct Layout;
+
+		// placement of one member: alignment, total size, count and stride of its instances, written value type
+		template<typename T> struct Member
+		{
+			static constexpr size_t alignment = Basic<T>::alignment;
+			static constexpr size_t size = Basic<T>::size;
+			static constexpr size_t stride = size;
+			static constexpr size_t count = 1;
+			using Value = T;
+			using Inner = void;
+		};
+		template<typename... Ts> struct Member<Struct<Ts...>>
+		{
+			static constexpr size_t alignment = roundUp(std::max({ Member<Ts>::alignment... }), VEC4_ALIGNMENT);
+			static constexpr size_t size = roundUp(Layout<Ts...>::size, alignment);
+			static constexpr size_t stride = size;
+			static constexpr size_t count = 1;
+			using Value = void;
+			using Inner = Layout<Ts...>;
+		};
+		template<typename T, size_t N> struct Member<Array<T, N>>
+		{
+			static_assert(N > 0, "std140 arrays must have at least one element");
+			static constexpr size_t alignment = roundUp(Member<T>::alignment, VEC4_ALIGNMENT);
+			static constexpr size_t stride = roundUp(Member<T>::size, alignment);
+			static constexpr size_t size = stride * N;
+			static constexpr size_t count = N;
+			using Value = typename Member<T>::Value;
+			using Inner = typename Member<T>::Inner;
+		};
+
+		template<typename... Ts>
+		constexpr std::array<size_t, sizeof...(Ts)> computeOffsets()
+		{
+			constexpr size_t alignments[] = { Member<Ts>::alignment... };
+			constexpr size_t sizes[] = { Member<Ts>::size... };
+			std::array<size_t, sizeof...(Ts)> out{};
+			size_t seek = 0;
+			for (size_t i = 0; i < sizeof...(Ts); i++)
+			{
+				out[i] = roundUp(seek, alignments[i]);
+				seek = out[i] + sizes[i];
+			}
+			return out;
+		}
+
+		template<typename... Ts>
+		struct Layout
+		{
+			static_assert(sizeof...(Ts) > 0, "empty uniform block layout");
+			static constexpr size_t COUNT = sizeof...(Ts);
+
+			template<size_t I> using Type = std::tuple_element_t<I, std::tuple<Ts...>>;
+			// basic type written to member I (or its elements), void for structures
+			template<size_t I> using Value = typename Member<Type<I>>::Value;
+			// layout of structure member I (or its elements), void for basic types
+			template<size_t I> using Inner = typename Member<Type<I>>::Inner;
+
+			static constexpr std::array<size_t, COUNT> offsets = computeOffsets<Ts...>();
+			// end of the last member, the size the shader declares for the block
+			static constexpr size_t size = offsets[COUNT - 1] + Member<Type<COUNT - 1>>::size;
+
+			// byte offset of member I, or of its element arrayIndex
+			template<size_t I>
+			static constexpr size_t offsetOf(size_t arrayIndex = 0)
+			{
+				assert(arrayIndex < Member<Type<I>>::count && "std140 array index out of range");
+				return offsets[I] + arrayIndex * Member<Type<I>>::stride;
+			}
+			// byte offset of member J of the structure member I (or of its element arrayIndex)
+			template<size_t I, size_t J>
+			static constexpr size_t offsetOf(size_t arrayIndex = 0) { return offsetOf<I>(arrayIndex) + Inner<I>::offsets[J]; }
+		};
+
+		// typed writes into memory holding a block of layout L (a mapped buffer or a host copy)
+		template<typename L>
+		class View
+		{
+		public:
+			explicit View(void* memory) : base{ static_cast<char*>(memory) } {}
+
+			// member I, or element arrayIndex of an array member
+			template<size_t I>
+			void set(const typename L::template Value<I>& value, size_t arrayIndex = 0) const
+			{ write(L::template offsetOf<I>(arrayIndex), value); }
+
+			// member J of the structure member I, or of its element arrayIndex
+			template<size_t I, size_t J>
+			void set(const typename L::template Inner<I>::template Value<J>& value, size_t arrayIndex = 0) const
+			{ write(L::template offsetOf<I, J>(arrayIndex), value); }
+
+		private:
+			char* base;
+
+			// only the std140 size is copied, a vec3 must not overwrite the scalar packed behind it
+			template<typename T>
+			void write(size_t offset, const T& value) const { memcpy(base + offset, &value, Basic<T>::size); }
+		};
+	}
+}
@@ -0,0 +1,151 @@
+#include "Core/GPU/TextureTable.h"
+
+#include "Core/GPU/Device.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+
+namespace
+{
+	constexpr VkDescriptorBindingFlags TABLE_BINDING_FLAGS = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+		| VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+}
+
+namespace EngineCore
+{
+	TextureTable::TextureTable(EngineDevice& device, uint32_t capacity, uint32_t framesInFlight)
+		: device{ device }, framesInFlight{ framesInFlight }
+	{
+		// the whole array counts against the update-after-bind limits, even while it is mostly unbound
+		VkPhysicalDeviceVulkan12Properties properties12{};
+		properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+		VkPhysicalDeviceProperties2 properties2{};
+		properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		properties2.pNext = &properties12;
+		vkGetPhysicalDeviceProperties2(device.getPhysicalDevice(), &properties2);
+		capacity = std::min({ capacity, properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+							properties12.maxPerStageDescriptorUpdateAfterBindSampledImages, properties12.maxUpdateAfterBindDescriptorsInAllPools });
+		if (capacity == 0) { throw std::runtime_error("texture table error, device has no update-after-bind sampled images"); }
+
+		layout = DescriptorSetLayout::Builder(device)
+			.addBinding(0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_SHADER_STAGE_ALL_GRAPHICS, capacity, TABLE_BINDING_FLAGS)
+			.setLayoutFlags(VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT)
+			.build(device.getLayoutCache());
+
+		pool = DescriptorPool::Builder(device)
+			.addPoolSize(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, capacity)
+			.setPoolFlags(VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT)
+			.setMaxSets(1)
+			.build();
+		if (pool->allocateDescriptor(layout->getDescriptorSetLayout(), set) != VK_SUCCESS)
+		{
+			throw std::runtime_error("texture table error, failed to allocate the table descriptor set");
+		}
+
+		views.resize(capacity, VK_NULL_HANDLE);
+		pending.resize(capacity, 0);
+		freeSlots.reserve(capacity);
+		for (uint32_t s = capacity; s > 0; s--) { freeSlots.push_back(s - 1); }
+		stats.capacity = lastStats.capacity = capacity;
+	}
+
+	uint32_t TextureTable::add(VkImageView view)
+	{
+		if (freeSlots.empty()) { throw std::runtime_error("texture table is full, increase its capacity"); }
+		const uint32_t slot = freeSlots.back();
+		freeSlots.pop_back();
+		views[slot] = view;
+		markPending(slot);
+		stats.occupied++;
+		return slot;
+	}
+
+	uint32_t TextureTable::replace(uint32_t slot, VkImageView view)
+	{
+		assert(slot < views.size() && views[slot] != VK_NULL_HANDLE && "replacing a free texture table slot");
+		// UPDATE_UNUSED_WHILE_PENDING only allows writing slots pending frames do not sample, the old one goes through
+		// the same delay as removed slots, added first so a full table throws before the old slot is lost
+		const uint32_t newSlot = add(view);
+		remove(slot);
+		return newSlot;
+	}
+
+	void TextureTable::remove(uint32_t slot)
+	{
+		assert(slot < views.size() && views[slot] != VK_NULL_HANDLE && "removing a free texture table slot");
+		// the descriptor is left as it is, partially bound arrays may hold stale entries that are not sampled
+		views[slot] = VK_NULL_HANDLE;
+		retired.push_back(RetiredSlot{ slot, frameNumber });
+		stats.occupied--;
+	}
+
+	void TextureTable::beginFrame()
+	{
+		frameNumber++;
+		// frames recorded up to the removal have all been waited on once framesInFlight frames have begun since
+		auto it = std::partition(retired.begin(), retired.end(),
+			[this](const RetiredSlot& r) { return frameNumber - r.frame < framesInFlight; });
+		if (it == retired.end()) { return; }
+		const size_t freeCount = freeSlots.size();
+		for (auto r = it; r != retired.end(); r++) { freeSlots.push_back(r->slot); }
+		retired.erase(it, retired.end());
+		// lowest slots first keeps the used range of the array compact, only the recycled few are sorted
+		std::sort(freeSlots.begin() + freeCount, freeSlots.end(), std::greater<uint32_t>());
+		std::inplace_merge(freeSlots.begin(), freeSlots.begin() + freeCount, freeSlots.end(), std::greater<uint32_t>());
+	}
+
+	void TextureTable::markPending(uint32_t slot)
+	{
+		if (pending[slot]) { return; }
+		pending[slot] = 1;
+		pendingSlots.push_back(slot);
+	}
+
+	void TextureTable::flush()
+	{
+		if (!pendingSlots.empty())
+		{
+			// consecutive slots share one write, all writes go to the driver in one call
+			std::sort(pendingSlots.begin(), pendingSlots.end());
+			std::vector<VkDescriptorImageInfo> infos{};
+			infos.reserve(pendingSlots.size()); // the writes point into it
+			std::vector<VkWriteDescriptorSet> writes{};
+			for (const uint32_t slot : pendingSlots)
+			{
+				pending[slot] = 0;
+				if (views[slot] == VK_NULL_HANDLE) { continue; } // removed before it was ever written
+
+				VkDescriptorImageInfo info{};
+				info.imageView = views[slot];
+				info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL; // correct layout assumed
+				infos.push_back(info);
+
+				VkWriteDescriptorSet* last = writes.empty() ? nullptr : &writes.back();
+				if (last && last->dstArrayElement + last->descriptorCount == slot) { last->descriptorCount++; continue; }
+				VkWriteDescriptorSet write{};
+				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				write.dstSet = set;
+				write.dstBinding = 0;
+				write.dstArrayElement = slot;
+				write.descriptorCount = 1;
+				write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+				write.pImageInfo = &infos.back();
+				writes.push_back(write);
+			}
+			if (!writes.empty())
+			{
+				vkUpdateDescriptorSets(device.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+				stats.writes += static_cast<uint32_t>(infos.size());
+				stats.writeCalls++;
+			}
+			pendingSlots.clear();
+		}
+
+		stats.retiring = static_cast<uint32_t>(retired.size());
+		lastStats = stats;
+		stats.writes = stats.writeCalls = 0;
+	}
+
+}
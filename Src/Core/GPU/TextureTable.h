@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Core/GPU/Descriptors.h"
+
+#include <memory>
+#include <vector>
+
+namespace EngineCore
+{
+	class EngineDevice;
+
+	/*	global bindless table of sampled images, one descriptor set holding a large partially bound array, shaders
+	*	index it with a 32-bit slot from push constants or instance data instead of binding a set per texture
+	*
+	*	the array is update-after-bind, so the one set serves every frame in flight, a slot is written while frames
+	*	that do not use it are pending and its update is recorded before the frame is submitted, a removed slot is
+	*	reused only after every frame that could still sample it has completed
+	*
+	*	shaders declare it as "layout(set = N, binding = 0) uniform texture2D textures[];" where N is the set index
+	*	of the table in the pipeline layout, and sample with the sampler of the scene global set */
+	class TextureTable
+	{
+	public:
+		struct Stats
+		{
+			uint32_t capacity = 0;
+			uint32_t occupied = 0; // slots in use
+			uint32_t retiring = 0; // removed slots waiting for their frames to complete
+			uint32_t writes = 0; // slots written in the frame
+			uint32_t writeCalls = 0; // vkUpdateDescriptorSets calls in the frame
+		};
+
+		// capacity is clamped to the device's update-after-bind sampled image limits
+		TextureTable(EngineDevice& device, uint32_t capacity, uint32_t framesInFlight);
+		TextureTable(const TextureTable&) = delete;
+		TextureTable& operator=(const TextureTable&) = delete;
+
+		// slot of a new entry, the view must be in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL when sampled
+		uint32_t add(VkImageView view);
+		/*	slot of another view for an existing entry (e.g. a reloaded texture), the old slot is removed as by remove(),
+		*	a live slot is never rewritten since frames in flight may still sample it, users switch to the returned slot */
+		uint32_t replace(uint32_t slot, VkImageView view);
+		// frees the slot, its view must stay alive until the frames in flight are done with it
+		void remove(uint32_t slot);
+
+		// recycles slots whose frames have completed, call after the frame fence was waited on
+		void beginFrame();
+		// writes every slot added since the last flush, call before the frame is submitted
+		void flush();
+
+		VkDescriptorSetLayout getLayout() const { return layout->getDescriptorSetLayout(); }
+		VkDescriptorSet getDescriptorSet() const { return set; }
+		uint32_t getCapacity() const { return static_cast<uint32_t>(views.size()); }
+		// counters of the last flushed frame
+		const Stats& getStats() const { return lastStats; }
+
+	private:
+		struct RetiredSlot
+		{
+			uint32_t slot;
+			uint64_t frame; // frame number of the removal
+		};
+
+		EngineDevice& device;
+		std::shared_ptr<DescriptorSetLayout> layout;
+		std::unique_ptr<DescriptorPool> pool; // update-after-bind pools cannot be shared with the DescriptorAllocator
+		VkDescriptorSet set = VK_NULL_HANDLE;
+
+		std::vector<VkImageView> views; // per slot
+		std::vector<uint32_t> freeSlots; // lowest slot at the back
+		std::vector<RetiredSlot> retired;
+		std::vector<uint32_t> pendingSlots; // written by the next flush
+		std::vector<uint8_t> pending; // per slot, set while it is in pendingSlots
+		uint32_t framesInFlight;
+		uint64_t frameNumber = 0;
+		Stats stats{};
+		Stats lastStats{};
+
+		void markPending(uint32_t slot);
+	};
+
+}
@@ -0,0 +1,72 @@
+#include "Core/GPU/UniformRing.h"
+
+#include "Core/GPU/Device.h"
+#include "Core/Types/Math.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace EngineCore
+{
+	UniformRing::UniformRing(EngineDevice& device, VkDeviceSize bytesPerFrame, uint32_t frameCount)
+	{
+		assert(frameCount > 0 && "uniform ring needs at least one frame region");
+		alignment = std::max<VkDeviceSize>(device.properties.limits.minUniformBufferOffsetAlignment, 1);
+		atomSize = std::max<VkDeviceSize>(device.properties.limits.nonCoherentAtomSize, 1);
+
+		// regions start on a multiple of both limits (powers of two), so a flushed range never reaches into another frame
+		buffer = std::make_unique<GBuffer>(device, bytesPerFrame, frameCount, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+											VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, std::max(alignment, atomSize));
+		if (buffer->map() != VK_SUCCESS) { throw std::runtime_error("failed to map uniform ring buffer"); }
+		// only host visible is requested, the type actually chosen decides whether flushes are needed
+		coherent = (buffer->getAllocatedMemoryPropertyFlags() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+	}
+
+	void UniformRing::beginFrame(uint32_t frameIndex)
+	{
+		assert(frameIndex < buffer->getInstanceCount() && "frame index exceeds uniform ring regions");
+		regionStart = head = flushedHead = buffer->getAlignmentSize() * frameIndex;
+		frameNumber++;
+		stats = Stats{};
+	}
+
+	uint32_t UniformRing::allocate(VkDeviceSize size, void** mappedOut)
+	{
+		const VkDeviceSize offset = Math::roundUpToClosestMultiple(head, alignment);
+		if (offset + size > regionStart + buffer->getAlignmentSize())
+		{
+			throw std::runtime_error("uniform ring frame region is full, increase its size per frame");
+		}
+		stats.allocations++;
+		stats.bytesAllocated += offset + size - head;
+		head = offset + size;
+		if (mappedOut) { *mappedOut = static_cast<char*>(buffer->getMappedMemory()) + offset; }
+		return static_cast<uint32_t>(offset);
+	}
+
+	uint32_t UniformRing::push(const void* data, VkDeviceSize size)
+	{
+		void* mapped;
+		const uint32_t offset = allocate(size, &mapped);
+		memcpy(mapped, data, size);
+		return offset;
+	}
+
+	void UniformRing::flush()
+	{
+		if (head > flushedHead && !coherent)
+		{
+			// the range is widened to whole atoms, the region end is a multiple of the atom size so it stays inside
+			const VkDeviceSize begin = flushedHead - flushedHead % atomSize;
+			const VkDeviceSize end = Math::roundUpToClosestMultiple(head, atomSize);
+			buffer->flush(end - begin, begin);
+			stats.flushes++;
+			stats.bytesFlushed += end - begin;
+		}
+		flushedHead = head;
+		lastStats = stats;
+	}
+
+}
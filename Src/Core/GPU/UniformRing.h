@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Core/GPU/Buffer.h"
+
+#include <memory>
+
+namespace EngineCore
+{
+	class EngineDevice;
+
+	/*	per-frame linear allocator for uniform data, one persistently mapped buffer split into a region per frame in flight,
+	*	allocations bump a head through the region of the current frame and are bound as dynamic offsets
+	*	(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC), so any number of objects can share one descriptor set
+	*
+	*	a region is reused once the fence of its frame has been waited on, everything written during a frame is a single
+	*	contiguous range, so it is flushed with one call before the frame is submitted instead of once per write */
+	class UniformRing
+	{
+	public:
+		struct Stats
+		{
+			uint32_t allocations = 0;
+			uint32_t flushes = 0; // vkFlushMappedMemoryRanges calls
+			VkDeviceSize bytesAllocated = 0; // including alignment padding
+			VkDeviceSize bytesFlushed = 0; // rounded to nonCoherentAtomSize
+		};
+
+		UniformRing(EngineDevice& device, VkDeviceSize bytesPerFrame, uint32_t frameCount);
+		UniformRing(const UniformRing&) = delete;
+		UniformRing& operator=(const UniformRing&) = delete;
+
+		// starts allocating from the region of frameIndex, the device must be done reading it (the frame fence was waited on)
+		void beginFrame(uint32_t frameIndex);
+		// reserves size bytes aligned to minUniformBufferOffsetAlignment, returns the offset to bind and the mapped memory
+		uint32_t allocate(VkDeviceSize size, void** mappedOut);
+		// allocates and copies data in, returns the offset to bind
+		uint32_t push(const void* data, VkDeviceSize size);
+		// makes everything written since the last flush visible to the device, call once before the frame is submitted
+		void flush();
+
+		// info for a dynamic uniform buffer binding of range bytes, the offset is given at bind time
+		VkDescriptorBufferInfo descriptorInfo(VkDeviceSize range) const { return VkDescriptorBufferInfo{ buffer->getBuffer(), 0, range }; }
+		// incremented by each beginFrame, offsets allocated under an older number may be overwritten by now
+		uint64_t getFrameNumber() const { return frameNumber; }
+		// counters of the last flushed frame
+		const Stats& getStats() const { return lastStats; }
+
+	private:
+		std::unique_ptr<GBuffer> buffer;
+		VkDeviceSize alignment; // minUniformBufferOffsetAlignment
+		VkDeviceSize atomSize; // nonCoherentAtomSize, flushed ranges must be multiples of it
+		VkDeviceSize regionStart = 0;
+		VkDeviceSize head = 0; // next free byte in the current region
+		VkDeviceSize flushedHead = 0; // end of the last flushed range
+		uint64_t frameNumber = 0;
+		bool coherent = false; // of the memory type the buffer was allocated from
+		Stats stats{};
+		Stats lastStats{};
+	};
+
+}
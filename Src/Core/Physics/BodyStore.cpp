@@ -0,0 +1,274 @@
+#include "Core/Physics/BodyStore.h"
+#include "Core/Types/SimdLanes.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Physics
+{
+	namespace
+	{
+		size_t paddedSize(size_t n) { return (n + Simd::MAX_LANES - 1) / Simd::MAX_LANES * Simd::MAX_LANES; }
+	}
+
+	BodyHandle BodyStore::create(const Vec& position, float mass, float damping)
+	{
+		uint32_t slot = freeSlot;
+		if (slot != BodyHandle::INVALID) { freeSlot = slots[slot].index; }
+		else
+		{
+			slot = static_cast<uint32_t>(slots.size());
+			slots.emplace_back();
+		}
+
+		const uint32_t i = static_cast<uint32_t>(count++);
+		if (data[0].size() < paddedSize(count))
+		{
+			for (auto& c : data) { c.resize(paddedSize(count), 0.f); }
+		}
+		denseToSlot.push_back(slot);
+		types.push_back(Collider::NONE);
+		continuous.push_back(0);
+		slots[slot].index = i;
+		slots[slot].alive = true;
+
+		const BodyHandle handle{ slot, slots[slot].generation };
+		setVec(POS_X, i, position);
+		setVec(PREV_POS_X, i, position);
+		setVec(VEL_X, i, Vec::zero());
+		setVec(ACC_X, i, Vec::zero());
+		setVec(FORCE_X, i, Vec::zero());
+		setMass(handle, mass);
+		setDamping(handle, damping);
+		data[SLEEP_TIMER][i] = 0.f;
+		// new bodies start awake, the first sleeping body moves to the end
+		swapBodies(i, static_cast<uint32_t>(awakeCount++));
+		revision++;
+		return handle;
+	}
+
+	void BodyStore::destroy(BodyHandle handle)
+	{
+		uint32_t i = indexOf(handle);
+		const uint32_t last = static_cast<uint32_t>(count - 1);
+
+		// keep the arrays dense and awake bodies first: an awake body first moves to the end of the awake range,
+		// which then becomes the start of the sleeping range, and from there the last body takes its place
+		if (i < awakeCount)
+		{
+			const uint32_t border = static_cast<uint32_t>(--awakeCount);
+			swapBodies(i, border);
+			i = border;
+		}
+		swapBodies(i, last);
+		for (auto& c : data) { c[last] = 0.f; } // padding lanes stay zero
+		denseToSlot.pop_back();
+		types.pop_back();
+		continuous.pop_back();
+		count--;
+		revision++;
+
+		Slot& slot = slots[handle.slot];
+		slot.alive = false;
+		slot.generation++; // invalidates outstanding handles
+		slot.index = freeSlot;
+		freeSlot = handle.slot;
+	}
+
+	bool BodyStore::isAlive(BodyHandle handle) const
+	{
+		return handle.slot < slots.size() && slots[handle.slot].alive && slots[handle.slot].generation == handle.generation;
+	}
+
+	void BodyStore::clear()
+	{
+		for (auto& c : data) { c.clear(); }
+		denseToSlot.clear();
+		types.clear();
+		continuous.clear();
+		// slots are kept so their generations keep counting, a handle from before the clear must not match a new body
+		freeSlot = BodyHandle::INVALID;
+		for (uint32_t s = static_cast<uint32_t>(slots.size()); s-- > 0;)
+		{
+			Slot& slot = slots[s];
+			if (slot.alive) { slot.alive = false; slot.generation++; }
+			slot.index = freeSlot;
+			freeSlot = s;
+		}
+		count = 0;
+		awakeCount = 0;
+		revision++;
+	}
+
+	void BodyStore::swapBodies(uint32_t i, uint32_t j)
+	{
+		if (i == j) { return; }
+		for (auto& c : data) { std::swap(c[i], c[j]); }
+		std::swap(types[i], types[j]);
+		std::swap(continuous[i], continuous[j]);
+		std::swap(denseToSlot[i], denseToSlot[j]);
+		slots[denseToSlot[i]].index = i;
+		slots[denseToSlot[j]].index = j;
+	}
+
+	void BodyStore::sleep(BodyHandle h)
+	{
+		const uint32_t i = indexOf(h);
+		if (i >= awakeCount) { return; }
+		setVec(VEL_X, i, Vec::zero());
+		setVec(FORCE_X, i, Vec::zero());
+		setVec(PREV_POS_X, i, getVec(POS_X, i)); // storePreviousPositions skips it from now on
+		swapBodies(i, static_cast<uint32_t>(--awakeCount));
+		revision++;
+	}
+
+	void BodyStore::wake(BodyHandle h)
+	{
+		const uint32_t i = indexOf(h);
+		if (i < awakeCount) { return; }
+		data[SLEEP_TIMER][i] = 0.f;
+		swapBodies(i, static_cast<uint32_t>(awakeCount++));
+		revision++;
+	}
+
+	uint32_t BodyStore::indexOf(BodyHandle handle) const
+	{
+		assert(isAlive(handle) && "body store error, stale or invalid body handle");
+		return slots[handle.slot].index;
+	}
+
+	BodyHandle BodyStore::handleAt(uint32_t index) const
+	{
+		const uint32_t slot = denseToSlot[index];
+		return BodyHandle{ slot, slots[slot].generation };
+	}
+
+	void BodyStore::applyForce(BodyHandle h, const Vec& f)
+	{
+		const uint32_t i = awakeIndexOf(h);
+		data[FORCE_X][i] += f.x;
+		data[FORCE_Y][i] += f.y;
+		data[FORCE_Z][i] += f.z;
+	}
+
+	void BodyStore::setMass(BodyHandle h, float mass)
+	{
+		data[INV_MASS][indexOf(h)] = mass > 0.f ? 1.f / mass : 0.f;
+	}
+
+	void BodyStore::setDamping(BodyHandle h, float damping)
+	{
+		const uint32_t i = indexOf(h);
+		data[DAMPING][i] = damping;
+		data[DAMPING_FACTOR][i] = cachedDeltaTime > 0.f ? std::pow(damping, cachedDeltaTime) : 1.f;
+	}
+
+	Collider BodyStore::getCollider(BodyHandle h) const
+	{
+		const uint32_t i = indexOf(h);
+		return Collider{ types[i], getVec(EXTENT_X, i) };
+	}
+
+	void BodyStore::setCollider(BodyHandle h, const Collider& collider)
+	{
+		const uint32_t i = indexOf(h);
+		types[i] = collider.type;
+		setVec(EXTENT_X, i, collider.type == Collider::NONE ? Vec::zero() : collider.halfExtents);
+		revision++; // the set of colliding bodies changed
+	}
+
+	void BodyStore::setContinuous(BodyHandle h, bool enabled)
+	{
+		continuous[indexOf(h)] = enabled ? 1 : 0;
+	}
+
+	Vec BodyStore::getInterpolatedPosition(BodyHandle h, float alpha) const
+	{
+		const uint32_t i = indexOf(h);
+		const Vec previous = getVec(PREV_POS_X, i);
+		return previous + (getVec(POS_X, i) - previous) * alpha;
+	}
+
+	void BodyStore::storePreviousPositions()
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			std::copy(data[POS_X + axis].begin(), data[POS_X + axis].begin() + awakeCount, data[PREV_POS_X + axis].begin());
+		}
+	}
+
+	void BodyStore::updateDampingFactors(float deltaTime)
+	{
+		// only runs when the step size changes, with a fixed step that is once
+		cachedDeltaTime = deltaTime;
+		const float* damping = data[DAMPING].data();
+		float* factor = data[DAMPING_FACTOR].data();
+		for (size_t i = 0; i < count; i++) { factor[i] = std::pow(damping[i], deltaTime); }
+	}
+
+	void BodyStore::integrateScalar(float deltaTime)
+	{
+		if (deltaTime != cachedDeltaTime) { updateDampingFactors(deltaTime); }
+		integrateRange(0, awakeCount, deltaTime);
+	}
+
+	void BodyStore::integrateRange(size_t begin, size_t end, float deltaTime)
+	{
+		const float* invMass = data[INV_MASS].data();
+		const float* factor = data[DAMPING_FACTOR].data();
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float* pos = data[POS_X + axis].data();
+			float* vel = data[VEL_X + axis].data();
+			const float* acc = data[ACC_X + axis].data();
+			float* force = data[FORCE_X + axis].data();
+			for (size_t i = begin; i < end; i++)
+			{
+				pos[i] = pos[i] + vel[i] * deltaTime;
+				vel[i] = (vel[i] + (acc[i] + force[i] * invMass[i]) * deltaTime) * factor[i];
+				force[i] = 0.f;
+			}
+		}
+	}
+
+#ifdef SIMD_LANES
+
+	void BodyStore::integrate(float deltaTime)
+	{
+		using L = Simd::Lanes;
+		if (deltaTime != cachedDeltaTime) { updateDampingFactors(deltaTime); }
+		const float* invMass = data[INV_MASS].data();
+		const float* factor = data[DAMPING_FACTOR].data();
+		const L::F dt = L::set(deltaTime);
+		const L::F zero = L::set(0.f);
+
+		// whole blocks of awake bodies, the block the awake range ends in also holds sleeping bodies and is done one by one
+		const size_t blockEnd = awakeCount == count ? count : awakeCount / L::WIDTH * L::WIDTH;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float* pos = data[POS_X + axis].data();
+			float* vel = data[VEL_X + axis].data();
+			const float* acc = data[ACC_X + axis].data();
+			float* force = data[FORCE_X + axis].data();
+			// with nothing asleep the padding lanes (zeros) are integrated harmlessly
+			for (size_t i = 0; i < blockEnd; i += L::WIDTH)
+			{
+				const L::F v = L::load(vel + i);
+				L::store(pos + i, L::add(L::load(pos + i), L::mul(v, dt)));
+				const L::F a = L::add(L::load(acc + i), L::mul(L::load(force + i), L::load(invMass + i)));
+				L::store(vel + i, L::mul(L::add(v, L::mul(a, dt)), L::load(factor + i)));
+				L::store(force + i, zero);
+			}
+		}
+		integrateRange(std::min(blockEnd, awakeCount), awakeCount, deltaTime);
+	}
+
+#else
+
+	void BodyStore::integrate(float deltaTime) { integrateScalar(deltaTime); }
+
+#endif
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace Physics
+{
+	// stable reference to a body, stays valid while bodies are added and removed (a removed body's handle becomes stale)
+	struct BodyHandle
+	{
+		static constexpr uint32_t INVALID = 0xFFFFFFFF;
+		uint32_t slot = INVALID;
+		uint32_t generation = 0;
+
+		bool isValid() const { return slot != INVALID; }
+		bool operator==(const BodyHandle& o) const { return slot == o.slot && generation == o.generation; }
+		bool operator!=(const BodyHandle& o) const { return !(*this == o); }
+	};
+
+	// collision shape of a body, axis aligned (bodies carry no orientation), centered on the body position
+	struct Collider
+	{
+		enum Type : uint8_t { NONE = 0, SPHERE, BOX };
+		Type type = NONE;
+		Vec halfExtents{}; // a sphere's radius in every component
+
+		static Collider sphere(float radius) { return Collider{ SPHERE, Vec{ radius, radius, radius } }; }
+		static Collider box(const Vec& halfExtents) { return Collider{ BOX, halfExtents }; }
+	};
+
+	/*	structure of arrays storage for rigid body state, one contiguous float array per component, so the integrator
+	*	(and later broadphase/solver passes) streams through memory and processes several bodies per SIMD instruction
+	*
+	*	bodies are kept densely packed (removal swaps the last body into the hole), handles map to dense indices through
+	*	a slot table, dense indices are only stable until the next removal
+	*
+	*	awake bodies come first, [0, getAwakeCount()) are awake and the sleeping ones follow, so passes that skip
+	*	sleeping bodies (the integrator, the broadphase) just stop at the awake count, putting a body to sleep or
+	*	waking it swaps it across that border and so also changes dense indices */
+	class BodyStore
+	{
+	public:
+		// dense component arrays, each padded to a multiple of Simd::MAX_LANES
+		enum Component
+		{
+			POS_X = 0, POS_Y, POS_Z,
+			VEL_X, VEL_Y, VEL_Z,
+			ACC_X, ACC_Y, ACC_Z, // constant acceleration (e.g. gravity)
+			FORCE_X, FORCE_Y, FORCE_Z, // accumulated for the next step, cleared by integrate()
+			INV_MASS,
+			DAMPING, // fraction of velocity kept per second
+			DAMPING_FACTOR, // pow(DAMPING, deltaTime), cached for the last deltaTime
+			EXTENT_X, EXTENT_Y, EXTENT_Z, // collider half extents, the body's bounds are position +- extent
+			PREV_POS_X, PREV_POS_Y, PREV_POS_Z, // position before the last step, for render interpolation
+			SLEEP_TIMER, // seconds the body has been moving slowly enough to sleep, see SleepSystem
+			COMPONENT_COUNT
+		};
+
+		static constexpr float DEFAULT_DAMPING = .99f;
+
+		BodyHandle create(const Vec& position, float mass, float damping = DEFAULT_DAMPING);
+		void destroy(BodyHandle handle);
+		bool isAlive(BodyHandle handle) const;
+		// removes every body, handles taken before stay stale (slots are reused with a new generation)
+		void clear();
+
+		size_t size() const { return count; }
+		// dense index of a live body
+		uint32_t indexOf(BodyHandle handle) const;
+		BodyHandle handleAt(uint32_t index) const;
+		// incremented by create/destroy/setCollider/sleep/wake, dense indices taken at an older revision may be out of date
+		uint64_t getRevision() const { return revision; }
+
+		size_t getAwakeCount() const { return awakeCount; }
+		bool isAwake(BodyHandle h) const { return indexOf(h) < awakeCount; }
+		// stops simulating the body until it is woken, its velocity and accumulated force are cleared
+		void sleep(BodyHandle h);
+		// no-op for awake bodies, resets the sleep timer
+		void wake(BodyHandle h);
+
+		// the setters below (and applyForce) wake the body, a sleeping body would otherwise ignore the change
+		Vec getPosition(BodyHandle h) const { return getVec(POS_X, indexOf(h)); }
+		// moves the body without interpolating from its old position
+		void setPosition(BodyHandle h, const Vec& p) { const uint32_t i = awakeIndexOf(h); setVec(POS_X, i, p); setVec(PREV_POS_X, i, p); }
+		// previous + (current - previous) * alpha, alpha is the fraction of a step the render time is past the last step
+		Vec getInterpolatedPosition(BodyHandle h, float alpha) const;
+		Vec getVelocity(BodyHandle h) const { return getVec(VEL_X, indexOf(h)); }
+		void setVelocity(BodyHandle h, const Vec& v) { setVec(VEL_X, awakeIndexOf(h), v); }
+		Vec getAcceleration(BodyHandle h) const { return getVec(ACC_X, indexOf(h)); }
+		void setAcceleration(BodyHandle h, const Vec& a) { setVec(ACC_X, awakeIndexOf(h), a); }
+		void applyForce(BodyHandle h, const Vec& f);
+		void resetForces(BodyHandle h) { setVec(FORCE_X, indexOf(h), Vec::zero()); }
+
+		float getMassInverse(BodyHandle h) const { return data[INV_MASS][indexOf(h)]; }
+		// mass <= 0 is treated as infinite (immovable)
+		void setMass(BodyHandle h, float mass);
+		float getDamping(BodyHandle h) const { return data[DAMPING][indexOf(h)]; }
+		void setDamping(BodyHandle h, float damping);
+		Collider getCollider(BodyHandle h) const;
+		void setCollider(BodyHandle h, const Collider& collider);
+		// collider type of each dense index
+		const Collider::Type* colliderTypes() const { return types.data(); }
+		// always sweep the body for continuous collision, not only once it moves faster than its size per step
+		void setContinuous(BodyHandle h, bool continuous);
+		bool isContinuous(BodyHandle h) const { return continuous[indexOf(h)] != 0; }
+		// continuous flag of each dense index
+		const uint8_t* continuousFlags() const { return continuous.data(); }
+
+		// xyz of a vector component (POS_X, VEL_X, ...) by dense index, for passes that already work on indices
+		Vec getVec(Component first, uint32_t i) const { return Vec{ data[first][i], data[first + 1][i], data[first + 2][i] }; }
+		void setVec(Component first, uint32_t i, const Vec& v) { data[first][i] = v.x; data[first + 1][i] = v.y; data[first + 2][i] = v.z; }
+		float getFloat(Component c, uint32_t i) const { return data[c][i]; }
+
+		// raw component array, valid until the next create/destroy
+		float* array(Component c) { return data[c].data(); }
+		const float* array(Component c) const { return data[c].data(); }
+
+		// copies every awake position to PREV_POS, called before each step
+		void storePreviousPositions();
+		// advances every awake body by deltaTime and clears the accumulated forces
+		void integrate(float deltaTime);
+		// same result as integrate(), one body at a time (reference and non-x86 fallback)
+		void integrateScalar(float deltaTime);
+
+	private:
+		struct Slot
+		{
+			uint32_t index = 0; // dense index while alive, next free slot while free
+			uint32_t generation = 0;
+			bool alive = false;
+		};
+
+		std::vector<float> data[COMPONENT_COUNT];
+		std::vector<Collider::Type> types;
+		std::vector<uint8_t> continuous;
+		std::vector<uint32_t> denseToSlot;
+		std::vector<Slot> slots;
+		uint32_t freeSlot = BodyHandle::INVALID;
+		size_t count = 0;
+		size_t awakeCount = 0;
+		float cachedDeltaTime = 0.f; // DAMPING_FACTOR is valid for this step size
+		uint64_t revision = 0;
+
+		void updateDampingFactors(float deltaTime);
+		void integrateRange(size_t begin, size_t end, float deltaTime);
+		// exchanges two bodies' dense positions, keeps the slot table in sync
+		void swapBodies(uint32_t i, uint32_t j);
+		uint32_t awakeIndexOf(BodyHandle h) { wake(h); return indexOf(h); }
+	};
+
+}
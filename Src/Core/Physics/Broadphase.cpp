@@ -0,0 +1,455 @@
+#include "Core/Physics/Broadphase.h"
+#include "Core/Types/SimdLanes.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace Physics
+{
+	namespace
+	{
+		// the order is rebuilt with a full sort once the insertion sort has to move more than this many entries per body
+		constexpr uint32_t MAX_SHIFTS_PER_BODY = 16;
+		// the sweep axis only changes when another axis spreads this much further, avoids flip-flopping full sorts
+		constexpr float AXIS_HYSTERESIS = 1.5f;
+		// columns are at least this many average body sizes wide, so few bodies straddle a border
+		constexpr float COLUMN_WIDTH_FACTOR = 8.f;
+		// and never so narrow that they hold less than this many bodies on average
+		constexpr float MIN_BODIES_PER_COLUMN = 32.f;
+		// sleeping bodies longer than this many times the average on the sweep axis are tested apart from the columns
+		constexpr float OVERSIZED_FACTOR = 16.f;
+	}
+
+	uint32_t Broadphase::Grid::column(int k, float v) const
+	{
+		const float c = (v - origin[k]) * inverseWidth[k];
+		if (!(c > 0.f)) { return 0; }
+		return std::min(static_cast<uint32_t>(c), count[k] - 1);
+	}
+
+	void Broadphase::Layer::clear()
+	{
+		for (auto& s : sorted) { s.clear(); }
+		sortedBody.clear();
+		columnStart.clear();
+		columnRanges.clear();
+		columnCursor.clear();
+		longest.clear();
+		grid = Grid{};
+	}
+
+	void Broadphase::clear()
+	{
+		order.clear();
+		restingOrder.clear();
+		restingOversized.clear();
+		keys.clear();
+		active.clear();
+		resting.clear();
+		pairs.clear();
+		revision = ~0ull;
+		stats = Stats{};
+	}
+
+	void Broadphase::update(const BodyStore& store)
+	{
+		stats = Stats{};
+		pairs.clear();
+
+		bool rebuild = store.getRevision() != revision;
+		if (rebuild)
+		{
+			revision = store.getRevision();
+			order.clear();
+			const Collider::Type* types = store.colliderTypes();
+			for (uint32_t i = 0; i < store.getAwakeCount(); i++)
+			{
+				if (types[i] != Collider::NONE) { order.push_back(i); }
+			}
+			keys.resize(store.size());
+			rebuildResting(store);
+			stats.restingRebuilt = true;
+		}
+		stats.restingBodies = static_cast<uint32_t>(restingOrder.size() + restingOversized.size());
+		stats.bodies = static_cast<uint32_t>(order.size()) + stats.restingBodies;
+
+		if (!order.empty())
+		{
+			const int bestAxis = selectAxis(store, order, axis);
+			if (bestAxis != axis)
+			{
+				axis = bestAxis;
+				rebuild = true;
+			}
+
+			const float* position = store.array(static_cast<BodyStore::Component>(BodyStore::POS_X + axis));
+			const float* extent = store.array(static_cast<BodyStore::Component>(BodyStore::EXTENT_X + axis));
+			for (uint32_t i : order) { keys[i] = position[i] - extent[i]; }
+
+			sortOrder(rebuild);
+			active.build(store, order, axis);
+			stats.columns = active.columnCount();
+			stats.entries = active.columnStart.back() - stats.columns * Simd::MAX_LANES;
+			sweep(store);
+		}
+		if (!order.empty() && stats.restingBodies > 0) { queryResting(store); }
+		stats.pairs = static_cast<uint32_t>(pairs.size());
+	}
+
+	void Broadphase::rebuildResting(const BodyStore& store)
+	{
+		restingOrder.clear();
+		restingOversized.clear();
+		const Collider::Type* types = store.colliderTypes();
+		for (uint32_t i = static_cast<uint32_t>(store.getAwakeCount()); i < store.size(); i++)
+		{
+			if (types[i] != Collider::NONE) { restingOrder.push_back(i); }
+		}
+		if (restingOrder.empty())
+		{
+			resting.clear();
+			return;
+		}
+
+		// sleeping bodies do not move, sorted once here and reused until the next revision
+		const int restingAxis = selectAxis(store, restingOrder, resting.axis);
+		const float* position = store.array(static_cast<BodyStore::Component>(BodyStore::POS_X + restingAxis));
+		const float* extent = store.array(static_cast<BodyStore::Component>(BodyStore::EXTENT_X + restingAxis));
+		float extentSum = 0.f;
+		for (uint32_t i : restingOrder) { extentSum += extent[i]; }
+		const float maxExtent = OVERSIZED_FACTOR * extentSum / restingOrder.size();
+		const auto oversized = std::stable_partition(restingOrder.begin(), restingOrder.end(), [&](uint32_t i) { return extent[i] <= maxExtent; });
+		restingOversized.assign(oversized, restingOrder.end());
+		restingOrder.erase(oversized, restingOrder.end());
+		if (restingOrder.empty())
+		{
+			resting.clear();
+			return;
+		}
+
+		for (uint32_t i : restingOrder) { keys[i] = position[i] - extent[i]; }
+		std::sort(restingOrder.begin(), restingOrder.end(), [this](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+		resting.build(store, restingOrder, restingAxis);
+	}
+
+	int Broadphase::selectAxis(const BodyStore& store, const std::vector<uint32_t>& bodies, int current)
+	{
+		float variance[3];
+		const float n = static_cast<float>(bodies.size());
+		for (int k = 0; k < 3; k++)
+		{
+			const float* p = store.array(static_cast<BodyStore::Component>(BodyStore::POS_X + k));
+			float sum = 0.f, sumSquared = 0.f;
+			for (uint32_t i : bodies)
+			{
+				sum += p[i];
+				sumSquared += p[i] * p[i];
+			}
+			const float mean = sum / n;
+			variance[k] = sumSquared / n - mean * mean;
+		}
+
+		int best = current;
+		for (int k = 0; k < 3; k++)
+		{
+			if (variance[k] > variance[best] * AXIS_HYSTERESIS) { best = k; }
+		}
+		return best;
+	}
+
+	void Broadphase::sortOrder(bool rebuild)
+	{
+		const auto byKey = [this](uint32_t a, uint32_t b) { return keys[a] < keys[b]; };
+		stats.rebuilt = rebuild;
+		if (rebuild)
+		{
+			std::sort(order.begin(), order.end(), byKey);
+			return;
+		}
+
+		// the previous order is nearly sorted, insertion sort touches little more than each entry once
+		const size_t maxShifts = order.size() * MAX_SHIFTS_PER_BODY;
+		size_t shifts = 0;
+		for (size_t i = 1; i < order.size(); i++)
+		{
+			const uint32_t body = order[i];
+			const float key = keys[body];
+			size_t j = i;
+			for (; j > 0 && key < keys[order[j - 1]]; j--) { order[j] = order[j - 1]; }
+			order[j] = body;
+			shifts += i - j;
+			if (shifts > maxShifts)
+			{
+				// bodies teleported or the scene was shuffled, finish with a full sort
+				std::sort(order.begin(), order.end(), byKey);
+				stats.rebuilt = true;
+				break;
+			}
+		}
+		stats.sortShifts = static_cast<uint32_t>(std::min<size_t>(shifts, UINT32_MAX));
+	}
+
+	void Broadphase::Layer::build(const BodyStore& store, const std::vector<uint32_t>& order, int sweepAxis)
+	{
+		axis = sweepAxis;
+		const size_t n = order.size();
+		const int axes[3] = { axis, (axis + 1) % 3, (axis + 2) % 3 };
+		const float* position[3];
+		const float* extent[3];
+		for (int k = 0; k < 3; k++)
+		{
+			position[k] = store.array(static_cast<BodyStore::Component>(BodyStore::POS_X + axes[k]));
+			extent[k] = store.array(static_cast<BodyStore::Component>(BodyStore::EXTENT_X + axes[k]));
+		}
+
+		// grid over axes B and C, from the bounds of all bodies and their average size
+		std::fill_n(lower, 3, FLT_MAX);
+		std::fill_n(upper, 3, -FLT_MAX);
+		float extentSum = 0.f;
+		for (uint32_t body : order)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				lower[k] = std::min(lower[k], position[k][body] - extent[k][body]);
+				upper[k] = std::max(upper[k], position[k][body] + extent[k][body]);
+			}
+			extentSum += extent[1][body] + extent[2][body];
+		}
+		const float minWidth = COLUMN_WIDTH_FACTOR * 2.f * extentSum / (2.f * n);
+		const float maxColumns = std::max(1.f, std::floor(std::sqrt(n / MIN_BODIES_PER_COLUMN)));
+		for (int k = 0; k < 2; k++)
+		{
+			const float span = upper[k + 1] - lower[k + 1];
+			const float columns = minWidth > 0.f ? std::clamp(std::floor(span / minWidth), 1.f, maxColumns) : 1.f;
+			grid.origin[k] = lower[k + 1];
+			grid.count[k] = static_cast<uint32_t>(columns);
+			grid.inverseWidth[k] = span > 0.f ? columns / span : 0.f;
+		}
+		const uint32_t columnCount = this->columnCount();
+
+		// count the bodies per column, then distribute them in sweep order (so each column stays sorted)
+		columnRanges.resize(n * 4);
+		columnStart.assign(columnCount + 1, 0);
+		for (size_t i = 0; i < n; i++)
+		{
+			const uint32_t body = order[i];
+			uint32_t* range = &columnRanges[i * 4];
+			range[0] = grid.column(0, position[1][body] - extent[1][body]);
+			range[1] = grid.column(0, position[1][body] + extent[1][body]);
+			range[2] = grid.column(1, position[2][body] - extent[2][body]);
+			range[3] = grid.column(1, position[2][body] + extent[2][body]);
+			for (uint32_t b = range[0]; b <= range[1]; b++)
+			{
+				for (uint32_t c = range[2]; c <= range[3]; c++) { columnStart[b * grid.count[1] + c + 1]++; }
+			}
+		}
+		for (uint32_t k = 0; k < columnCount; k++) { columnStart[k + 1] += columnStart[k] + Simd::MAX_LANES; }
+		const uint32_t total = columnStart[columnCount];
+
+		// scatter only the body indices, then fill each bounds array front to back, many scattered write streams are slow
+		sortedBody.resize(total);
+		columnCursor.assign(columnStart.begin(), columnStart.end() - 1);
+		for (size_t i = 0; i < n; i++)
+		{
+			const uint32_t* range = &columnRanges[i * 4];
+			for (uint32_t b = range[0]; b <= range[1]; b++)
+			{
+				for (uint32_t c = range[2]; c <= range[3]; c++) { sortedBody[columnCursor[b * grid.count[1] + c]++] = order[i]; }
+			}
+		}
+		for (int k = 0; k < 3; k++)
+		{
+			sorted[MIN_A + 2 * k].resize(total);
+			sorted[MAX_A + 2 * k].resize(total);
+			float* lowerOut = sorted[MIN_A + 2 * k].data();
+			float* upperOut = sorted[MAX_A + 2 * k].data();
+			for (uint32_t column = 0; column < columnCount; column++)
+			{
+				// the padding intervals start at +max and never overlap anything, a full SIMD load at the end of a column stays in bounds
+				const uint32_t end = columnCursor[column];
+				for (uint32_t slot = columnStart[column]; slot < end; slot++)
+				{
+					const uint32_t body = sortedBody[slot];
+					lowerOut[slot] = position[k][body] - extent[k][body];
+					upperOut[slot] = position[k][body] + extent[k][body];
+				}
+				std::fill_n(lowerOut + end, Simd::MAX_LANES, FLT_MAX);
+				std::fill_n(upperOut + end, Simd::MAX_LANES, -FLT_MAX);
+			}
+		}
+
+		longest.assign(columnCount, 0.f);
+		for (uint32_t column = 0; column < columnCount; column++)
+		{
+			for (uint32_t slot = columnStart[column]; slot < columnCursor[column]; slot++)
+			{
+				longest[column] = std::max(longest[column], sorted[MAX_A][slot] - sorted[MIN_A][slot]);
+			}
+		}
+	}
+
+	void Broadphase::sweep(const BodyStore& store)
+	{
+		const Grid& grid = active.grid;
+		const std::vector<uint32_t>& sortedBody = active.sortedBody;
+		const std::vector<uint32_t>& columnStart = active.columnStart;
+		const float* invMass = store.array(BodyStore::INV_MASS);
+		const float* minA = active.sorted[MIN_A].data();
+		const float* maxA = active.sorted[MAX_A].data();
+		const float* minB = active.sorted[MIN_B].data();
+		const float* maxB = active.sorted[MAX_B].data();
+		const float* minC = active.sorted[MIN_C].data();
+		const float* maxC = active.sorted[MAX_C].data();
+
+		const uint32_t columnCount = active.columnCount();
+		for (uint32_t column = 0; column < columnCount; column++)
+		{
+			const uint32_t columnB = column / grid.count[1];
+			const uint32_t columnC = column % grid.count[1];
+			const auto addPair = [&](uint32_t i, uint32_t j)
+			{
+				const uint32_t a = sortedBody[i];
+				const uint32_t b = sortedBody[j];
+				if (invMass[a] <= 0.f && invMass[b] <= 0.f) { return; } // two immovable bodies never need a contact
+				// bodies straddling a border meet in several columns, only the one holding the overlap's lower corner reports them
+				if (grid.column(0, std::max(minB[i], minB[j])) != columnB || grid.column(1, std::max(minC[i], minC[j])) != columnC) { return; }
+				pairs.push_back(a < b ? BodyPair{ a, b } : BodyPair{ b, a });
+			};
+
+			const size_t begin = columnStart[column];
+			const size_t end = columnStart[column + 1] - Simd::MAX_LANES;
+#ifdef SIMD_LANES
+			using L = Simd::Lanes;
+			constexpr uint32_t ALL_LANES = (1u << L::WIDTH) - 1;
+			for (size_t i = begin; i < end; i++)
+			{
+				const L::F upperA = L::set(maxA[i]);
+				const L::F lowerB = L::set(minB[i]), upperB = L::set(maxB[i]);
+				const L::F lowerC = L::set(minC[i]), upperC = L::set(maxC[i]);
+				for (size_t j = i + 1; ; j += L::WIDTH)
+				{
+					// candidates are sorted by lower bound, the first one starting past our upper bound ends the sweep
+					const L::F inRange = L::lessEqual(L::load(minA + j), upperA);
+					const uint32_t rangeMask = L::mask(inRange);
+					L::F overlap = L::bitAnd(inRange, L::lessEqual(L::load(minB + j), upperB));
+					overlap = L::bitAnd(overlap, L::lessEqual(lowerB, L::load(maxB + j)));
+					overlap = L::bitAnd(overlap, L::lessEqual(L::load(minC + j), upperC));
+					overlap = L::bitAnd(overlap, L::lessEqual(lowerC, L::load(maxC + j)));
+
+					uint32_t mask = L::mask(overlap);
+					for (uint32_t lane = 0; mask != 0; lane++, mask >>= 1)
+					{
+						if (mask & 1) { addPair(static_cast<uint32_t>(i), static_cast<uint32_t>(j + lane)); }
+					}
+					if (rangeMask != ALL_LANES) { break; }
+				}
+			}
+#else
+			for (size_t i = begin; i < end; i++)
+			{
+				for (size_t j = i + 1; j < end && minA[j] <= maxA[i]; j++)
+				{
+					if (minB[j] <= maxB[i] && minB[i] <= maxB[j] && minC[j] <= maxC[i] && minC[i] <= maxC[j]) { addPair(static_cast<uint32_t>(i), static_cast<uint32_t>(j)); }
+				}
+			}
+#endif
+		}
+	}
+
+	template<typename OnOverlap>
+	void Broadphase::Layer::forEachOverlap(const float queryLower[3], const float queryUpper[3], OnOverlap&& onOverlap) const
+	{
+		if (queryUpper[0] < lower[0] || upper[0] < queryLower[0] || queryUpper[1] < lower[1] || upper[1] < queryLower[1] || queryUpper[2] < lower[2] || upper[2] < queryLower[2]) { return; }
+		const float* minA = sorted[MIN_A].data();
+		const float* maxA = sorted[MAX_A].data();
+		const float* minB = sorted[MIN_B].data();
+		const float* maxB = sorted[MAX_B].data();
+		const float* minC = sorted[MIN_C].data();
+		const float* maxC = sorted[MAX_C].data();
+
+		const uint32_t lastB = grid.column(0, queryUpper[1]);
+		const uint32_t lastC = grid.column(1, queryUpper[2]);
+		for (uint32_t b = grid.column(0, queryLower[1]); b <= lastB; b++)
+		{
+			for (uint32_t c = grid.column(1, queryLower[2]); c <= lastC; c++)
+			{
+				// a column is sorted by lower bound, nothing starting further back than its longest interval reaches us
+				const uint32_t column = b * grid.count[1] + c;
+				const float* begin = minA + columnStart[column];
+				const float* end = minA + columnStart[column + 1] - Simd::MAX_LANES;
+				for (const float* it = std::lower_bound(begin, end, queryLower[0] - longest[column]); it != end && *it <= queryUpper[0]; ++it)
+				{
+					const size_t j = it - minA;
+					if (maxA[j] < queryLower[0] || minB[j] > queryUpper[1] || maxB[j] < queryLower[1] || minC[j] > queryUpper[2] || maxC[j] < queryLower[2]) { continue; }
+					// a body in several columns is reported by the one holding the lower corner of the overlap
+					if (grid.column(0, std::max(queryLower[1], minB[j])) != b || grid.column(1, std::max(queryLower[2], minC[j])) != c) { continue; }
+					onOverlap(sortedBody[j]);
+				}
+			}
+		}
+	}
+
+	void Broadphase::queryResting(const BodyStore& store)
+	{
+		const int axes[3] = { resting.axis, (resting.axis + 1) % 3, (resting.axis + 2) % 3 };
+		const float* position[3];
+		const float* extent[3];
+		for (int k = 0; k < 3; k++)
+		{
+			position[k] = store.array(static_cast<BodyStore::Component>(BodyStore::POS_X + axes[k]));
+			extent[k] = store.array(static_cast<BodyStore::Component>(BodyStore::EXTENT_X + axes[k]));
+		}
+		const float* invMass = store.array(BodyStore::INV_MASS);
+
+		for (uint32_t body : order)
+		{
+			float lower[3], upper[3];
+			for (int k = 0; k < 3; k++)
+			{
+				lower[k] = position[k][body] - extent[k][body];
+				upper[k] = position[k][body] + extent[k][body];
+			}
+			// awake indices are always below sleeping ones
+			const auto addPair = [&](uint32_t other)
+			{
+				if (invMass[body] > 0.f || invMass[other] > 0.f) { pairs.push_back(BodyPair{ body, other }); }
+			};
+			for (uint32_t other : restingOversized)
+			{
+				bool overlap = true;
+				for (int k = 0; k < 3; k++)
+				{
+					overlap = overlap && position[k][other] - extent[k][other] <= upper[k] && lower[k] <= position[k][other] + extent[k][other];
+				}
+				if (overlap) { addPair(other); }
+			}
+			if (!restingOrder.empty()) { resting.forEachOverlap(lower, upper, addPair); }
+		}
+	}
+
+	void Broadphase::query(const BodyStore& store, const Vec& lower, const Vec& upper, std::vector<uint32_t>& bodiesOut) const
+	{
+		const float lowerXYZ[3] = { lower.x, lower.y, lower.z };
+		const float upperXYZ[3] = { upper.x, upper.y, upper.z };
+		const auto search = [&](const Layer& layer)
+		{
+			float layerLower[3], layerUpper[3];
+			for (int k = 0; k < 3; k++)
+			{
+				layerLower[k] = lowerXYZ[(layer.axis + k) % 3];
+				layerUpper[k] = upperXYZ[(layer.axis + k) % 3];
+			}
+			layer.forEachOverlap(layerLower, layerUpper, [&bodiesOut](uint32_t body) { bodiesOut.push_back(body); });
+		};
+		if (!order.empty()) { search(active); }
+		if (!restingOrder.empty()) { search(resting); }
+		for (uint32_t body : restingOversized)
+		{
+			const Vec center = store.getVec(BodyStore::POS_X, body);
+			const Vec extent = store.getVec(BodyStore::EXTENT_X, body);
+			if (center.x - extent.x <= upper.x && lower.x <= center.x + extent.x && center.y - extent.y <= upper.y && lower.y <= center.y + extent.y
+				&& center.z - extent.z <= upper.z && lower.z <= center.z + extent.z) { bodiesOut.push_back(body); }
+		}
+	}
+
+}
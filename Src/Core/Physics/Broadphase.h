@@ -0,0 +1,115 @@
+#pragma once
+#include "Core/Physics/BodyStore.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Physics
+{
+	// two bodies whose bounds overlap, dense indices with a < b
+	struct BodyPair
+	{
+		uint32_t a;
+		uint32_t b;
+	};
+
+	/*	incremental sweep and prune over the body bounds (position +- collider extent)
+	*
+	*	bodies with a collider are kept sorted by their lower bound along one axis, between steps bodies move little,
+	*	so re-sorting the previous order with an insertion sort is close to linear, the sweep then only visits bodies
+	*	whose intervals overlap on that axis and tests the other two axes 4 (SSE) or 8 (AVX) candidates at a time
+	*
+	*	a single sweep degrades when many bodies share the same sweep interval (a dense 3D pile or a wide plane of bodies),
+	*	so the other two axes are split into a coarse grid of columns sized from the body extents, each column is swept
+	*	on its own, bodies straddling a column border are swept in every column they touch (the pair is only reported by
+	*	the column that holds the lower corner of the overlap)
+	*
+	*	the sweep axis follows the largest spread of body positions, the order is rebuilt from scratch when the axis
+	*	changes or bodies/colliders were added or removed (BodyStore::getRevision)
+	*
+	*	only awake bodies are swept every update, sleeping bodies do not move and live in a separate resting layer
+	*	with the same column layout, it is rebuilt only when a body falls asleep, wakes or is added/removed, each awake
+	*	body queries it for sleeping neighbours, pairs of two sleeping bodies are never reported */
+	class Broadphase
+	{
+	public:
+		struct Stats
+		{
+			uint32_t bodies = 0; // bodies with a collider
+			uint32_t restingBodies = 0; // of those asleep, in the resting layer
+			uint32_t pairs = 0;
+			uint32_t sortShifts = 0; // insertion sort moves, a measure of how much the order changed
+			uint32_t columns = 0; // of the awake sweep
+			uint32_t entries = 0; // awake bodies swept, counting every column a body touches
+			bool rebuilt = false; // full sort this update
+			bool restingRebuilt = false;
+		};
+
+		// finds all overlapping pairs, pairs where both bodies are immovable or both asleep are skipped
+		void update(const BodyStore& store);
+		void clear();
+
+		/*	appends the bodies with a collider whose bounds overlap lower..upper, as of the last update(),
+		*	for extra queries between update() calls (swept bounds of fast bodies) */
+		void query(const BodyStore& store, const Vec& lower, const Vec& upper, std::vector<uint32_t>& bodiesOut) const;
+
+		const std::vector<BodyPair>& getPairs() const { return pairs; }
+		const Stats& getStats() const { return stats; }
+		int getAxis() const { return axis; }
+
+	private:
+		// bounds in sweep order, A is the sweep axis, B and C the other two, padded with empty intervals
+		enum SortedComponent { MIN_A = 0, MAX_A, MIN_B, MAX_B, MIN_C, MAX_C, SORTED_COUNT };
+
+		struct Grid
+		{
+			float origin[2]; // axes B and C
+			float inverseWidth[2];
+			uint32_t count[2];
+			uint32_t column(int k, float v) const;
+		};
+
+		// bodies split into columns over axes B and C, each column sorted by lower bound on axis A
+		struct Layer
+		{
+			Grid grid{};
+			int axis = 0;
+			// per column the bodies in sweep order followed by Simd::MAX_LANES empty intervals
+			std::vector<float> sorted[SORTED_COUNT];
+			std::vector<uint32_t> sortedBody;
+			std::vector<uint32_t> columnStart; // columnCount + 1 offsets into sorted
+			std::vector<uint32_t> columnRanges; // first/last column on B and C per position in order
+			std::vector<uint32_t> columnCursor;
+			std::vector<float> longest; // per column the longest interval on axis A, bounds how far back a query looks
+			float lower[3], upper[3]; // bounds of all bodies, axes A, B, C
+
+			// order holds dense indices sorted by lower bound on axis
+			void build(const BodyStore& store, const std::vector<uint32_t>& order, int axis);
+			void clear();
+			uint32_t columnCount() const { return grid.count[0] * grid.count[1]; }
+			// calls onOverlap(dense index) once per body overlapping the bounds, given on axes A, B, C
+			template<typename OnOverlap>
+			void forEachOverlap(const float queryLower[3], const float queryUpper[3], OnOverlap&& onOverlap) const;
+		};
+
+		std::vector<uint32_t> order; // dense indices of awake bodies with a collider, sorted by lower bound on axis
+		std::vector<uint32_t> restingOrder; // same for sleeping bodies, sorted by lower bound on resting.axis
+		// sleeping bodies much longer than the rest on resting.axis (the ground), kept out of the layer, a single one
+		// in a column would make every query of that column scan back to its start
+		std::vector<uint32_t> restingOversized;
+		std::vector<float> keys; // lower bound on axis per dense index
+		Layer active;
+		Layer resting;
+		std::vector<BodyPair> pairs;
+		uint64_t revision = ~0ull;
+		int axis = 0;
+		Stats stats{};
+
+		static int selectAxis(const BodyStore& store, const std::vector<uint32_t>& bodies, int current);
+		void rebuildResting(const BodyStore& store);
+		void sortOrder(bool rebuild);
+		void sweep(const BodyStore& store);
+		void queryResting(const BodyStore& store);
+	};
+
+}
@@ -1,32 +1,33 @@
 #include "Core/Physics/Collision.h"
-#include "Core/Physics/Rigidbody.h"
+#include "Core/Physics/BodyStore.h"
 
 namespace Physics
 {
 
-	void Collision::resolve(float deltaTime) 
+	void Collision::resolve(BodyStore& store, float deltaTime) 
 	{ 
-		resolveVelocity(deltaTime);
-		resolvePenetration(deltaTime);
+		resolveVelocity(store, deltaTime);
+		resolvePenetration(store, deltaTime);
 	}
 
-	float Collision::getSeparatingVelocity() const
+	float Collision::getSeparatingVelocity(const BodyStore& store) const
 	{
-		Vec relativeVelocity = bodies[0]->getVelocity();
-		if (bodies[1]) relativeVelocity -= bodies[1]->getVelocity();
-		return (relativeVelocity * normal).getMagnitude(); // is magnitude correct to use here? if everything works, probably yes
+		Vec relativeVelocity = store.getVec(BodyStore::VEL_X, bodies[0]);
+		if (bodies[1] != NO_BODY) relativeVelocity -= store.getVec(BodyStore::VEL_X, bodies[1]);
+		return Vec::dot(relativeVelocity, normal);
 	}
 
-	void Collision::resolveVelocity(float deltaTime)
+	void Collision::resolveVelocity(BodyStore& store, float deltaTime)
 	{
-		float separatingVelocity = getSeparatingVelocity();
+		float separatingVelocity = getSeparatingVelocity(store);
 		if (separatingVelocity > 0) { return; }
 
 		float newSepVelocity = -separatingVelocity * restitution;
 		float deltaVelocity = newSepVelocity - separatingVelocity;
 
-		float totalInverseMass = bodies[0]->getMassInverse();
-		if (bodies[1]) { totalInverseMass += bodies[1]->getMassInverse(); }
+		const float inverseMass0 = store.getFloat(BodyStore::INV_MASS, bodies[0]);
+		const float inverseMass1 = bodies[1] != NO_BODY ? store.getFloat(BodyStore::INV_MASS, bodies[1]) : 0.f;
+		float totalInverseMass = inverseMass0 + inverseMass1;
 
 		if (totalInverseMass <= 0) return; // infinite mass
 
@@ -34,32 +35,33 @@ namespace Physics
 		Vec impulsePerInvMass = normal * impulse;
 
 		// apply impulses
-		bodies[0]->setVelocity(bodies[0]->getVelocity() + impulsePerInvMass * bodies[0]->getMassInverse());
-		if (bodies[1])
+		store.setVec(BodyStore::VEL_X, bodies[0], store.getVec(BodyStore::VEL_X, bodies[0]) + impulsePerInvMass * inverseMass0);
+		if (bodies[1] != NO_BODY)
 		{
-			bodies[1]->setVelocity(bodies[1]->getVelocity() + impulsePerInvMass * -bodies[1]->getMassInverse());
+			store.setVec(BodyStore::VEL_X, bodies[1], store.getVec(BodyStore::VEL_X, bodies[1]) + impulsePerInvMass * -inverseMass1);
 		}
 	}
 
-	void Collision::resolvePenetration(float deltaTime) 
+	void Collision::resolvePenetration(BodyStore& store, float deltaTime) 
 	{
 		if (penetrationDepth <= 0) return;
 
-		float totalInverseMass = bodies[0]->getMassInverse();
-		if (bodies[1]) { totalInverseMass += bodies[1]->getMassInverse(); }
+		const float inverseMass0 = store.getFloat(BodyStore::INV_MASS, bodies[0]);
+		const float inverseMass1 = bodies[1] != NO_BODY ? store.getFloat(BodyStore::INV_MASS, bodies[1]) : 0.f;
+		float totalInverseMass = inverseMass0 + inverseMass1;
 		
 		if (totalInverseMass <= 0) return; // infinite mass
 
-		Vec movePerInvMass = normal * (-penetrationDepth / totalInverseMass);
+		Vec movePerInvMass = normal * (penetrationDepth / totalInverseMass);
 		
-		// separate
-		bodies[0]->setPosition(bodies[0]->getPosition() + movePerInvMass * bodies[0]->getMassInverse());
-		if (bodies[1])
+		// separate, each body moves in proportion to its inverse mass, in opposite directions
+		store.setVec(BodyStore::POS_X, bodies[0], store.getVec(BodyStore::POS_X, bodies[0]) + movePerInvMass * inverseMass0);
+		if (bodies[1] != NO_BODY)
 		{
-			bodies[1]->setPosition(bodies[1]->getPosition() + movePerInvMass * bodies[1]->getMassInverse());
+			store.setVec(BodyStore::POS_X, bodies[1], store.getVec(BodyStore::POS_X, bodies[1]) - movePerInvMass * inverseMass1);
 		}
 	}
 
 
 
-}
\ No newline at end of file
+}
@@ -1,27 +1,33 @@
 #pragma once
 #include "Core/Types/CommonTypes.h"
 
-#include <memory>
+#include <stdint.h>
 #include <array>
 
 namespace Physics
 {
-	class Rigidbody;
+	class BodyStore;
 
 	class Collision
 	{
 	public:
-		std::array<std::shared_ptr<Rigidbody>, 2> bodies = { nullptr, nullptr };
-		float restitution;
-		Vec normal;
-		float penetrationDepth;
-	protected:
-		void resolve(float deltaTime);
-
-		float getSeparatingVelocity() const;
+		static constexpr uint32_t NO_BODY = 0xFFFFFFFF;
+
+		// dense indices into the scene's BodyStore (only valid for the step that produced the contact),
+		// bodies[1] is NO_BODY for a contact with immovable scenery
+		std::array<uint32_t, 2> bodies = { NO_BODY, NO_BODY };
+		float restitution = 0.f;
+		Vec normal{}; // unit length, points from bodies[1] towards bodies[0]
+		float penetrationDepth = 0.f;
+		float accumulatedImpulse = 0.f; // normal impulse, warm start value before ContactSolver::solve, the solved total after
+
+		void resolve(BodyStore& store, float deltaTime);
+
+		// relative velocity along the normal, negative while the bodies approach each other
+		float getSeparatingVelocity(const BodyStore& store) const;
 	private:
-		void resolveVelocity(float deltaTime);
-		void resolvePenetration(float deltaTime);
+		void resolveVelocity(BodyStore& store, float deltaTime);
+		void resolvePenetration(BodyStore& store, float deltaTime);
 
 	};
 
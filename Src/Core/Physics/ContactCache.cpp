@@ -0,0 +1,109 @@
+#include "Core/Physics/ContactCache.h"
+#include "Core/Physics/BodyStore.h"
+
+namespace Physics
+{
+	namespace
+	{
+		uint64_t mix(uint64_t v)
+		{
+			// splitmix64 finalizer
+			v ^= v >> 30; v *= 0xbf58476d1ce4e5b9ULL;
+			v ^= v >> 27; v *= 0x94d049bb133111ebULL;
+			v ^= v >> 31;
+			return v;
+		}
+	}
+
+	ContactCache::Entry ContactCache::makeEntry(const BodyStore& store, const Collision& contact) const
+	{
+		// a contact with scenery uses slot EMPTY for the missing body
+		const BodyHandle a = store.handleAt(contact.bodies[0]);
+		const BodyHandle b = contact.bodies[1] != Collision::NO_BODY ? store.handleAt(contact.bodies[1]) : BodyHandle{};
+		return Entry{ (static_cast<uint64_t>(a.slot) << 32) | b.slot, a.generation, b.generation, contact.normal, contact.accumulatedImpulse, 0 };
+	}
+
+	uint32_t ContactCache::find(const Entry& probe) const
+	{
+		if (table.empty()) { return EMPTY; }
+		const size_t mask = table.size() - 1;
+		for (size_t i = mix(probe.key) & mask; table[i] != EMPTY; i = (i + 1) & mask)
+		{
+			const Entry& e = entries[table[i]];
+			if (e.key == probe.key && e.generationA == probe.generationA && e.generationB == probe.generationB) { return table[i]; }
+		}
+		return EMPTY;
+	}
+
+	void ContactCache::rebuildTable()
+	{
+		size_t capacity = 16;
+		while (capacity < entries.size() * 2) { capacity *= 2; }
+		table.assign(capacity, EMPTY);
+		const size_t mask = capacity - 1;
+		for (uint32_t e = 0; e < entries.size(); e++)
+		{
+			size_t i = mix(entries[e].key) & mask;
+			while (table[i] != EMPTY) { i = (i + 1) & mask; }
+			table[i] = e;
+		}
+	}
+
+	void ContactCache::warmStart(const BodyStore& store, std::vector<Collision>& contacts)
+	{
+		stats = Stats{};
+		seen.assign(entries.size(), 0);
+		for (Collision& c : contacts)
+		{
+			c.accumulatedImpulse = 0.f;
+			if (!enabled) { continue; }
+
+			const uint32_t e = find(makeEntry(store, c));
+			if (e == EMPTY)
+			{
+				stats.misses++;
+				continue;
+			}
+			seen[e] = 1;
+			// a contact that turned too far is a different contact, its old impulse would push the wrong way
+			if (Vec::dot(entries[e].normal, c.normal) < normalTolerance) { continue; }
+			c.accumulatedImpulse = entries[e].impulse * warmStartFactor;
+			stats.hits++;
+		}
+	}
+
+	void ContactCache::update(const BodyStore& store, const std::vector<Collision>& contacts)
+	{
+		if (!enabled)
+		{
+			clear();
+			return;
+		}
+
+		// live contacts first, then the old entries that did not show up this step, one step older
+		nextEntries.clear();
+		for (const Collision& c : contacts) { nextEntries.push_back(makeEntry(store, c)); }
+		for (uint32_t e = 0; e < entries.size(); e++)
+		{
+			if (e < seen.size() && seen[e]) { continue; }
+			if (entries[e].age + 1 > maxAge)
+			{
+				stats.aged++;
+				continue;
+			}
+			nextEntries.push_back(entries[e]);
+			nextEntries.back().age++;
+		}
+		entries.swap(nextEntries);
+		rebuildTable();
+		stats.cached = static_cast<uint32_t>(entries.size());
+	}
+
+	void ContactCache::clear()
+	{
+		entries.clear();
+		table.clear();
+		seen.clear();
+	}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/Physics/Collision.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Physics
+{
+	class BodyStore;
+
+	/*	keeps the solved impulse of every contact from one step to the next, keyed by body pair
+	*
+	*	before solving, contacts that existed last step start from their previous impulse (warm starting), a resting stack
+	*	then begins each step close to the answer and the solver converges in a pass or two instead of building the
+	*	impulses up from zero, pairs are identified by their handle slots and generations, so they survive the dense
+	*	index shuffling of body removal and a reused slot never inherits an old impulse
+	*
+	*	contacts that disappear are kept for a few steps (contacts on the edge of the slop flicker), then aged out,
+	*	the table is rebuilt every step from the live contacts, so it never accumulates tombstones */
+	class ContactCache
+	{
+	public:
+		struct Stats
+		{
+			uint32_t hits = 0; // contacts warm started this step
+			uint32_t misses = 0; // new contacts
+			uint32_t cached = 0; // entries kept for the next step
+			uint32_t aged = 0; // entries dropped this step
+		};
+
+		bool enabled = true;
+		float warmStartFactor = 1.f; // fraction of the cached impulse applied up front
+		uint32_t maxAge = 3; // steps an entry survives without its contact
+		float normalTolerance = .95f; // cos of the angle the normal may turn and still be warm started
+
+		// sets accumulatedImpulse of every contact, from the cache or 0
+		void warmStart(const BodyStore& store, std::vector<Collision>& contacts);
+		// stores the solved impulses, ages and drops entries whose contact is gone
+		void update(const BodyStore& store, const std::vector<Collision>& contacts);
+		void clear();
+
+		const Stats& getStats() const { return stats; }
+		size_t size() const { return entries.size(); }
+
+	private:
+		struct Entry
+		{
+			uint64_t key; // (slot a << 32) | slot b
+			uint32_t generationA, generationB;
+			Vec normal;
+			float impulse;
+			uint32_t age; // steps since the contact was last seen
+		};
+
+		static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+
+		std::vector<Entry> entries;
+		std::vector<uint32_t> table; // open addressing (linear probing) into entries, power of two size
+		std::vector<Entry> nextEntries;
+		std::vector<uint8_t> seen; // per entry, found by warmStart this step
+		Stats stats{};
+
+		Entry makeEntry(const BodyStore& store, const Collision& contact) const;
+		uint32_t find(const Entry& probe) const;
+		void rebuildTable();
+	};
+
+}
@@ -0,0 +1,238 @@
+#include "Core/Physics/ContactSolver.h"
+#include "Core/Physics/BodyStore.h"
+#include "Core/Types/TaskPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Physics
+{
+	namespace
+	{
+		// islands are packed into tasks of at least this many contacts, single small islands are not worth a task
+		constexpr uint32_t TASK_GRAIN = 256;
+		constexpr uint32_t NO_ISLAND = 0xFFFFFFFF;
+
+		double millisecondsSince(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	uint32_t ContactSolver::findRoot(uint32_t body)
+	{
+		// path halving
+		while (parent[body] != body)
+		{
+			parent[body] = parent[parent[body]];
+			body = parent[body];
+		}
+		return body;
+	}
+
+	void ContactSolver::buildIslands(const BodyStore& store, const std::vector<Collision>& contacts)
+	{
+		const float* inverseMass = store.array(BodyStore::INV_MASS);
+		const auto movable = [inverseMass](uint32_t body) { return body != Collision::NO_BODY && inverseMass[body] > 0.f; };
+
+		parent.resize(store.size());
+		for (uint32_t i = 0; i < parent.size(); i++) { parent[i] = i; }
+		for (const Collision& c : contacts)
+		{
+			if (!movable(c.bodies[0]) || !movable(c.bodies[1])) { continue; }
+			const uint32_t rootA = findRoot(c.bodies[0]);
+			const uint32_t rootB = findRoot(c.bodies[1]);
+			// the smaller index becomes the root, island roots do not depend on the contact order
+			if (rootA < rootB) { parent[rootB] = rootA; }
+			else { parent[rootA] = rootB; }
+		}
+
+		// count the contacts of every island, then place them grouped by island
+		islands.clear();
+		islandOfRoot.assign(store.size(), NO_ISLAND);
+		contactIsland.assign(contacts.size(), NO_ISLAND);
+		for (uint32_t i = 0; i < contacts.size(); i++)
+		{
+			const Collision& c = contacts[i];
+			const uint32_t body = movable(c.bodies[0]) ? c.bodies[0] : (movable(c.bodies[1]) ? c.bodies[1] : Collision::NO_BODY);
+			if (body == Collision::NO_BODY) { continue; } // nothing to move
+			const uint32_t root = findRoot(body);
+			if (islandOfRoot[root] == NO_ISLAND)
+			{
+				islandOfRoot[root] = static_cast<uint32_t>(islands.size());
+				islands.push_back(Island{ 0, 0, 0 });
+			}
+			contactIsland[i] = islandOfRoot[root];
+			islands[contactIsland[i]].end++; // count for now
+		}
+		uint32_t offset = 0;
+		for (Island& island : islands)
+		{
+			island.begin = offset;
+			offset += island.end;
+			island.end = island.begin;
+		}
+
+		const float* position[3] = { store.array(BodyStore::POS_X), store.array(BodyStore::POS_Y), store.array(BodyStore::POS_Z) };
+		const auto positionOf = [&position](uint32_t body) { return Vec{ position[0][body], position[1][body], position[2][body] }; };
+		solverContacts.resize(offset);
+		for (uint32_t i = 0; i < contacts.size(); i++)
+		{
+			if (contactIsland[i] == NO_ISLAND) { continue; }
+			const Collision& c = contacts[i];
+			SolverContact& s = solverContacts[islands[contactIsland[i]].end++];
+			s.a = movable(c.bodies[0]) ? c.bodies[0] : Collision::NO_BODY;
+			s.b = movable(c.bodies[1]) ? c.bodies[1] : Collision::NO_BODY;
+			s.inverseMassA = s.a != Collision::NO_BODY ? inverseMass[s.a] : 0.f;
+			s.inverseMassB = s.b != Collision::NO_BODY ? inverseMass[s.b] : 0.f;
+			s.normal = c.normal;
+			s.targetVelocity = c.restitution; // resolved to a velocity in solveIsland
+			s.impulse = c.accumulatedImpulse; // warm start, 0 without a ContactCache
+			s.depth = c.penetrationDepth;
+			s.startA = s.a != Collision::NO_BODY ? positionOf(s.a) : Vec::zero();
+			s.startB = s.b != Collision::NO_BODY ? positionOf(s.b) : Vec::zero();
+			s.source = i;
+		}
+
+		if (settings.deterministic)
+		{
+			for (const Island& island : islands)
+			{
+				std::sort(solverContacts.begin() + island.begin, solverContacts.begin() + island.end, [&contacts](const SolverContact& x, const SolverContact& y)
+				{
+					const Collision& cx = contacts[x.source];
+					const Collision& cy = contacts[y.source];
+					return cx.bodies[0] != cy.bodies[0] ? cx.bodies[0] < cy.bodies[0] : cx.bodies[1] < cy.bodies[1];
+				});
+			}
+		}
+
+		// largest islands first so they start early, then packed into tasks of roughly TASK_GRAIN contacts
+		taskIslands.resize(islands.size());
+		for (uint32_t i = 0; i < islands.size(); i++) { taskIslands[i] = i; }
+		std::sort(taskIslands.begin(), taskIslands.end(), [this](uint32_t x, uint32_t y)
+		{
+			const uint32_t sizeX = islands[x].end - islands[x].begin;
+			const uint32_t sizeY = islands[y].end - islands[y].begin;
+			return sizeX != sizeY ? sizeX > sizeY : x < y;
+		});
+		taskStart.clear();
+		uint32_t taskContacts = TASK_GRAIN;
+		for (uint32_t i = 0; i < taskIslands.size(); i++)
+		{
+			if (taskContacts >= TASK_GRAIN)
+			{
+				taskStart.push_back(i);
+				taskContacts = 0;
+			}
+			taskContacts += islands[taskIslands[i]].end - islands[taskIslands[i]].begin;
+		}
+		taskStart.push_back(static_cast<uint32_t>(taskIslands.size()));
+	}
+
+	void ContactSolver::solveIsland(BodyStore& store, Island& island)
+	{
+		float* velocity[3] = { store.array(BodyStore::VEL_X), store.array(BodyStore::VEL_Y), store.array(BodyStore::VEL_Z) };
+		float* position[3] = { store.array(BodyStore::POS_X), store.array(BodyStore::POS_Y), store.array(BodyStore::POS_Z) };
+		const auto read = [](float* const* v, uint32_t body) { return body != Collision::NO_BODY ? Vec{ v[0][body], v[1][body], v[2][body] } : Vec::zero(); };
+		const auto add = [](float* const* v, uint32_t body, const Vec& d)
+		{
+			if (body == Collision::NO_BODY) { return; }
+			v[0][body] += d.x;
+			v[1][body] += d.y;
+			v[2][body] += d.z;
+		};
+		SolverContact* begin = solverContacts.data() + island.begin;
+		SolverContact* end = solverContacts.data() + island.end;
+
+		// bounce velocity from the approach speed before solving
+		for (SolverContact* c = begin; c != end; c++)
+		{
+			const float approach = Vec::dot(read(velocity, c->a) - read(velocity, c->b), c->normal);
+			c->targetVelocity = approach < -settings.restitutionThreshold ? -approach * c->targetVelocity : 0.f;
+		}
+
+		// warm start, apply the impulses carried over from the last step before iterating
+		for (SolverContact* c = begin; c != end; c++)
+		{
+			if (c->impulse == 0.f) { continue; }
+			add(velocity, c->a, c->normal * (c->impulse * c->inverseMassA));
+			add(velocity, c->b, c->normal * (-c->impulse * c->inverseMassB));
+		}
+
+		island.iterations = 0;
+		while (island.iterations < settings.velocityIterations)
+		{
+			island.iterations++;
+			float largestChange = 0.f;
+			for (SolverContact* c = begin; c != end; c++)
+			{
+				const float totalInverseMass = c->inverseMassA + c->inverseMassB;
+				const float separating = Vec::dot(read(velocity, c->a) - read(velocity, c->b), c->normal);
+				// the accumulated impulse may only push, clamping the total (not each change) lets later passes correct earlier ones
+				const float impulse = std::max(c->impulse - (separating - c->targetVelocity) / totalInverseMass, 0.f);
+				const float change = impulse - c->impulse;
+				c->impulse = impulse;
+				add(velocity, c->a, c->normal * (change * c->inverseMassA));
+				add(velocity, c->b, c->normal * (-change * c->inverseMassB));
+				largestChange = std::max(largestChange, std::abs(change));
+			}
+			if (largestChange <= settings.convergenceTolerance) { break; }
+		}
+
+		for (uint32_t pass = 0; pass < settings.positionIterations; pass++)
+		{
+			for (SolverContact* c = begin; c != end; c++)
+			{
+				// overlap left after the corrections so far
+				const Vec movedA = read(position, c->a) - c->startA;
+				const Vec movedB = read(position, c->b) - c->startB;
+				const float remaining = c->depth - Vec::dot(movedA - movedB, c->normal) - settings.penetrationSlop;
+				if (remaining <= 0.f) { continue; }
+
+				const float move = remaining * settings.positionCorrection / (c->inverseMassA + c->inverseMassB);
+				add(position, c->a, c->normal * (move * c->inverseMassA));
+				add(position, c->b, c->normal * (-move * c->inverseMassB));
+			}
+		}
+	}
+
+	void ContactSolver::solve(BodyStore& store, std::vector<Collision>& contacts)
+	{
+		stats = Stats{};
+		stats.contacts = static_cast<uint32_t>(contacts.size());
+		if (contacts.empty()) { return; }
+
+		auto start = std::chrono::steady_clock::now();
+		buildIslands(store, contacts);
+		stats.buildMs = millisecondsSince(start);
+
+		start = std::chrono::steady_clock::now();
+		const auto runTask = [this, &store](uint32_t task)
+		{
+			for (uint32_t i = taskStart[task]; i < taskStart[task + 1]; i++) { solveIsland(store, islands[taskIslands[i]]); }
+		};
+		const uint32_t taskCount = static_cast<uint32_t>(taskStart.size() - 1);
+		if (pool) { pool->parallelFor(taskCount, runTask); }
+		else
+		{
+			for (uint32_t t = 0; t < taskCount; t++) { runTask(t); }
+		}
+		stats.solveMs = millisecondsSince(start);
+
+		uint64_t weightedIterations = 0;
+		for (const Island& island : islands)
+		{
+			const uint32_t size = island.end - island.begin;
+			stats.largestIsland = std::max(stats.largestIsland, size);
+			stats.maxIterations = std::max(stats.maxIterations, island.iterations);
+			weightedIterations += static_cast<uint64_t>(island.iterations) * size;
+		}
+		for (const SolverContact& c : solverContacts) { contacts[c.source].accumulatedImpulse = c.impulse; }
+		stats.islands = static_cast<uint32_t>(islands.size());
+		stats.tasks = taskCount;
+		stats.averageIterations = solverContacts.empty() ? 0.f : static_cast<float>(weightedIterations) / solverContacts.size();
+	}
+
+}
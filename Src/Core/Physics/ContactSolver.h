@@ -0,0 +1,94 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/Physics/Collision.h"
+
+#include <stdint.h>
+#include <vector>
+
+class TaskPool;
+
+namespace Physics
+{
+	class BodyStore;
+
+	/*	sequential impulse solver for a step's contacts
+	*
+	*	contacts are split into islands, groups of bodies connected through contacts (union-find over dense body indices,
+	*	immovable bodies do not connect anything, otherwise the ground would merge everything into one island),
+	*	islands share no movable body, so they are solved in parallel on a TaskPool without any locking
+	*
+	*	each island runs up to velocityIterations passes of accumulated, clamped normal impulses and stops early once
+	*	no impulse changes by more than convergenceTolerance, then positionIterations passes push overlapping bodies apart
+	*
+	*	the outcome of an island depends on the order of its contacts, in deterministic mode they are sorted by body pair,
+	*	so results do not depend on the order the broadphase happened to report them in */
+	class ContactSolver
+	{
+	public:
+		struct Settings
+		{
+			uint32_t velocityIterations = 10; // per island, at most
+			uint32_t positionIterations = 4;
+			float convergenceTolerance = 1e-4f; // impulse change (N*s) below which an island counts as converged
+			float restitutionThreshold = .5f; // slower impacts (m/s) do not bounce, keeps resting contacts calm
+			float penetrationSlop = .005f; // overlap left in place, keeps contacts alive between steps
+			float positionCorrection = .8f; // fraction of the remaining overlap removed per position pass
+			bool deterministic = false;
+		};
+
+		struct Stats
+		{
+			uint32_t contacts = 0;
+			uint32_t islands = 0;
+			uint32_t largestIsland = 0; // contacts
+			uint32_t tasks = 0;
+			uint32_t maxIterations = 0; // velocity passes of the slowest island
+			float averageIterations = 0.f; // weighted by contacts
+			double buildMs = 0.0; // island construction
+			double solveMs = 0.0;
+		};
+
+		// without a pool every island is solved on the calling thread
+		explicit ContactSolver(TaskPool* pool = nullptr) : pool{ pool } {}
+
+		/*	applies impulses and position corrections to the bodies, accumulatedImpulse of each contact is the starting impulse
+		*	(see ContactCache) and receives the solved impulse */
+		void solve(BodyStore& store, std::vector<Collision>& contacts);
+
+		Settings settings;
+		const Stats& getStats() const { return stats; }
+
+	private:
+		struct SolverContact
+		{
+			uint32_t a, b; // NO_BODY for immovable bodies, they are never written
+			float inverseMassA, inverseMassB;
+			Vec normal;
+			float targetVelocity; // separating velocity after the impact
+			float impulse;
+			float depth;
+			Vec startA, startB; // positions before solving, for the remaining penetration
+			uint32_t source; // index into the contacts passed to solve()
+		};
+		struct Island
+		{
+			uint32_t begin, end; // range in solverContacts
+			uint32_t iterations;
+		};
+
+		void buildIslands(const BodyStore& store, const std::vector<Collision>& contacts);
+		void solveIsland(BodyStore& store, Island& island);
+		uint32_t findRoot(uint32_t body);
+
+		TaskPool* pool;
+		std::vector<uint32_t> parent; // union-find over dense body indices
+		std::vector<uint32_t> islandOfRoot;
+		std::vector<uint32_t> contactIsland;
+		std::vector<SolverContact> solverContacts; // grouped by island
+		std::vector<Island> islands;
+		std::vector<uint32_t> taskIslands; // island indices, grouped by task
+		std::vector<uint32_t> taskStart;
+		Stats stats{};
+	};
+
+}
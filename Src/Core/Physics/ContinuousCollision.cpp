@@ -0,0 +1,160 @@
+#include "Core/Physics/ContinuousCollision.h"
+#include "Core/Physics/Collision.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Physics
+{
+	namespace
+	{
+		bool pairLess(const BodyPair& x, const BodyPair& y) { return x.a != y.a ? x.a < y.a : x.b < y.b; }
+	}
+
+	void ContinuousCollision::begin(const BodyStore& store, float deltaTime)
+	{
+		stats = Stats{};
+		movers.clear();
+		if (!settings.enabled) { return; }
+
+		const Collider::Type* types = store.colliderTypes();
+		const uint8_t* flags = store.continuousFlags();
+		const float* inverseMass = store.array(BodyStore::INV_MASS);
+		const size_t awake = store.getAwakeCount();
+		for (uint32_t i = 0; i < awake; i++)
+		{
+			// immovable bodies are moved by the game, they push through whatever is in the way
+			if (types[i] == Collider::NONE || inverseMass[i] <= 0.f) { continue; }
+
+			// integrate() moves the body by exactly its current velocity * deltaTime
+			const Vec displacement = store.getVec(BodyStore::VEL_X, i) * deltaTime;
+			const Vec extent = store.getVec(BodyStore::EXTENT_X, i);
+			const float smallest = std::min(extent.x, std::min(extent.y, extent.z));
+			if (flags[i] || (settings.automatic && Vec::dot(displacement, displacement) > smallest * smallest))
+			{
+				movers.push_back(Mover{ i, store.getVec(BodyStore::POS_X, i), displacement });
+			}
+		}
+	}
+
+	void ContinuousCollision::resolve(BodyStore& store, const Broadphase& broadphase, std::vector<BodyPair>& pairsOut)
+	{
+		stats.movers = static_cast<uint32_t>(movers.size());
+		if (movers.empty()) { return; }
+
+		const Collider::Type* types = store.colliderTypes();
+		moverOf.resize(store.size(), NOT_MOVING);
+		for (uint32_t k = 0; k < movers.size(); k++) { moverOf[movers[k].body] = k; }
+
+		hits.clear();
+		for (const Mover& mover : movers)
+		{
+			const Vec end = mover.start + mover.displacement;
+			const Vec extent = store.getVec(BodyStore::EXTENT_X, mover.body);
+			const Vec lower{ std::min(mover.start.x, end.x) - extent.x, std::min(mover.start.y, end.y) - extent.y, std::min(mover.start.z, end.z) - extent.z };
+			const Vec upper{ std::max(mover.start.x, end.x) + extent.x, std::max(mover.start.y, end.y) + extent.y, std::max(mover.start.z, end.z) + extent.z };
+			candidates.clear();
+			broadphase.query(store, lower, upper, candidates);
+			stats.candidates += static_cast<uint32_t>(candidates.size());
+
+			float first = 1.f;
+			uint32_t hit = Collision::NO_BODY;
+			for (uint32_t other : candidates)
+			{
+				if (other == mover.body) { continue; }
+				Vec otherStart = store.getVec(BodyStore::POS_X, other);
+				Vec otherDisplacement = Vec::zero();
+				if (moverOf[other] != NOT_MOVING)
+				{
+					otherStart = movers[moverOf[other]].start;
+					otherDisplacement = movers[moverOf[other]].displacement;
+				}
+
+				// relative to the other body, close to the origin, which also keeps precision far from the world origin
+				const Vec relativeStart = mover.start - otherStart;
+				const Vec relativeDisplacement = mover.displacement - otherDisplacement;
+				const Vec otherExtent = store.getVec(BodyStore::EXTENT_X, other);
+				float time;
+				const bool touches = types[mover.body] == Collider::SPHERE && types[other] == Collider::SPHERE
+					? sweepSphereSphere(relativeStart, relativeDisplacement, extent.x + otherExtent.x, time)
+					: sweepBox(relativeStart, relativeDisplacement, extent + otherExtent, time);
+				if (touches && time < first)
+				{
+					first = time;
+					hit = other;
+				}
+			}
+			if (hit == Collision::NO_BODY) { continue; }
+
+			const float length = std::sqrt(Vec::dot(mover.displacement, mover.displacement));
+			const float time = std::min(1.f, first + settings.contactSkin / length);
+			store.setVec(BodyStore::POS_X, mover.body, mover.start + mover.displacement * time);
+			hits.push_back(mover.body < hit ? BodyPair{ mover.body, hit } : BodyPair{ hit, mover.body });
+		}
+		for (const Mover& mover : movers) { moverOf[mover.body] = NOT_MOVING; }
+		stats.hits = static_cast<uint32_t>(hits.size());
+		if (hits.empty()) { return; }
+
+		// two fast bodies hitting each other report the pair twice, and a pair still overlapping at the end of the step
+		// is already in the broadphase pairs, a duplicate would be solved twice
+		std::sort(hits.begin(), hits.end(), pairLess);
+		hits.erase(std::unique(hits.begin(), hits.end(), [](const BodyPair& x, const BodyPair& y) { return x.a == y.a && x.b == y.b; }), hits.end());
+		for (const BodyPair& pair : broadphase.getPairs())
+		{
+			const auto found = std::lower_bound(hits.begin(), hits.end(), pair, pairLess);
+			if (found != hits.end() && found->a == pair.a && found->b == pair.b) { found->a = found->b = Collision::NO_BODY; }
+		}
+		for (const BodyPair& pair : hits)
+		{
+			if (pair.a != Collision::NO_BODY) { pairsOut.push_back(pair); }
+		}
+	}
+
+	bool ContinuousCollision::sweepSphereSphere(const Vec& relativeStart, const Vec& displacement, float radii, float& timeOut)
+	{
+		// |start + t * displacement| = radii
+		const float c = Vec::dot(relativeStart, relativeStart) - radii * radii;
+		if (c <= 0.f) { return false; }
+		const float b = Vec::dot(relativeStart, displacement);
+		if (b >= 0.f) { return false; } // moving apart
+		const float a = Vec::dot(displacement, displacement);
+		const float discriminant = b * b - a * c;
+		if (discriminant < 0.f) { return false; }
+
+		const float time = (-b - std::sqrt(discriminant)) / a;
+		if (time > 1.f) { return false; }
+		timeOut = time;
+		return true;
+	}
+
+	bool ContinuousCollision::sweepBox(const Vec& relativeStart, const Vec& displacement, const Vec& halfExtents, float& timeOut)
+	{
+		// slabs of the Minkowski box, the segment enters the box at the latest entry and leaves at the earliest exit
+		const float start[3] = { relativeStart.x, relativeStart.y, relativeStart.z };
+		const float direction[3] = { displacement.x, displacement.y, displacement.z };
+		const float half[3] = { halfExtents.x, halfExtents.y, halfExtents.z };
+		float entry = 0.f;
+		float exit = 1.f;
+		bool inside = true;
+		for (int k = 0; k < 3; k++)
+		{
+			const bool outside = std::abs(start[k]) > half[k];
+			inside = inside && !outside;
+			if (std::abs(direction[k]) < EPSILON_F)
+			{
+				if (outside) { return false; }
+				continue;
+			}
+			const float inverse = 1.f / direction[k];
+			const float t1 = (-half[k] - start[k]) * inverse;
+			const float t2 = (half[k] - start[k]) * inverse;
+			entry = std::max(entry, std::min(t1, t2));
+			exit = std::min(exit, std::max(t1, t2));
+			if (entry > exit) { return false; }
+		}
+		if (inside) { return false; }
+		timeOut = entry;
+		return true;
+	}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/Physics/BodyStore.h"
+#include "Core/Physics/Broadphase.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Physics
+{
+	/*	continuous collision for fast bodies, a body moving further than its smallest half extent in one step can pass
+	*	through thin geometry without ever overlapping it at the end of a step, so discrete contacts never see it
+	*
+	*	before integration the fast bodies (and the ones flagged with BodyStore::setContinuous) record their start and
+	*	displacement, after the broadphase update each one queries the broadphase with its swept bounds and sweeps
+	*	against the candidates, a sphere as a swept sphere, a box as a swept box (Minkowski sum of the two boxes), a
+	*	sphere against a box uses the box grown by the radius, which is exact except near its edges where it is early
+	*
+	*	a body that hits something is moved back to its first time of impact, plus a little into the contact so the
+	*	narrowphase generates it, the solver then removes the approaching velocity as for any other contact, the
+	*	cost is one broadphase query and a few sweeps per fast body, slow bodies only pay for the speed check
+	*
+	*	the other body is swept too if it is fast, otherwise taken at its end of step position */
+	class ContinuousCollision
+	{
+	public:
+		struct Settings
+		{
+			bool enabled = true;
+			bool automatic = true; // sweep any body moving further than its smallest half extent in a step
+			float contactSkin = .002f; // how far past the time of impact a body is placed, below the solver's slop
+		};
+
+		struct Stats
+		{
+			uint32_t movers = 0; // bodies swept this step
+			uint32_t candidates = 0; // broadphase results over all sweeps
+			uint32_t hits = 0; // bodies moved back to an impact
+		};
+
+		// records the fast bodies, before the step's integration
+		void begin(const BodyStore& store, float deltaTime);
+		/*	after the broadphase update, moves bodies back to their first impact and appends those pairs to pairsOut
+		*	unless the broadphase already reported them */
+		void resolve(BodyStore& store, const Broadphase& broadphase, std::vector<BodyPair>& pairsOut);
+
+		Settings settings;
+		const Stats& getStats() const { return stats; }
+
+		/*	fraction of the displacement (0..1) at which a body starting at relativeStart (its center minus the other body's
+		*	center) first touches the other body, the displacement is relative too, false when it does not touch within
+		*	the step or already overlaps at the start (the discrete contact handles that) */
+		static bool sweepSphereSphere(const Vec& relativeStart, const Vec& displacement, float radii, float& timeOut);
+		// halfExtents are those of the Minkowski sum, the sum of both bodies' half extents
+		static bool sweepBox(const Vec& relativeStart, const Vec& displacement, const Vec& halfExtents, float& timeOut);
+
+	private:
+		struct Mover
+		{
+			uint32_t body;
+			Vec start;
+			Vec displacement;
+		};
+
+		static constexpr uint32_t NOT_MOVING = 0xFFFFFFFF;
+
+		std::vector<Mover> movers;
+		std::vector<uint32_t> moverOf; // per dense index, its mover or NOT_MOVING
+		std::vector<uint32_t> candidates;
+		std::vector<BodyPair> hits;
+		Stats stats{};
+	};
+
+}
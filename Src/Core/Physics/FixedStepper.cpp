@@ -0,0 +1,64 @@
+#include "Core/Physics/FixedStepper.h"
+#include "Core/Physics/PhysicsScene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Physics
+{
+	namespace
+	{
+		// weight of the latest step in the moving average of the step cost
+		constexpr double STEP_COST_SMOOTHING = .1;
+	}
+
+	FixedStepper::FixedStepper(PhysicsScene& scene) : scene{ scene } {}
+
+	FixedStepper::FixedStepper(PhysicsScene& scene, const Settings& settings) : settings{ settings }, scene{ scene } {}
+
+	void FixedStepper::advance(double frameDelta)
+	{
+		const double step = settings.stepSize;
+		accumulator += std::clamp(frameDelta, 0.0, settings.maxFrameDelta);
+
+		// steps this frame may take, from what is owed, the hard limit and the CPU budget
+		uint32_t steps = static_cast<uint32_t>(accumulator / step);
+		steps = std::min(steps, settings.maxSubsteps);
+		if (stats.averageStepMs > 0.0)
+		{
+			const uint32_t affordable = static_cast<uint32_t>(settings.budgetMs / stats.averageStepMs);
+			steps = std::min(steps, std::max(affordable, 1u));
+		}
+
+		stats.steps = steps;
+		stats.simMs = 0.0;
+		for (uint32_t i = 0; i < steps; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			scene.getBodyStore().storePreviousPositions();
+			scene.simulate(settings.stepSize);
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			stats.simMs += ms;
+			stats.averageStepMs = stats.averageStepMs > 0.0 ? stats.averageStepMs + (ms - stats.averageStepMs) * STEP_COST_SMOOTHING : ms;
+			accumulator -= step;
+		}
+
+		// the guard kicked in, whatever is still owed beyond one step is dropped instead of carried into the next frame
+		stats.droppedTime = 0.0;
+		if (accumulator >= step)
+		{
+			stats.droppedTime = accumulator - std::fmod(accumulator, step);
+			stats.totalDroppedTime += stats.droppedTime;
+			accumulator -= stats.droppedTime;
+		}
+		stats.alpha = static_cast<float>(accumulator / step);
+	}
+
+	Vec FixedStepper::getRenderPosition(BodyHandle body) const
+	{
+		return scene.getBodyStore().getInterpolatedPosition(body, stats.alpha);
+	}
+
+}
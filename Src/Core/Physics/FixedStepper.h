@@ -0,0 +1,60 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/Physics/BodyStore.h"
+
+#include <stdint.h>
+
+namespace Physics
+{
+	class PhysicsScene;
+
+	/*	drives PhysicsScene::simulate with a fixed step size, independent of the frame rate
+	*
+	*	frame time is collected in an accumulator and consumed in whole steps, the remainder (less than one step) is
+	*	expressed as an interpolation alpha, so rendering shows the bodies between their previous and current state
+	*
+	*	spiral of death guard: when simulating costs more than the frame budget, fewer steps run per frame
+	*	(never less than one) and the time that could not be simulated is dropped, the simulation then runs
+	*	slower than real time instead of falling further behind every frame */
+	class FixedStepper
+	{
+	public:
+		struct Settings
+		{
+			float stepSize = 1.f / 60.f;
+			uint32_t maxSubsteps = 4; // steps per frame at most
+			double maxFrameDelta = .25; // longer frames (breakpoints, hitches) are cut to this
+			double budgetMs = 8.0; // CPU time per frame the steps may take, estimated from recent step cost
+		};
+
+		struct Stats
+		{
+			uint32_t steps = 0; // steps run this frame
+			double simMs = 0.0; // time spent simulating this frame
+			double droppedTime = 0.0; // simulation seconds skipped this frame
+			double totalDroppedTime = 0.0;
+			double averageStepMs = 0.0; // moving average of the cost of a single step
+			float alpha = 0.f;
+		};
+
+		FixedStepper(PhysicsScene& scene);
+		FixedStepper(PhysicsScene& scene, const Settings& settings);
+
+		// consumes frameDelta seconds of simulation time, runs zero or more steps
+		void advance(double frameDelta);
+
+		// fraction of a step the render time is past the last step (0..1)
+		float getAlpha() const { return stats.alpha; }
+		// body position to draw this frame
+		Vec getRenderPosition(BodyHandle body) const;
+
+		Settings settings;
+		const Stats& getStats() const { return stats; }
+
+	private:
+		PhysicsScene& scene;
+		double accumulator = 0.0;
+		Stats stats{};
+	};
+
+}
@@ -1,6 +1,8 @@
 #include "Core/Physics/ForceGenerator.h"
 #include "Core/Physics/Rigidbody.h"
 
+#include <cmath>
+
 namespace Physics
 {
 
@@ -17,12 +19,11 @@ namespace Physics
 	{
 		Vec f = body.getPosition();
 		f -= other->getPosition();
-		float magnitude = f.getMagnitude();
-		magnitude = std::abs(magnitude - restLength);
-		magnitude *= springConstant;
+		const float length = std::sqrt(Vec::dot(f, f));
+		if (length < EPSILON_F) { return; } // direction undefined
 
-		f.normalize();
-		f *= -magnitude;
+		// hooke, pulls when stretched and pushes when compressed, the axis is scaled once instead of normalized
+		f *= -springConstant * (length - restLength) / length;
 		body.applyForce(f);
 	}
 
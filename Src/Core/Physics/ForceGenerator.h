@@ -6,6 +6,7 @@ namespace Physics
 {
 	class Rigidbody;
 
+	// polymorphic generator for custom forces, the common kinds (springs, gravity, drag) belong in ForcePools
 	class ForceGenerator 
 	{
 	public:
@@ -0,0 +1,287 @@
+#include "Core/Physics/ForcePools.h"
+#include "Core/Types/SimdLanes.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Physics
+{
+	namespace
+	{
+		size_t paddedSize(size_t n) { return (n + Simd::MAX_LANES - 1) / Simd::MAX_LANES * Simd::MAX_LANES; }
+
+		// moves entry `from` to `to` in every listed array, used to compact pools after bodies were destroyed
+		template<typename... Arrays>
+		void moveEntry(size_t from, size_t to, Arrays&... arrays) { ((arrays[to] = arrays[from]), ...); }
+
+		// spring length below which the direction is undefined and no force is applied
+		constexpr float MIN_SPRING_LENGTH = 1e-6f;
+	}
+
+	// springs
+
+	void SpringPool::add(BodyHandle a, BodyHandle b, float restLengthIn, float stiffnessIn, float dampingIn)
+	{
+		handleA.push_back(a);
+		handleB.push_back(b);
+		indexA.push_back(0);
+		indexB.push_back(0);
+		restLength.resize(count);
+		stiffness.resize(count);
+		damping.resize(count);
+		restLength.push_back(restLengthIn);
+		stiffness.push_back(stiffnessIn);
+		damping.push_back(dampingIn);
+		count++;
+		revision = ~0ull; // look the indices up on the next apply
+	}
+
+	void SpringPool::clear()
+	{
+		handleA.clear(); handleB.clear();
+		indexA.clear(); indexB.clear();
+		restLength.clear(); stiffness.clear(); damping.clear();
+		count = 0;
+	}
+
+	void SpringPool::refresh(const BodyStore& store)
+	{
+		revision = store.getRevision();
+		size_t kept = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!store.isAlive(handleA[i]) || !store.isAlive(handleB[i])) { continue; }
+			moveEntry(i, kept, handleA, handleB, restLength, stiffness, damping);
+			indexA[kept] = store.indexOf(handleA[kept]);
+			indexB[kept] = store.indexOf(handleB[kept]);
+			kept++;
+		}
+		count = kept;
+		handleA.resize(count); handleB.resize(count);
+		indexA.resize(count); indexB.resize(count);
+
+		// the parameter arrays are padded with zero springs, which produce no force
+		for (auto* a : { &restLength, &stiffness, &damping })
+		{
+			a->resize(count);
+			a->resize(paddedSize(count), 0.f);
+		}
+		for (auto& s : scratch) { s.assign(paddedSize(count), 0.f); }
+	}
+
+	void SpringPool::apply(BodyStore& store)
+	{
+		if (store.getRevision() != revision) { refresh(store); }
+		if (count == 0) { return; }
+
+		// gather the spring axes (and relative velocities if any spring is damped)
+		const float* position[3] = { store.array(BodyStore::POS_X), store.array(BodyStore::POS_Y), store.array(BodyStore::POS_Z) };
+		const float* velocity[3] = { store.array(BodyStore::VEL_X), store.array(BodyStore::VEL_Y), store.array(BodyStore::VEL_Z) };
+		const bool damped = std::any_of(damping.begin(), damping.begin() + count, [](float c) { return c != 0.f; });
+		for (int k = 0; k < 3; k++)
+		{
+			float* d = scratch[DX + k].data();
+			float* rv = scratch[RVX + k].data();
+			for (size_t i = 0; i < count; i++) { d[i] = position[k][indexA[i]] - position[k][indexB[i]]; }
+			if (damped)
+			{
+				for (size_t i = 0; i < count; i++) { rv[i] = velocity[k][indexA[i]] - velocity[k][indexB[i]]; }
+			}
+		}
+
+		// f = -(stiffness * (length - rest) + damping * closing speed) * axis / length, one square root per spring
+		float* dx = scratch[DX].data(); float* dy = scratch[DY].data(); float* dz = scratch[DZ].data();
+		float* rvx = scratch[RVX].data(); float* rvy = scratch[RVY].data(); float* rvz = scratch[RVZ].data();
+		float* fx = scratch[FX].data(); float* fy = scratch[FY].data(); float* fz = scratch[FZ].data();
+#ifdef SIMD_LANES
+		using L = Simd::Lanes;
+		const L::F minLength = L::set(MIN_SPRING_LENGTH);
+		const L::F one = L::set(1.f);
+		const L::F zero = L::set(0.f);
+		for (size_t i = 0; i < count; i += L::WIDTH)
+		{
+			const L::F x = L::load(dx + i), y = L::load(dy + i), z = L::load(dz + i);
+			const L::F length = L::sqrt(L::add(L::add(L::mul(x, x), L::mul(y, y)), L::mul(z, z)));
+			const L::F inverse = L::div(one, L::max(length, minLength));
+			const L::F closing = L::mul(L::add(L::add(L::mul(L::load(rvx + i), x), L::mul(L::load(rvy + i), y)), L::mul(L::load(rvz + i), z)), inverse);
+			const L::F tension = L::add(L::mul(L::load(stiffness.data() + i), L::sub(length, L::load(restLength.data() + i))), L::mul(L::load(damping.data() + i), closing));
+			const L::F scale = L::mul(L::sub(zero, tension), inverse);
+			L::store(fx + i, L::mul(x, scale));
+			L::store(fy + i, L::mul(y, scale));
+			L::store(fz + i, L::mul(z, scale));
+		}
+#else
+		for (size_t i = 0; i < count; i++)
+		{
+			const float length = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i]);
+			const float inverse = 1.f / std::max(length, MIN_SPRING_LENGTH);
+			const float closing = (rvx[i] * dx[i] + rvy[i] * dy[i] + rvz[i] * dz[i]) * inverse;
+			const float scale = -(stiffness[i] * (length - restLength[i]) + damping[i] * closing) * inverse;
+			fx[i] = dx[i] * scale;
+			fy[i] = dy[i] * scale;
+			fz[i] = dz[i] * scale;
+		}
+#endif
+
+		// scatter, equal and opposite on both ends, sleeping ends never clear their accumulated force and are skipped
+		const size_t awake = store.getAwakeCount();
+		for (int k = 0; k < 3; k++)
+		{
+			float* force = store.array(static_cast<BodyStore::Component>(BodyStore::FORCE_X + k));
+			const float* f = scratch[FX + k].data();
+			for (size_t i = 0; i < count; i++)
+			{
+				if (indexA[i] < awake) { force[indexA[i]] += f[i]; }
+				if (indexB[i] < awake) { force[indexB[i]] -= f[i]; }
+			}
+		}
+	}
+
+	// gravity
+
+	void GravityPool::add(BodyHandle body, const Vec& g)
+	{
+		handles.push_back(body);
+		indices.push_back(0);
+		gravity[0].push_back(g.x);
+		gravity[1].push_back(g.y);
+		gravity[2].push_back(g.z);
+		revision = ~0ull;
+	}
+
+	void GravityPool::clear()
+	{
+		handles.clear();
+		indices.clear();
+		for (auto& g : gravity) { g.clear(); }
+	}
+
+	void GravityPool::refresh(const BodyStore& store)
+	{
+		revision = store.getRevision();
+		size_t kept = 0;
+		for (size_t i = 0; i < handles.size(); i++)
+		{
+			if (!store.isAlive(handles[i])) { continue; }
+			moveEntry(i, kept, handles, gravity[0], gravity[1], gravity[2]);
+			indices[kept] = store.indexOf(handles[kept]);
+			kept++;
+		}
+		handles.resize(kept);
+		indices.resize(kept);
+		for (auto& g : gravity) { g.resize(kept); }
+	}
+
+	void GravityPool::apply(BodyStore& store)
+	{
+		if (store.getRevision() != revision) { refresh(store); }
+		const float* inverseMass = store.array(BodyStore::INV_MASS);
+		const size_t awake = store.getAwakeCount();
+		for (int k = 0; k < 3; k++)
+		{
+			float* force = store.array(static_cast<BodyStore::Component>(BodyStore::FORCE_X + k));
+			const float* g = gravity[k].data();
+			for (size_t i = 0; i < indices.size(); i++)
+			{
+				// immovable bodies ignore gravity, sleeping ones rest on something that cancels it
+				const uint32_t body = indices[i];
+				if (body < awake && inverseMass[body] > 0.f) { force[body] += g[i] / inverseMass[body]; }
+			}
+		}
+	}
+
+	// drag
+
+	void DragPool::add(BodyHandle body, float linearIn, float quadraticIn)
+	{
+		handles.push_back(body);
+		indices.push_back(0);
+		linear.resize(count);
+		quadratic.resize(count);
+		linear.push_back(linearIn);
+		quadratic.push_back(quadraticIn);
+		count++;
+		revision = ~0ull;
+	}
+
+	void DragPool::clear()
+	{
+		handles.clear();
+		indices.clear();
+		linear.clear();
+		quadratic.clear();
+		count = 0;
+	}
+
+	void DragPool::refresh(const BodyStore& store)
+	{
+		revision = store.getRevision();
+		size_t kept = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!store.isAlive(handles[i])) { continue; }
+			moveEntry(i, kept, handles, linear, quadratic);
+			indices[kept] = store.indexOf(handles[kept]);
+			kept++;
+		}
+		count = kept;
+		handles.resize(count);
+		indices.resize(count);
+		for (auto* a : { &linear, &quadratic })
+		{
+			a->resize(count);
+			a->resize(paddedSize(count), 0.f);
+		}
+		for (auto& s : scratch) { s.assign(paddedSize(count), 0.f); }
+	}
+
+	void DragPool::apply(BodyStore& store)
+	{
+		if (store.getRevision() != revision) { refresh(store); }
+		if (count == 0) { return; }
+		const size_t awake = store.getAwakeCount();
+
+		for (int k = 0; k < 3; k++)
+		{
+			const float* velocity = store.array(static_cast<BodyStore::Component>(BodyStore::VEL_X + k));
+			float* v = scratch[VX + k].data();
+			for (size_t i = 0; i < count; i++) { v[i] = velocity[indices[i]]; }
+		}
+
+		// f = -v * (linear + quadratic * |v|), written back into the velocity scratch
+		float* vx = scratch[VX].data(); float* vy = scratch[VY].data(); float* vz = scratch[VZ].data();
+#ifdef SIMD_LANES
+		using L = Simd::Lanes;
+		const L::F zero = L::set(0.f);
+		for (size_t i = 0; i < count; i += L::WIDTH)
+		{
+			const L::F x = L::load(vx + i), y = L::load(vy + i), z = L::load(vz + i);
+			const L::F speed = L::sqrt(L::add(L::add(L::mul(x, x), L::mul(y, y)), L::mul(z, z)));
+			const L::F scale = L::sub(zero, L::add(L::load(linear.data() + i), L::mul(L::load(quadratic.data() + i), speed)));
+			L::store(vx + i, L::mul(x, scale));
+			L::store(vy + i, L::mul(y, scale));
+			L::store(vz + i, L::mul(z, scale));
+		}
+#else
+		for (size_t i = 0; i < count; i++)
+		{
+			const float speed = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+			const float scale = -(linear[i] + quadratic[i] * speed);
+			vx[i] *= scale;
+			vy[i] *= scale;
+			vz[i] *= scale;
+		}
+#endif
+
+		for (int k = 0; k < 3; k++)
+		{
+			float* force = store.array(static_cast<BodyStore::Component>(BodyStore::FORCE_X + k));
+			const float* f = scratch[VX + k].data();
+			for (size_t i = 0; i < count; i++)
+			{
+				if (indices[i] < awake) { force[indices[i]] += f[i]; }
+			}
+		}
+	}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/Physics/BodyStore.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Physics
+{
+	/*	typed force generators, one pool per kind, each stored as structure of arrays and applied in a single
+	*	non-virtual pass: body state is gathered into contiguous scratch arrays, the forces are computed 4 (SSE)
+	*	or 8 (AVX) generators at a time, then added to the bodies' accumulated forces
+	*
+	*	entries refer to bodies by handle, the dense indices are looked up again only when the BodyStore's revision
+	*	changes, entries whose body was destroyed are dropped at that point (entry indices are not stable)
+	*
+	*	sleeping bodies receive no forces, a spring with one end asleep only pulls on its awake end and SleepSystem
+	*	wakes the other
+	*
+	*	ForceGenerator remains for rare custom forces that do not fit a pool */
+
+	// Hooke spring between two bodies with optional damping along the spring axis, pulls both ends equally
+	class SpringPool
+	{
+	public:
+		void add(BodyHandle a, BodyHandle b, float restLength, float stiffness, float damping = 0.f);
+		void clear();
+		size_t size() const { return count; }
+		// ends of spring i, may be stale until the next apply()
+		BodyHandle getBodyA(size_t i) const { return handleA[i]; }
+		BodyHandle getBodyB(size_t i) const { return handleB[i]; }
+		void apply(BodyStore& store);
+
+	private:
+		enum Scratch { DX = 0, DY, DZ, RVX, RVY, RVZ, FX, FY, FZ, SCRATCH_COUNT };
+		std::vector<BodyHandle> handleA, handleB;
+		std::vector<uint32_t> indexA, indexB;
+		std::vector<float> restLength, stiffness, damping; // padded to Simd::MAX_LANES
+		std::vector<float> scratch[SCRATCH_COUNT];
+		size_t count = 0;
+		uint64_t revision = ~0ull;
+
+		void refresh(const BodyStore& store);
+	};
+
+	// constant acceleration applied as a force (m * g), so it shows up in the accumulated force of the body
+	class GravityPool
+	{
+	public:
+		void add(BodyHandle body, const Vec& gravity);
+		void clear();
+		size_t size() const { return handles.size(); }
+		void apply(BodyStore& store);
+
+	private:
+		std::vector<BodyHandle> handles;
+		std::vector<uint32_t> indices;
+		std::vector<float> gravity[3];
+		uint64_t revision = ~0ull;
+
+		void refresh(const BodyStore& store);
+	};
+
+	// drag opposing the velocity, -v * (linear + quadratic * |v|)
+	class DragPool
+	{
+	public:
+		void add(BodyHandle body, float linear, float quadratic);
+		void clear();
+		size_t size() const { return count; }
+		void apply(BodyStore& store);
+
+	private:
+		enum Scratch { VX = 0, VY, VZ, SCRATCH_COUNT };
+		std::vector<BodyHandle> handles;
+		std::vector<uint32_t> indices;
+		std::vector<float> linear, quadratic; // padded to Simd::MAX_LANES
+		std::vector<float> scratch[SCRATCH_COUNT];
+		size_t count = 0;
+		uint64_t revision = ~0ull;
+
+		void refresh(const BodyStore& store);
+	};
+
+	struct ForcePools
+	{
+		SpringPool springs;
+		GravityPool gravity;
+		DragPool drag;
+
+		void apply(BodyStore& store)
+		{
+			gravity.apply(store);
+			drag.apply(store);
+			springs.apply(store);
+		}
+	};
+
+}
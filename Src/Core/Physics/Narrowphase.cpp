@@ -0,0 +1,123 @@
+#include "Core/Physics/Narrowphase.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Physics
+{
+	namespace
+	{
+		// separation direction for coincident centers, any unit vector works
+		const Vec FALLBACK_NORMAL{ 0.f, 1.f, 0.f };
+	}
+
+	size_t Narrowphase::generate(const BodyStore& store, const std::vector<BodyPair>& pairs, std::vector<Collision>& contactsOut) const
+	{
+		const size_t before = contactsOut.size();
+		const Collider::Type* types = store.colliderTypes();
+		Collision contact{};
+		contact.restitution = restitution;
+
+		for (const BodyPair& pair : pairs)
+		{
+			const Vec centerA = store.getVec(BodyStore::POS_X, pair.a);
+			const Vec centerB = store.getVec(BodyStore::POS_X, pair.b);
+			const Vec extentA = store.getVec(BodyStore::EXTENT_X, pair.a);
+			const Vec extentB = store.getVec(BodyStore::EXTENT_X, pair.b);
+
+			bool touching = false;
+			if (types[pair.a] == Collider::SPHERE && types[pair.b] == Collider::SPHERE)
+			{
+				touching = sphereSphere(centerA, extentA.x, centerB, extentB.x, contact);
+			}
+			else if (types[pair.a] == Collider::SPHERE)
+			{
+				touching = sphereBox(centerA, extentA.x, centerB, extentB, contact);
+			}
+			else if (types[pair.b] == Collider::SPHERE)
+			{
+				touching = sphereBox(centerB, extentB.x, centerA, extentA, contact);
+				contact.normal = contact.normal * -1.f; // the test ran with b first
+			}
+			else
+			{
+				touching = boxBox(centerA, extentA, centerB, extentB, contact);
+			}
+
+			if (touching)
+			{
+				contact.bodies = { pair.a, pair.b };
+				contactsOut.push_back(contact);
+			}
+		}
+		return contactsOut.size() - before;
+	}
+
+	bool Narrowphase::sphereSphere(const Vec& centerA, float radiusA, const Vec& centerB, float radiusB, Collision& contactOut)
+	{
+		const Vec d = centerA - centerB;
+		const float distanceSquared = Vec::dot(d, d);
+		const float radii = radiusA + radiusB;
+		if (distanceSquared > radii * radii) { return false; }
+
+		const float distance = std::sqrt(distanceSquared);
+		contactOut.normal = distance > EPSILON_F ? d * (1.f / distance) : FALLBACK_NORMAL;
+		contactOut.penetrationDepth = radii - distance;
+		return true;
+	}
+
+	bool Narrowphase::sphereBox(const Vec& centerA, float radiusA, const Vec& centerB, const Vec& halfExtentsB, Collision& contactOut)
+	{
+		// closest point of the box to the sphere center
+		const Vec local = centerA - centerB;
+		const Vec closest
+		{
+			std::clamp(local.x, -halfExtentsB.x, halfExtentsB.x),
+			std::clamp(local.y, -halfExtentsB.y, halfExtentsB.y),
+			std::clamp(local.z, -halfExtentsB.z, halfExtentsB.z),
+		};
+		const Vec d = local - closest;
+		const float distanceSquared = Vec::dot(d, d);
+		if (distanceSquared > radiusA * radiusA) { return false; }
+
+		if (distanceSquared > EPSILON_F * EPSILON_F)
+		{
+			const float distance = std::sqrt(distanceSquared);
+			contactOut.normal = d * (1.f / distance);
+			contactOut.penetrationDepth = radiusA - distance;
+			return true;
+		}
+
+		// the center is inside the box, push out through the nearest face
+		const float depth[3] = { halfExtentsB.x - std::abs(local.x), halfExtentsB.y - std::abs(local.y), halfExtentsB.z - std::abs(local.z) };
+		const float sign[3] = { local.x < 0.f ? -1.f : 1.f, local.y < 0.f ? -1.f : 1.f, local.z < 0.f ? -1.f : 1.f };
+		const int k = depth[0] <= depth[1] && depth[0] <= depth[2] ? 0 : (depth[1] <= depth[2] ? 1 : 2);
+		float n[3] = { 0.f, 0.f, 0.f };
+		n[k] = sign[k];
+		contactOut.normal = Vec{ n[0], n[1], n[2] };
+		contactOut.penetrationDepth = depth[k] + radiusA;
+		return true;
+	}
+
+	bool Narrowphase::boxBox(const Vec& centerA, const Vec& halfExtentsA, const Vec& centerB, const Vec& halfExtentsB, Collision& contactOut)
+	{
+		const Vec d = centerA - centerB;
+		const float overlap[3] =
+		{
+			halfExtentsA.x + halfExtentsB.x - std::abs(d.x),
+			halfExtentsA.y + halfExtentsB.y - std::abs(d.y),
+			halfExtentsA.z + halfExtentsB.z - std::abs(d.z),
+		};
+		if (overlap[0] < 0.f || overlap[1] < 0.f || overlap[2] < 0.f) { return false; }
+
+		// separate along the axis of least overlap
+		const float sign[3] = { d.x < 0.f ? -1.f : 1.f, d.y < 0.f ? -1.f : 1.f, d.z < 0.f ? -1.f : 1.f };
+		const int k = overlap[0] <= overlap[1] && overlap[0] <= overlap[2] ? 0 : (overlap[1] <= overlap[2] ? 1 : 2);
+		float n[3] = { 0.f, 0.f, 0.f };
+		n[k] = sign[k];
+		contactOut.normal = Vec{ n[0], n[1], n[2] };
+		contactOut.penetrationDepth = overlap[k];
+		return true;
+	}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/Physics/Broadphase.h"
+#include "Core/Physics/Collision.h"
+
+#include <vector>
+
+namespace Physics
+{
+	// exact shape tests for the broadphase candidates, each touching pair becomes a Collision
+	class Narrowphase
+	{
+	public:
+		float restitution = .5f; // given to every generated contact
+
+		// appends one contact per pair that actually touches, returns the number of contacts added
+		size_t generate(const BodyStore& store, const std::vector<BodyPair>& pairs, std::vector<Collision>& contactsOut) const;
+
+		// the tests fill normal (pointing from b to a) and penetrationDepth of contactOut, boxes are axis aligned
+		static bool sphereSphere(const Vec& centerA, float radiusA, const Vec& centerB, float radiusB, Collision& contactOut);
+		static bool sphereBox(const Vec& centerA, float radiusA, const Vec& centerB, const Vec& halfExtentsB, Collision& contactOut);
+		static bool boxBox(const Vec& centerA, const Vec& halfExtentsA, const Vec& centerB, const Vec& halfExtentsB, Collision& contactOut);
+	};
+
+}
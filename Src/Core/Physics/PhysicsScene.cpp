@@ -2,8 +2,17 @@
 #include "Core/Physics/Rigidbody.h"
 #include "Core/Physics/ForceGenerator.h"
 
+#include <chrono>
+
 namespace Physics
 {
+	namespace
+	{
+		double millisecondsSince(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
 
 	PhysicsScene::PhysicsScene() 
 	{
@@ -17,12 +26,61 @@ namespace Physics
 
 	std::vector<Vec> PhysicsScene::simulate(float deltaTime) 
 	{
-		// keep reading 139 - 7.2 Collision Processing
+		stats = Stats{};
+		stats.bodies = static_cast<uint32_t>(bodyStore.size());
 
+		auto start = std::chrono::steady_clock::now();
+		forces.apply(bodyStore);
 		for (auto& f : generators) { f->applyForces(deltaTime); }
-		for (auto& b : bodies) { b->simulate(deltaTime); }
+		continuous.begin(bodyStore, deltaTime);
+		bodyStore.integrate(deltaTime);
+		stats.integrateMs = millisecondsSince(start);
+
+		detectCollisions();
+
+		start = std::chrono::steady_clock::now();
+		contactCache.warmStart(bodyStore, contacts);
+		solver.solve(bodyStore, contacts);
+		contactCache.update(bodyStore, contacts);
+		stats.resolveMs = millisecondsSince(start);
+
+		// last, it reorders the bodies and the contacts' dense indices are stale afterwards
+		start = std::chrono::steady_clock::now();
+		sleepSystem.update(bodyStore, contacts, forces.springs, deltaTime);
+		stats.sleepMs = millisecondsSince(start);
+		stats.awake = sleepSystem.getStats().awake;
+		stats.sleeping = sleepSystem.getStats().sleeping;
 
 		return std::vector<Vec>();
 	}
 
-}
\ No newline at end of file
+	void PhysicsScene::detectCollisions()
+	{
+		auto start = std::chrono::steady_clock::now();
+		broadphase.update(bodyStore);
+		stats.broadphaseMs = millisecondsSince(start);
+		stats.pairs = broadphase.getStats().pairs;
+
+		// fast bodies are moved back to their first impact, before the narrowphase so it sees them touching
+		start = std::chrono::steady_clock::now();
+		sweptPairs.clear();
+		continuous.resolve(bodyStore, broadphase, sweptPairs);
+		stats.continuousMs = millisecondsSince(start);
+		stats.sweptBodies = continuous.getStats().movers;
+
+		start = std::chrono::steady_clock::now();
+		contacts.clear();
+		narrowphase.generate(bodyStore, broadphase.getPairs(), contacts);
+		narrowphase.generate(bodyStore, sweptPairs, contacts);
+		stats.narrowphaseMs = millisecondsSince(start);
+		stats.contacts = static_cast<uint32_t>(contacts.size());
+	}
+
+	std::shared_ptr<Rigidbody> PhysicsScene::createBody(const Vec& position, float mass, const Collider& collider)
+	{
+		bodies.push_back(std::make_shared<Rigidbody>(bodyStore, position, mass));
+		if (collider.type != Collider::NONE) { bodies.back()->setCollider(collider); }
+		return bodies.back();
+	}
+
+}
@@ -1,5 +1,15 @@
 #pragma once
 #include "Core/Types/CommonTypes.h"
+#include "Core/Physics/BodyStore.h"
+#include "Core/Physics/Broadphase.h"
+#include "Core/Physics/Narrowphase.h"
+#include "Core/Physics/Collision.h"
+#include "Core/Physics/ContactSolver.h"
+#include "Core/Physics/ContactCache.h"
+#include "Core/Physics/ContinuousCollision.h"
+#include "Core/Physics/ForcePools.h"
+#include "Core/Physics/SleepSystem.h"
+#include "Core/Types/TaskPool.h"
 
 #include <memory>
 #include <vector>
@@ -12,14 +22,65 @@ namespace Physics
 	class PhysicsScene
 	{
 	public:
+		// per simulate() call
+		struct Stats
+		{
+			uint32_t bodies = 0;
+			uint32_t awake = 0; // after the step
+			uint32_t sleeping = 0;
+			uint32_t pairs = 0; // broadphase candidates
+			uint32_t sweptBodies = 0; // fast bodies checked for continuous collision
+			uint32_t contacts = 0; // pairs that actually touch
+			double integrateMs = 0.0; // force pools, generators and integration
+			double broadphaseMs = 0.0;
+			double continuousMs = 0.0; // sweeps of fast bodies, after the broadphase
+			double narrowphaseMs = 0.0;
+			double resolveMs = 0.0; // contact cache and solver, including island construction
+			double sleepMs = 0.0;
+		};
+
 		PhysicsScene();
 		// temporary test functions
 		void setupTest();
 		std::vector<Vec> simulate(float deltaTime);
 
+		// adds a body to the scene, it is simulated for as long as the scene exists
+		std::shared_ptr<Rigidbody> createBody(const Vec& position, float mass, const Collider& collider = Collider{});
+		BodyStore& getBodyStore() { return bodyStore; }
+		ForcePools& getForces() { return forces; }
+		void addGenerator(const std::shared_ptr<ForceGenerator>& generator) { generators.push_back(generator); }
+		const BodyStore& getBodyStore() const { return bodyStore; }
+
+		const Stats& getStats() const { return stats; }
+		const Broadphase::Stats& getBroadphaseStats() const { return broadphase.getStats(); }
+		// contacts found by the last step, body indices are dense BodyStore indices of that step (bodies falling asleep or
+		// waking at its end reorder them, see BodyStore::getRevision)
+		const std::vector<Collision>& getContacts() const { return contacts; }
+		Narrowphase& getNarrowphase() { return narrowphase; }
+		ContactSolver& getSolver() { return solver; }
+		ContactCache& getContactCache() { return contactCache; }
+		SleepSystem& getSleepSystem() { return sleepSystem; }
+		ContinuousCollision& getContinuousCollision() { return continuous; }
+		const ContactSolver::Stats& getSolverStats() const { return solver.getStats(); }
+
 	protected:
+		BodyStore bodyStore; // declared first, so it outlives the bodies below
 		std::vector<std::shared_ptr<Rigidbody>> bodies;
+		ForcePools forces;
 		std::vector<std::shared_ptr<ForceGenerator>> generators;
+
+		Broadphase broadphase;
+		ContinuousCollision continuous;
+		std::vector<BodyPair> sweptPairs; // impacts found by continuous, not reported by the broadphase
+		Narrowphase narrowphase;
+		std::vector<Collision> contacts;
+		TaskPool taskPool{};
+		ContactSolver solver{ &taskPool };
+		ContactCache contactCache;
+		SleepSystem sleepSystem;
+		Stats stats{};
+
+		void detectCollisions();
 	};
 
 }
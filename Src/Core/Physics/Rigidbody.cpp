@@ -1,23 +1,14 @@
 #include "Core/Physics/Rigidbody.h"
 
-#include <cmath>
-
 namespace Physics
 {
-	Rigidbody::Rigidbody(const Vec& position, float mass)
-		: position{ position }
-	{
-		setMass(mass);
-	}
+	Rigidbody::Rigidbody(BodyStore& store, const Vec& position, float mass)
+		: store{ store }, handle{ store.create(position, mass) }
+	{}
 
-	void Rigidbody::simulate(float deltaTime)
+	Rigidbody::~Rigidbody()
 	{
-		position += velocity * deltaTime;
-		auto resAcc = acceleration;
-		resAcc += accumulatedForces * massInverse;
-		velocity += resAcc * deltaTime;
-		velocity *= std::pow(damping, deltaTime);
-		resetForces();
+		store.destroy(handle);
 	}
 
-}
\ No newline at end of file
+}
@@ -1,40 +1,51 @@
 #pragma once
 #include "Core/Types/CommonTypes.h"
+#include "Core/Physics/BodyStore.h"
 
 namespace Physics
 {
-
+	/*	object-style access to one body in a BodyStore, the state itself lives in the store's arrays,
+	*	the facade owns its body (destroying the facade removes the body) and must not outlive the store */
 	class Rigidbody 
 	{
 	public:
-		Rigidbody(const Vec& position, float mass);
+		Rigidbody(BodyStore& store, const Vec& position, float mass);
+		~Rigidbody();
+		Rigidbody(const Rigidbody&) = delete;
+		Rigidbody& operator=(const Rigidbody&) = delete;
 
-		const Vec& getPosition() const { return position; }
-		void setPosition(const Vec& p) { position = p; }
+		Vec getPosition() const { return store.getPosition(handle); }
+		void setPosition(const Vec& p) { store.setPosition(handle, p); }
 
-		const Vec& getVelocity() const { return velocity; }
-		void setVelocity(const Vec& v) { velocity = v; }
+		Vec getVelocity() const { return store.getVelocity(handle); }
+		void setVelocity(const Vec& v) { store.setVelocity(handle, v); }
 
-		float getMass() const { return 1.f / massInverse; }
-		float getMassInverse() const { return massInverse; }
-		void setMass(float mass) { massInverse = 1.f / mass; }
-		
-		
-		
-		void applyForce(const Vec& f) { accumulatedForces += f; }
-		void simulate(float deltaTime);
-		void resetForces() { accumulatedForces.zero(); }
+		Vec getAcceleration() const { return store.getAcceleration(handle); }
+		void setAcceleration(const Vec& a) { store.setAcceleration(handle, a); }
 
-	private:
-		Vec position;
-		Vec velocity;
-		Vec acceleration;
-		Vec accumulatedForces;
-		float massInverse;
-		float damping;
+		float getMass() const { return 1.f / store.getMassInverse(handle); }
+		float getMassInverse() const { return store.getMassInverse(handle); }
+		void setMass(float mass) { store.setMass(handle, mass); }
 
+		// fraction of velocity kept per second
+		float getDamping() const { return store.getDamping(handle); }
+		void setDamping(float damping) { store.setDamping(handle, damping); }
+
+		Collider getCollider() const { return store.getCollider(handle); }
+		void setCollider(const Collider& collider) { store.setCollider(handle, collider); }
+		// sweep for collisions every step, see ContinuousCollision
+		bool isContinuous() const { return store.isContinuous(handle); }
+		void setContinuous(bool continuous) { store.setContinuous(handle, continuous); }
 		
+		void applyForce(const Vec& f) { store.applyForce(handle, f); }
+		void resetForces() { store.resetForces(handle); }
+
+		BodyHandle getHandle() const { return handle; }
+
+	private:
+		BodyStore& store;
+		BodyHandle handle;
 
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,183 @@
+#include "Core/Physics/SleepSystem.h"
+#include "Core/Physics/ForcePools.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace Physics
+{
+	uint32_t SleepSystem::findRoot(uint32_t body)
+	{
+		// path halving
+		while (parent[body] != body)
+		{
+			parent[body] = parent[parent[body]];
+			body = parent[body];
+		}
+		return body;
+	}
+
+	void SleepSystem::unite(uint32_t a, uint32_t b)
+	{
+		const uint32_t rootA = findRoot(a);
+		const uint32_t rootB = findRoot(b);
+		if (rootA < rootB) { parent[rootB] = rootA; }
+		else { parent[rootA] = rootB; }
+	}
+
+	uint32_t SleepSystem::allocateIsland()
+	{
+		if (!freeIslands.empty())
+		{
+			const uint32_t island = freeIslands.back();
+			freeIslands.pop_back();
+			return island;
+		}
+		islands.emplace_back();
+		return static_cast<uint32_t>(islands.size() - 1);
+	}
+
+	void SleepSystem::wakeIsland(BodyStore& store, BodyHandle body)
+	{
+		const uint32_t island = body.slot < islandOfSlot.size() ? islandOfSlot[body.slot] : NO_ISLAND;
+		if (island != NO_ISLAND && !islands[island].empty())
+		{
+			// members destroyed or woken on their own since are skipped, a member may have fallen asleep again elsewhere
+			for (BodyHandle member : islands[island])
+			{
+				if (!store.isAlive(member) || store.isAwake(member)) { continue; }
+				store.wake(member);
+				islandOfSlot[member.slot] = NO_ISLAND;
+				stats.woken++;
+			}
+			islands[island].clear();
+			freeIslands.push_back(island);
+		}
+		if (store.isAlive(body) && !store.isAwake(body))
+		{
+			store.wake(body);
+			stats.woken++;
+		}
+	}
+
+	void SleepSystem::update(BodyStore& store, const std::vector<Collision>& contacts, const SpringPool& springs, float deltaTime)
+	{
+		stats = Stats{};
+		if (!settings.enabled)
+		{
+			wakeAll(store);
+			stats.awake = static_cast<uint32_t>(store.size());
+			return;
+		}
+
+		// wake requests are collected first, waking moves bodies and the contacts' dense indices go stale
+		const float* inverseMass = store.array(BodyStore::INV_MASS);
+		uint32_t awake = static_cast<uint32_t>(store.getAwakeCount());
+		const auto requestWake = [&](uint32_t body, uint32_t other)
+		{
+			if (body >= awake && other < awake && inverseMass[body] > 0.f) { pending.push_back(store.handleAt(body)); }
+		};
+		pending.clear();
+		for (const Collision& c : contacts)
+		{
+			if (c.bodies[1] == Collision::NO_BODY) { continue; }
+			requestWake(c.bodies[0], c.bodies[1]);
+			requestWake(c.bodies[1], c.bodies[0]);
+		}
+		for (size_t i = 0; i < springs.size(); i++)
+		{
+			const BodyHandle a = springs.getBodyA(i), b = springs.getBodyB(i);
+			if (!store.isAlive(a) || !store.isAlive(b)) { continue; }
+			requestWake(store.indexOf(a), store.indexOf(b));
+			requestWake(store.indexOf(b), store.indexOf(a));
+		}
+		for (BodyHandle body : pending) { wakeIsland(store, body); }
+
+		// sleep timers of the awake bodies, measured after solving so resting contacts have already cancelled gravity
+		awake = static_cast<uint32_t>(store.getAwakeCount());
+		const float* velocity[3] = { store.array(BodyStore::VEL_X), store.array(BodyStore::VEL_Y), store.array(BodyStore::VEL_Z) };
+		float* timer = store.array(BodyStore::SLEEP_TIMER);
+		for (uint32_t i = 0; i < awake; i++)
+		{
+			const float energy = .5f * (velocity[0][i] * velocity[0][i] + velocity[1][i] * velocity[1][i] + velocity[2][i] * velocity[2][i]);
+			timer[i] = energy <= settings.energyThreshold ? timer[i] + deltaTime : 0.f;
+		}
+
+		// the islands below need this step's indices, after a wake they are rebuilt from next step's contacts instead
+		if (stats.woken == 0)
+		{
+			parent.resize(awake);
+			for (uint32_t i = 0; i < awake; i++) { parent[i] = i; }
+			const auto link = [&](uint32_t a, uint32_t b)
+			{
+				if (a < awake && b < awake && inverseMass[a] > 0.f && inverseMass[b] > 0.f) { unite(a, b); }
+			};
+			for (const Collision& c : contacts)
+			{
+				if (c.bodies[1] != Collision::NO_BODY) { link(c.bodies[0], c.bodies[1]); }
+			}
+			for (size_t i = 0; i < springs.size(); i++)
+			{
+				const BodyHandle a = springs.getBodyA(i), b = springs.getBodyB(i);
+				if (store.isAlive(a) && store.isAlive(b)) { link(store.indexOf(a), store.indexOf(b)); }
+			}
+
+			islandTimer.assign(awake, FLT_MAX);
+			for (uint32_t i = 0; i < awake; i++)
+			{
+				if (inverseMass[i] > 0.f)
+				{
+					float& shortest = islandTimer[findRoot(i)];
+					shortest = std::min(shortest, timer[i]);
+				}
+			}
+
+			// collect handles first, every sleep() moves bodies
+			pending.clear();
+			rootIsland.assign(awake, NO_ISLAND);
+			for (uint32_t i = 0; i < awake; i++)
+			{
+				if (inverseMass[i] <= 0.f)
+				{
+					if (timer[i] >= settings.timeToSleep) { pending.push_back(store.handleAt(i)); }
+					continue;
+				}
+				const uint32_t root = findRoot(i);
+				if (islandTimer[root] < settings.timeToSleep) { continue; }
+				if (rootIsland[root] == NO_ISLAND) { rootIsland[root] = allocateIsland(); }
+
+				const BodyHandle body = store.handleAt(i);
+				if (body.slot >= islandOfSlot.size()) { islandOfSlot.resize(body.slot + 1, NO_ISLAND); }
+				islandOfSlot[body.slot] = rootIsland[root];
+				islands[rootIsland[root]].push_back(body);
+				pending.push_back(body);
+			}
+			for (BodyHandle body : pending) { store.sleep(body); }
+			stats.fellAsleep = static_cast<uint32_t>(pending.size());
+		}
+
+		stats.awake = static_cast<uint32_t>(store.getAwakeCount());
+		stats.sleeping = static_cast<uint32_t>(store.size() - store.getAwakeCount());
+		stats.sleepingIslands = static_cast<uint32_t>(islands.size() - freeIslands.size());
+	}
+
+	void SleepSystem::wakeAll(BodyStore& store)
+	{
+		while (store.getAwakeCount() < store.size())
+		{
+			store.wake(store.handleAt(static_cast<uint32_t>(store.getAwakeCount())));
+		}
+		islands.clear();
+		freeIslands.clear();
+		islandOfSlot.clear();
+	}
+
+	void SleepSystem::clear()
+	{
+		islands.clear();
+		freeIslands.clear();
+		islandOfSlot.clear();
+		stats = Stats{};
+	}
+
+}
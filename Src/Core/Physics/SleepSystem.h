@@ -0,0 +1,70 @@
+#pragma once
+#include "Core/Physics/BodyStore.h"
+#include "Core/Physics/Collision.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Physics
+{
+	class SpringPool;
+
+	/*	puts bodies that came to rest to sleep, sleeping bodies are not integrated, swept against each other or solved
+	*
+	*	a body is resting while its kinetic energy per unit of mass (.5 v^2) stays below energyThreshold, its sleep timer
+	*	(BodyStore::SLEEP_TIMER) counts how long, bodies touching or linked by a spring form an island (union-find over
+	*	the step's contacts) and an island only falls asleep once all of its movable bodies rested for timeToSleep,
+	*	a single body in a stack falling asleep on its own would leave the bodies above it resting on something frozen
+	*
+	*	the island is remembered, when an awake body touches one of its bodies or a spring pulls on one, the whole island
+	*	wakes, a body also wakes on its own when changed through its handle (BodyStore setters and applyForce)
+	*
+	*	immovable bodies belong to no island, they sleep on their own once they stopped moving and contacts never wake
+	*	them (a resting body on sleeping ground is the common case, it must not keep the ground awake) */
+	class SleepSystem
+	{
+	public:
+		struct Settings
+		{
+			bool enabled = true;
+			float energyThreshold = .5f * .05f * .05f; // J/kg, about 5 cm/s
+			float timeToSleep = .5f; // seconds
+		};
+
+		struct Stats
+		{
+			uint32_t awake = 0;
+			uint32_t sleeping = 0;
+			uint32_t fellAsleep = 0; // this update
+			uint32_t woken = 0; // this update, by contacts and springs
+			uint32_t sleepingIslands = 0;
+		};
+
+		/*	runs after the contacts were solved, their dense indices must still be those of this step,
+		*	wakes islands touched by awake bodies, advances the sleep timers and puts resting islands to sleep */
+		void update(BodyStore& store, const std::vector<Collision>& contacts, const SpringPool& springs, float deltaTime);
+		void wakeAll(BodyStore& store);
+		void clear();
+
+		Settings settings;
+		const Stats& getStats() const { return stats; }
+
+	private:
+		static constexpr uint32_t NO_ISLAND = 0xFFFFFFFF;
+
+		std::vector<std::vector<BodyHandle>> islands; // sleeping islands, an empty one is free
+		std::vector<uint32_t> freeIslands;
+		std::vector<uint32_t> islandOfSlot; // per BodyHandle::slot the island it fell asleep in
+		std::vector<uint32_t> parent; // union-find over awake dense indices
+		std::vector<float> islandTimer; // per root, the shortest sleep timer of the island
+		std::vector<uint32_t> rootIsland; // per root, the island its bodies go to
+		std::vector<BodyHandle> pending;
+		Stats stats{};
+
+		uint32_t findRoot(uint32_t body);
+		void unite(uint32_t a, uint32_t b);
+		void wakeIsland(BodyStore& store, BodyHandle body);
+		uint32_t allocateIsland();
+	};
+
+}
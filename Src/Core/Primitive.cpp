@@ -1,6 +1,7 @@
 #include "Core/Primitive.h"
 #include "Core/GPU/Material.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -11,21 +12,29 @@ namespace EngineCore
 {
 	Primitive::Primitive(EngineDevice& device, const MeshBuilder& builder) : device{ device }
 	{
-		createVertexBuffers(builder.vertices);
-		createIndexBuffers(builder.indices);
+		createVertexBuffers(builder.vertices.data(), static_cast<uint32_t>(builder.vertices.size()));
+		createIndexBuffers(builder.indices.data(), static_cast<uint32_t>(builder.indices.size()));
 	}
 
 	Primitive::Primitive(EngineDevice& device, const std::vector<Vertex>& vertices) : device{ device }
 	{
-		createVertexBuffers(vertices);
+		createVertexBuffers(vertices.data(), static_cast<uint32_t>(vertices.size()));
+		createIndexBuffers(nullptr, 0);
+	}
+
+	Primitive::Primitive(EngineDevice& device, const Vertex* vertices, uint32_t vertexCount, 
+						const uint32_t* indices, uint32_t indexCount) : device{ device }
+	{
+		createVertexBuffers(vertices, vertexCount);
+		createIndexBuffers(indices, indexCount);
 	}
 
 	Primitive::Primitive(EngineDevice& device) : device{ device }
 	{
 		Primitive::MeshBuilder builder{};
 		builder.makeCubeMesh();
-		createVertexBuffers(builder.vertices);
-		createIndexBuffers(builder.indices);
+		createVertexBuffers(builder.vertices.data(), static_cast<uint32_t>(builder.vertices.size()));
+		createIndexBuffers(builder.indices.data(), static_cast<uint32_t>(builder.indices.size()));
 	}
 
 	void Primitive::setMaterial(std::shared_ptr<Material> newMaterial) { material = newMaterial; }
@@ -34,19 +43,28 @@ namespace EngineCore
 
 	std::shared_ptr<Material> Primitive::getMaterial() const { return material; }
 
-    bool Primitive::isPointInsideOOBB(const Vec& point)
-    {
-		assert(false && "not implemented (TODO)");
-		return false;
-    }
+	bool Primitive::isPointInsideOOBB(const Vec& point) const
+	{
+		return getOOBB().containsPoint(point);
+	}
 
-    void Primitive::createVertexBuffers(const std::vector<Vertex>& vertices)
+	OOBB Primitive::getOOBB() const
 	{
-		generateOOBB(vertices);
-		vertexCount = static_cast<uint32_t>(vertices.size());
+		if (boxRevision != transform.getRevision())
+		{
+			box = OOBB::fromMatrix(boundsMin, boundsMax, transform.getMatrix());
+			boxRevision = transform.getRevision();
+		}
+		return box;
+	}
+
+    void Primitive::createVertexBuffers(const Vertex* vertices, uint32_t count)
+	{
+		generateOOBB(vertices, count);
+		vertexCount = count;
 		assert(vertexCount >= 3 && "vertexCount cannot be below 3");
-		VkDeviceSize bufferSize = sizeof(vertices[0]) * vertexCount;
-		uint32_t vertexSize = sizeof(vertices[0]);
+		uint32_t vertexSize = sizeof(Vertex);
+		VkDeviceSize bufferSize = vertexSize * vertexCount;
 		// temporary buffer to transfer from CPU (host) to GPU (device)
 		GBuffer stagingBuffer
 		{
@@ -55,23 +73,23 @@ namespace EngineCore
 			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
 		};
 		stagingBuffer.map();
-		stagingBuffer.writeToBuffer((void*)vertices.data()); // write vertices
+		stagingBuffer.writeToBuffer((void*)vertices); // write vertices
 
-		// destination buffer, GPU only for speed (not host accessible)
+		// destination buffer, GPU only for speed (not host accessible), may be copied back with readbackMesh
 		vertexBuffer = std::make_unique<GBuffer>(device, vertexSize, vertexCount,
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
 		device.copyBuffer(stagingBuffer.getBuffer(), vertexBuffer->getBuffer(), bufferSize);
 	}
 
-	void Primitive::createIndexBuffers(const std::vector<uint32_t>& indices)
+	void Primitive::createIndexBuffers(const uint32_t* indices, uint32_t count)
 	{
-		indexCount = static_cast<uint32_t>(indices.size());
+		indexCount = count;
 		hasIndexBuffer = indexCount > 0;
 		if (!hasIndexBuffer) { return; }
-		VkDeviceSize bufferSize = sizeof(indices[0]) * indexCount;
-		uint32_t indexSize = sizeof(indices[0]);
+		uint32_t indexSize = sizeof(uint32_t);
+		VkDeviceSize bufferSize = indexSize * indexCount;
 		// same as for vertex buffer
 		GBuffer stagingBuffer
 		{
@@ -80,22 +98,46 @@ namespace EngineCore
 			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
 		};
 		stagingBuffer.map();
-		stagingBuffer.writeToBuffer((void*)indices.data());
+		stagingBuffer.writeToBuffer((void*)indices);
 
 		indexBuffer = std::make_unique<GBuffer>(device, indexSize, indexCount,
-			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT); // note INDEX_BUFFER_BIT
 
 		device.copyBuffer(stagingBuffer.getBuffer(), indexBuffer->getBuffer(), bufferSize);
 	}
 
-	void Primitive::generateOOBB(const std::vector<Vertex>& vertices)
+	void Primitive::readbackBuffer(const GBuffer& src, VkDeviceSize size, void* dst)
+	{
+		GBuffer stagingBuffer
+		{
+			device, size, 1,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		};
+		device.copyBuffer(src.getBuffer(), stagingBuffer.getBuffer(), size);
+		stagingBuffer.map();
+		memcpy(dst, stagingBuffer.getMappedMemory(), size);
+	}
+
+	void Primitive::readbackMesh(MeshBuilder& builderOut)
+	{
+		builderOut.vertices.resize(vertexCount);
+		readbackBuffer(*vertexBuffer, sizeof(Vertex) * vertexCount, builderOut.vertices.data());
+		builderOut.indices.resize(getIndexCount());
+		if (hasIndexBuffer) { readbackBuffer(*indexBuffer, sizeof(uint32_t) * indexCount, builderOut.indices.data()); }
+	}
+
+	void Primitive::generateOOBB(const Vertex* vertices, uint32_t count)
 	{
-		for (const auto& v : vertices)
+		boxRevision = 0xFFFFFFFF;
+		if (count == 0) { boundsMin = boundsMax = Vec::zero(); return; }
+		boundsMin = boundsMax = Vec{ vertices[0].position.x, vertices[0].position.y, vertices[0].position.z };
+		for (uint32_t i = 1; i < count; i++)
 		{
-			extent.x = std::max(extent.x, std::abs(v.position.x));
-			extent.y = std::max(extent.y, std::abs(v.position.y));
-			extent.z = std::max(extent.z, std::abs(v.position.z));
+			const auto& v = vertices[i].position;
+			boundsMin = Vec{ std::min(boundsMin.x, v.x), std::min(boundsMin.y, v.y), std::min(boundsMin.z, v.z) };
+			boundsMax = Vec{ std::max(boundsMax.x, v.x), std::max(boundsMax.y, v.y), std::max(boundsMax.z, v.z) };
 		}
 	}
 
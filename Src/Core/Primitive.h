@@ -2,6 +2,8 @@
 
 #include "Core/GPU/Device.h"
 #include "Core/GPU/Buffer.h"
+#include "Core/Types/OOBB.h"
+#include "Core/Types/CachedTransform.h"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -41,6 +43,8 @@ namespace EngineCore
 
 		Primitive(EngineDevice& device, const MeshBuilder& builder);
 		Primitive(EngineDevice& device, const std::vector<Vertex>& vertices);
+		// uploads directly from caller-owned memory (e.g. a memory-mapped file), indexCount may be 0
+		Primitive(EngineDevice& device, const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
 		Primitive(EngineDevice& device);
 		~Primitive() = default;
 
@@ -58,19 +62,33 @@ namespace EngineCore
 
 		bool useFakeScale = false; //TODO: TMP - FakeScaleTest082
 
-		Transform& getTransform() { return transform; } // this should be changed to virtual, returning const
-		void setTransform(const Transform& t) { transform = t; }
-		void setTranslation(const Vec& t) { transform.translation = t; }
-
-		bool isPointInsideOOBB(const Vec& point);
+		// matrices are cached, change the transform through its setters
+		CachedTransform& getTransform() { return transform; }
+		const CachedTransform& getTransform() const { return transform; }
+		void setTransform(const Transform& t) { transform.set(t); }
+		void setTranslation(const Vec& t) { transform.setTranslation(t); }
+
+		// point in the same space as the transform (sector-local)
+		bool isPointInsideOOBB(const Vec& point) const;
+		// oriented bounding box of the mesh with the current transform applied
+		OOBB getOOBB() const;
+		// axis aligned bounds of the mesh in its own (untransformed) space
+		const Vec& getLocalBoundsMin() const { return boundsMin; }
+		const Vec& getLocalBoundsMax() const { return boundsMax; }
+
+		// copies the vertex and index data back from the GPU (slow, waits for the transfer to finish)
+		void readbackMesh(MeshBuilder& builderOut);
+		uint32_t getVertexCount() const { return vertexCount; }
+		uint32_t getIndexCount() const { return hasIndexBuffer ? indexCount : 0; }
 
 	private:
-		void createVertexBuffers(const std::vector<Vertex>& vertices);
-		void createIndexBuffers(const std::vector<uint32_t>& indices);
+		void createVertexBuffers(const Vertex* vertices, uint32_t count);
+		void createIndexBuffers(const uint32_t* indices, uint32_t count);
+		void readbackBuffer(const GBuffer& src, VkDeviceSize size, void* dst);
 
 		EngineDevice& device;
 
-		Transform transform{};
+		CachedTransform transform{};
 		std::shared_ptr<Material> material;
 
 		std::unique_ptr<GBuffer> vertexBuffer;
@@ -79,7 +97,11 @@ namespace EngineCore
 		uint32_t indexCount;
 		bool hasIndexBuffer = false;
 
-		void generateOOBB(const std::vector<Vertex>& vertices);
-		Vec extent{};
+		void generateOOBB(const Vertex* vertices, uint32_t count);
+		Vec boundsMin{};
+		Vec boundsMax{};
+		// getOOBB result, valid while the transform revision matches
+		mutable OOBB box{};
+		mutable uint32_t boxRevision = 0xFFFFFFFF;
 	};
 }
\ No newline at end of file
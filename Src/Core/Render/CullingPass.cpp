@@ -0,0 +1,96 @@
+#include "Core/Render/CullingPass.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EngineCore
+{
+	Frustum Frustum::fromMatrix(const glm::mat4& m)
+	{
+		// glm is column-major, row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+		const auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+		const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+		Frustum f{};
+		f.planes[Left] = r3 + r0;
+		f.planes[Right] = r3 - r0;
+		f.planes[Bottom] = r3 + r1;
+		f.planes[Top] = r3 - r1;
+		f.planes[Near] = r2; // 0 <= z
+		f.planes[Far] = r3 - r2; // z <= w
+
+		for (auto& p : f.planes)
+		{
+			const float length = glm::length(glm::vec3(p));
+			if (length > EPSILON_F) { p /= length; }
+		}
+		return f;
+	}
+
+	bool Frustum::intersectsSphere(const Vec& center, float radius) const
+	{
+		for (const auto& p : planes)
+		{
+			if (p.x * center.x + p.y * center.y + p.z * center.z + p.w < -radius) { return false; }
+		}
+		return true;
+	}
+
+	bool Frustum::intersectsAABB(const Vec& min, const Vec& max) const
+	{
+		for (const auto& p : planes)
+		{
+			// corner furthest along the plane normal, if that one is outside the whole box is
+			const float x = p.x >= 0.f ? max.x : min.x;
+			const float y = p.y >= 0.f ? max.y : min.y;
+			const float z = p.z >= 0.f ? max.z : min.z;
+			if (p.x * x + p.y * y + p.z * z + p.w < 0.f) { return false; }
+		}
+		return true;
+	}
+
+	void CullingPass::begin(const glm::mat4& projectionView, const Vec& observerIn)
+	{
+		start = std::chrono::steady_clock::now();
+		frustum = Frustum::fromMatrix(projectionView);
+		observer = observerIn;
+		visible.clear();
+		stats = Stats{};
+	}
+
+	bool CullingPass::testSector(const Vec& boundsMin, const Vec& boundsMax)
+	{
+		stats.sectorsTested++;
+
+		// squared distance from the observer to the closest point of the box
+		const float dx = std::max(std::max(boundsMin.x - observer.x, observer.x - boundsMax.x), 0.f);
+		const float dy = std::max(std::max(boundsMin.y - observer.y, observer.y - boundsMax.y), 0.f);
+		const float dz = std::max(std::max(boundsMin.z - observer.z, observer.z - boundsMax.z), 0.f);
+		const bool inRange = dx * dx + dy * dy + dz * dz <= maxDistance * maxDistance; // inf when unlimited
+
+		if (!inRange || !frustum.intersectsAABB(boundsMin, boundsMax)) { return false; }
+		stats.sectorsVisible++;
+		return true;
+	}
+
+	bool CullingPass::submit(const Vec& center, float radius, uint32_t id)
+	{
+		stats.primitivesTested++;
+
+		const float dx = center.x - observer.x, dy = center.y - observer.y, dz = center.z - observer.z;
+		const float reach = maxDistance + radius;
+		const bool inRange = dx * dx + dy * dy + dz * dz <= reach * reach;
+
+		if (!inRange || !frustum.intersectsSphere(center, radius)) { return false; }
+		visible.push_back(id);
+		stats.primitivesVisible++;
+		return true;
+	}
+
+	void CullingPass::end()
+	{
+		const std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+		stats.ms = ms.count();
+	}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+namespace EngineCore
+{
+	// six normalized planes (xyz = normal pointing inside, w = distance), extracted from a projection-view matrix
+	struct Frustum
+	{
+		enum Plane { Left = 0, Right, Bottom, Top, Near, Far, COUNT };
+		glm::vec4 planes[COUNT]{};
+
+		// Gribb-Hartmann plane extraction, expects depth in the 0..1 range (Vulkan)
+		static Frustum fromMatrix(const glm::mat4& projectionView);
+
+		bool intersectsSphere(const Vec& center, float radius) const;
+		bool intersectsAABB(const Vec& min, const Vec& max) const;
+	};
+
+	/*	CPU visibility pass, runs before command recording, sectors are tested first so the primitives of
+	*	off-screen sectors are never looked at, the visible primitive ids are collected in a compact list
+	*
+	*	the pass only sees bounds and ids, it holds no GPU resources (and can be tested without a device):
+	*	begin() -> { testSector() -> submit()... }... -> end() -> getVisible() */
+	class CullingPass
+	{
+	public:
+		struct Stats
+		{
+			uint32_t sectorsTested = 0;
+			uint32_t sectorsVisible = 0;
+			uint32_t primitivesTested = 0;
+			uint32_t primitivesVisible = 0;
+			double ms = 0.0; // time spent between begin() and end()
+		};
+
+		// anything further than this from the observer is culled, independent of the far plane
+		float maxDistance = std::numeric_limits<float>::max();
+
+		void begin(const glm::mat4& projectionView, const Vec& observer);
+		// returns false if the whole sector is outside the frustum or too far away, its primitives should be skipped
+		bool testSector(const Vec& boundsMin, const Vec& boundsMax);
+		// tests a primitive bounding sphere, appends id to the visible list if it may be visible
+		bool submit(const Vec& center, float radius, uint32_t id);
+		void end();
+
+		const std::vector<uint32_t>& getVisible() const { return visible; }
+		const Stats& getStats() const { return stats; }
+		const Frustum& getFrustum() const { return frustum; }
+
+	private:
+		Frustum frustum{};
+		Vec observer{};
+		std::vector<uint32_t> visible;
+		Stats stats{};
+		std::chrono::steady_clock::time_point start;
+	};
+
+}
@@ -8,10 +8,21 @@
 #include <array>
 #include <cassert>
 
+namespace
+{
+	// uniform ring bytes per frame in flight, room for 2048 UBOs at the usual 256 byte offset alignment
+	constexpr VkDeviceSize UNIFORM_RING_FRAME_SIZE = 512 * 1024;
+	// texture table slots, clamped to the device limits
+	constexpr uint32_t TEXTURE_TABLE_CAPACITY = 4096;
+}
+
 namespace EngineCore
 {
 	Renderer::Renderer(EngineWindow& window, EngineDevice& device, EngineRenderSettings& renderSettings)
-							: window{window}, device{device}, renderSettings{renderSettings}
+							: window{window}, device{device}, renderSettings{renderSettings},
+							uniformRing{ device, UNIFORM_RING_FRAME_SIZE, EngineSwapChain::MAX_FRAMES_IN_FLIGHT },
+							descriptorAllocator{ device, EngineSwapChain::MAX_FRAMES_IN_FLIGHT },
+							textureTable{ device, TEXTURE_TABLE_CAPACITY, EngineSwapChain::MAX_FRAMES_IN_FLIGHT }
 	{
 		create();
 		createCommandBuffers();
@@ -150,6 +161,10 @@ namespace EngineCore
 
 		isFrameStarted = true;
 		auto commandBuffer = getCurrentCommandBuffer();
+		// the acquire waited on this frame's fence, its ring region and transient descriptor sets are free
+		uniformRing.beginFrame(currentFrameIndex);
+		descriptorAllocator.resetFrame(currentFrameIndex);
+		textureTable.beginFrame();
 
 		VkCommandBufferBeginInfo beginInfo{};
 		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -163,6 +178,8 @@ namespace EngineCore
 		assert(isFrameStarted && "endFrame failed, no frame in progress");
 
 		auto commandBuffer = getCurrentCommandBuffer();
+		uniformRing.flush(); // everything the frame wrote to the ring, in one range
+		textureTable.flush(); // slots added during the frame, update-after-bind allows it after they were bound
 
 		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
 		{ throw std::runtime_error("failed to record command buffer"); }
@@ -1,5 +1,8 @@
 #pragma once
 #include "Core/GPU/Swapchain.h"
+#include "Core/GPU/UniformRing.h"
+#include "Core/GPU/Descriptors.h"
+#include "Core/GPU/TextureTable.h"
 #include "Core/Render/Renderpass.h"
 #include "Core/Render/Attachment.h"
 
@@ -58,6 +61,13 @@ namespace EngineCore
 			vkCmdEndRenderPass(getCurrentCommandBuffer());
 		}
 
+		// per-frame uniform data (descriptor set UBOs), reset by beginFrame and flushed by endFrame
+		UniformRing& getUniformRing() { return uniformRing; }
+		// descriptor pools shared by all descriptor sets, transient sets of a frame are released by beginFrame
+		DescriptorAllocator& getDescriptorAllocator() { return descriptorAllocator; }
+		// bindless sampled images referred to by slot index, recycled by beginFrame and written by endFrame
+		TextureTable& getTextureTable() { return textureTable; }
+
 		const std::vector<VkImageView>& getFxPassInputImageViews() const { return fxPassInputImageViews; }
 		const std::vector<VkImageView>& getFxPassInputDepthImageViews() const { return fxPassInputDepthImageViews; }
 
@@ -87,6 +97,9 @@ namespace EngineCore
 		EngineWindow& window;
 		EngineDevice& device;
 		EngineRenderSettings& renderSettings;
+		UniformRing uniformRing;
+		DescriptorAllocator descriptorAllocator;
+		TextureTable textureTable;
 		std::unique_ptr<EngineSwapChain> swapchain;
 		std::vector<VkCommandBuffer> commandBuffers;
 		// index of the current swapchain image
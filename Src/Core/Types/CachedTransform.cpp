@@ -0,0 +1,84 @@
+#include "Core/Types/CachedTransform.h"
+
+#include <cmath>
+
+void CachedTransform::set(const Transform& transform)
+{
+	translation = transform.translation;
+	rotation = quaternionFromEuler(transform.rotation);
+	scale = transform.scale;
+	markDirty();
+}
+
+Transform CachedTransform::toTransform() const
+{
+	Transform transform{};
+	transform.translation = translation;
+	transform.rotation = eulerFromQuaternion(rotation);
+	transform.scale = scale;
+	return transform;
+}
+
+void CachedTransform::setTranslation(const Vec& t)
+{
+	translation = t;
+	revision++;
+	// a pending rebuild writes the translation anyway
+	if (!dirty) { matrix[3] = glm::vec4(t.x, t.y, t.z, 1.f); }
+}
+
+void CachedTransform::setRotation(const glm::vec4& quaternion)
+{
+	const float lengthSquared = glm::dot(quaternion, quaternion);
+	rotation = lengthSquared > EPSILON_F ? quaternion * Math::invSqrt(lengthSquared) : glm::vec4(0.f, 0.f, 0.f, 1.f);
+	markDirty();
+}
+
+void CachedTransform::rebuild() const
+{
+	const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+	const Vec axes[3] =
+	{
+		{ 1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y) },
+		{ 2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x) },
+		{ 2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y) },
+	};
+	const float scales[3] = { scale.x, scale.y, scale.z };
+	for (int k = 0; k < 3; k++)
+	{
+		// (R * S)^-T = R * S^-1, a zero scale collapses the normals of that axis instead of dividing by zero
+		const float inverse = std::abs(scales[k]) > EPSILON_F ? 1.f / scales[k] : 0.f;
+		matrix[k] = glm::vec4(axes[k].x * scales[k], axes[k].y * scales[k], axes[k].z * scales[k], 0.f);
+		normalMatrix[k] = glm::vec4(axes[k].x * inverse, axes[k].y * inverse, axes[k].z * inverse, 0.f);
+	}
+	matrix[3] = glm::vec4(translation.x, translation.y, translation.z, 1.f);
+	normalMatrix[3] = glm::vec4(0.f, 0.f, 0.f, 1.f);
+	dirty = false;
+}
+
+glm::vec4 CachedTransform::quaternionFromEuler(const Vec& radians)
+{
+	const float sx = std::sin(radians.x * .5f), cx = std::cos(radians.x * .5f);
+	const float sy = std::sin(radians.y * .5f), cy = std::cos(radians.y * .5f);
+	const float sz = std::sin(radians.z * .5f), cz = std::cos(radians.z * .5f);
+
+	// qx * qy, then * qz
+	const float px = sx * cy, py = cx * sy, pz = sx * sy, pw = cx * cy;
+	return glm::vec4(px * cz + py * sz, py * cz - px * sz, pw * sz + pz * cz, pw * cz - pz * sz);
+}
+
+Vec CachedTransform::eulerFromQuaternion(const glm::vec4& q)
+{
+	// from the rotation matrix Rx * Ry * Rz, its column 2 is (sin y, -cos y sin x, cos x cos y)
+	const float m20 = 2.f * (q.x * q.z + q.w * q.y);
+	const float m21 = 2.f * (q.y * q.z - q.w * q.x);
+	const float m22 = 1.f - 2.f * (q.x * q.x + q.y * q.y);
+	const float cosY = std::sqrt(m21 * m21 + m22 * m22);
+	const float y = std::atan2(m20, cosY);
+	if (cosY < 1e-6f)
+	{
+		// gimbal lock, x and z rotate about the same axis, all of it is put into x
+		return Vec{ std::atan2(2.f * (q.y * q.z + q.w * q.x), 1.f - 2.f * (q.x * q.x + q.z * q.z)), y, 0.f };
+	}
+	return Vec{ std::atan2(-m21, m22), y, std::atan2(-2.f * (q.x * q.y - q.w * q.z), 1.f - 2.f * (q.y * q.y + q.z * q.z)) };
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+
+#include <stdint.h>
+
+/*	transform stored as translation, rotation quaternion (x, y, z, w) and scale, with its local to world matrix and
+*	normal matrix cached, both are rebuilt on first use after the rotation or scale changed, so an object that does not
+*	move costs no matrix math per frame, a translation change only patches the last column
+*
+*	the rotation follows Transform (Euler X-Y-Z order, Translation * Rx * Ry * Rz * Scale), so set(Transform) gives
+*	the same matrix as Transform::mat4(), toTransform() recovers Euler angles for code that stores Transform (files)
+*
+*	getRevision() changes with every change, for caching values derived from the transform (e.g. bounds) */
+class CachedTransform
+{
+public:
+	CachedTransform() = default;
+	explicit CachedTransform(const Transform& transform) { set(transform); }
+
+	void set(const Transform& transform);
+	Transform toTransform() const;
+
+	void setTranslation(const Vec& t);
+	void translate(const Vec& offset) { setTranslation(translation + offset); }
+	// normalized here
+	void setRotation(const glm::vec4& quaternion);
+	void setRotationEuler(const Vec& radians) { setRotation(quaternionFromEuler(radians)); }
+	void setScale(const Vec& s) { scale = s; markDirty(); }
+
+	const Vec& getTranslation() const { return translation; }
+	const glm::vec4& getRotation() const { return rotation; }
+	const Vec& getScale() const { return scale; }
+
+	const glm::mat4& getMatrix() const { if (dirty) { rebuild(); } return matrix; }
+	// inverse transpose of the rotation and scale, translation is left out (shaders use its upper 3x3)
+	const glm::mat4& getNormalMatrix() const { if (dirty) { rebuild(); } return normalMatrix; }
+	uint32_t getRevision() const { return revision; }
+
+	// quaternion of Rx * Ry * Rz, the rotation of Transform::makeMatrixDef
+	static glm::vec4 quaternionFromEuler(const Vec& radians);
+	static Vec eulerFromQuaternion(const glm::vec4& quaternion);
+
+private:
+	Vec translation{};
+	glm::vec4 rotation{ 0.f, 0.f, 0.f, 1.f };
+	Vec scale{ 1.f, 1.f, 1.f };
+
+	mutable glm::mat4 matrix{ 1.f };
+	mutable glm::mat4 normalMatrix{ 1.f };
+	mutable bool dirty = false;
+	uint32_t revision = 0;
+
+	void markDirty() { dirty = true; revision++; }
+	void rebuild() const;
+};
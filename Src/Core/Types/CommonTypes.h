@@ -19,16 +19,16 @@ public:
 	Vector3D<T> operator-(const Vector3D<T>& v) const { return Vector3D{ x - v.x, y - v.y, z - v.z }; } // -
 	Vector3D<T> operator*(const Vector3D<T>& v) const { return Vector3D{ x * v.x, y * v.y, z * v.z }; } // *
 	Vector3D<T> operator/(const Vector3D<T>& v) const { return Vector3D{ x / v.x, y / v.y, z / v.z }; } // /
-	Vector3D<T> operator+=(const Vector3D<T>& v) { *this = *this + v; return *this; } // Vector += Vector
-	Vector3D<T> operator-=(const Vector3D<T>& v) { *this = *this - v; return *this; } // Vector -= Vector
-	Vector3D<T> operator*=(const Vector3D<T>& v) { *this = *this * v; return *this; } // Vector *= Vector
+	Vector3D<T>& operator+=(const Vector3D<T>& v) { x += v.x; y += v.y; z += v.z; return *this; } // Vector += Vector
+	Vector3D<T>& operator-=(const Vector3D<T>& v) { x -= v.x; y -= v.y; z -= v.z; return *this; } // Vector -= Vector
+	Vector3D<T>& operator*=(const Vector3D<T>& v) { x *= v.x; y *= v.y; z *= v.z; return *this; } // Vector *= Vector
 
-	Vector3D<float> operator+(const float& f) const { return Vector3D{ x + f, y + f, z + f }; } // Vector + float
-	Vector3D<float> operator-(const float& f) const { return Vector3D{ x - f, y - f, z - f }; } // Vector - float
-	Vector3D<float> operator*(const float& f) const { return Vector3D{ x * f, y * f, z * f }; } // Vector * float
-	Vector3D<float> operator+=(const float& f) { *this = *this + f; return *this; } // Vector += float
-	Vector3D<float> operator-=(const float& f) { *this = *this - f; return *this; } // Vector -= float
-	Vector3D<float> operator*=(const float& f) { *this = *this * f; return *this; } // Vector *= float
+	Vector3D<T> operator+(const float& f) const { return Vector3D{ x + f, y + f, z + f }; } // Vector + float
+	Vector3D<T> operator-(const float& f) const { return Vector3D{ x - f, y - f, z - f }; } // Vector - float
+	Vector3D<T> operator*(const float& f) const { return Vector3D{ x * f, y * f, z * f }; } // Vector * float
+	Vector3D<T>& operator+=(const float& f) { x += f; y += f; z += f; return *this; } // Vector += float
+	Vector3D<T>& operator-=(const float& f) { x -= f; y -= f; z -= f; return *this; } // Vector -= float
+	Vector3D<T>& operator*=(const float& f) { x *= f; y *= f; z *= f; return *this; } // Vector *= float
 	
 #ifdef GLM_VERSION
 	Vector3D<T>(const glm::vec3& g) : x{ g.x }, y{ g.y }, z{ g.z } {};
@@ -37,7 +37,7 @@ public:
 	static auto dot(const Vector3D<T>& a, const Vector3D<T>& b) 
 		{ return (a.x * b.x) + (a.y * b.y) + (a.z * b.z); }
 	static Vector3D<T> cross(const Vector3D<T>& a, const Vector3D<T>& b) 
-		{ return ((a.y * b.z - b.y * a.z), (a.z * b.x - b.z * a.x), (a.x * b.y - b.x * a.y)); }
+		{ return Vector3D<T>{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
 	Vector3D<T> getNormalized() const 
 	{ 
 		const auto sum = dot(*this, *this); // magnitude squared
@@ -54,9 +54,9 @@ public:
 		}
 		return false;
 	}
-	const T& getMagnitude() const { return std::sqrt(x * x + y * y + z * z); }
-	static float distanceSquared(const Vector3D<T>& a, const Vector3D<T>& b) { return pow(b.x - a.x,2) + pow(b.y - a.y,2) + pow(b.z - a.z,2); }
-	static float distance(const Vector3D<T>& a, const Vector3D<T>& b) { return sqrt(distanceSquared(a, b)); }
+	T getMagnitude() const { return std::sqrt(x * x + y * y + z * z); }
+	static T distanceSquared(const Vector3D<T>& a, const Vector3D<T>& b) { const Vector3D<T> d = b - a; return dot(d, d); }
+	static T distance(const Vector3D<T>& a, const Vector3D<T>& b) { return std::sqrt(distanceSquared(a, b)); }
 	static auto direction(Vector3D<float> a, Vector3D<float> b) { return Vector3D<float>(b - a).getNormalized(); }
 	//Vector3D<T>& zero() { x = 0; y = 0; z = 0; return *this; }
 	static Vector3D<T> zero() { return Vector3D<T>(); }
@@ -1,37 +1,280 @@
 #pragma once
+#include <stdint.h>
 #include <array>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-template <class T, unsigned int MAX>
-class LinkedArraySeries 
-{	
-	struct LnkArr
-	{
-		LnkArr(const uint32_t& n) : arr[n]
-		{ len = n; };
-		array<T> arr;
-		uint32_t len;
-		LnkArr* next = nullptr;
-		void linkTo(LnkArr& l) { next = &l; }
+/*	series of up to MAX arrays (chunks) owning objects of type T, chunk k holds firstArrayLength * 2^k objects,
+*	growing allocates one more chunk and never moves or copies existing objects, so pointers and references stay
+*	valid until their object is erased, append is O(1) and objects are not individually heap allocated
+*
+*	erase() moves the last object into the gap (O(1), only the moved object changes its address), with FREE_LISTS
+*	the gap is left instead and kept in its chunk's free list, emplace() fills gaps before appending and iteration
+*	skips them, so no object ever moves (operator[] then takes slot indices, which include the gaps)
+*
+*	chunks are reached through a fixed table rather than a linked list, so operator[] is O(1) as well,
+*	T may be incomplete where the series is declared, as with std::unique_ptr it must be complete where it is destroyed */
+template <class T, unsigned int MAX = 24, bool FREE_LISTS = false>
+class LinkedArraySeries
+{
+	struct Chunk
+	{
+		T* elements = nullptr; // raw storage, slots below used are constructed (unless freed)
+		uint32_t length = 0;
+		uint32_t used = 0; // slots handed out, every chunk before the last one in use is full
+		std::vector<uint32_t> freeSlots; // FREE_LISTS only
+		std::vector<uint8_t> alive; // FREE_LISTS only, per slot
 	};
 
 public:
-	// <T, AMAX> series holds at most MAX arrays (nodes) which can own objects of type T
-	LinkedArraySeries(const uint32_t& firstArrayLength)
+	explicit LinkedArraySeries(uint32_t firstArrayLength = 16) : firstLength{ firstArrayLength }
+	{
+		assert(firstArrayLength > 0 && "first array length must be above 0");
+	}
+	~LinkedArraySeries() { clear(); release(); }
+
+	LinkedArraySeries(const LinkedArraySeries&) = delete;
+	LinkedArraySeries& operator=(const LinkedArraySeries&) = delete;
+	LinkedArraySeries(LinkedArraySeries&& other) noexcept { swap(other); }
+	LinkedArraySeries& operator=(LinkedArraySeries&& other) noexcept
+	{
+		if (this != &other) { clear(); release(); swap(other); }
+		return *this;
+	}
+
+	// constructs at the end, existing objects stay where they are
+	template<typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		uint32_t k = last;
+		if (chunks[k].used == chunks[k].length)
+		{
+			if (chunks[k].length != 0) { k++; }
+			if (k == MAX) { throw std::runtime_error("LinkedArraySeries is full, all of its arrays are in use"); }
+			allocate(k);
+		}
+		Chunk& chunk = chunks[k];
+		T* object = new (chunk.elements + chunk.used) T(std::forward<Args>(args)...);
+		if constexpr (FREE_LISTS) { chunk.alive.push_back(1); }
+		chunk.used++;
+		last = k;
+		count++;
+		return *object;
+	}
+	T& push_back(const T& value) { return emplace_back(value); }
+	T& push_back(T&& value) { return emplace_back(std::move(value)); }
+
+	// fills the gap left by the latest erase in the lowest chunk that has one, appends if there is none
+	template<typename... Args>
+	T& emplace(Args&&... args)
+	{
+		static_assert(FREE_LISTS, "emplace() reuses gaps, use emplace_back() without FREE_LISTS");
+		for (uint32_t k = 0; k <= last; k++)
+		{
+			Chunk& chunk = chunks[k];
+			if (chunk.freeSlots.empty()) { continue; }
+			const uint32_t slot = chunk.freeSlots.back();
+			T* object = new (chunk.elements + slot) T(std::forward<Args>(args)...);
+			chunk.freeSlots.pop_back();
+			chunk.alive[slot] = 1;
+			count++;
+			return *object;
+		}
+		return emplace_back(std::forward<Args>(args)...);
+	}
+
+	/*	without FREE_LISTS the last object is moved into index (its address changes) and the series shrinks by one,
+	*	the erased object is destroyed and the last one move-constructed in its place, so T needs a noexcept move
+	*	constructor but no assignment (objects holding references have none, e.g. Primitive, which is not movable
+	*	at all and needs FREE_LISTS to be erased)
+	*	with FREE_LISTS the object at slot index is destroyed in place and its slot reused by emplace() */
+	void erase(size_t index)
+	{
+		uint32_t k, offset;
+		locate(index, k, offset);
+		Chunk& chunk = chunks[k];
+		if constexpr (FREE_LISTS)
+		{
+			assert(chunk.alive[offset] && "erasing a free slot");
+			chunk.elements[offset].~T();
+			chunk.alive[offset] = 0;
+			chunk.freeSlots.push_back(offset);
+			count--;
+		}
+		else
+		{
+			static_assert(std::is_nothrow_move_constructible<T>::value, "erase() moves the last object into the gap, T needs a noexcept move constructor");
+			Chunk& tail = chunks[last];
+			T* gap = chunk.elements + offset;
+			T* back = tail.elements + tail.used - 1;
+			if (gap != back)
+			{
+				gap->~T();
+				new (gap) T(std::move(*back));
+			}
+			pop_back();
+		}
+	}
+
+	void pop_back()
+	{
+		static_assert(!FREE_LISTS, "pop_back() would leave the free lists pointing past the end");
+		assert(count > 0 && "pop_back() on an empty series");
+		Chunk& tail = chunks[last];
+		tail.elements[--tail.used].~T();
+		count--;
+		if (tail.used == 0 && last > 0) { last--; } // its storage is kept for the next append
+	}
+
+	// destroys every object, allocated arrays are kept
+	void clear()
+	{
+		for (uint32_t k = 0; k <= last; k++)
+		{
+			Chunk& chunk = chunks[k];
+			for (uint32_t i = 0; i < chunk.used; i++)
+			{
+				if (!FREE_LISTS || chunk.alive[i]) { chunk.elements[i].~T(); }
+			}
+			chunk.used = 0;
+			chunk.freeSlots.clear();
+			chunk.alive.clear();
+		}
+		last = 0;
+		count = 0;
+	}
+
+	// allocates arrays until n objects fit without further allocations
+	void reserve(size_t n)
 	{
-		assert(initArrayLength > 0);
-		elementSizeBytes = sizeof(T);
-		series.push_back(std::move(new T[n]));
+		for (uint32_t k = 0; k < MAX && capacity() < n; k++)
+		{
+			if (chunks[k].length == 0) { allocate(k); }
+		}
+		if (capacity() < n) { throw std::runtime_error("LinkedArraySeries cannot hold the reserved size"); }
 	}
-	// deletes everything in the container
-	LinkedArraySeries(const uint32_t& arrSize)
+
+	// objects (without gaps)
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	// slots handed out, including gaps, the upper bound of slot indices
+	size_t slotCount() const { return chunkStart(last) + chunks[last].used; }
+	size_t capacity() const
 	{
+		size_t total = 0;
+		for (const Chunk& chunk : chunks) { total += chunk.length; }
+		return total;
+	}
 
+	T& operator[](size_t index) { uint32_t k, offset; locate(index, k, offset); return chunks[k].elements[offset]; }
+	const T& operator[](size_t index) const { uint32_t k, offset; locate(index, k, offset); return chunks[k].elements[offset]; }
+	T& back() { const Chunk& tail = chunks[last]; return tail.elements[tail.used - 1]; }
+
+	// slot index of an object in the series, O(MAX)
+	size_t indexOf(const T* object) const
+	{
+		for (uint32_t k = 0; k <= last; k++)
+		{
+			const Chunk& chunk = chunks[k];
+			if (object >= chunk.elements && object < chunk.elements + chunk.used) { return chunkStart(k) + static_cast<size_t>(object - chunk.elements); }
+		}
+		throw std::runtime_error("object is not part of this LinkedArraySeries");
 	}
-	void initSeries(const uint32_t& n) { series[n]; }
 
-	size_t nodeSizeBytes;
-	std::array<LnkArr*, MAX> series;
+	// visits objects in slot order, chunk by chunk, gaps are skipped
+	template<typename S, typename V>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = V;
+		using pointer = V*;
+		using reference = V&;
 
+		Iterator(S* series, uint32_t chunk, uint32_t offset) : series{ series }, chunk{ chunk }, offset{ offset } { skipFree(); }
+		reference operator*() const { return series->chunks[chunk].elements[offset]; }
+		pointer operator->() const { return &series->chunks[chunk].elements[offset]; }
+		Iterator& operator++() { step(); skipFree(); return *this; }
+		Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+		friend bool operator== (const Iterator& a, const Iterator& b) { return a.chunk == b.chunk && a.offset == b.offset; };
+		friend bool operator!= (const Iterator& a, const Iterator& b) { return !(a == b); };
+	private:
+		void step()
+		{
+			offset++;
+			if (offset == series->chunks[chunk].used && chunk < series->last) { chunk++; offset = 0; }
+		}
+		void skipFree()
+		{
+			if constexpr (FREE_LISTS)
+			{
+				while (offset < series->chunks[chunk].used && !series->chunks[chunk].alive[offset]) { step(); }
+			}
+		}
+		S* series;
+		uint32_t chunk;
+		uint32_t offset;
+	};
+	using iterator = Iterator<LinkedArraySeries, T>;
+	using const_iterator = Iterator<const LinkedArraySeries, const T>;
+
+	iterator begin() { return iterator(this, 0, 0); }
+	iterator end() { return iterator(this, last, chunks[last].used); }
+	const_iterator begin() const { return const_iterator(this, 0, 0); }
+	const_iterator end() const { return const_iterator(this, last, chunks[last].used); }
+
+private:
+	std::array<Chunk, MAX> chunks{};
+	uint32_t firstLength = 16;
+	uint32_t last = 0; // last chunk in use, chunk 0 while empty
+	size_t count = 0;
 
+	// index of the first slot of chunk k, the lengths before it sum up to firstLength * (2^k - 1)
+	size_t chunkStart(uint32_t k) const { return static_cast<size_t>(firstLength) * ((size_t{ 1 } << k) - 1); }
+
+	void locate(size_t index, uint32_t& chunkOut, uint32_t& offsetOut) const
+	{
+		assert(index < slotCount() && "LinkedArraySeries index out of range");
+		// chunk k starts at firstLength * (2^k - 1), so k is the position of the highest bit of index / firstLength + 1
+		size_t scaled = index / firstLength + 1;
+		uint32_t k = 0;
+		while (scaled >>= 1) { k++; }
+		chunkOut = k;
+		offsetOut = static_cast<uint32_t>(index - chunkStart(k));
+	}
+
+	void allocate(uint32_t k)
+	{
+		Chunk& chunk = chunks[k];
+		if (chunk.length != 0) { return; } // kept from before a clear or pop_back
+		const uint32_t length = firstLength << k;
+		chunk.elements = static_cast<T*>(::operator new(sizeof(T) * length, std::align_val_t(alignof(T))));
+		chunk.length = length;
+		if constexpr (FREE_LISTS) { chunk.alive.reserve(length); }
+	}
+
+	// frees the storage of every array, objects must have been destroyed
+	void release()
+	{
+		for (Chunk& chunk : chunks)
+		{
+			if (chunk.elements) { ::operator delete(chunk.elements, std::align_val_t(alignof(T))); }
+			chunk = Chunk{};
+		}
+	}
+
+	void swap(LinkedArraySeries& other) noexcept
+	{
+		std::swap(chunks, other.chunks);
+		std::swap(firstLength, other.firstLength);
+		std::swap(last, other.last);
+		std::swap(count, other.count);
+	}
 };
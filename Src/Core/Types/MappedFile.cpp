@@ -0,0 +1,72 @@
+#include "Core/Types/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::open(const std::string& path)
+{
+	close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { return false; }
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { CloseHandle(file); return false; }
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) { CloseHandle(file); return false; }
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+
+	fileHandle = file;
+	mappingHandle = mapping;
+	mapped = static_cast<const uint8_t*>(view);
+	length = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) { return false; }
+	struct stat st{};
+	if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+
+	void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED) { ::close(fd); return false; }
+	madvise(view, static_cast<size_t>(st.st_size), MADV_WILLNEED);
+
+	fileDescriptor = fd;
+	mapped = static_cast<const uint8_t*>(view);
+	length = static_cast<size_t>(st.st_size);
+#endif
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (!mapped) { return; }
+#ifdef _WIN32
+	UnmapViewOfFile(mapped);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+	mappingHandle = fileHandle = nullptr;
+#else
+	munmap(const_cast<uint8_t*>(mapped), length);
+	::close(fileDescriptor);
+	fileDescriptor = -1;
+#endif
+	mapped = nullptr;
+	length = 0;
+}
+
+void MappedFile::prefetch() const
+{
+	// one read per 4 KiB page, volatile so the loop is not optimized away
+	volatile uint8_t sink = 0;
+	for (size_t i = 0; i < length; i += 4096) { sink = sink + mapped[i]; }
+}
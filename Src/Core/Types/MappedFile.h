@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+
+/*	read-only memory-mapped file, the contents are paged in by the OS on first access,
+*	so data can be copied straight from the mapping without an intermediate read buffer */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile() { close(); }
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// returns false if the file does not exist or cannot be mapped
+	bool open(const std::string& path);
+	void close();
+
+	// touches every page so later reads (e.g. on the render thread) do not fault
+	void prefetch() const;
+
+	const uint8_t* data() const { return mapped; }
+	size_t size() const { return length; }
+	bool isOpen() const { return mapped != nullptr; }
+
+private:
+	const uint8_t* mapped = nullptr;
+	size_t length = 0;
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#else
+	int fileDescriptor = -1;
+#endif
+};
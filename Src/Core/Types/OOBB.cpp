@@ -0,0 +1,241 @@
+#include "Core/Types/OOBB.h"
+#include "Core/Types/SimdLanes.h"
+
+#include <cfloat>
+
+namespace
+{
+	// same NaN behaviour as minps/maxps (second operand is returned), so scalar and SIMD results match exactly
+	inline float laneMin(float a, float b) { return a < b ? a : b; }
+	inline float laneMax(float a, float b) { return a > b ? a : b; }
+
+#ifdef SIMD_LANES
+	using Simd::Lanes;
+#endif
+	constexpr size_t PADDING = Simd::MAX_LANES; // arrays are always a multiple of the widest lane count
+}
+
+OOBB OOBB::fromTransform(const Vec& boundsMin, const Vec& boundsMax, const Transform& transform)
+{
+	return fromMatrix(boundsMin, boundsMax, transform.mat4());
+}
+
+OOBB OOBB::fromMatrix(const Vec& boundsMin, const Vec& boundsMax, const glm::mat4& m)
+{
+	const Vec localCenter = (boundsMin + boundsMax) * .5f;
+	const Vec localHalf = (boundsMax - boundsMin) * .5f;
+
+	OOBB box{};
+	float scale[3];
+	for (int k = 0; k < 3; k++)
+	{
+		// each basis column holds rotation * scale, split it into a unit axis and its length
+		const Vec column{ m[k][0], m[k][1], m[k][2] };
+		scale[k] = std::sqrt(Vec::dot(column, column));
+		if (scale[k] > EPSILON_F) { box.axes[k] = column * (1.f / scale[k]); }
+	}
+	const glm::vec4 c = m * glm::vec4(localCenter.x, localCenter.y, localCenter.z, 1.f);
+	box.center = Vec{ c.x, c.y, c.z };
+	box.halfExtents = Vec{ localHalf.x * scale[0], localHalf.y * scale[1], localHalf.z * scale[2] };
+	return box;
+}
+
+bool OOBB::containsPoint(const Vec& point) const
+{
+	const Vec d = point - center;
+	return std::abs(Vec::dot(d, axes[0])) <= halfExtents.x
+		&& std::abs(Vec::dot(d, axes[1])) <= halfExtents.y
+		&& std::abs(Vec::dot(d, axes[2])) <= halfExtents.z;
+}
+
+bool OOBB::intersectRay(const Vec& origin, const Vec& dir, float& tOut) const
+{
+	const Vec d = origin - center;
+	const float half[3] = { halfExtents.x, halfExtents.y, halfExtents.z };
+	float tMin = 0.f;
+	float tMax = FLT_MAX;
+	for (int k = 0; k < 3; k++)
+	{
+		// slab of axis k in box space, a zero direction component yields +-inf and is handled by the min/max
+		const float o = Vec::dot(d, axes[k]);
+		const float inv = 1.f / Vec::dot(dir, axes[k]);
+		const float t1 = (-half[k] - o) * inv;
+		const float t2 = (half[k] - o) * inv;
+		tMin = laneMax(tMin, laneMin(t1, t2));
+		tMax = laneMin(tMax, laneMax(t1, t2));
+	}
+	tOut = tMin;
+	return tMin <= tMax;
+}
+
+void OOBBBatch::clear()
+{
+	for (auto& c : data) { c.clear(); }
+	count = 0;
+}
+
+void OOBBBatch::reserve(size_t n)
+{
+	for (auto& c : data) { c.reserve(n + PADDING); }
+}
+
+uint32_t OOBBBatch::add(const OOBB& box)
+{
+	if (count % PADDING == 0)
+	{
+		for (auto& c : data) { c.resize(count + PADDING, 0.f); }
+	}
+	const float values[COMPONENT_COUNT] =
+	{
+		box.center.x, box.center.y, box.center.z,
+		box.axes[0].x, box.axes[0].y, box.axes[0].z,
+		box.axes[1].x, box.axes[1].y, box.axes[1].z,
+		box.axes[2].x, box.axes[2].y, box.axes[2].z,
+		box.halfExtents.x, box.halfExtents.y, box.halfExtents.z,
+	};
+	for (int c = 0; c < COMPONENT_COUNT; c++) { data[c][count] = values[c]; }
+	return static_cast<uint32_t>(count++);
+}
+
+OOBB OOBBBatch::get(size_t i) const
+{
+	OOBB box{};
+	box.center = Vec{ data[CX][i], data[CY][i], data[CZ][i] };
+	box.axes[0] = Vec{ data[A0X][i], data[A0Y][i], data[A0Z][i] };
+	box.axes[1] = Vec{ data[A1X][i], data[A1Y][i], data[A1Z][i] };
+	box.axes[2] = Vec{ data[A2X][i], data[A2Y][i], data[A2Z][i] };
+	box.halfExtents = Vec{ data[HX][i], data[HY][i], data[HZ][i] };
+	return box;
+}
+
+uint32_t OOBBBatch::getLaneWidth()
+{
+#ifdef SIMD_LANES
+	return Lanes::WIDTH;
+#else
+	return 1;
+#endif
+}
+
+void OOBBBatch::queryPointScalar(const Vec& point, std::vector<uint32_t>& hitsOut) const
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (get(i).containsPoint(point)) { hitsOut.push_back(static_cast<uint32_t>(i)); }
+	}
+}
+
+void OOBBBatch::queryRayScalar(const Vec& origin, const Vec& dir, std::vector<RayHit>& hitsOut) const
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		float t;
+		if (get(i).intersectRay(origin, dir, t)) { hitsOut.push_back(RayHit{ static_cast<uint32_t>(i), t }); }
+	}
+}
+
+#ifdef SIMD_LANES
+
+void OOBBBatch::queryPoint(const Vec& point, std::vector<uint32_t>& hitsOut) const
+{
+	using L = Lanes;
+	const L::F px = L::set(point.x), py = L::set(point.y), pz = L::set(point.z);
+	const float* c[COMPONENT_COUNT];
+	for (int k = 0; k < COMPONENT_COUNT; k++) { c[k] = data[k].data(); }
+
+	for (size_t i = 0; i < count; i += L::WIDTH)
+	{
+		const L::F dx = L::sub(px, L::load(c[CX] + i));
+		const L::F dy = L::sub(py, L::load(c[CY] + i));
+		const L::F dz = L::sub(pz, L::load(c[CZ] + i));
+
+		// |dot(p - center, axis)| <= halfExtent on all three box axes
+		L::F inside = L::lessEqual(L::abs(L::add(L::add(L::mul(dx, L::load(c[A0X] + i)), L::mul(dy, L::load(c[A0Y] + i))), L::mul(dz, L::load(c[A0Z] + i)))), L::load(c[HX] + i));
+		inside = L::bitAnd(inside, L::lessEqual(L::abs(L::add(L::add(L::mul(dx, L::load(c[A1X] + i)), L::mul(dy, L::load(c[A1Y] + i))), L::mul(dz, L::load(c[A1Z] + i)))), L::load(c[HY] + i)));
+		inside = L::bitAnd(inside, L::lessEqual(L::abs(L::add(L::add(L::mul(dx, L::load(c[A2X] + i)), L::mul(dy, L::load(c[A2Y] + i))), L::mul(dz, L::load(c[A2Z] + i)))), L::load(c[HZ] + i)));
+
+		uint32_t mask = L::mask(inside);
+		for (uint32_t lane = 0; mask != 0; lane++, mask >>= 1)
+		{
+			if ((mask & 1) && i + lane < count) { hitsOut.push_back(static_cast<uint32_t>(i + lane)); }
+		}
+	}
+}
+
+template<typename OnHit>
+void OOBBBatch::forEachRayHit(const Vec& origin, const Vec& dir, OnHit&& onHit) const
+{
+	using L = Lanes;
+	const float* c[COMPONENT_COUNT];
+	for (int k = 0; k < COMPONENT_COUNT; k++) { c[k] = data[k].data(); }
+	const L::F ox = L::set(origin.x), oy = L::set(origin.y), oz = L::set(origin.z);
+	const L::F rx = L::set(dir.x), ry = L::set(dir.y), rz = L::set(dir.z);
+	const L::F zero = L::set(0.f);
+	alignas(32) float tEntry[L::WIDTH];
+
+	for (size_t i = 0; i < count; i += L::WIDTH)
+	{
+		const L::F dx = L::sub(ox, L::load(c[CX] + i));
+		const L::F dy = L::sub(oy, L::load(c[CY] + i));
+		const L::F dz = L::sub(oz, L::load(c[CZ] + i));
+		L::F tMin = zero;
+		L::F tMax = L::set(FLT_MAX);
+
+		const int axisX[3] = { A0X, A1X, A2X };
+		const int halfComponent[3] = { HX, HY, HZ };
+		for (int k = 0; k < 3; k++)
+		{
+			const L::F ax = L::load(c[axisX[k]] + i), ay = L::load(c[axisX[k] + 1] + i), az = L::load(c[axisX[k] + 2] + i);
+			const L::F h = L::load(c[halfComponent[k]] + i);
+			const L::F o = L::add(L::add(L::mul(dx, ax), L::mul(dy, ay)), L::mul(dz, az));
+			const L::F inv = L::div(L::set(1.f), L::add(L::add(L::mul(rx, ax), L::mul(ry, ay)), L::mul(rz, az)));
+			const L::F t1 = L::mul(L::sub(L::sub(zero, h), o), inv);
+			const L::F t2 = L::mul(L::sub(h, o), inv);
+			tMin = L::max(tMin, L::min(t1, t2));
+			tMax = L::min(tMax, L::max(t1, t2));
+		}
+
+		uint32_t mask = L::mask(L::lessEqual(tMin, tMax));
+		if (mask == 0) { continue; }
+		L::store(tEntry, tMin);
+		for (uint32_t lane = 0; mask != 0; lane++, mask >>= 1)
+		{
+			if ((mask & 1) && i + lane < count) { onHit(static_cast<uint32_t>(i + lane), tEntry[lane]); }
+		}
+	}
+}
+
+void OOBBBatch::queryRay(const Vec& origin, const Vec& dir, std::vector<RayHit>& hitsOut) const
+{
+	forEachRayHit(origin, dir, [&hitsOut](uint32_t index, float t) { hitsOut.push_back(RayHit{ index, t }); });
+}
+
+bool OOBBBatch::raycast(const Vec& origin, const Vec& dir, RayHit& hitOut) const
+{
+	bool hit = false;
+	forEachRayHit(origin, dir, [&hit, &hitOut](uint32_t index, float t)
+	{
+		if (!hit || t < hitOut.t) { hitOut = RayHit{ index, t }; }
+		hit = true;
+	});
+	return hit;
+}
+
+#else
+
+void OOBBBatch::queryPoint(const Vec& point, std::vector<uint32_t>& hitsOut) const { queryPointScalar(point, hitsOut); }
+
+void OOBBBatch::queryRay(const Vec& origin, const Vec& dir, std::vector<RayHit>& hitsOut) const { queryRayScalar(origin, dir, hitsOut); }
+
+bool OOBBBatch::raycast(const Vec& origin, const Vec& dir, RayHit& hitOut) const
+{
+	bool hit = false;
+	for (size_t i = 0; i < count; i++)
+	{
+		float t;
+		if (get(i).intersectRay(origin, dir, t) && (!hit || t < hitOut.t)) { hitOut = RayHit{ static_cast<uint32_t>(i), t }; hit = true; }
+	}
+	return hit;
+}
+
+#endif
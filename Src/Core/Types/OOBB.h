@@ -0,0 +1,66 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+// object oriented bounding box in world (or sector-local) space
+struct OOBB
+{
+	Vec center{};
+	Vec axes[3]{ { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f, 1.f } }; // unit length, the box's local x, y and z
+	Vec halfExtents{};
+
+	// box around local bounds [boundsMin, boundsMax] after applying transform (rotation, scale and translation)
+	static OOBB fromTransform(const Vec& boundsMin, const Vec& boundsMax, const Transform& transform);
+	// same, from a local to world matrix (rotation, scale and translation, no projection)
+	static OOBB fromMatrix(const Vec& boundsMin, const Vec& boundsMax, const glm::mat4& m);
+
+	bool containsPoint(const Vec& point) const;
+	// slab test, returns the entry distance along dir in tOut (0 if origin is inside), dir does not need to be normalized
+	bool intersectRay(const Vec& origin, const Vec& dir, float& tOut) const;
+	float getBoundingRadius() const { return std::sqrt(Vec::dot(halfExtents, halfExtents)); }
+};
+
+/*	many boxes stored as structure of arrays, so one point or ray is tested against 4 (SSE) or 8 (AVX) boxes per instruction,
+*	the scalar versions of each query give the same results and exist as a reference (and for non-x86 targets),
+*	ray distances are bit-identical as long as the compiler does not contract the scalar math into FMA */
+class OOBBBatch
+{
+public:
+	struct RayHit
+	{
+		uint32_t index;
+		float t;
+	};
+
+	void clear();
+	void reserve(size_t count);
+	// returns the index of the added box
+	uint32_t add(const OOBB& box);
+	size_t size() const { return count; }
+
+	// appends the indices of all boxes containing point, in ascending order
+	void queryPoint(const Vec& point, std::vector<uint32_t>& hitsOut) const;
+	void queryPointScalar(const Vec& point, std::vector<uint32_t>& hitsOut) const;
+	// appends every box hit by the ray, in ascending index order
+	void queryRay(const Vec& origin, const Vec& dir, std::vector<RayHit>& hitsOut) const;
+	void queryRayScalar(const Vec& origin, const Vec& dir, std::vector<RayHit>& hitsOut) const;
+	// closest box hit by the ray, returns false if nothing was hit
+	bool raycast(const Vec& origin, const Vec& dir, RayHit& hitOut) const;
+
+	// number of boxes processed per SIMD instruction (1 if compiled without SSE)
+	static uint32_t getLaneWidth();
+
+private:
+	// one array per component, padded to a multiple of 8 so full SIMD loads stay in bounds (lanes past count are ignored)
+	enum Component { CX = 0, CY, CZ, A0X, A0Y, A0Z, A1X, A1Y, A1Z, A2X, A2Y, A2Z, HX, HY, HZ, COMPONENT_COUNT };
+	std::vector<float> data[COMPONENT_COUNT];
+	size_t count = 0;
+
+	OOBB get(size_t i) const;
+	// SIMD slab test of every box, calls onHit(index, t) in ascending index order
+	template<typename OnHit>
+	void forEachRayHit(const Vec& origin, const Vec& dir, OnHit&& onHit) const;
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+
+/*	thin wrapper around the widest float SIMD instruction set enabled at compile time (AVX: 8 lanes, SSE2: 4 lanes),
+*	kernels are written once against Simd::Lanes, SIMD_LANES is undefined on targets without either,
+*	loads and stores are unaligned since the data usually lives in std::vector */
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SIMD_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_LANES 4
+#endif
+
+namespace Simd
+{
+	// arrays processed with Lanes should be padded to a multiple of this, independent of the instruction set in use
+	constexpr uint32_t MAX_LANES = 8;
+
+#if SIMD_LANES == 8
+	struct Lanes
+	{
+		using F = __m256;
+		static constexpr uint32_t WIDTH = 8;
+		static F load(const float* p) { return _mm256_loadu_ps(p); }
+		static void store(float* p, F a) { _mm256_storeu_ps(p, a); }
+		static F set(float v) { return _mm256_set1_ps(v); }
+		static F add(F a, F b) { return _mm256_add_ps(a, b); }
+		static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+		static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+		static F div(F a, F b) { return _mm256_div_ps(a, b); }
+		static F sqrt(F a) { return _mm256_sqrt_ps(a); }
+		static F min(F a, F b) { return _mm256_min_ps(a, b); }
+		static F max(F a, F b) { return _mm256_max_ps(a, b); }
+		static F abs(F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+		static F lessEqual(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		static F bitAnd(F a, F b) { return _mm256_and_ps(a, b); }
+		static uint32_t mask(F a) { return static_cast<uint32_t>(_mm256_movemask_ps(a)); }
+	};
+#elif SIMD_LANES == 4
+	struct Lanes
+	{
+		using F = __m128;
+		static constexpr uint32_t WIDTH = 4;
+		static F load(const float* p) { return _mm_loadu_ps(p); }
+		static void store(float* p, F a) { _mm_storeu_ps(p, a); }
+		static F set(float v) { return _mm_set1_ps(v); }
+		static F add(F a, F b) { return _mm_add_ps(a, b); }
+		static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+		static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+		static F div(F a, F b) { return _mm_div_ps(a, b); }
+		static F sqrt(F a) { return _mm_sqrt_ps(a); }
+		static F min(F a, F b) { return _mm_min_ps(a, b); }
+		static F max(F a, F b) { return _mm_max_ps(a, b); }
+		static F abs(F a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+		static F lessEqual(F a, F b) { return _mm_cmple_ps(a, b); }
+		static F bitAnd(F a, F b) { return _mm_and_ps(a, b); }
+		static uint32_t mask(F a) { return static_cast<uint32_t>(_mm_movemask_ps(a)); }
+	};
+#endif
+
+}
@@ -0,0 +1,56 @@
+#include "Core/Types/SimdVector.h"
+
+namespace VecBatch
+{
+	void toVec3A(const Vec* in, Vec3A* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) { out[i] = Vec3A(in[i]); }
+	}
+
+	void toVec(const Vec3A* in, Vec* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			// a full 16 byte store into Vec storage would overrun the array at its last element
+			alignas(16) float f[4];
+			Simd::Quad::store(f, in[i].v);
+			out[i] = Vec{ f[0], f[1], f[2] };
+		}
+	}
+
+	void normalize(Vec3A* vectors, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) { vectors[i] = vectors[i].normalized(); }
+	}
+
+	void dot(const Vec3A* a, const Vec3A* b, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) { out[i] = Vec3A::dot(a[i], b[i]); }
+	}
+
+	void cross(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) { out[i] = Vec3A::cross(a[i], b[i]); }
+	}
+
+	void scaleAdd(const Vec3A* a, const Vec3A* b, float scale, Vec3A* out, size_t count)
+	{
+		const Simd::Quad::R s = Simd::Quad::splat(scale);
+		for (size_t i = 0; i < count; i++) { out[i] = Vec3A{ Simd::Quad::add(a[i].v, Simd::Quad::mul(b[i].v, s)) }; }
+	}
+
+#ifdef GLM_VERSION
+	void transformPoints(const glm::mat4& m, const Vec3A* in, Vec3A* out, size_t count)
+	{
+		using namespace Simd::Quad;
+		// glm is column major, the point is the sum of the columns scaled by its components
+		const R c0 = load(&m[0].x), c1 = load(&m[1].x), c2 = load(&m[2].x), c3 = load(&m[3].x);
+		for (size_t i = 0; i < count; i++)
+		{
+			const R p = in[i].v;
+			const R r = add(add(mul(c0, splat(lane<0>(p))), mul(c1, splat(lane<1>(p)))), add(mul(c2, splat(lane<2>(p))), c3));
+			out[i] = Vec3A{ zeroW(r) };
+		}
+	}
+#endif
+}
@@ -0,0 +1,222 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+
+#include <stddef.h>
+#include <cmath>
+
+/*	Vec3A and Vec4, float vectors held in one 128 bit register (SSE2, or NEON on AArch64, plain floats elsewhere),
+*	for hot code that works on whole vectors at a time (directions, normals, points being transformed)
+*
+*	Vec3A is Vec padded to 16 bytes and 16 byte aligned, the w lane is kept at 0 by every operation, so a Vec3A
+*	array is 4/3 the size of a Vec array, convert to Vec for storage and interfaces, loops that stream one component
+*	of many bodies at a time are better off with structure of arrays and Simd::Lanes (see BodyStore)
+*
+*	the batch functions in VecBatch run an operation over whole arrays and are the intended way to do millions of them */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_QUAD_SSE
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SIMD_QUAD_NEON
+#endif
+
+namespace Simd
+{
+	// one register of 4 floats and the operations Vec3A and Vec4 are built from
+	namespace Quad
+	{
+#if defined(SIMD_QUAD_SSE)
+		using R = __m128;
+		inline R set(float x, float y, float z, float w) { return _mm_set_ps(w, z, y, x); }
+		inline R splat(float v) { return _mm_set1_ps(v); }
+		inline R load(const float* p) { return _mm_loadu_ps(p); }
+		inline void store(float* p, R a) { _mm_storeu_ps(p, a); }
+		inline R add(R a, R b) { return _mm_add_ps(a, b); }
+		inline R sub(R a, R b) { return _mm_sub_ps(a, b); }
+		inline R mul(R a, R b) { return _mm_mul_ps(a, b); }
+		inline R div(R a, R b) { return _mm_div_ps(a, b); }
+		inline R min(R a, R b) { return _mm_min_ps(a, b); }
+		inline R max(R a, R b) { return _mm_max_ps(a, b); }
+		template<int i> float lane(R a) { return _mm_cvtss_f32(_mm_shuffle_ps(a, a, _MM_SHUFFLE(i, i, i, i))); }
+		// x + y + z in every lane
+		inline R sum3(R a)
+		{
+			return _mm_add_ps(_mm_add_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1))), _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)));
+		}
+		// x + y + z + w in every lane
+		inline R sum4(R a)
+		{
+			const R pairs = _mm_add_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+		// (y, z, x, w)
+		inline R yzx(R a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)); }
+		inline R zeroW(R a) { return _mm_and_ps(a, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1))); }
+		// a where limit <= b, else 0
+		inline R keepIfAtLeast(R a, R b, R limit) { return _mm_and_ps(a, _mm_cmple_ps(limit, b)); }
+		// hardware estimate (12 bits) refined by one Newton-Raphson step (about 22 bits)
+		inline R rsqrt(R a)
+		{
+			const R e = _mm_rsqrt_ps(a);
+			return mul(mul(splat(.5f), e), sub(splat(3.f), mul(mul(a, e), e)));
+		}
+#elif defined(SIMD_QUAD_NEON)
+		using R = float32x4_t;
+		inline R set(float x, float y, float z, float w) { const float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+		inline R splat(float v) { return vdupq_n_f32(v); }
+		inline R load(const float* p) { return vld1q_f32(p); }
+		inline void store(float* p, R a) { vst1q_f32(p, a); }
+		inline R add(R a, R b) { return vaddq_f32(a, b); }
+		inline R sub(R a, R b) { return vsubq_f32(a, b); }
+		inline R mul(R a, R b) { return vmulq_f32(a, b); }
+		inline R div(R a, R b) { return vdivq_f32(a, b); }
+		inline R min(R a, R b) { return vminq_f32(a, b); }
+		inline R max(R a, R b) { return vmaxq_f32(a, b); }
+		template<int i> float lane(R a) { return vgetq_lane_f32(a, i); }
+		inline R sum3(R a) { return vdupq_n_f32(vgetq_lane_f32(a, 0) + vgetq_lane_f32(a, 1) + vgetq_lane_f32(a, 2)); }
+		inline R sum4(R a) { return vdupq_n_f32(vaddvq_f32(a)); }
+		inline R yzx(R a)
+		{
+			const R rotated = vextq_f32(a, a, 1); // (y, z, w, x)
+			return vsetq_lane_f32(vgetq_lane_f32(a, 3), vsetq_lane_f32(vgetq_lane_f32(a, 0), rotated, 2), 3);
+		}
+		inline R zeroW(R a) { return vsetq_lane_f32(0.f, a, 3); }
+		inline R keepIfAtLeast(R a, R b, R limit) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vcleq_f32(limit, b))); }
+		inline R rsqrt(R a)
+		{
+			const R e = vrsqrteq_f32(a);
+			return vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a, e), e));
+		}
+#else
+		struct R { float f[4]; };
+		inline R set(float x, float y, float z, float w) { return R{ { x, y, z, w } }; }
+		inline R splat(float v) { return R{ { v, v, v, v } }; }
+		inline R load(const float* p) { return R{ { p[0], p[1], p[2], p[3] } }; }
+		inline void store(float* p, R a) { for (int i = 0; i < 4; i++) { p[i] = a.f[i]; } }
+		inline R add(R a, R b) { for (int i = 0; i < 4; i++) { a.f[i] += b.f[i]; } return a; }
+		inline R sub(R a, R b) { for (int i = 0; i < 4; i++) { a.f[i] -= b.f[i]; } return a; }
+		inline R mul(R a, R b) { for (int i = 0; i < 4; i++) { a.f[i] *= b.f[i]; } return a; }
+		inline R div(R a, R b) { for (int i = 0; i < 4; i++) { a.f[i] /= b.f[i]; } return a; }
+		inline R min(R a, R b) { for (int i = 0; i < 4; i++) { a.f[i] = a.f[i] < b.f[i] ? a.f[i] : b.f[i]; } return a; }
+		inline R max(R a, R b) { for (int i = 0; i < 4; i++) { a.f[i] = a.f[i] > b.f[i] ? a.f[i] : b.f[i]; } return a; }
+		template<int i> float lane(R a) { return a.f[i]; }
+		inline R sum3(R a) { return splat(a.f[0] + a.f[1] + a.f[2]); }
+		inline R sum4(R a) { return splat(a.f[0] + a.f[1] + a.f[2] + a.f[3]); }
+		inline R yzx(R a) { return set(a.f[1], a.f[2], a.f[0], a.f[3]); }
+		inline R zeroW(R a) { a.f[3] = 0.f; return a; }
+		inline R keepIfAtLeast(R a, R b, R limit) { for (int i = 0; i < 4; i++) { a.f[i] = limit.f[i] <= b.f[i] ? a.f[i] : 0.f; } return a; }
+		inline R rsqrt(R a) { for (int i = 0; i < 4; i++) { a.f[i] = 1.f / std::sqrt(a.f[i]); } return a; }
+#endif
+	}
+}
+
+struct alignas(16) Vec4
+{
+	Simd::Quad::R v;
+
+	Vec4() : v{ Simd::Quad::splat(0.f) } {}
+	Vec4(float x, float y, float z, float w) : v{ Simd::Quad::set(x, y, z, w) } {}
+	explicit Vec4(float s) : v{ Simd::Quad::splat(s) } {}
+	explicit Vec4(Simd::Quad::R r) : v{ r } {}
+	Vec4(const Vec& xyz, float w) : v{ Simd::Quad::set(xyz.x, xyz.y, xyz.z, w) } {}
+#ifdef GLM_VERSION
+	explicit Vec4(const glm::vec4& g) : v{ Simd::Quad::set(g.x, g.y, g.z, g.w) } {}
+	glm::vec4 toGlm() const { return glm::vec4(x(), y(), z(), w()); }
+#endif
+
+	// unaligned, 4 floats
+	static Vec4 load(const float* p) { return Vec4{ Simd::Quad::load(p) }; }
+	void store(float* p) const { Simd::Quad::store(p, v); }
+
+	float x() const { return Simd::Quad::lane<0>(v); }
+	float y() const { return Simd::Quad::lane<1>(v); }
+	float z() const { return Simd::Quad::lane<2>(v); }
+	float w() const { return Simd::Quad::lane<3>(v); }
+
+	Vec4 operator+(const Vec4& o) const { return Vec4{ Simd::Quad::add(v, o.v) }; }
+	Vec4 operator-(const Vec4& o) const { return Vec4{ Simd::Quad::sub(v, o.v) }; }
+	Vec4 operator*(const Vec4& o) const { return Vec4{ Simd::Quad::mul(v, o.v) }; }
+	Vec4 operator/(const Vec4& o) const { return Vec4{ Simd::Quad::div(v, o.v) }; }
+	Vec4 operator*(float f) const { return Vec4{ Simd::Quad::mul(v, Simd::Quad::splat(f)) }; }
+	Vec4 operator-() const { return Vec4{ Simd::Quad::sub(Simd::Quad::splat(0.f), v) }; }
+	Vec4& operator+=(const Vec4& o) { v = Simd::Quad::add(v, o.v); return *this; }
+	Vec4& operator-=(const Vec4& o) { v = Simd::Quad::sub(v, o.v); return *this; }
+	Vec4& operator*=(const Vec4& o) { v = Simd::Quad::mul(v, o.v); return *this; }
+	Vec4& operator*=(float f) { v = Simd::Quad::mul(v, Simd::Quad::splat(f)); return *this; }
+
+	static float dot(const Vec4& a, const Vec4& b) { return Simd::Quad::lane<0>(Simd::Quad::sum4(Simd::Quad::mul(a.v, b.v))); }
+	static Vec4 min(const Vec4& a, const Vec4& b) { return Vec4{ Simd::Quad::min(a.v, b.v) }; }
+	static Vec4 max(const Vec4& a, const Vec4& b) { return Vec4{ Simd::Quad::max(a.v, b.v) }; }
+};
+
+struct alignas(16) Vec3A
+{
+	Simd::Quad::R v; // w is always 0
+
+	Vec3A() : v{ Simd::Quad::splat(0.f) } {}
+	Vec3A(float x, float y, float z) : v{ Simd::Quad::set(x, y, z, 0.f) } {}
+	explicit Vec3A(float s) : v{ Simd::Quad::set(s, s, s, 0.f) } {}
+	// the caller guarantees w == 0
+	explicit Vec3A(Simd::Quad::R r) : v{ r } {}
+	explicit Vec3A(const Vec& o) : v{ Simd::Quad::set(o.x, o.y, o.z, 0.f) } {}
+	Vec toVec() const { return Vec{ x(), y(), z() }; }
+#ifdef GLM_VERSION
+	explicit Vec3A(const glm::vec3& g) : v{ Simd::Quad::set(g.x, g.y, g.z, 0.f) } {}
+	glm::vec3 toGlm() const { return glm::vec3(x(), y(), z()); }
+#endif
+
+	float x() const { return Simd::Quad::lane<0>(v); }
+	float y() const { return Simd::Quad::lane<1>(v); }
+	float z() const { return Simd::Quad::lane<2>(v); }
+
+	Vec3A operator+(const Vec3A& o) const { return Vec3A{ Simd::Quad::add(v, o.v) }; }
+	Vec3A operator-(const Vec3A& o) const { return Vec3A{ Simd::Quad::sub(v, o.v) }; }
+	Vec3A operator*(const Vec3A& o) const { return Vec3A{ Simd::Quad::mul(v, o.v) }; }
+	Vec3A operator/(const Vec3A& o) const { return Vec3A{ Simd::Quad::zeroW(Simd::Quad::div(v, o.v)) }; } // 0 / 0 in w
+	Vec3A operator*(float f) const { return Vec3A{ Simd::Quad::mul(v, Simd::Quad::splat(f)) }; }
+	Vec3A operator/(float f) const { return Vec3A{ Simd::Quad::div(v, Simd::Quad::splat(f)) }; }
+	Vec3A operator-() const { return Vec3A{ Simd::Quad::sub(Simd::Quad::splat(0.f), v) }; }
+	Vec3A& operator+=(const Vec3A& o) { v = Simd::Quad::add(v, o.v); return *this; }
+	Vec3A& operator-=(const Vec3A& o) { v = Simd::Quad::sub(v, o.v); return *this; }
+	Vec3A& operator*=(const Vec3A& o) { v = Simd::Quad::mul(v, o.v); return *this; }
+	Vec3A& operator*=(float f) { v = Simd::Quad::mul(v, Simd::Quad::splat(f)); return *this; }
+
+	static float dot(const Vec3A& a, const Vec3A& b) { return Simd::Quad::lane<0>(Simd::Quad::sum3(Simd::Quad::mul(a.v, b.v))); }
+	static Vec3A cross(const Vec3A& a, const Vec3A& b)
+	{
+		// a * b.yzx - a.yzx * b is the cross product in zxy order, w stays a.w * b.w - a.w * b.w = 0
+		using namespace Simd::Quad;
+		const R zxy = sub(mul(a.v, yzx(b.v)), mul(yzx(a.v), b.v));
+		return Vec3A{ yzx(zxy) };
+	}
+	static Vec3A min(const Vec3A& a, const Vec3A& b) { return Vec3A{ Simd::Quad::min(a.v, b.v) }; }
+	static Vec3A max(const Vec3A& a, const Vec3A& b) { return Vec3A{ Simd::Quad::max(a.v, b.v) }; }
+	static float distanceSquared(const Vec3A& a, const Vec3A& b) { const Vec3A d = b - a; return dot(d, d); }
+
+	float lengthSquared() const { return dot(*this, *this); }
+	float length() const { return std::sqrt(lengthSquared()); }
+	// reciprocal square root estimate plus one refinement step (relative error about 1e-6), vectors shorter than
+	// sqrt(EPSILON_F) become zero, same as Vec::getNormalized
+	Vec3A normalized() const
+	{
+		using namespace Simd::Quad;
+		const R lengthSquared = sum3(mul(v, v));
+		return Vec3A{ keepIfAtLeast(mul(v, rsqrt(lengthSquared)), lengthSquared, splat(EPSILON_F)) };
+	}
+};
+
+// operations over whole arrays, the arrays may alias when the element types match
+namespace VecBatch
+{
+	void toVec3A(const Vec* in, Vec3A* out, size_t count);
+	void toVec(const Vec3A* in, Vec* out, size_t count);
+	void normalize(Vec3A* vectors, size_t count);
+	void dot(const Vec3A* a, const Vec3A* b, float* out, size_t count);
+	void cross(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t count);
+	// out = a + b * scale, e.g. positions += velocities * deltaTime
+	void scaleAdd(const Vec3A* a, const Vec3A* b, float scale, Vec3A* out, size_t count);
+#ifdef GLM_VERSION
+	// out = (m * vec4(in, 1)).xyz, affine matrices (no projection)
+	void transformPoints(const glm::mat4& m, const Vec3A* in, Vec3A* out, size_t count);
+#endif
+}
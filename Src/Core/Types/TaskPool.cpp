@@ -0,0 +1,143 @@
+#include "Core/Types/TaskPool.h"
+
+#include <algorithm>
+
+TaskPool::TaskPool(int numThreads)
+{
+	if (numThreads < 0)
+	{
+		// the caller is a thread of the pool as well
+		numThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u)) - 1;
+	}
+	for (int i = 0; i <= numThreads; i++) { queues.push_back(std::make_unique<TaskQueue>()); }
+	for (int i = 0; i < numThreads; i++) { workers.emplace_back(&TaskPool::workerLoop, this, static_cast<uint32_t>(i)); }
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wakeCondition.notify_all();
+	for (auto& w : workers) { w.join(); }
+}
+
+void TaskPool::parallelFor(uint32_t count, const std::function<void(uint32_t)>& task)
+{
+	if (count == 0) { return; }
+	const uint32_t self = static_cast<uint32_t>(workers.size());
+	if (workers.empty() || count == 1)
+	{
+		// same exception behaviour as the parallel path, every task runs and the first exception is rethrown
+		std::exception_ptr first;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			try
+			{
+				task(i);
+			}
+			catch (...)
+			{
+				if (!first) { first = std::current_exception(); }
+			}
+		}
+		if (first) { std::rethrow_exception(first); }
+		return;
+	}
+
+	batch = &task;
+	remaining.store(count);
+	// deal the tasks out round robin, task 0 (usually the largest) goes to the caller, which starts right away
+	const uint32_t threads = getThreadCount();
+	for (uint32_t t = 0; t < threads; t++)
+	{
+		TaskQueue& queue = *queues[(self + t) % threads];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		for (uint32_t i = t; i < count; i += threads) { queue.tasks.push_front(i); }
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		batchId++;
+	}
+	wakeCondition.notify_all();
+
+	runTasks(self);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this] { return remaining.load() == 0; });
+	batch = nullptr;
+	if (error)
+	{
+		std::exception_ptr e = error;
+		error = nullptr;
+		std::rethrow_exception(e);
+	}
+}
+
+bool TaskPool::popOrSteal(uint32_t self, uint32_t& taskOut)
+{
+	{
+		// own work from the back, lowest task index first
+		TaskQueue& own = *queues[self];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty())
+		{
+			taskOut = own.tasks.back();
+			own.tasks.pop_back();
+			return true;
+		}
+	}
+	for (uint32_t k = 1; k < queues.size(); k++)
+	{
+		// steal from the other end of another thread's deque
+		TaskQueue& victim = *queues[(self + k) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			taskOut = victim.tasks.front();
+			victim.tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+void TaskPool::runTasks(uint32_t self)
+{
+	uint32_t task;
+	while (popOrSteal(self, task))
+	{
+		try
+		{
+			(*batch)(task);
+		}
+		catch (...)
+		{
+			// an exception escaping a worker would terminate, keep it for the caller and finish the batch
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!error) { error = std::current_exception(); }
+		}
+		if (remaining.fetch_sub(1) == 1)
+		{
+			// last task of the batch, wake the caller
+			std::lock_guard<std::mutex> lock(mutex);
+			doneCondition.notify_all();
+		}
+	}
+}
+
+void TaskPool::workerLoop(uint32_t self)
+{
+	uint64_t seenBatch = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wakeCondition.wait(lock, [this, seenBatch] { return stopping || batchId != seenBatch; });
+			if (stopping) { return; }
+			seenBatch = batchId;
+		}
+		runTasks(self);
+	}
+}
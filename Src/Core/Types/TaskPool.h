@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*	fork-join pool for short, CPU-bound batches (e.g. one physics step), not for long-running jobs
+*
+*	parallelFor() deals the task indices out to one deque per thread, every thread works through its own deque from the
+*	back and, once that is empty, steals from the front of the others, so uneven tasks (one large island, many small ones)
+*	still keep every core busy, the calling thread takes part and the call returns when every task has finished */
+class TaskPool
+{
+public:
+	// numThreads is the number of worker threads besides the caller, -1 uses one per remaining hardware thread
+	explicit TaskPool(int numThreads = -1);
+	~TaskPool();
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	/*	runs task(i) for every i in [0, count), tasks must not call parallelFor themselves
+	*	if tasks throw, the rest of the batch still runs and the first exception is rethrown on the caller once it is done */
+	void parallelFor(uint32_t count, const std::function<void(uint32_t)>& task);
+
+	// threads working on a batch, including the caller
+	uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+private:
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<uint32_t> tasks;
+	};
+
+	bool popOrSteal(uint32_t self, uint32_t& taskOut);
+	void runTasks(uint32_t self);
+	void workerLoop(uint32_t self);
+
+	std::vector<std::thread> workers;
+	std::vector<std::unique_ptr<TaskQueue>> queues; // one per worker, the caller's is last
+
+	const std::function<void(uint32_t)>* batch = nullptr; // set before any task of the batch is queued
+	std::atomic<uint32_t> remaining{ 0 };
+	std::exception_ptr error; // first exception thrown by a task of the batch, guarded by mutex
+
+	std::mutex mutex;
+	std::condition_variable wakeCondition;
+	std::condition_variable doneCondition;
+	uint64_t batchId = 0;
+	bool stopping = false;
+};
@@ -0,0 +1,41 @@
+#include "Core/WorldSystem/FloatingOrigin.h"
+
+#include <cmath>
+
+namespace WorldSystem
+{
+	SectorCoord FloatingOrigin::getShift(const Vec& observer) const
+	{
+		const float S = static_cast<float>(sectorSize);
+		const auto sectorsPassed = [S](float p) -> intmax_t { return std::abs(p) > S ? static_cast<intmax_t>(p / S) : 0; };
+		return SectorCoord(sectorsPassed(observer.x), sectorsPassed(observer.y), sectorsPassed(observer.z));
+	}
+
+	Vec FloatingOrigin::rebase(const SectorCoord& shift)
+	{
+		localSector += shift;
+		return Vec(static_cast<float>(shift.x), static_cast<float>(shift.y), static_cast<float>(shift.z)) * -static_cast<float>(sectorSize);
+	}
+
+	Vec FloatingOrigin::sectorToLocal(const SectorCoord& sector, const Vec& offset) const
+	{
+		return worldToLocal(WorldPosition{ sector, Vec64(offset.x, offset.y, offset.z) });
+	}
+
+	WorldPosition FloatingOrigin::localToWorld(const Vec& local) const
+	{
+		return WorldPosition{ localSector, Vec64(local.x, local.y, local.z) };
+	}
+
+	Vec FloatingOrigin::worldToLocal(const WorldPosition& position) const
+	{
+		// sector distance is computed in integers first, only the (small) relative result is converted to float
+		const SectorCoord relative = position.sector - localSector;
+		const double S = static_cast<double>(sectorSize);
+		return Vec(
+			static_cast<float>((static_cast<double>(relative.x) * S) + position.offset.x),
+			static_cast<float>((static_cast<double>(relative.y) * S) + position.offset.y),
+			static_cast<float>((static_cast<double>(relative.z) * S) + position.offset.z));
+	}
+
+}
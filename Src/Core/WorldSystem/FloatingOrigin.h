@@ -0,0 +1,56 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/WorldSystem/Sector.h"
+
+#include <stdint.h>
+
+namespace WorldSystem
+{
+	// absolute position without precision loss, a sector coordinate plus a double-precision offset from that sector's origin
+	struct WorldPosition
+	{
+		SectorCoord sector{};
+		Vec64 offset{};
+	};
+
+	/*	floating origin of the world, everything the renderer sees (camera, primitive transforms) is kept in float
+	*	relative to the origin of the local sector, the local sector follows the observer in whole sectors
+	*
+	*	the shift is a whole multiple of the sector size, which is exact in float, so a position moving towards the
+	*	new origin (the observer, everything near it) is shifted without rounding and repeated rebases do not drift */
+	class FloatingOrigin
+	{
+	public:
+		explicit FloatingOrigin(uint32_t sectorSize) : sectorSize{ sectorSize } {}
+
+		const SectorCoord& getLocalSector() const { return localSector; }
+		void setLocalSector(const SectorCoord& coord) { localSector = coord; }
+		uint32_t getSectorSize() const { return sectorSize; }
+
+		/*	whole sectors the observer has moved past the local origin, zero on an axis until it is more than one full
+		*	sector away (not half), so hovering on a boundary does not rebase back and forth */
+		SectorCoord getShift(const Vec& observer) const;
+		// moves the local sector by shift, returns the offset to add to every local position
+		Vec rebase(const SectorCoord& shift);
+
+		// position of a sector origin plus offset, relative to the local sector origin
+		Vec sectorToLocal(const SectorCoord& sector, const Vec& offset = Vec::zero()) const;
+		WorldPosition localToWorld(const Vec& local) const;
+		Vec worldToLocal(const WorldPosition& position) const;
+
+		/*	the rebase pass, adds offset to the transform of every object in the range (anything with getTransform()
+		*	returning a CachedTransform), only the translation column of the cached matrices is patched, no rebuild */
+		template<typename Range>
+		static uint32_t shiftTransforms(Range& objects, const Vec& offset)
+		{
+			uint32_t count = 0;
+			for (auto& object : objects) { object.getTransform().translate(offset); count++; }
+			return count;
+		}
+
+	private:
+		uint32_t sectorSize;
+		SectorCoord localSector{};
+	};
+
+}
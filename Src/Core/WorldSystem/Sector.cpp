@@ -1,11 +1,19 @@
 #include "Core/WorldSystem/Sector.h"
 #include "Core/Primitive.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace WorldSystem
 {
 	SectorCoord::SectorCoord() : x{ 0 }, y{ 0 }, z{ 0 } {};
 	SectorCoord::SectorCoord(intmax_t x, intmax_t y, intmax_t z) : x{ x }, y{ y }, z{ z } {};
 
+	intmax_t SectorCoord::chebyshevDistance(const SectorCoord& other) const
+	{
+		return std::max(std::max(std::abs(x - other.x), std::abs(y - other.y)), std::abs(z - other.z));
+	}
+
 	Sector::Sector(const SectorCoord& coord)
 		: coordinates{ coord }
 	{}
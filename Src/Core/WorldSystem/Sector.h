@@ -1,4 +1,6 @@
 #pragma once
+#include "Core/Types/LinkedArraySeriesContainer.h"
+
 #include <stdint.h>
 #include <vector>
 #include <memory>
@@ -22,6 +24,8 @@ namespace WorldSystem
 		SectorCoord operator-(const SectorCoord& s) const { return SectorCoord{ x - s.x, y - s.y, z - s.z }; } // -
 		SectorCoord operator+=(const SectorCoord& s) { *this = s + *this; return *this; } // +=
 		SectorCoord operator-=(const SectorCoord& s) { *this = s - *this; return *this; } // -=
+		// number of sector rings between this and other (max axis distance)
+		intmax_t chebyshevDistance(const SectorCoord& other) const;
 	};
 
 	class Sector
@@ -30,7 +34,8 @@ namespace WorldSystem
 		Sector(const SectorCoord& coord);
 
 		SectorCoord coordinates;
-		std::vector<std::unique_ptr<EngineCore::Primitive>> primitives;
+		// stored in place, chunks never move, so Primitive pointers (e.g. draw lists) stay valid while the sector is loaded
+		LinkedArraySeries<EngineCore::Primitive> primitives;
 		bool isCulled = false;
 
 	};
@@ -0,0 +1,223 @@
+#include "Core/WorldSystem/SectorFile.h"
+#include "Core/Types/MappedFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace WorldSystem
+{
+	using Vertex = EngineCore::Primitive::Vertex;
+	static_assert(std::is_trivially_copyable<Vertex>::value, "sector files store vertices as raw bytes");
+	static_assert(sizeof(SectorFile::Header) == 48, "sector file header layout changed");
+	static_assert(sizeof(SectorFile::SectionEntry) == 24, "sector file section entry layout changed");
+	static_assert(sizeof(SectorFile::PrimitiveRecord) == 64, "sector file primitive record layout changed");
+
+	namespace
+	{
+		uint64_t alignUp(uint64_t v) { return (v + SectorFile::SECTION_ALIGNMENT - 1) & ~(SectorFile::SECTION_ALIGNMENT - 1); }
+
+		struct SectionData
+		{
+			SectorFile::SectionType type;
+			uint32_t elementCount;
+			const void* data;
+			uint64_t size;
+		};
+
+		const SectorFile::SectionEntry* findSection(const SectorFile::SectionEntry* toc, uint32_t count, SectorFile::SectionType type)
+		{
+			for (uint32_t i = 0; i < count; i++) { if (toc[i].type == static_cast<uint32_t>(type)) { return &toc[i]; } }
+			return nullptr;
+		}
+
+		// the elements the section claims to hold must fit in its byte size
+		bool holdsElements(const SectorFile::SectionEntry& section, uint64_t elementSize)
+		{
+			return section.elementCount <= section.size / elementSize;
+		}
+
+		// first + count <= available, without the sum wrapping around
+		bool rangeInside(uint64_t first, uint64_t count, uint64_t available)
+		{
+			return count <= available && first <= available - count;
+		}
+	}
+
+	std::string SectorFile::makeFileName(const SectorCoord& coord)
+	{
+		return "sector_" + std::to_string(coord.x) + "_" + std::to_string(coord.y) + "_" + std::to_string(coord.z) + ".vsec";
+	}
+
+	void SectorFile::write(const std::string& path, const SectorCoord& coord, const SectorContent& content)
+	{
+		// flatten everything into the section blobs
+		std::vector<PrimitiveRecord> primitives;
+		std::vector<MaterialRecord> materials;
+		std::string strings;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+
+		for (const auto& m : content.materials)
+		{
+			MaterialRecord rec{};
+			rec.vertPathOffset = static_cast<uint32_t>(strings.size());
+			rec.vertPathLength = static_cast<uint32_t>(m.vertPath.size());
+			strings += m.vertPath;
+			rec.fragPathOffset = static_cast<uint32_t>(strings.size());
+			rec.fragPathLength = static_cast<uint32_t>(m.fragPath.size());
+			strings += m.fragPath;
+			materials.push_back(rec);
+		}
+
+		for (const auto& p : content.primitives)
+		{
+			const bool mapped = p.mappedVertices != nullptr;
+			const Vertex* v = mapped ? p.mappedVertices : p.mesh.vertices.data();
+			const uint32_t* ind = mapped ? p.mappedIndices : p.mesh.indices.data();
+			const uint32_t vCount = mapped ? p.mappedVertexCount : static_cast<uint32_t>(p.mesh.vertices.size());
+			const uint32_t iCount = mapped ? p.mappedIndexCount : static_cast<uint32_t>(p.mesh.indices.size());
+
+			PrimitiveRecord rec{};
+			const Transform& t = p.transform;
+			const float tf[9] = { t.translation.x, t.translation.y, t.translation.z,
+								t.rotation.x, t.rotation.y, t.rotation.z, t.scale.x, t.scale.y, t.scale.z };
+			memcpy(rec.translation, tf, sizeof(float) * 3);
+			memcpy(rec.rotation, tf + 3, sizeof(float) * 3);
+			memcpy(rec.scale, tf + 6, sizeof(float) * 3);
+			rec.materialIndex = p.materialIndex;
+			rec.firstVertex = vertices.size();
+			rec.firstIndex = indices.size();
+			rec.vertexCount = vCount;
+			rec.indexCount = iCount;
+			vertices.insert(vertices.end(), v, v + vCount);
+			indices.insert(indices.end(), ind, ind + iCount);
+			primitives.push_back(rec);
+		}
+
+		const SectionData sections[] =
+		{
+			{ SectionType::Primitives, static_cast<uint32_t>(primitives.size()), primitives.data(), primitives.size() * sizeof(PrimitiveRecord) },
+			{ SectionType::Materials, static_cast<uint32_t>(materials.size()), materials.data(), materials.size() * sizeof(MaterialRecord) },
+			{ SectionType::Strings, static_cast<uint32_t>(strings.size()), strings.data(), strings.size() },
+			{ SectionType::Vertices, static_cast<uint32_t>(vertices.size()), vertices.data(), vertices.size() * sizeof(Vertex) },
+			{ SectionType::Indices, static_cast<uint32_t>(indices.size()), indices.data(), indices.size() * sizeof(uint32_t) },
+		};
+		constexpr uint32_t sectionCount = sizeof(sections) / sizeof(sections[0]);
+
+		// table of contents, sections follow the header and TOC at aligned offsets
+		std::vector<SectionEntry> toc(sectionCount);
+		uint64_t offset = alignUp(sizeof(Header) + sizeof(SectionEntry) * sectionCount);
+		for (uint32_t i = 0; i < sectionCount; i++)
+		{
+			toc[i] = SectionEntry{ static_cast<uint32_t>(sections[i].type), sections[i].elementCount, offset, sections[i].size };
+			offset = alignUp(offset + sections[i].size);
+		}
+
+		Header header{};
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.sectionCount = sectionCount;
+		header.vertexStride = sizeof(Vertex);
+		header.coord[0] = coord.x;
+		header.coord[1] = coord.y;
+		header.coord[2] = coord.z;
+		header.fileSize = offset;
+
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+		if (!file.is_open()) { throw std::runtime_error("sector file error, could not open " + path + " for writing"); }
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(reinterpret_cast<const char*>(toc.data()), sizeof(SectionEntry) * sectionCount);
+
+		const char padding[SECTION_ALIGNMENT] = {};
+		uint64_t written = sizeof(Header) + sizeof(SectionEntry) * sectionCount;
+		for (uint32_t i = 0; i < sectionCount; i++)
+		{
+			file.write(padding, static_cast<std::streamsize>(toc[i].offset - written));
+			file.write(static_cast<const char*>(sections[i].data), static_cast<std::streamsize>(sections[i].size));
+			written = toc[i].offset + sections[i].size;
+		}
+		file.write(padding, static_cast<std::streamsize>(header.fileSize - written));
+		if (!file) { throw std::runtime_error("sector file error, failed writing " + path); }
+	}
+
+	bool SectorFile::read(const std::string& path, const SectorCoord& coord, SectorContent& contentOut)
+	{
+		auto mapping = std::make_shared<MappedFile>();
+		if (!mapping->open(path)) { return false; }
+
+		const uint8_t* base = mapping->data();
+		const size_t size = mapping->size();
+		const auto fail = [&path](const char* reason) { throw std::runtime_error("sector file error, " + path + ": " + reason); };
+
+		if (size < sizeof(Header)) { fail("file too small"); }
+		const Header& header = *reinterpret_cast<const Header*>(base);
+		if (header.magic != MAGIC) { fail("not a sector file"); }
+		if (header.version != VERSION) { fail("unsupported version"); }
+		if (header.vertexStride != sizeof(Vertex)) { fail("vertex layout mismatch"); }
+		if (header.fileSize != size) { fail("truncated file"); }
+		if (header.coord[0] != coord.x || header.coord[1] != coord.y || header.coord[2] != coord.z) { fail("sector coordinate mismatch"); }
+		if (sizeof(Header) + uint64_t(sizeof(SectionEntry)) * header.sectionCount > size) { fail("table of contents out of range"); }
+
+		const auto* toc = reinterpret_cast<const SectionEntry*>(base + sizeof(Header));
+		for (uint32_t i = 0; i < header.sectionCount; i++)
+		{
+			if (toc[i].offset % SECTION_ALIGNMENT != 0 || !rangeInside(toc[i].offset, toc[i].size, size)) { fail("section out of range"); }
+		}
+		const auto* primSection = findSection(toc, header.sectionCount, SectionType::Primitives);
+		const auto* matSection = findSection(toc, header.sectionCount, SectionType::Materials);
+		const auto* strSection = findSection(toc, header.sectionCount, SectionType::Strings);
+		const auto* vertSection = findSection(toc, header.sectionCount, SectionType::Vertices);
+		const auto* indSection = findSection(toc, header.sectionCount, SectionType::Indices);
+		if (!primSection || !matSection || !strSection || !vertSection || !indSection) { fail("missing section"); }
+		// element counts are trusted below, a section claiming more elements than it holds would read past it
+		if (!holdsElements(*primSection, sizeof(PrimitiveRecord)) || !holdsElements(*matSection, sizeof(MaterialRecord)) ||
+			!holdsElements(*strSection, 1) || !holdsElements(*vertSection, sizeof(Vertex)) ||
+			!holdsElements(*indSection, sizeof(uint32_t))) { fail("section element count out of range"); }
+
+		const char* strings = reinterpret_cast<const char*>(base + strSection->offset);
+		const auto* materials = reinterpret_cast<const MaterialRecord*>(base + matSection->offset);
+		contentOut.materials.clear();
+		for (uint32_t i = 0; i < matSection->elementCount; i++)
+		{
+			const auto& m = materials[i];
+			if (!rangeInside(m.vertPathOffset, m.vertPathLength, strSection->size) ||
+				!rangeInside(m.fragPathOffset, m.fragPathLength, strSection->size)) { fail("material path out of range"); }
+			contentOut.materials.push_back(SectorContent::MaterialRef{
+				std::string(strings + m.vertPathOffset, m.vertPathLength), std::string(strings + m.fragPathOffset, m.fragPathLength) });
+		}
+
+		const auto* vertices = reinterpret_cast<const Vertex*>(base + vertSection->offset);
+		const auto* indices = reinterpret_cast<const uint32_t*>(base + indSection->offset);
+		const auto* primitives = reinterpret_cast<const PrimitiveRecord*>(base + primSection->offset);
+		contentOut.primitives.clear();
+		contentOut.primitives.reserve(primSection->elementCount);
+		for (uint32_t i = 0; i < primSection->elementCount; i++)
+		{
+			const auto& rec = primitives[i];
+			if (!rangeInside(rec.firstVertex, rec.vertexCount, vertSection->elementCount) ||
+				!rangeInside(rec.firstIndex, rec.indexCount, indSection->elementCount)) { fail("primitive data out of range"); }
+			// without materials every primitive uses the default sector material
+			if (matSection->elementCount && rec.materialIndex >= matSection->elementCount) { fail("material index out of range"); }
+
+			contentOut.primitives.emplace_back();
+			auto& p = contentOut.primitives.back();
+			p.transform.translation = Vec{ rec.translation[0], rec.translation[1], rec.translation[2] };
+			p.transform.rotation = Vec{ rec.rotation[0], rec.rotation[1], rec.rotation[2] };
+			p.transform.scale = Vec{ rec.scale[0], rec.scale[1], rec.scale[2] };
+			p.materialIndex = rec.materialIndex;
+			p.mappedVertices = vertices + rec.firstVertex;
+			p.mappedVertexCount = rec.vertexCount;
+			p.mappedIndices = rec.indexCount ? indices + rec.firstIndex : nullptr;
+			p.mappedIndexCount = rec.indexCount;
+		}
+
+		// fault the pages in here (loader thread), so the render thread only pays for the memcpy
+		mapping->prefetch();
+		contentOut.mapping = mapping;
+		return true;
+	}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "Core/WorldSystem/Sector.h"
+#include "Core/WorldSystem/SectorStreamer.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace WorldSystem
+{
+	/*	versioned binary sector format, designed to be memory-mapped and uploaded without parsing
+	*
+	*	layout (little-endian):
+	*	[Header][SectionEntry * sectionCount][sections...]
+	*	every section starts at a multiple of SECTION_ALIGNMENT, vertex data is stored exactly as
+	*	Primitive::Vertex so it can be copied straight from the mapping into a staging buffer */
+	class SectorFile
+	{
+	public:
+		static constexpr uint32_t MAGIC = 0x46534B56; // "VKSF"
+		static constexpr uint32_t VERSION = 1;
+		static constexpr uint64_t SECTION_ALIGNMENT = 64;
+
+		enum class SectionType : uint32_t { Primitives = 1, Materials = 2, Strings = 3, Vertices = 4, Indices = 5 };
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t sectionCount;
+			uint32_t vertexStride; // must match sizeof(Primitive::Vertex)
+			int64_t coord[3];
+			uint64_t fileSize;
+		};
+
+		// table of contents entry
+		struct SectionEntry
+		{
+			uint32_t type; // SectionType
+			uint32_t elementCount;
+			uint64_t offset; // from start of file
+			uint64_t size; // bytes
+		};
+
+		struct PrimitiveRecord
+		{
+			float translation[3]; // relative to sector origin
+			float rotation[3];
+			float scale[3];
+			uint32_t materialIndex; // into the material section, ignored if it is empty
+			uint64_t firstVertex; // element offsets into the vertex and index sections
+			uint64_t firstIndex;
+			uint32_t vertexCount;
+			uint32_t indexCount; // 0 for non-indexed primitives
+		};
+
+		// shader paths, stored as ranges in the string section
+		struct MaterialRecord
+		{
+			uint32_t vertPathOffset;
+			uint32_t vertPathLength;
+			uint32_t fragPathOffset;
+			uint32_t fragPathLength;
+		};
+
+		// file name of a sector, relative to the sector directory
+		static std::string makeFileName(const SectorCoord& coord);
+
+		// throws on I/O failure
+		static void write(const std::string& path, const SectorCoord& coord, const SectorContent& content);
+		/*	maps the file and fills contentOut with zero-copy views into the mapping (the mapping is kept alive by contentOut),
+		*	returns false if the file does not exist, throws if it exists but is not a valid sector file */
+		static bool read(const std::string& path, const SectorCoord& coord, SectorContent& contentOut);
+	};
+
+}
@@ -0,0 +1,98 @@
+#include "Core/WorldSystem/SectorMap.h"
+#include "Core/Primitive.h"
+
+#include <cassert>
+#include <utility>
+
+namespace WorldSystem
+{
+	SectorMap::SectorMap(size_t initialCapacity)
+	{
+		size_t cap = 8;
+		while (cap < initialCapacity) { cap <<= 1; }
+		slots.resize(cap);
+		mask = cap - 1;
+	}
+
+	size_t SectorMap::probe(const SectorCoord& coord, uint64_t hash) const
+	{
+		size_t i = static_cast<size_t>(hash) & mask;
+		// load factor is capped below 1, so an empty slot is always reached
+		while (slots[i].sector && (slots[i].hash != hash || slots[i].key != coord))
+		{
+			i = (i + 1) & mask;
+		}
+		return i;
+	}
+
+	Sector* SectorMap::find(const SectorCoord& coord) const
+	{
+		return slots[probe(coord, SectorCoordHash{}(coord))].sector.get();
+	}
+
+	Sector& SectorMap::insert(std::unique_ptr<Sector> sector)
+	{
+		assert(sector && "cannot insert null sector");
+		// keep load factor at or below 3/4, linear probing degrades quickly above that
+		if ((count + 1) * 4 > slots.size() * 3) { rehash(slots.size() * 2); }
+
+		const SectorCoord coord = sector->coordinates;
+		const uint64_t hash = SectorCoordHash{}(coord);
+		Slot& slot = slots[probe(coord, hash)];
+		assert(!slot.sector && "attempted to insert a sector that is already present");
+		slot.key = coord;
+		slot.hash = hash;
+		slot.sector = std::move(sector);
+		count++;
+		return *slot.sector;
+	}
+
+	bool SectorMap::erase(const SectorCoord& coord)
+	{
+		return extract(coord) != nullptr;
+	}
+
+	std::unique_ptr<Sector> SectorMap::extract(const SectorCoord& coord)
+	{
+		size_t i = probe(coord, SectorCoordHash{}(coord));
+		if (!slots[i].sector) { return nullptr; }
+		std::unique_ptr<Sector> sector = std::move(slots[i].sector);
+		count--;
+
+		// backward-shift deletion, pulls displaced entries into the hole so no tombstones are needed
+		size_t j = i;
+		while (true)
+		{
+			j = (j + 1) & mask;
+			if (!slots[j].sector) { break; }
+			const size_t home = static_cast<size_t>(slots[j].hash) & mask;
+			// entry at j may move to i only if its home slot is not cyclically within (i, j]
+			const bool canMove = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+			if (canMove)
+			{
+				slots[i] = std::move(slots[j]);
+				i = j;
+			}
+		}
+		return sector;
+	}
+
+	void SectorMap::clear()
+	{
+		for (auto& s : slots) { s.sector.reset(); }
+		count = 0;
+	}
+
+	void SectorMap::rehash(size_t newCapacity)
+	{
+		std::vector<Slot> old = std::move(slots);
+		slots = std::vector<Slot>(newCapacity);
+		mask = newCapacity - 1;
+		for (auto& s : old)
+		{
+			if (!s.sector) { continue; }
+			slots[probe(s.key, s.hash)] = std::move(s);
+		}
+	}
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "Core/WorldSystem/Sector.h"
+
+#include <stdint.h>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace WorldSystem
+{
+	// 3D integer hash for sector coordinates, all axes are avalanched so neighbouring sectors spread over the table
+	struct SectorCoordHash
+	{
+		static uint64_t mix(uint64_t v)
+		{
+			// splitmix64 finalizer
+			v ^= v >> 30; v *= 0xbf58476d1ce4e5b9ULL;
+			v ^= v >> 27; v *= 0x94d049bb133111ebULL;
+			v ^= v >> 31;
+			return v;
+		}
+		uint64_t operator()(const SectorCoord& c) const
+		{
+			return mix(static_cast<uint64_t>(c.x) + mix(static_cast<uint64_t>(c.y) + mix(static_cast<uint64_t>(c.z))));
+		}
+	};
+
+	/*	open-addressing (linear probing) hash map from sector coordinates to owned sectors,
+	*	each sector is allocated once on insert, so Sector* handles stay valid until that sector is erased
+	*	(rehashing only moves the owning pointers) */
+	class SectorMap
+	{
+		struct Slot
+		{
+			SectorCoord key{};
+			uint64_t hash = 0;
+			std::unique_ptr<Sector> sector; // nullptr marks an empty slot
+		};
+
+	public:
+		SectorMap(size_t initialCapacity = 64);
+		SectorMap(const SectorMap&) = delete;
+		SectorMap& operator=(const SectorMap&) = delete;
+
+		// returns nullptr if the sector is not present
+		Sector* find(const SectorCoord& coord) const;
+		// takes ownership of the sector, the coordinate must not already be present
+		Sector& insert(std::unique_ptr<Sector> sector);
+		// destroys the sector at coord, returns false if it was not present
+		bool erase(const SectorCoord& coord);
+		// removes the sector at coord and hands ownership to the caller, nullptr if it was not present
+		std::unique_ptr<Sector> extract(const SectorCoord& coord);
+		void clear();
+
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		size_t capacity() const { return slots.size(); }
+
+		// iterates occupied slots only, order is unspecified and changes when the map grows
+		template<typename S, typename V>
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = V;
+			using pointer = V*;
+			using reference = V&;
+
+			Iterator(S* p, S* end) : p{ p }, end{ end } { skipEmpty(); }
+			reference operator*() const { return *p->sector; }
+			pointer operator->() const { return p->sector.get(); }
+			Iterator& operator++() { ++p; skipEmpty(); return *this; }
+			Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+			friend bool operator== (const Iterator& a, const Iterator& b) { return a.p == b.p; };
+			friend bool operator!= (const Iterator& a, const Iterator& b) { return a.p != b.p; };
+		private:
+			void skipEmpty() { while (p != end && !p->sector) { ++p; } }
+			S* p;
+			S* end;
+		};
+		using iterator = Iterator<Slot, Sector>;
+		using const_iterator = Iterator<const Slot, const Sector>;
+
+		iterator begin() { return iterator(slots.data(), slots.data() + slots.size()); }
+		iterator end() { return iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+		const_iterator begin() const { return const_iterator(slots.data(), slots.data() + slots.size()); }
+		const_iterator end() const { return const_iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+
+	private:
+		std::vector<Slot> slots; // capacity is always a power of two
+		size_t count = 0;
+		size_t mask = 0;
+
+		// returns the slot index holding coord, or the empty slot where it would be inserted
+		size_t probe(const SectorCoord& coord, uint64_t hash) const;
+		void rehash(size_t newCapacity);
+	};
+
+}
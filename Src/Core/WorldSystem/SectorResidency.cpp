@@ -0,0 +1,122 @@
+#include "Core/WorldSystem/SectorResidency.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace WorldSystem
+{
+
+	void SectorResidency::track(const SectorCoord& coord, const Footprint& footprint)
+	{
+		auto& entry = entries[coord];
+		hostBytes += footprint.hostBytes - entry.footprint.hostBytes;
+		deviceBytes += footprint.deviceBytes - entry.footprint.deviceBytes;
+		entry.footprint = footprint;
+		entry.lastUsedFrame = frame;
+	}
+
+	void SectorResidency::untrack(const SectorCoord& coord)
+	{
+		auto it = entries.find(coord);
+		assert(it != entries.end() && "attempted to untrack an unknown sector");
+		hostBytes -= it->second.footprint.hostBytes;
+		deviceBytes -= it->second.footprint.deviceBytes;
+		entries.erase(it);
+	}
+
+	void SectorResidency::touch(const SectorCoord& coord)
+	{
+		auto it = entries.find(coord);
+		if (it != entries.end()) { it->second.lastUsedFrame = frame; }
+	}
+
+	void SectorResidency::selectEvictions(const SectorCoord& localSector, uint32_t loadRadius, std::vector<SectorCoord>& evictOut)
+	{
+		evictOut.clear();
+		requestedRadius = loadRadius;
+		// a dropped ring comes back one at a time, once it fits next to everything loaded now
+		if (radiusLimit < loadRadius && fits(hostBytes + droppedRing.hostBytes, deviceBytes + droppedRing.deviceBytes))
+		{
+			radiusLimit++;
+		}
+		if (radiusLimit >= loadRadius) { radiusLimit = NO_RADIUS_LIMIT; }
+		intmax_t radius = static_cast<intmax_t>(getLoadRadius(loadRadius));
+		const intmax_t unloadRadius = radius + hysteresis;
+
+		// distance pass, everything outside the unload ring goes
+		size_t host = hostBytes;
+		size_t device = deviceBytes;
+		candidates.clear();
+		ringMembers.clear();
+		for (const auto& [coord, entry] : entries)
+		{
+			const intmax_t distance = coord.chebyshevDistance(localSector);
+			if (distance > unloadRadius)
+			{
+				evictOut.push_back(coord);
+				host -= entry.footprint.hostBytes;
+				device -= entry.footprint.deviceBytes;
+				evictedByDistance++;
+			}
+			else if (distance > radius)
+			{
+				const float age = static_cast<float>(frame - entry.lastUsedFrame);
+				candidates.push_back(Candidate{ coord, static_cast<float>(distance) + age * ageWeight });
+			}
+			else if (distance > 0)
+			{
+				ringMembers.push_back(RingMember{ coord, distance });
+			}
+		}
+		if (fits(host, device)) { evictedLastUpdate = static_cast<uint32_t>(evictOut.size()); return; }
+
+		// budget pass, drop the least useful sectors outside the load ring until we fit, they are not streamed in again
+		std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+		for (const auto& c : candidates)
+		{
+			if (fits(host, device)) { break; }
+			const auto& footprint = entries.find(c.coord)->second.footprint;
+			evictOut.push_back(c.coord);
+			host -= footprint.hostBytes;
+			device -= footprint.deviceBytes;
+			evictedByBudget++;
+		}
+
+		// the load ring alone is over budget, shrink it from the outside so the dropped sectors are not requested again
+		std::sort(ringMembers.begin(), ringMembers.end(), [](const RingMember& a, const RingMember& b) { return a.distance > b.distance; });
+		auto member = ringMembers.begin();
+		while (!fits(host, device) && radius > 0)
+		{
+			droppedRing = Footprint{};
+			for (; member != ringMembers.end() && member->distance == radius; member++)
+			{
+				const auto& footprint = entries.find(member->coord)->second.footprint;
+				evictOut.push_back(member->coord);
+				host -= footprint.hostBytes;
+				device -= footprint.deviceBytes;
+				droppedRing.hostBytes += footprint.hostBytes;
+				droppedRing.deviceBytes += footprint.deviceBytes;
+				evictedByBudget++;
+			}
+			radius--;
+			radiusLimit = static_cast<uint32_t>(radius);
+		}
+		evictedLastUpdate = static_cast<uint32_t>(evictOut.size());
+	}
+
+	SectorResidency::Stats SectorResidency::getStats() const
+	{
+		Stats stats{};
+		stats.residentSectors = static_cast<uint32_t>(entries.size());
+		stats.hostBytes = hostBytes;
+		stats.deviceBytes = deviceBytes;
+		stats.hostBudget = budget.hostBytes;
+		stats.deviceBudget = budget.deviceBytes;
+		stats.evictedLastUpdate = evictedLastUpdate;
+		stats.evictedByDistance = evictedByDistance;
+		stats.evictedByBudget = evictedByBudget;
+		stats.droppedRings = requestedRadius - getLoadRadius(requestedRadius);
+		return stats;
+	}
+
+}
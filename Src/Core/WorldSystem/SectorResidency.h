@@ -0,0 +1,107 @@
+#pragma once
+#include "Core/WorldSystem/Sector.h"
+#include "Core/WorldSystem/SectorMap.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace WorldSystem
+{
+	/*	decides which loaded sectors to unload, pure bookkeeping (the world owns the sectors)
+	*
+	*	sectors further than loadRadius + hysteresis from the local sector are always unloaded, the extra ring keeps
+	*	an observer hovering on a sector boundary from reloading the same sectors over and over,
+	*	if host or device memory is still over budget after that, the sectors between the two radii with the highest
+	*	distance + age score (least recently used, far away) are unloaded until the budget is met
+	*
+	*	sectors inside the load ring would be streamed in again right away, so when those alone exceed the budget
+	*	the load radius itself shrinks ring by ring (getLoadRadius), it grows back once the last dropped ring fits */
+	class SectorResidency
+	{
+	public:
+		struct Footprint
+		{
+			size_t hostBytes = 0;
+			size_t deviceBytes = 0;
+		};
+
+		struct Budget
+		{
+			size_t hostBytes = 256ull * 1024 * 1024;
+			size_t deviceBytes = 1024ull * 1024 * 1024;
+		};
+
+		struct Stats
+		{
+			uint32_t residentSectors = 0;
+			size_t hostBytes = 0;
+			size_t deviceBytes = 0;
+			size_t hostBudget = 0;
+			size_t deviceBudget = 0;
+			uint32_t evictedLastUpdate = 0;
+			uint64_t evictedByDistance = 0;
+			uint64_t evictedByBudget = 0;
+			uint32_t droppedRings = 0; // rings of the requested load radius the budget currently keeps unloaded
+		};
+
+		Budget budget{};
+		// extra rings beyond the load radius before a sector is unloaded
+		uint32_t hysteresis = 1;
+		// score added per frame since a sector was last used, one ring of distance per ~10 seconds at 60 fps
+		float ageWeight = 1.f / 600.f;
+
+		void track(const SectorCoord& coord, const Footprint& footprint);
+		void untrack(const SectorCoord& coord);
+		// marks a sector as used this frame (e.g. inside the load ring or visible)
+		void touch(const SectorCoord& coord);
+		void nextFrame() { frame++; }
+
+		/*	fills evictOut with the sectors that should be unloaded, the local sector is never selected,
+		*	the caller is expected to unload them and call untrack() for each */
+		void selectEvictions(const SectorCoord& localSector, uint32_t loadRadius, std::vector<SectorCoord>& evictOut);
+		// radius the caller should stream with instead of the requested one, smaller while the budget cannot hold the full ring
+		uint32_t getLoadRadius(uint32_t requested) const { return std::min(requested, radiusLimit); }
+
+		bool isOverBudget() const { return hostBytes > budget.hostBytes || deviceBytes > budget.deviceBytes; }
+		Stats getStats() const;
+
+	private:
+		struct Entry
+		{
+			Footprint footprint{};
+			uint64_t lastUsedFrame = 0;
+		};
+		struct Candidate
+		{
+			SectorCoord coord;
+			float score;
+		};
+		struct RingMember
+		{
+			SectorCoord coord;
+			intmax_t distance;
+		};
+
+		std::unordered_map<SectorCoord, Entry, SectorCoordHash> entries;
+		std::vector<Candidate> candidates; // reused by selectEvictions
+		std::vector<RingMember> ringMembers; // reused by selectEvictions
+		size_t hostBytes = 0;
+		size_t deviceBytes = 0;
+		uint64_t frame = 0;
+
+		static constexpr uint32_t NO_RADIUS_LIMIT = ~0u;
+		uint32_t radiusLimit = NO_RADIUS_LIMIT;
+		uint32_t requestedRadius = 0;
+		Footprint droppedRing{}; // footprint of the ring dropped last, it has to fit before the radius grows again
+
+		bool fits(size_t host, size_t device) const { return host <= budget.hostBytes && device <= budget.deviceBytes; }
+
+		uint32_t evictedLastUpdate = 0;
+		uint64_t evictedByDistance = 0;
+		uint64_t evictedByBudget = 0;
+	};
+
+}
@@ -0,0 +1,188 @@
+#include "Core/WorldSystem/SectorStreamer.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace WorldSystem
+{
+	size_t SectorContent::getSizeBytes() const
+	{
+		size_t bytes = 0;
+		for (const auto& p : primitives)
+		{
+			bytes += (p.mesh.vertices.size() + p.mappedVertexCount) * sizeof(EngineCore::Primitive::Vertex);
+			bytes += (p.mesh.indices.size() + p.mappedIndexCount) * sizeof(uint32_t);
+		}
+		return bytes;
+	}
+
+	SectorStreamer::SectorStreamer(SectorContentProvider provider, uint32_t numThreads)
+		: provider{ provider }, rateWindowStart{ std::chrono::steady_clock::now() }
+	{
+		if (numThreads == 0)
+		{
+			// leave most cores to the render thread and the driver
+			numThreads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+		}
+		for (uint32_t i = 0; i < numThreads; i++) { workers.emplace_back(&SectorStreamer::workerLoop, this); }
+	}
+
+	SectorStreamer::~SectorStreamer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+			for (auto& job : inFlight) { job->cancelled = true; }
+		}
+		wakeCondition.notify_all();
+		for (auto& w : workers) { w.join(); }
+	}
+
+	bool SectorStreamer::isLessUrgent(const Request& a, const Request& b)
+	{
+		// heap comparator, keeps the nearest sector at the front
+		return a.priority > b.priority;
+	}
+
+	bool SectorStreamer::isInRing(const SectorCoord& c) const
+	{
+		return c.chebyshevDistance(ringCenter) <= static_cast<intmax_t>(ringRadius);
+	}
+
+	bool SectorStreamer::isTracked(const SectorCoord& c) const
+	{
+		for (const auto& r : queue) { if (r.coord == c) { return true; } }
+		for (const auto& j : inFlight) { if (j->coord == c && !j->cancelled) { return true; } }
+		for (const auto& f : finished) { if (f.coord == c) { return true; } }
+		return false;
+	}
+
+	void SectorStreamer::retarget(const SectorCoord& center, uint32_t radius, const Vec& observerLocal, float sectorSize,
+								const std::function<bool(const SectorCoord&)>& isResident)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			ringCenter = center;
+			ringRadius = radius;
+
+			// cancel everything the observer has moved away from
+			const size_t queuedBefore = queue.size() + finished.size();
+			queue.erase(std::remove_if(queue.begin(), queue.end(),
+				[this](const Request& r) { return !isInRing(r.coord); }), queue.end());
+			finished.erase(std::remove_if(finished.begin(), finished.end(),
+				[this](const FinishedSector& f) { return !isInRing(f.coord); }), finished.end());
+			stats.cancelled += queuedBefore - (queue.size() + finished.size());
+			for (auto& job : inFlight)
+			{
+				if (!job->cancelled && !isInRing(job->coord)) { job->cancelled = true; stats.cancelled++; }
+			}
+
+			// queue the missing part of the ring
+			const intmax_t r = static_cast<intmax_t>(radius);
+			for (intmax_t x = -r; x <= r; x++)
+			for (intmax_t y = -r; y <= r; y++)
+			for (intmax_t z = -r; z <= r; z++)
+			{
+				const SectorCoord c = center + SectorCoord(x, y, z);
+				if (isResident(c) || isTracked(c)) { continue; }
+				queue.push_back(Request{ c, 0.f });
+			}
+
+			// sector centers relative to the local sector origin (render space), prioritized by distance to observer
+			for (auto& req : queue)
+			{
+				const SectorCoord rel = req.coord - center;
+				const Vec sectorCenter{ rel.x * sectorSize, rel.y * sectorSize, rel.z * sectorSize };
+				req.priority = Vec::distanceSquared(sectorCenter, observerLocal);
+			}
+			std::make_heap(queue.begin(), queue.end(), isLessUrgent);
+			stats.queued = static_cast<uint32_t>(queue.size());
+		}
+		wakeCondition.notify_all();
+	}
+
+	void SectorStreamer::collectFinished(std::vector<FinishedSector>& out, size_t byteBudget)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		size_t bytes = 0;
+		size_t taken = 0;
+		while (taken < finished.size() && (taken == 0 || bytes < byteBudget))
+		{
+			auto& f = finished[taken];
+			bytes += f.content ? f.content->getSizeBytes() : 0;
+			out.push_back(std::move(f));
+			taken++;
+		}
+		finished.erase(finished.begin(), finished.begin() + taken);
+		stats.pendingUpload = static_cast<uint32_t>(finished.size());
+	}
+
+	SectorStreamer::Stats SectorStreamer::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return stats;
+	}
+
+	void SectorStreamer::accountLoadedBytes(size_t bytes)
+	{
+		// expects the mutex to be held
+		stats.bytesLoaded += bytes;
+		rateWindowBytes += bytes;
+		const auto now = std::chrono::steady_clock::now();
+		const std::chrono::duration<double> elapsed = now - rateWindowStart;
+		if (elapsed.count() >= 1.0)
+		{
+			stats.bytesPerSecond = rateWindowBytes / elapsed.count();
+			rateWindowBytes = 0;
+			rateWindowStart = now;
+		}
+	}
+
+	void SectorStreamer::workerLoop()
+	{
+		while (true)
+		{
+			std::shared_ptr<Job> job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+				if (stopping) { return; }
+
+				std::pop_heap(queue.begin(), queue.end(), isLessUrgent);
+				job = std::make_shared<Job>();
+				job->coord = queue.back().coord;
+				queue.pop_back();
+				inFlight.push_back(job);
+				stats.queued = static_cast<uint32_t>(queue.size());
+				stats.inFlight = static_cast<uint32_t>(inFlight.size());
+			}
+
+			// file I/O, mesh parsing and vertex packing happen here, outside the lock
+			auto content = std::make_unique<SectorContent>();
+			bool hasContent = false;
+			std::string error{};
+			try
+			{
+				hasContent = provider(job->coord, *content);
+			}
+			catch (const std::exception& e)
+			{
+				// a broken sector must not take the loader down, it is treated as empty and the error goes to the render thread
+				error = e.what();
+				hasContent = false;
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			inFlight.erase(std::find(inFlight.begin(), inFlight.end(), job));
+			stats.inFlight = static_cast<uint32_t>(inFlight.size());
+			if (job->cancelled) { continue; } // already counted as cancelled
+
+			accountLoadedBytes(hasContent ? content->getSizeBytes() : 0);
+			finished.push_back(FinishedSector{ job->coord, hasContent ? std::move(content) : nullptr, std::move(error) });
+			stats.completed++;
+			if (!finished.back().error.empty()) { stats.failed++; }
+			stats.pendingUpload = static_cast<uint32_t>(finished.size());
+		}
+	}
+
+}
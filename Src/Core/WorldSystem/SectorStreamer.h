@@ -0,0 +1,127 @@
+#pragma once
+#include "Core/Types/CommonTypes.h"
+#include "Core/WorldSystem/Sector.h"
+#include "Core/Primitive.h"
+#include "Core/Types/MappedFile.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WorldSystem
+{
+	// CPU-side sector data, produced on a loader thread and turned into GPU resources on the render thread
+	struct SectorContent
+	{
+		struct PrimitiveData
+		{
+			EngineCore::Primitive::MeshBuilder mesh;
+			Transform transform{};
+			uint32_t materialIndex = 0;
+
+			// zero-copy views into the mapped sector file, used instead of mesh when set
+			const EngineCore::Primitive::Vertex* mappedVertices = nullptr;
+			const uint32_t* mappedIndices = nullptr;
+			uint32_t mappedVertexCount = 0;
+			uint32_t mappedIndexCount = 0;
+		};
+		struct MaterialRef
+		{
+			std::string vertPath;
+			std::string fragPath;
+		};
+		std::vector<PrimitiveData> primitives;
+		std::vector<MaterialRef> materials; // empty uses the default sector material
+		std::shared_ptr<MappedFile> mapping; // keeps the mapped views alive
+
+		// host bytes held by the vertex and index data
+		size_t getSizeBytes() const;
+	};
+
+	/*	reads, parses and packs the content of a sector, always called on a loader thread,
+	*	returns false if the sector has no content (it is still considered loaded) */
+	using SectorContentProvider = std::function<bool(const SectorCoord&, SectorContent&)>;
+
+	/*	background sector loader, a small pool of worker threads performs file I/O and mesh parsing
+	*	for the sectors around the observer, the render thread only collects finished content */
+	class SectorStreamer
+	{
+	public:
+		struct Stats
+		{
+			uint32_t queued = 0; // waiting for a worker
+			uint32_t inFlight = 0; // currently being loaded by a worker
+			uint32_t pendingUpload = 0; // loaded, waiting to be collected by the render thread
+			uint64_t completed = 0;
+			uint64_t cancelled = 0;
+			uint64_t failed = 0; // provider threw, included in completed
+			uint64_t bytesLoaded = 0;
+			double bytesPerSecond = 0.0; // loader throughput, averaged over roughly one second
+		};
+
+		struct FinishedSector
+		{
+			SectorCoord coord;
+			std::unique_ptr<SectorContent> content; // nullptr if the sector has no content
+			std::string error; // what the provider threw, the sector then has no content
+		};
+
+		SectorStreamer(SectorContentProvider provider, uint32_t numThreads = 0);
+		~SectorStreamer();
+		SectorStreamer(const SectorStreamer&) = delete;
+		SectorStreamer& operator=(const SectorStreamer&) = delete;
+
+		/*	centers streaming on a sector, queues every non-resident sector within ringRadius (chebyshev distance),
+		*	nearest to the observer first, anything outside the ring is cancelled or discarded */
+		void retarget(const SectorCoord& center, uint32_t ringRadius, const Vec& observerLocal, float sectorSize,
+					const std::function<bool(const SectorCoord&)>& isResident);
+		// moves finished sectors to out, stops once byteBudget is exceeded (at least one sector is returned if available)
+		void collectFinished(std::vector<FinishedSector>& out, size_t byteBudget);
+
+		Stats getStats() const;
+
+	private:
+		struct Request
+		{
+			SectorCoord coord;
+			float priority; // squared distance to observer, lower is loaded first
+		};
+		struct Job
+		{
+			SectorCoord coord;
+			bool cancelled = false;
+		};
+
+		static bool isLessUrgent(const Request& a, const Request& b);
+		void workerLoop();
+		bool isInRing(const SectorCoord& c) const;
+		bool isTracked(const SectorCoord& c) const;
+		void accountLoadedBytes(size_t bytes);
+
+		SectorContentProvider provider;
+		std::vector<std::thread> workers;
+
+		mutable std::mutex mutex;
+		std::condition_variable wakeCondition;
+		bool stopping = false;
+
+		std::vector<Request> queue; // binary min-heap on priority
+		std::vector<std::shared_ptr<Job>> inFlight;
+		std::vector<FinishedSector> finished;
+
+		SectorCoord ringCenter{};
+		uint32_t ringRadius = 0;
+
+		Stats stats{};
+		std::chrono::steady_clock::time_point rateWindowStart;
+		uint64_t rateWindowBytes = 0;
+	};
+
+}
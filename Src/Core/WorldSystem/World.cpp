@@ -1,180 +1,324 @@
 #include "Core/GPU/Device.h"
 #include "Core/WorldSystem/World.h"
+#include "Core/WorldSystem/SectorFile.h"
 #include "Core/Camera.h"
 #include "Core/Primitive.h"
 #include "Core/GPU/Material.h"
 #include "Core/GPU/Buffer.h"
 #include "Core/GPU/Image.h"
+#include "Core/GPU/Swapchain.h"
 #include "Core/Engine.h"
 
 #include <cmath>
 #include <algorithm>
-#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
 
 
 namespace WorldSystem
 {
 
 	World::World(EngineCore::EngineDevice& device, EngineCore::EngineApplication& engine)
-		: device{ device }, engine{ engine }, localSectorCoord{ std::make_unique<SectorCoord>() }
+		: device{ device }, engine{ engine }
 	{
 		// create the persistent world sector
-		sectors.push_back(std::make_unique<Sector>(SectorCoord(0, 0, 0)));
+		persistentSector = std::make_unique<Sector>(SectorCoord(0, 0, 0));
 	}
 
 
 	void World::sectorUpdate(EngineCore::Camera& camera)
 	{
-		if (updateSectorCoord(camera.transform.translation));
+		frameCounter++;
+		releaseRetiredSectors();
+		const bool enteredNewSector = updateSectorCoord(camera.transform.translation);
+		if (!streamer) { return; }
+
+		if (enteredNewSector || !streamingStarted)
 		{
-			// new local sector entered
-			loadSector(getLocalSectorCoordinate());
+			// new local sector entered, queue its neighbourhood and drop loads we moved away from
+			streamingStarted = true;
+			retargetStreaming(camera);
 		}
+		uploadStreamedSectors();
+		updateResidency();
+		// the memory budget shrank or regrew the load ring, stop loading the dropped ring or queue the regrown one
+		if (residency.getLoadRadius(streamingRadius) != streamedRadius) { retargetStreaming(camera); }
 	}
 
-	bool World::updateSectorCoord(Vec& pos)
+	void World::retargetStreaming(const EngineCore::Camera& camera)
 	{
-		SectorCoord coordNew = getLocalSectorCoordinate();
-		Vec newLocalPos = pos;
-		auto& S = World::SECTOR_SIZE;
-		if (pos.x > S)
-		{
-			coordNew.x += static_cast<intmax_t>(std::floor(pos.x / S));
-			newLocalPos.x = (S - (pos.x - S)) * -1;
-		}
-		else if (pos.x < -S)
+		streamedRadius = residency.getLoadRadius(streamingRadius);
+		streamer->retarget(getLocalSectorCoordinate(), streamedRadius, camera.transform.translation,
+						static_cast<float>(SECTOR_SIZE), [this](const SectorCoord& c) { return getSector(c) != nullptr; });
+	}
+
+	void World::uploadStreamedSectors()
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		finishedSectors.clear();
+		streamer->collectFinished(finishedSectors, uploadByteBudget);
+		for (auto& f : finishedSectors)
 		{
-			coordNew.x -= static_cast<intmax_t>(std::floor(std::abs(pos.x) / S));
-			newLocalPos.x = (S - (std::abs(pos.x) - S));
+			// a sector that failed to load stays loaded without content, so it is not requested again every frame
+			if (!f.error.empty())
+			{
+				streamingStats.lastError = "sector " + std::to_string(f.coord.x) + " " + std::to_string(f.coord.y) + " "
+					+ std::to_string(f.coord.z) + ": " + f.error;
+			}
+			if (!getSector(f.coord)) { loadSector(f.coord, f.content.get()); }
 		}
 
-		if (pos.y > S)
+		const std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+		streamingStats.uploadedThisFrame = static_cast<uint32_t>(finishedSectors.size());
+		streamingStats.uploadMs = ms.count();
+		streamingStats.uploadMsMax = std::max(streamingStats.uploadMsMax, ms.count());
+		finishedSectors.clear(); // release host copies of the uploaded data
+	}
+
+	void World::updateResidency()
+	{
+		residency.nextFrame();
+		const SectorCoord& local = getLocalSectorCoordinate();
+		for (const Sector& s : sectors)
 		{
-			coordNew.y += static_cast<intmax_t>(std::floor(pos.y / S));
-			newLocalPos.y = (S - (pos.y - S)) * -1;
+			if (s.coordinates.chebyshevDistance(local) <= static_cast<intmax_t>(streamedRadius)) { residency.touch(s.coordinates); }
 		}
-		else if (pos.y < -S)
+
+		residency.selectEvictions(local, streamingRadius, evictions);
+		for (const auto& coord : evictions) { forgetSector(coord); }
+	}
+
+	void World::releaseRetiredSectors()
+	{
+		// a frame slot is reused after MAX_FRAMES_IN_FLIGHT frames, its fence has been waited on by then
+		const uint64_t safeFrames = EngineCore::EngineSwapChain::MAX_FRAMES_IN_FLIGHT;
+		retiredSectors.erase(std::remove_if(retiredSectors.begin(), retiredSectors.end(),
+			[this, safeFrames](const RetiredSector& r) { return frameCounter - r.frame > safeFrames; }), retiredSectors.end());
+	}
+
+	SectorResidency::Footprint World::getSectorFootprint(const Sector& sector)
+	{
+		SectorResidency::Footprint footprint{};
+		footprint.hostBytes = sizeof(Sector) + sector.primitives.capacity() * sizeof(EngineCore::Primitive);
+		for (const auto& p : sector.primitives)
 		{
-			coordNew.y -= static_cast<intmax_t>(std::floor(std::abs(pos.y) / S));
-			newLocalPos.y = (S - (std::abs(pos.y) - S));
+			footprint.deviceBytes += p.getVertexCount() * sizeof(EngineCore::Primitive::Vertex);
+			footprint.deviceBytes += p.getIndexCount() * sizeof(uint32_t);
 		}
+		return footprint;
+	}
 
-		if (pos.z > S)
+	bool World::updateSectorCoord(Vec& pos)
+	{
+		const SectorCoord shift = origin.getShift(pos);
+		if (shift == SectorCoord(0, 0, 0)) { return false; }
+		rebaseOrigin(shift, pos);
+		return true;
+	}
+
+	void World::rebaseOrigin(const SectorCoord& shift, Vec& observer)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		const Vec offset = origin.rebase(shift);
+		observer += offset;
+
+		// one pass over every loaded transform
+		uint32_t shifted = FloatingOrigin::shiftTransforms(persistentSector->primitives, offset);
+		for (Sector& sector : sectors) { shifted += FloatingOrigin::shiftTransforms(sector.primitives, offset); }
+
+		const std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+		rebaseStats.count++;
+		rebaseStats.primitives = shifted;
+		rebaseStats.ms = ms.count();
+		rebaseStats.msMax = std::max(rebaseStats.msMax, ms.count());
+	}
+
+	Sector& World::loadSector(const SectorCoord& sectorPosition, const SectorContent* content)
+	{
+		if (Sector* loaded = getSector(sectorPosition)) { return *loaded; }
+		Sector& sector = sectors.insert(std::make_unique<Sector>(sectorPosition));
+		if (!content)
 		{
-			coordNew.z += static_cast<intmax_t>(std::floor(pos.z / S));
-			newLocalPos.z = (S - (pos.z - S)) * -1;
+			residency.track(sectorPosition, getSectorFootprint(sector));
+			return sector;
 		}
-		else if (pos.z < -S)
+
+		std::vector<std::shared_ptr<EngineCore::Material>> materials;
+		for (const auto& ref : content->materials) { materials.push_back(getSectorMaterial(ref)); }
+
+		// vertex data was already parsed and packed (or mapped) by the loader thread, only the GPU upload happens here
+		for (const auto& p : content->primitives)
 		{
-			coordNew.z -= static_cast<intmax_t>(std::floor(std::abs(pos.z) / S));
-			newLocalPos.z = (S - (std::abs(pos.z) - S));
+			auto& primitive = p.mappedVertices
+				? sector.primitives.emplace_back(device, p.mappedVertices, p.mappedVertexCount, p.mappedIndices, p.mappedIndexCount)
+				: sector.primitives.emplace_back(device, p.mesh);
+			primitive.setTransform(p.transform);
+			primitive.setTranslation(sectorToLocal(sectorPosition, p.transform.translation));
+			primitive.setMaterial(p.materialIndex < materials.size() ? materials[p.materialIndex] : sectorMaterial);
 		}
-
-		bool enteredNewSector = (coordNew != getLocalSectorCoordinate());
-		//pos = newLocalPos;		TODO: actually update the camera position !!!
-		setLocalSectorCoordinate(coordNew);
-		return enteredNewSector;
+		residency.track(sectorPosition, getSectorFootprint(sector));
+		return sector;
 	}
 
-	Sector& World::loadSector(const SectorCoord& sectorPosition)
+	std::shared_ptr<EngineCore::Material> World::getSectorMaterial(const SectorContent::MaterialRef& ref)
 	{
-		// TODO: allow loading arbitrary sectors from file
-		if (sectorPosition != SectorCoord(0,0,0))
+		const auto& defaultPaths = sectorMaterial->getCreateInfo().shaderPaths;
+		if (ref.vertPath == defaultPaths.vertPath && ref.fragPath == defaultPaths.fragPath) { return sectorMaterial; }
+
+		auto& material = sectorMaterialCache[ref.vertPath + "|" + ref.fragPath];
+		if (!material)
 		{
-			//std::cout << "sector loading not implemented for " << sectorPosition.x << ", " << sectorPosition.y << ", " << sectorPosition.z;
-			return *sectors.back().get();
+			// same layouts and render state as the default sector material, only the shaders differ
+			EngineCore::MaterialCreateInfo matInfo = sectorMaterial->getCreateInfo();
+			matInfo.shaderPaths = EngineCore::ShaderFilePaths(ref.vertPath, ref.fragPath);
+			material = std::make_shared<EngineCore::Material>(matInfo, device);
+			material->setMaterialSpecificDescriptorSet(sectorMaterialSet);
 		}
-		else
+		return material;
+	}
+
+	void World::saveSector(const SectorCoord& coord, const std::string& path)
+	{
+		Sector* sector = getSector(coord);
+		if (!sector) { throw std::runtime_error("sector file error, attempted to save a sector that is not loaded"); }
+
+		SectorContent content{};
+		std::vector<EngineCore::Material*> materials;
+		for (auto& primitive : sector->primitives)
 		{
-			
+			content.primitives.emplace_back();
+			auto& p = content.primitives.back();
+			primitive.readbackMesh(p.mesh);
+			p.transform = primitive.getTransform().toTransform();
+			p.transform.translation = p.transform.translation - sectorToLocal(coord); // files store positions relative to their own sector
+
+			EngineCore::Material* material = primitive.getMaterial().get();
+			auto it = std::find(materials.begin(), materials.end(), material);
+			p.materialIndex = static_cast<uint32_t>(it - materials.begin());
+			if (it == materials.end())
+			{
+				materials.push_back(material);
+				const auto& paths = (material ? material : sectorMaterial.get())->getCreateInfo().shaderPaths;
+				content.materials.push_back(SectorContent::MaterialRef{ paths.vertPath, paths.fragPath });
+			}
 		}
+		SectorFile::write(path, coord, content);
+	}
+
+	EngineCore::DescriptorSet* World::getSectorMaterialSet()
+	{
+		return sectorMaterial ? sectorMaterial->getMaterialSpecificDescriptorSet() : nullptr;
+	}
 
-		return *sectors.back().get();
+	const World::StreamingStats& World::getStreamingStats()
+	{
+		if (streamer) { streamingStats.loader = streamer->getStats(); }
+		return streamingStats;
 	}
 
 	const SectorCoord& World::getLocalSectorCoordinate() const 
 	{
-		return *localSectorCoord.get();
+		return origin.getLocalSector();
 	}
 
 	void World::setLocalSectorCoordinate(const SectorCoord& coordNew)
 	{
-		*localSectorCoord.get() = coordNew;
+		origin.setLocalSector(coordNew);
 	}
 
-	Vec World::sectorToAbsolute(const SectorCoord& sector, Vec offset)
+	Vec64 World::sectorToAbsolute(const SectorCoord& sector, const Vec64& offset)
 	{ 
-		return Vec(
-			(sector.x * SECTOR_SIZE) + offset.x, 
-			(sector.y * SECTOR_SIZE) + offset.y, 
-			(sector.z * SECTOR_SIZE) + offset.z);
+		const double S = static_cast<double>(SECTOR_SIZE);
+		return Vec64(
+			(static_cast<double>(sector.x) * S) + offset.x, 
+			(static_cast<double>(sector.y) * S) + offset.y, 
+			(static_cast<double>(sector.z) * S) + offset.z);
+	}
+
+	Vec World::sectorToLocal(const SectorCoord& sector, const Vec& offset) const
+	{
+		return origin.sectorToLocal(sector, offset);
 	}
 
+	WorldPosition World::localToWorld(const Vec& local) const
+	{
+		return origin.localToWorld(local);
+	}
+
+	Vec World::worldToLocal(const WorldPosition& position) const
+	{
+		return origin.worldToLocal(position);
+	}
 
-	Vec World::getLocalSectorOriginAbsolute() const
+	Vec64 World::getLocalSectorOriginAbsolute() const
 	{
-		return sectorToAbsolute(getLocalSectorCoordinate(), Vec::zero());
+		return sectorToAbsolute(getLocalSectorCoordinate());
 	}
 
 	void World::forgetSector(const SectorCoord& coord)
 	{
-		auto it = std::remove_if(sectors.begin(), sectors.end(), [coord](const std::unique_ptr<Sector>& s) { return s->coordinates == coord; });
-		assert(it != sectors.end() && "attempted to remove an unknown world sector");
-		assert(it->get()->coordinates != getLocalSectorCoordinate() && "attempted to remove the local world sector");
-		sectors.erase(it, sectors.end());
+		assert(coord != getLocalSectorCoordinate() && "attempted to remove the local world sector");
+		std::unique_ptr<Sector> sector = sectors.extract(coord);
+		assert(sector && "attempted to remove an unknown world sector");
+		residency.untrack(coord);
+		retiredSectors.push_back(RetiredSector{ std::move(sector), frameCounter });
 	}
 
 	Sector* World::getSector(const SectorCoord& coord)
 	{
-		auto it = std::find_if(sectors.begin(), sectors.end(), [coord](const std::unique_ptr<Sector>& s) { return s->coordinates == coord; });
-		if (it == sectors.end()) { return nullptr ; }
-		return it->get();
+		return sectors.find(coord);
 	}
 
-	void World::createDemoSectorContent()
+	bool World::loadSectorContent(const SectorCoord& coord, SectorContent& contentOut)
+	{
+		if (SectorFile::read(makePath(("Sectors/" + SectorFile::makeFileName(coord)).c_str()), coord, contentOut)) { return true; }
+		return loadDemoSectorContent(coord, contentOut);
+	}
+
+	bool World::loadDemoSectorContent(const SectorCoord& coord, SectorContent& contentOut)
 	{
-		auto& sector = *sectors[0]; // get the persistent sector
+		if (coord != SectorCoord(0, 0, 0)) { return false; }
 
 		// create 3D primitive(s)
 		for (size_t i = 0; i < 1; i++)
 		{
-			EngineCore::Primitive::MeshBuilder builder{};
-			builder.loadFromFile(makePath("Meshes/teapot.obj")); // TODO: hardcoded path
-			sector.primitives.push_back(std::make_unique<EngineCore::Primitive>(device, builder));
-			sector.primitives.back()->getTransform().translation = Vec{ 17.f + (i * 17.f), 0.f, 0.f };
-			sector.primitives.back()->getTransform().scale = 30.f;
+			contentOut.primitives.emplace_back();
+			auto& p = contentOut.primitives.back();
+			p.mesh.loadFromFile(makePath("Meshes/teapot.obj")); // TODO: hardcoded path
+			p.transform.translation = Vec{ 17.f + (i * 17.f), 0.f, 0.f };
+			p.transform.scale = 30.f;
 			if (i == 0)
 			{
-				sector.primitives.back()->getTransform().scale *= 5.f; // scale up the second mesh
-				sector.primitives.back()->getTransform().translation.x += 1500.f;
-				sector.primitives.back()->getTransform().rotation.z += 95.f;
+				p.transform.scale *= 5.f; // scale up the second mesh
+				p.transform.translation.x += 1500.f;
+				p.transform.rotation.z += 95.f;
 			}
 		}
+		return true;
+	}
 
+	void World::createDemoSectorContent()
+	{
 		// create material-specific descriptor set (the set must be initialized before using its layout)
-		EngineCore::UBO_Struct ubo{};
-		ubo.add(EngineCore::uelem::vec3); // camera position
-		ubo.add(EngineCore::uelem::vec3); // light position
-		ubo.add(EngineCore::uelem::scalar); // roughness
-		auto matSet = std::make_shared<EngineCore::DescriptorSet>(device);
-		matSet->addUBO(ubo, device);
-		matSet->finalize(); // create material-specific descriptor set
-
-		// create demo material
+		sectorMaterialSet = std::make_shared<EngineCore::DescriptorSet>(device, engine.getRenderer().getDescriptorAllocator());
+		// camera position, light position, roughness
+		sectorMaterialSet->addUBO<EngineCore::ShaderUniforms::SectorMaterial>(engine.getRenderer().getUniformRing());
+		sectorMaterialSet->finalize(); // create material-specific descriptor set
+
+		// create demo material, shared by all streamed primitives (pipeline creation must happen on the render thread)
 		EngineCore::ShaderFilePaths shader(makePath("Shaders/shader.vert.spv"), makePath("Shaders/pbr.frag.spv"));
-		for (size_t i = 0; i < sector.primitives.size(); i++)
-		{
-			// TODO: materials should automatically include the layout of their own set (if present) on construct!!!
-			EngineCore::MaterialCreateInfo matInfo(shader, std::vector<VkDescriptorSetLayout>{ engine.getGlobalDescriptorLayout(), matSet->getLayout() },
-						engine.getRenderSettings().sampleCountMSAA, engine.getRenderer().getBaseRenderpass().getRenderpass(), sizeof(EngineCore::ShaderPushConstants::MeshPushConstants));
-			matInfo.shadingProperties.cullModeFlags = VK_CULL_MODE_NONE;
+		// TODO: materials should automatically include the layout of their own set (if present) on construct!!!
+		EngineCore::MaterialCreateInfo matInfo(shader, std::vector<VkDescriptorSetLayout>{ engine.getGlobalDescriptorLayout(), sectorMaterialSet->getLayout() },
+					engine.getRenderSettings().sampleCountMSAA, engine.getRenderer().getBaseRenderpass().getRenderpass(), sizeof(EngineCore::ShaderPushConstants::MeshPushConstants));
+		matInfo.shadingProperties.cullModeFlags = VK_CULL_MODE_NONE;
+		sectorMaterial = std::make_shared<EngineCore::Material>(matInfo, device);
+		sectorMaterial->setMaterialSpecificDescriptorSet(sectorMaterialSet); // TODO: better way to create material-specific sets
 
-			sector.primitives[i]->setMaterial(matInfo);
-			sector.primitives[i]->getMaterial()->setMaterialSpecificDescriptorSet(matSet); // TODO: better way to create material-specific sets
-		}
+		// sector content is loaded and parsed by background threads from now on
+		streamer = std::make_unique<SectorStreamer>(&World::loadSectorContent);
 	}
 
-	
-
 }
-
@@ -1,9 +1,15 @@
 #pragma once
 #include "Core/Types/CommonTypes.h"
 #include "Core/WorldSystem/Sector.h"
+#include "Core/WorldSystem/FloatingOrigin.h"
+#include "Core/WorldSystem/SectorMap.h"
+#include "Core/WorldSystem/SectorResidency.h"
+#include "Core/WorldSystem/SectorStreamer.h"
 
 #include <stdint.h>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace EngineCore 
@@ -11,6 +17,8 @@ namespace EngineCore
 	class EngineDevice;
 	class Camera;
 	class EngineApplication;
+	class Material;
+	class DescriptorSet;
 }
 
 namespace WorldSystem
@@ -21,29 +29,105 @@ namespace WorldSystem
 	public:
 		World(EngineCore::EngineDevice& device, EngineCore::EngineApplication& engine);
 
+		struct StreamingStats
+		{
+			SectorStreamer::Stats loader{};
+			uint32_t uploadedThisFrame = 0; // sectors turned into GPU resources during the last update
+			double uploadMs = 0.0; // render thread time spent uploading during the last update
+			double uploadMsMax = 0.0;
+			std::string lastError; // most recent failed sector load (loader.failed counts them), empty if none
+		};
+
+		// creates the shared sector material and starts streaming sectors around the observer
 		void createDemoSectorContent();
-		// checks whether we have moved into a new sector
+		// checks whether we have moved into a new sector, queues sector loads and uploads finished sectors
 		void sectorUpdate(EngineCore::Camera& camera);
 
+		struct RebaseStats
+		{
+			uint64_t count = 0; // number of origin shifts so far
+			uint32_t primitives = 0; // transforms shifted by the last rebase
+			double ms = 0.0; // duration of the last rebase
+			double msMax = 0.0;
+		};
+
 		const SectorCoord& getLocalSectorCoordinate() const;
 		void setLocalSectorCoordinate(const SectorCoord& coordNew);
-		static Vec sectorToAbsolute(const SectorCoord& sector, Vec offset = Vec::zero());
+		// absolute position of a sector origin plus offset, in world units
+		static Vec64 sectorToAbsolute(const SectorCoord& sector, const Vec64& offset = Vec64::zero());
+		// position of a sector origin plus offset, relative to the local sector origin
+		Vec sectorToLocal(const SectorCoord& sector, const Vec& offset = Vec::zero()) const;
+		WorldPosition localToWorld(const Vec& local) const;
+		Vec worldToLocal(const WorldPosition& position) const;
 		// returns the real physical location of the current sector center, in world units
-		Vec getLocalSectorOriginAbsolute() const;
+		Vec64 getLocalSectorOriginAbsolute() const;
+		const RebaseStats& getRebaseStats() const { return rebaseStats; }
 		uint32_t getSectorSize() const { return SECTOR_SIZE; }
-		std::vector<std::unique_ptr<Sector>>& getLoadedSectors() { return sectors; }
-		Sector& getPersistentSector() { return *sectors[0].get(); }
+		// currently loaded spatial sectors, does not include the persistent sector
+		SectorMap& getLoadedSectors() { return sectors; }
+		Sector& getPersistentSector() { return *persistentSector.get(); }
+		// material-specific descriptor set shared by all streamed sector primitives
+		EngineCore::DescriptorSet* getSectorMaterialSet();
+		const StreamingStats& getStreamingStats();
+		// memory budgets and eviction tuning for loaded sectors
+		SectorResidency& getResidency() { return residency; }
+		SectorResidency::Stats getResidencyStats() const { return residency.getStats(); }
+		// writes a loaded sector to a binary sector file (reads the mesh data back from the GPU), throws on failure
+		void saveSector(const SectorCoord& coord, const std::string& path);
+
+		// sectors within this chebyshev distance of the local sector are streamed in
+		uint32_t streamingRadius = 1;
+		// max bytes of vertex/index data uploaded to the GPU per frame (at least one sector is always uploaded)
+		size_t uploadByteBudget = 8 * 1024 * 1024;
 
 
 	private:
-		// currently loaded sectors, index 0 is the persistent sector
-		std::vector<std::unique_ptr<Sector>> sectors;
-		std::unique_ptr<SectorCoord> localSectorCoord;
+		// sector that is always loaded, independent of the local sector coordinate
+		std::unique_ptr<Sector> persistentSector;
+		// currently loaded sectors, keyed by sector coordinate
+		SectorMap sectors;
+		FloatingOrigin origin{ SECTOR_SIZE };
+
+		std::unique_ptr<SectorStreamer> streamer;
+		std::vector<SectorStreamer::FinishedSector> finishedSectors; // reused every frame
+		std::shared_ptr<EngineCore::Material> sectorMaterial;
+		std::shared_ptr<EngineCore::DescriptorSet> sectorMaterialSet;
+		// materials referenced by sector files, keyed by shader paths, share the layout and set of sectorMaterial
+		std::unordered_map<std::string, std::shared_ptr<EngineCore::Material>> sectorMaterialCache;
+		StreamingStats streamingStats{};
+		bool streamingStarted = false;
+		uint32_t streamedRadius = 0; // load radius of the last retarget, streamingRadius limited by the memory budget
+
+		SectorResidency residency{};
+		std::vector<SectorCoord> evictions; // reused every frame
+		// unloaded sectors wait here until no frame in flight can reference their buffers anymore
+		struct RetiredSector
+		{
+			std::unique_ptr<Sector> sector;
+			uint64_t frame;
+		};
+		std::vector<RetiredSector> retiredSectors;
+		uint64_t frameCounter = 0;
+
+		RebaseStats rebaseStats{};
 
+		// moves the local sector once the observer is more than one sector away from its origin, returns true if it changed
 		bool updateSectorCoord(Vec& pos);
+		// shifts the observer and every loaded transform by whole sectors so they stay relative to the new local sector
+		void rebaseOrigin(const SectorCoord& shift, Vec& observer);
 		Sector* getSector(const SectorCoord& coord);
-		Sector& loadSector(const SectorCoord& sectorPosition);
+		// creates GPU resources for loaded sector content, must run on the render thread
+		Sector& loadSector(const SectorCoord& sectorPosition, const SectorContent* content);
 		void forgetSector(const SectorCoord& coord);
+		void retargetStreaming(const EngineCore::Camera& camera);
+		void uploadStreamedSectors();
+		void updateResidency();
+		void releaseRetiredSectors();
+		static SectorResidency::Footprint getSectorFootprint(const Sector& sector);
+		std::shared_ptr<EngineCore::Material> getSectorMaterial(const SectorContent::MaterialRef& ref);
+		// loader thread content source, reads binary sector files and falls back to the demo content
+		static bool loadSectorContent(const SectorCoord& coord, SectorContent& contentOut);
+		static bool loadDemoSectorContent(const SectorCoord& coord, SectorContent& contentOut);
 
 	private:
 		EngineCore::EngineDevice& device;
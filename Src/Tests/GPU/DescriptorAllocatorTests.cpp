@@ -0,0 +1,113 @@
+#include "Core/GPU/Descriptors.h"
+#include "GpuTest.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace EngineCore;
+
+namespace
+{
+	class DescriptorAllocatorTest : public GpuTest
+	{
+	protected:
+		std::shared_ptr<DescriptorSetLayout> layoutOf(VkDescriptorType type, uint32_t count)
+		{
+			return DescriptorSetLayout::Builder(*device).addBinding(0, type, VK_SHADER_STAGE_FRAGMENT_BIT, count)
+				.build(device->getLayoutCache());
+		}
+	};
+}
+
+TEST_F(DescriptorAllocatorTest, PersistentSetsShareGrowingPools)
+{
+	DescriptorAllocator allocator{ *device, 2 };
+	const auto layout = layoutOf(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1);
+	std::vector<VkDescriptorSet> sets(1000);
+	std::vector<DescriptorPool*> pools(1000);
+	for (size_t i = 0; i < sets.size(); i++) { ASSERT_TRUE(allocator.allocate(layout->getDescriptorSetLayout(), sets[i], pools[i])); }
+	// 64 + 128 + 256 + 512 + 1024 sets, fewer if the driver does not enforce maxSets
+	EXPECT_LE(allocator.getStats().pools, 5u);
+	EXPECT_EQ(allocator.getStats().sets, 1000u);
+
+	// freed sets leave room in the pools they came from, reallocating them creates no pools
+	const uint32_t poolCount = allocator.getStats().pools;
+	for (size_t i = 0; i < sets.size(); i += 2) { allocator.free(sets[i], pools[i]); }
+	EXPECT_EQ(allocator.getStats().sets, 500u);
+	for (size_t i = 0; i < sets.size(); i += 2) { ASSERT_TRUE(allocator.allocate(layout->getDescriptorSetLayout(), sets[i], pools[i])); }
+	EXPECT_EQ(allocator.getStats().pools, poolCount);
+	EXPECT_EQ(allocator.getStats().failures, 0u);
+
+	for (size_t i = 0; i < sets.size(); i++) { allocator.free(sets[i], pools[i]); }
+	EXPECT_EQ(allocator.getStats().sets, 0u);
+}
+
+TEST_F(DescriptorAllocatorTest, SmallSetsReuseSkippedPools)
+{
+	DescriptorAllocator allocator{ *device, 1 };
+	// a 64 set pool holds 128 combined image samplers, one set of 100, the second one skips to a new pool
+	const auto large = layoutOf(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 100);
+	const auto small = layoutOf(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1);
+	VkDescriptorSet set;
+	DescriptorPool* first;
+	DescriptorPool* pool;
+	ASSERT_TRUE(allocator.allocate(large->getDescriptorSetLayout(), set, first));
+	ASSERT_TRUE(allocator.allocate(large->getDescriptorSetLayout(), set, pool));
+	if (pool == first) { GTEST_SKIP() << "the driver does not enforce pool descriptor counts"; }
+
+	// fill every pool with small sets, the first pool's 28 spare samplers are used before another pool is created
+	const uint32_t poolCount = allocator.getStats().pools;
+	bool usedFirst = false;
+	for (int i = 0; i < 300 && allocator.getStats().pools == poolCount; i++)
+	{
+		ASSERT_TRUE(allocator.allocate(small->getDescriptorSetLayout(), set, pool));
+		usedFirst = usedFirst || pool == first;
+	}
+	EXPECT_TRUE(usedFirst);
+}
+
+TEST_F(DescriptorAllocatorTest, OversizedSetFailsWithoutGrowingTheChain)
+{
+	DescriptorAllocator allocator{ *device, 1 };
+	// more samplers than the largest pool (4096 sets, 8192 samplers) holds
+	const auto oversized = layoutOf(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 9000);
+	VkDescriptorSet set;
+	DescriptorPool* pool;
+	if (allocator.allocate(oversized->getDescriptorSetLayout(), set, pool))
+	{
+		GTEST_SKIP() << "the driver does not enforce pool descriptor counts";
+	}
+	const uint32_t poolCount = allocator.getStats().pools;
+	for (int i = 0; i < 100; i++) { EXPECT_FALSE(allocator.allocate(oversized->getDescriptorSetLayout(), set, pool)); }
+	EXPECT_EQ(allocator.getStats().pools, poolCount);
+	EXPECT_EQ(allocator.getStats().failures, 101u);
+
+	// the empty pools left from the first attempt still serve ordinary sets
+	const auto layout = layoutOf(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1);
+	EXPECT_TRUE(allocator.allocate(layout->getDescriptorSetLayout(), set, pool));
+	EXPECT_EQ(allocator.getStats().pools, poolCount);
+	allocator.free(set, pool);
+}
+
+TEST_F(DescriptorAllocatorTest, TransientPoolsAreReusedAfterReset)
+{
+	DescriptorAllocator allocator{ *device, 2 };
+	const auto layout = layoutOf(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1);
+	uint32_t poolCount = 0;
+	for (uint32_t frame = 0; frame < 6; frame++)
+	{
+		const uint32_t frameIndex = frame % 2;
+		allocator.resetFrame(frameIndex);
+		for (int i = 0; i < 300; i++)
+		{
+			VkDescriptorSet set;
+			ASSERT_TRUE(allocator.allocateTransient(layout->getDescriptorSetLayout(), frameIndex, set));
+		}
+		// both frames have built their chains after the first two frames, later frames reuse them
+		if (frame == 1) { poolCount = allocator.getStats().pools; }
+		if (frame > 1) { EXPECT_EQ(allocator.getStats().pools, poolCount); }
+		EXPECT_EQ(allocator.getStats().sets, frame == 0 ? 300u : 600u);
+	}
+	EXPECT_LE(poolCount, 6u); // 64 + 128 + 256 sets per frame
+}
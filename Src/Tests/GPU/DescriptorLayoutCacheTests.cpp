@@ -0,0 +1,131 @@
+#include "Core/GPU/Descriptors.h"
+#include "GpuTest.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace EngineCore;
+
+namespace
+{
+	// a cache of its own per test, the device's cache is shared with everything the device created
+	class DescriptorLayoutCacheTest : public GpuTest
+	{
+	protected:
+		VkDescriptorSetLayoutBinding binding(uint32_t index, VkDescriptorType type, uint32_t count = 1)
+		{
+			VkDescriptorSetLayoutBinding b{};
+			b.binding = index;
+			b.descriptorType = type;
+			b.descriptorCount = count;
+			b.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+			return b;
+		}
+	};
+}
+
+TEST_F(DescriptorLayoutCacheTest, ReorderedBindingsShareLayout)
+{
+	DescriptorLayoutCache cache{ *device };
+	const auto ubo = binding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+	const auto image = binding(1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 4);
+	const auto sampler = binding(2, VK_DESCRIPTOR_TYPE_SAMPLER);
+
+	auto a = cache.getSetLayout({ ubo, image, sampler });
+	auto b = cache.getSetLayout({ sampler, ubo, image });
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(a->getDescriptorSetLayout(), b->getDescriptorSetLayout());
+
+	// the builder keeps its bindings in a hash map, the order it hands them over in does not matter either
+	auto built = DescriptorSetLayout::Builder(*device)
+		.addBinding(2, VK_DESCRIPTOR_TYPE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
+		.addBinding(1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_SHADER_STAGE_ALL_GRAPHICS, 4)
+		.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_ALL_GRAPHICS)
+		.build(cache);
+	EXPECT_EQ(built, a);
+
+	const auto stats = cache.getStats();
+	EXPECT_EQ(stats.setLayoutLookups, 3u);
+	EXPECT_EQ(stats.setLayoutHits, 2u);
+	EXPECT_EQ(stats.setLayouts, 1u);
+}
+
+TEST_F(DescriptorLayoutCacheTest, DifferentFlagsGiveDifferentLayouts)
+{
+	DescriptorLayoutCache cache{ *device };
+	const std::vector<VkDescriptorSetLayoutBinding> bindings{ binding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 16) };
+
+	auto plain = cache.getSetLayout(bindings);
+	auto partiallyBound = cache.getSetLayout(bindings, { { 0, VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT } });
+	auto updateAfterBind = cache.getSetLayout(bindings,
+		{ { 0, VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT } },
+		VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT);
+	EXPECT_NE(plain, partiallyBound);
+	EXPECT_NE(partiallyBound, updateAfterBind);
+	EXPECT_NE(plain->getDescriptorSetLayout(), partiallyBound->getDescriptorSetLayout());
+
+	// flags for a binding the layout does not have are not part of the key
+	EXPECT_EQ(cache.getSetLayout(bindings, { { 5, VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT } }), plain);
+	// and the same flags again hit
+	EXPECT_EQ(cache.getSetLayout(bindings, { { 0, VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT } }), partiallyBound);
+	EXPECT_EQ(cache.getStats().setLayouts, 3u);
+}
+
+TEST_F(DescriptorLayoutCacheTest, EntryPrunedAfterLastOwner)
+{
+	DescriptorLayoutCache cache{ *device };
+	const std::vector<VkDescriptorSetLayoutBinding> bindings{ binding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) };
+	const VkPushConstantRange push{ VK_SHADER_STAGE_VERTEX_BIT, 0, 128 };
+
+	auto setLayout = cache.getSetLayout(bindings);
+	auto pipelineLayout = cache.getPipelineLayout({ setLayout->getDescriptorSetLayout() }, push);
+	EXPECT_EQ(cache.getPipelineLayout({ setLayout->getDescriptorSetLayout() }, push), pipelineLayout);
+
+	// the pipeline layout owns its set layouts, dropping the set layout alone keeps it alive and cached
+	setLayout.reset();
+	EXPECT_EQ(cache.getStats().setLayouts, 1u);
+	auto again = cache.getSetLayout(bindings);
+	EXPECT_EQ(cache.getStats().setLayoutHits, 1u);
+	again.reset();
+
+	// without owners both layouts are destroyed, their entries stay until the next creation prunes them
+	pipelineLayout.reset();
+	auto stats = cache.getStats();
+	EXPECT_EQ(stats.setLayouts, 0u);
+	EXPECT_EQ(stats.pipelineLayouts, 0u);
+	EXPECT_EQ(stats.entries, 2u);
+
+	auto other = cache.getSetLayout({ binding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) });
+	stats = cache.getStats();
+	EXPECT_EQ(stats.entries, 1u);
+	EXPECT_EQ(stats.setLayouts, 1u);
+
+	// the same bindings as before are a miss now, a new layout is created
+	const uint32_t hits = stats.setLayoutHits;
+	auto recreated = cache.getSetLayout(bindings);
+	EXPECT_EQ(cache.getStats().setLayoutHits, hits);
+	EXPECT_EQ(cache.getStats().setLayouts, 2u);
+}
+
+TEST_F(DescriptorLayoutCacheTest, PipelineLayoutsKeyedBySetLayoutsAndPushRange)
+{
+	DescriptorLayoutCache cache{ *device };
+	auto a = cache.getSetLayout({ binding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) });
+	auto b = cache.getSetLayout({ binding(0, VK_DESCRIPTOR_TYPE_SAMPLER) });
+	const VkPushConstantRange push{ VK_SHADER_STAGE_VERTEX_BIT, 0, 128 };
+
+	auto ab = cache.getPipelineLayout({ a->getDescriptorSetLayout(), b->getDescriptorSetLayout() }, push);
+	EXPECT_NE(cache.getPipelineLayout({ b->getDescriptorSetLayout(), a->getDescriptorSetLayout() }, push), ab); // set order matters
+	EXPECT_NE(cache.getPipelineLayout({ a->getDescriptorSetLayout(), b->getDescriptorSetLayout() }, VkPushConstantRange{ VK_SHADER_STAGE_VERTEX_BIT, 0, 64 }), ab);
+
+	// an empty push constant range is the same layout whatever its stage flags
+	auto none = cache.getPipelineLayout({ a->getDescriptorSetLayout() }, VkPushConstantRange{ VK_SHADER_STAGE_VERTEX_BIT, 0, 0 });
+	EXPECT_EQ(cache.getPipelineLayout({ a->getDescriptorSetLayout() }, VkPushConstantRange{}), none);
+
+	// set layouts from elsewhere cannot be looked up
+	auto uncached = DescriptorSetLayout::Builder(*device).addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS).build();
+	EXPECT_THROW(cache.getPipelineLayout({ uncached->getDescriptorSetLayout() }, push), std::runtime_error);
+}
@@ -0,0 +1,89 @@
+#include "Core/GPU/Descriptors.h"
+#include "Core/GPU/Image.h"
+#include "Core/GPU/Material.h"
+#include "Core/GPU/UniformRing.h"
+#include "GpuTest.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace EngineCore;
+
+namespace
+{
+	class DescriptorTemplateTest : public GpuTest
+	{
+	protected:
+		std::unique_ptr<Image> makeImage()
+		{
+			auto image = std::make_unique<Image>(*device, Image::makeImageCreateInfo(4, 4));
+			image->updateView(VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT);
+			return image;
+		}
+	};
+}
+
+TEST_F(DescriptorTemplateTest, DataIndicesFollowBindingOrder)
+{
+	// added out of order, the update data is laid out by binding index
+	auto layout = DescriptorSetLayout::Builder(*device)
+		.addBinding(2, VK_DESCRIPTOR_TYPE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
+		.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_ALL_GRAPHICS)
+		.addBinding(1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_SHADER_STAGE_ALL_GRAPHICS, 3)
+		.build();
+	EXPECT_NE(layout->getUpdateTemplate(), VK_NULL_HANDLE);
+	EXPECT_EQ(layout->getDescriptorCount(), 5u);
+	EXPECT_EQ(layout->getDataIndex(0), 0u);
+	EXPECT_EQ(layout->getDataIndex(1), 1u);
+	EXPECT_EQ(layout->getDataIndex(2), 4u);
+}
+
+TEST_F(DescriptorTemplateTest, CachedLayoutsShareTheTemplate)
+{
+	const auto build = [this]()
+	{
+		return DescriptorSetLayout::Builder(*device)
+			.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_ALL_GRAPHICS)
+			.addBinding(1, VK_DESCRIPTOR_TYPE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
+			.build(device->getLayoutCache());
+	};
+	const auto a = build();
+	const auto b = build();
+	EXPECT_EQ(a.get(), b.get());
+	EXPECT_EQ(a->getUpdateTemplate(), b->getUpdateTemplate());
+}
+
+TEST_F(DescriptorTemplateTest, RebindRewritesEachFrameOnFetch)
+{
+	constexpr uint32_t frames = 3;
+	UniformRing ring{ *device, 4096, frames };
+	DescriptorAllocator allocator{ *device, frames };
+	auto first = makeImage();
+	auto second = makeImage();
+	VkSampler sampler;
+	Image::createSampler(sampler, *device);
+
+	// the shape of the engine's global set: dynamic UBO, two sampled images, a sampler
+	DescriptorSet set{ *device, allocator, frames };
+	set.addUBO<ShaderUniforms::SceneGlobal>(ring);
+	ImageArrayDescriptor images{};
+	images.addImage(std::vector<VkImageView>(frames, first->getView()));
+	images.addImage(std::vector<VkImageView>(frames, first->getView()));
+	set.addImageArray(images);
+	set.addSampler(sampler);
+	set.finalize();
+	EXPECT_EQ(allocator.getStats().sets, frames);
+
+	std::vector<VkDescriptorSet> handles{};
+	for (uint32_t f = 0; f < frames; f++) { handles.push_back(set.getDescriptorSet(f)); EXPECT_NE(handles.back(), VK_NULL_HANDLE); }
+
+	// rebinding keeps the sets, each is rewritten in place when it is next fetched
+	set.setArrayImage(0, 1, std::vector<VkImageView>(frames, second->getView()));
+	for (uint32_t f = 0; f < frames; f++) { EXPECT_EQ(set.getDescriptorSet(f), handles[f]); }
+	EXPECT_EQ(allocator.getStats().sets, frames);
+
+	vkDeviceWaitIdle(device->device());
+	vkDestroySampler(device->device(), sampler, nullptr);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Core/GPU/Device.h"
+#include "Core/Window.h"
+
+#include <gtest/gtest.h>
+
+#include <exception>
+#include <memory>
+#include <string>
+
+namespace EngineCore
+{
+	/*	fixture for tests that need a real device, one window and device are shared by all tests of a file,
+	*	any Vulkan implementation works, e.g. lavapipe under a virtual display:
+	*	VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json xvfb-run ./DescriptorAllocatorTests
+	*	the tests skip when no device can be created */
+	class GpuTest : public ::testing::Test
+	{
+	public:
+		static void SetUpTestSuite()
+		{
+			try
+			{
+				window = std::make_unique<EngineWindow>(64, 64, "gpu test");
+				device = std::make_unique<EngineDevice>(*window);
+			}
+			catch (const std::exception& e)
+			{
+				skipReason = e.what();
+				device.reset();
+			}
+		}
+		static void TearDownTestSuite()
+		{
+			device.reset();
+			window.reset();
+		}
+
+	protected:
+		void SetUp() override
+		{
+			if (!device) { GTEST_SKIP() << "no Vulkan device: " << skipReason; }
+		}
+
+		static inline std::unique_ptr<EngineWindow> window;
+		static inline std::unique_ptr<EngineDevice> device;
+		static inline std::string skipReason;
+	};
+}
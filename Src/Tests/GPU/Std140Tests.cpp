@@ -0,0 +1,110 @@
+#include "Core/GPU/Descriptors.h"
+#include "Core/GPU/Material.h"
+#include "Core/GPU/Std140.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+using namespace EngineCore;
+using namespace Std140;
+
+namespace
+{
+	// one member of every kind, arrays of a single element included
+	using Mixed = Layout<float, glm::vec3, float, Array<float, 1>, glm::vec2, Array<glm::vec3, 3>, Struct<glm::vec3, float>,
+						Array<Struct<float, glm::vec2>, 2>, glm::mat4, Array<glm::vec4, 1>, uint32_t, Struct<float>, int32_t>;
+
+	static_assert(Mixed::offsets[0] == 0 && Mixed::offsets[1] == 16 && Mixed::offsets[2] == 28, "a scalar uses the vec3 padding");
+	static_assert(Mixed::offsets[3] == 32 && Member<Array<float, 1>>::stride == 16, "a one element array still has a vec4 stride");
+	static_assert(Mixed::offsets[4] == 48 && Mixed::offsets[5] == 64 && Member<Array<glm::vec3, 3>>::stride == 16, "vec3 array stride");
+	static_assert(Mixed::offsets[6] == 112 && Member<Struct<glm::vec3, float>>::size == 16, "a structure is padded to a vec4");
+	static_assert(Mixed::offsets[7] == 128 && Member<Array<Struct<float, glm::vec2>, 2>>::stride == 16
+				&& Mixed::Inner<7>::offsets[1] == 8, "structure array stride and inner offsets");
+	static_assert(Mixed::offsets[8] == 160 && Mixed::offsets[9] == 224 && Mixed::offsets[10] == 240, "mat4 and vec4 array");
+	static_assert(Mixed::offsets[11] == 256 && Mixed::offsets[12] == 272 && Mixed::size == 276, "single member structure");
+
+	// layouts of a single array, the case the runtime layout used to get wrong
+	using ScalarArray1 = Layout<Array<float, 1>>;
+	using ScalarArray4 = Layout<Array<float, 4>, float>;
+	using StructArray1 = Layout<glm::vec2, Array<Struct<glm::vec3>, 1>, float>;
+	static_assert(ScalarArray1::size == 16 && ScalarArray4::size == 68 && StructArray1::size == 36, "array sizes");
+
+	// compares every member, array element and structure member of L with the runtime layout built from it
+	template<typename L, size_t I>
+	void expectMemberMatches(UBO_Layout& runtime)
+	{
+		using M = Member<typename L::template Type<I>>;
+		for (size_t a = 0; a < M::count; a++)
+		{
+			size_t size, offset;
+			if constexpr (std::is_void_v<typename M::Inner>)
+			{
+				runtime.accessElement(UBO_Layout::ElementAccessor{ I, a, 0 }, size, offset);
+				EXPECT_EQ(offset, L::template offsetOf<I>(a)) << "member " << I << " element " << a;
+				EXPECT_EQ(size, Basic<typename M::Value>::size) << "member " << I;
+			}
+			else
+			{
+				using Inner = typename M::Inner;
+				for (size_t e = 0; e < Inner::COUNT; e++)
+				{
+					runtime.accessElement(UBO_Layout::ElementAccessor{ I, a, e }, size, offset);
+					EXPECT_EQ(offset, L::template offsetOf<I>(a) + Inner::offsets[e]) << "member " << I << "." << e << " element " << a;
+				}
+			}
+		}
+	}
+
+	template<typename L, size_t... I>
+	void expectLayoutMatches(std::index_sequence<I...>)
+	{
+		UBO_Layout runtime{ UBO_Struct::fromLayout(L{}) };
+		EXPECT_EQ(runtime.getBufferSize(), L::size);
+		(expectMemberMatches<L, I>(runtime), ...);
+	}
+
+	template<typename L>
+	void expectLayoutMatches() { expectLayoutMatches<L>(std::make_index_sequence<L::COUNT>{}); }
+}
+
+TEST(Std140, RuntimeLayoutMatchesCompileTimeLayout)
+{
+	expectLayoutMatches<Mixed>();
+	expectLayoutMatches<ScalarArray1>();
+	expectLayoutMatches<ScalarArray4>();
+	expectLayoutMatches<StructArray1>();
+	expectLayoutMatches<ShaderUniforms::SceneGlobal>();
+	expectLayoutMatches<ShaderUniforms::SectorMaterial>();
+	expectLayoutMatches<ShaderUniforms::FxViewport>();
+}
+
+TEST(Std140, ArrayLengthZeroIsAPlainMember)
+{
+	// a plain member leaves its padding to the next one, an array of one element does not
+	UBO_Struct plain{};
+	plain.add(uelem::vec3);
+	plain.add(uelem::scalar);
+	UBO_Struct array{};
+	array.add(uelem::vec3, 1);
+	array.add(uelem::scalar);
+	EXPECT_EQ(UBO_Layout{ plain }.getBufferSize(), 16u);
+	EXPECT_EQ(UBO_Layout{ array }.getBufferSize(), 20u);
+}
+
+TEST(Std140, ViewWritesOnlyTheMember)
+{
+	using L = ShaderUniforms::SectorMaterial;
+	std::vector<uint8_t> data(L::size, 0);
+	View<L> view{ data.data() };
+	view.set<L::Roughness>(.5f);
+	view.set<L::LightPosition>(glm::vec3{ 1.f, 2.f, 3.f }); // must not overwrite the roughness packed behind it
+
+	float floats[L::size / sizeof(float)];
+	memcpy(floats, data.data(), L::size);
+	EXPECT_EQ(floats[4], 1.f);
+	EXPECT_EQ(floats[6], 3.f);
+	EXPECT_EQ(floats[7], .5f);
+}
@@ -0,0 +1,63 @@
+#include "Core/Physics/BodyStore.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Physics;
+
+TEST(BodyStore, DestroyKeepsOtherHandlesAndArraysDense)
+{
+	BodyStore store{};
+	std::vector<BodyHandle> bodies{};
+	for (int i = 0; i < 10; i++) { bodies.push_back(store.create(Vec{ static_cast<float>(i), 0.f, 0.f }, 1.f)); }
+
+	store.destroy(bodies[3]);
+	EXPECT_FALSE(store.isAlive(bodies[3]));
+	EXPECT_EQ(store.size(), 9u);
+	for (int i = 0; i < 10; i++)
+	{
+		if (i == 3) { continue; }
+		ASSERT_TRUE(store.isAlive(bodies[i]));
+		EXPECT_EQ(store.getPosition(bodies[i]).x, static_cast<float>(i));
+		EXPECT_LT(store.indexOf(bodies[i]), store.size());
+		EXPECT_EQ(store.handleAt(store.indexOf(bodies[i])), bodies[i]);
+	}
+
+	// the freed slot is reused with a new generation
+	const BodyHandle reused = store.create(Vec{}, 1.f);
+	EXPECT_EQ(reused.slot, bodies[3].slot);
+	EXPECT_NE(reused, bodies[3]);
+	EXPECT_FALSE(store.isAlive(bodies[3]));
+}
+
+TEST(BodyStore, ClearInvalidatesHandles)
+{
+	BodyStore store{};
+	std::vector<BodyHandle> before{};
+	for (int i = 0; i < 8; i++) { before.push_back(store.create(Vec{}, 1.f)); }
+	store.destroy(before[5]);
+	const uint64_t revision = store.getRevision();
+
+	store.clear();
+	EXPECT_EQ(store.size(), 0u);
+	EXPECT_EQ(store.getAwakeCount(), 0u);
+	EXPECT_NE(store.getRevision(), revision);
+	for (const BodyHandle& h : before) { EXPECT_FALSE(store.isAlive(h)); }
+
+	// bodies created after a clear reuse the slots, a handle kept from before (e.g. in a contact cache) must not see them
+	std::vector<BodyHandle> after{};
+	for (int i = 0; i < 8; i++) { after.push_back(store.create(Vec{ 1.f, 2.f, 3.f }, 1.f)); }
+	for (const BodyHandle& h : after)
+	{
+		EXPECT_TRUE(store.isAlive(h));
+		for (const BodyHandle& old : before) { EXPECT_NE(h, old); }
+	}
+	for (const BodyHandle& h : before) { EXPECT_FALSE(store.isAlive(h)); }
+
+	// and a second clear keeps counting
+	store.clear();
+	const BodyHandle third = store.create(Vec{}, 1.f);
+	for (const BodyHandle& h : before) { EXPECT_NE(third, h); }
+	for (const BodyHandle& h : after) { EXPECT_NE(third, h); }
+}
@@ -0,0 +1,213 @@
+#include "Core/Physics/Broadphase.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Physics;
+
+namespace
+{
+	using PairList = std::vector<std::pair<uint32_t, uint32_t>>;
+
+	bool overlaps(const BodyStore& store, uint32_t a, uint32_t b)
+	{
+		const Vec pa = store.getVec(BodyStore::POS_X, a), ea = store.getVec(BodyStore::EXTENT_X, a);
+		const Vec pb = store.getVec(BodyStore::POS_X, b), eb = store.getVec(BodyStore::EXTENT_X, b);
+		return pb.x - eb.x <= pa.x + ea.x && pa.x - ea.x <= pb.x + eb.x
+			&& pb.y - eb.y <= pa.y + ea.y && pa.y - ea.y <= pb.y + eb.y
+			&& pb.z - eb.z <= pa.z + ea.z && pa.z - ea.z <= pb.z + eb.z;
+	}
+
+	// every overlapping pair, skipping the ones Broadphase skips (both immovable or both asleep)
+	PairList referencePairs(const BodyStore& store)
+	{
+		PairList pairs{};
+		const Collider::Type* types = store.colliderTypes();
+		const auto n = static_cast<uint32_t>(store.size());
+		const auto awake = static_cast<uint32_t>(store.getAwakeCount());
+		for (uint32_t a = 0; a < n; a++)
+		{
+			for (uint32_t b = a + 1; b < n; b++)
+			{
+				if (types[a] == Collider::NONE || types[b] == Collider::NONE) { continue; }
+				if (store.getFloat(BodyStore::INV_MASS, a) <= 0.f && store.getFloat(BodyStore::INV_MASS, b) <= 0.f) { continue; }
+				if (a >= awake && b >= awake) { continue; }
+				if (overlaps(store, a, b)) { pairs.emplace_back(a, b); }
+			}
+		}
+		return pairs;
+	}
+
+	PairList sortedPairs(const Broadphase& broadphase)
+	{
+		PairList pairs{};
+		for (const BodyPair& p : broadphase.getPairs()) { pairs.emplace_back(std::min(p.a, p.b), std::max(p.a, p.b)); }
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	// bodies spread over a box of the given size, a mix of spheres, boxes, immovable and collider-less bodies
+	struct Scene
+	{
+		BodyStore store;
+		std::vector<BodyHandle> bodies;
+		std::mt19937 rng{ 5 };
+
+		BodyHandle add(const Vec& size)
+		{
+			std::uniform_real_distribution<float> x{ -size.x, size.x }, y{ -size.y, size.y }, z{ -size.z, size.z };
+			std::uniform_real_distribution<float> extent{ .2f, 1.5f };
+			std::uniform_int_distribution<int> kind{ 0, 9 };
+			const int k = kind(rng);
+			const BodyHandle h = store.create(Vec{ x(rng), y(rng), z(rng) }, k == 0 ? 0.f : 1.f);
+			if (k == 1) { store.setCollider(h, Collider{}); }
+			else if (k < 5) { store.setCollider(h, Collider::sphere(extent(rng))); }
+			else { store.setCollider(h, Collider::box(Vec{ extent(rng), extent(rng), extent(rng) })); }
+			bodies.push_back(h);
+			return h;
+		}
+
+		// small coherent moves of every awake body, written straight to the arrays so nothing is woken
+		void jitter(float amount)
+		{
+			std::uniform_real_distribution<float> d{ -amount, amount };
+			for (uint32_t i = 0; i < store.getAwakeCount(); i++)
+			{
+				store.setVec(BodyStore::POS_X, i, store.getVec(BodyStore::POS_X, i) + Vec{ d(rng), d(rng), d(rng) });
+			}
+		}
+	};
+
+	void expectMatchesReference(Broadphase& broadphase, const BodyStore& store)
+	{
+		broadphase.update(store);
+		const PairList expected = referencePairs(store);
+		ASSERT_EQ(sortedPairs(broadphase), expected);
+		EXPECT_EQ(broadphase.getStats().pairs, expected.size());
+	}
+}
+
+TEST(Broadphase, MatchesReferenceThroughMoves)
+{
+	Scene scene{};
+	for (int i = 0; i < 1500; i++) { scene.add(Vec{ 40.f, 40.f, 40.f }); }
+
+	Broadphase broadphase{};
+	expectMatchesReference(broadphase, scene.store);
+	EXPECT_TRUE(broadphase.getStats().rebuilt);
+	EXPECT_GT(broadphase.getStats().pairs, 50u);
+
+	// coherent motion keeps the previous order and only fixes it up
+	for (int step = 0; step < 20; step++)
+	{
+		scene.jitter(.3f);
+		expectMatchesReference(broadphase, scene.store);
+		EXPECT_FALSE(broadphase.getStats().rebuilt);
+	}
+
+	// teleports force a full sort
+	scene.jitter(60.f);
+	expectMatchesReference(broadphase, scene.store);
+}
+
+TEST(Broadphase, MatchesReferenceThroughAddRemoveAndSleep)
+{
+	Scene scene{};
+	for (int i = 0; i < 1000; i++) { scene.add(Vec{ 30.f, 30.f, 30.f }); }
+	Broadphase broadphase{};
+	expectMatchesReference(broadphase, scene.store);
+
+	std::uniform_int_distribution<size_t> pick{ 0, 999 };
+	for (int round = 0; round < 10; round++)
+	{
+		// remove, add and put to sleep a few bodies, then move the rest
+		for (int k = 0; k < 20; k++)
+		{
+			const size_t i = pick(scene.rng) % scene.bodies.size();
+			if (scene.store.isAlive(scene.bodies[i])) { scene.store.destroy(scene.bodies[i]); }
+			scene.add(Vec{ 30.f, 30.f, 30.f });
+		}
+		for (int k = 0; k < 30; k++)
+		{
+			const BodyHandle h = scene.bodies[pick(scene.rng) % scene.bodies.size()];
+			if (scene.store.isAlive(h)) { scene.store.sleep(h); }
+		}
+		expectMatchesReference(broadphase, scene.store);
+		EXPECT_TRUE(broadphase.getStats().restingRebuilt);
+
+		scene.jitter(.5f);
+		expectMatchesReference(broadphase, scene.store);
+		EXPECT_GT(broadphase.getStats().restingBodies, 0u);
+	}
+}
+
+TEST(Broadphase, FollowsTheLargestSpread)
+{
+	Scene scene{};
+	for (int i = 0; i < 800; i++) { scene.add(Vec{ 200.f, 10.f, 10.f }); }
+	Broadphase broadphase{};
+	expectMatchesReference(broadphase, scene.store);
+	EXPECT_EQ(broadphase.getAxis(), 0);
+
+	// stretch the scene along z, the sweep axis switches and the pairs stay right
+	for (uint32_t i = 0; i < scene.store.size(); i++)
+	{
+		Vec p = scene.store.getVec(BodyStore::POS_X, i);
+		std::swap(p.x, p.z);
+		scene.store.setVec(BodyStore::POS_X, i, p);
+	}
+	expectMatchesReference(broadphase, scene.store);
+	EXPECT_EQ(broadphase.getAxis(), 2);
+}
+
+TEST(Broadphase, DensePileAndOversizedGround)
+{
+	Scene scene{};
+	// a dense cube of bodies resting on one long immovable ground box that sleeps
+	const BodyHandle ground = scene.store.create(Vec{ 0.f, -12.f, 0.f }, 0.f);
+	scene.store.setCollider(ground, Collider::box(Vec{ 500.f, 1.f, 500.f }));
+	for (int i = 0; i < 2000; i++) { scene.add(Vec{ 12.f, 12.f, 12.f }); }
+	scene.store.sleep(ground);
+
+	Broadphase broadphase{};
+	for (int step = 0; step < 5; step++)
+	{
+		expectMatchesReference(broadphase, scene.store);
+		scene.jitter(.2f);
+	}
+	EXPECT_GT(broadphase.getStats().columns, 1u);
+}
+
+TEST(Broadphase, QueryMatchesReference)
+{
+	Scene scene{};
+	for (int i = 0; i < 1000; i++) { scene.add(Vec{ 30.f, 30.f, 30.f }); }
+	for (int i = 0; i < 100; i++) { scene.store.sleep(scene.bodies[i * 7]); }
+	Broadphase broadphase{};
+	broadphase.update(scene.store);
+
+	std::uniform_real_distribution<float> position{ -35.f, 35.f }, size{ 0.f, 6.f };
+	std::vector<uint32_t> found{};
+	for (int q = 0; q < 200; q++)
+	{
+		const Vec lower{ position(scene.rng), position(scene.rng), position(scene.rng) };
+		const Vec upper = lower + Vec{ size(scene.rng), size(scene.rng), size(scene.rng) };
+		found.clear();
+		broadphase.query(scene.store, lower, upper, found);
+		std::sort(found.begin(), found.end());
+
+		std::vector<uint32_t> expected{};
+		for (uint32_t i = 0; i < scene.store.size(); i++)
+		{
+			if (scene.store.colliderTypes()[i] == Collider::NONE) { continue; }
+			const Vec p = scene.store.getVec(BodyStore::POS_X, i), e = scene.store.getVec(BodyStore::EXTENT_X, i);
+			if (p.x - e.x <= upper.x && lower.x <= p.x + e.x && p.y - e.y <= upper.y && lower.y <= p.y + e.y &&
+				p.z - e.z <= upper.z && lower.z <= p.z + e.z) { expected.push_back(i); }
+		}
+		ASSERT_EQ(found, expected);
+	}
+}
@@ -0,0 +1,153 @@
+#include "Core/Physics/ContactCache.h"
+#include "Core/Physics/BodyStore.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Physics;
+
+namespace
+{
+	Collision contact(uint32_t a, uint32_t b, const Vec& normal, float impulse = 0.f)
+	{
+		Collision c{};
+		c.bodies = { a, b };
+		c.normal = normal;
+		c.penetrationDepth = .01f;
+		c.accumulatedImpulse = impulse;
+		return c;
+	}
+
+	const Vec UP{ 0.f, 1.f, 0.f };
+}
+
+TEST(ContactCache, SamePairIsWarmStarted)
+{
+	BodyStore store{};
+	for (int i = 0; i < 4; i++) { store.create(Vec{ static_cast<float>(i), 0.f, 0.f }, 1.f); }
+	ContactCache cache{};
+	cache.warmStartFactor = .5f;
+
+	std::vector<Collision> contacts{ contact(0, 1, UP), contact(2, Collision::NO_BODY, UP) };
+	cache.warmStart(store, contacts);
+	EXPECT_EQ(cache.getStats().misses, 2u);
+	EXPECT_EQ(contacts[0].accumulatedImpulse, 0.f);
+	// what the solver would have left behind
+	contacts[0].accumulatedImpulse = 4.f;
+	contacts[1].accumulatedImpulse = 2.f;
+	cache.update(store, contacts);
+	EXPECT_EQ(cache.size(), 2u);
+
+	// next step, reported in a different order, plus a pair that is new
+	std::vector<Collision> next{ contact(2, Collision::NO_BODY, UP), contact(1, 3, UP), contact(0, 1, UP, 99.f) };
+	cache.warmStart(store, next);
+	EXPECT_EQ(cache.getStats().hits, 2u);
+	EXPECT_EQ(cache.getStats().misses, 1u);
+	EXPECT_EQ(next[0].accumulatedImpulse, 1.f);
+	EXPECT_EQ(next[1].accumulatedImpulse, 0.f);
+	EXPECT_EQ(next[2].accumulatedImpulse, 2.f); // the stale input value is overwritten
+}
+
+TEST(ContactCache, TurnedNormalStartsFromZero)
+{
+	BodyStore store{};
+	store.create(Vec{}, 1.f);
+	store.create(Vec{}, 1.f);
+	ContactCache cache{};
+
+	std::vector<Collision> contacts{ contact(0, 1, UP) };
+	cache.warmStart(store, contacts);
+	contacts[0].accumulatedImpulse = 3.f;
+	cache.update(store, contacts);
+
+	std::vector<Collision> turned{ contact(0, 1, Vec{ 1.f, 0.f, 0.f }) };
+	cache.warmStart(store, turned);
+	EXPECT_EQ(turned[0].accumulatedImpulse, 0.f);
+	EXPECT_EQ(cache.getStats().hits, 0u);
+}
+
+TEST(ContactCache, MatchesHandlesNotDenseIndices)
+{
+	BodyStore store{};
+	std::vector<BodyHandle> h{};
+	for (int i = 0; i < 4; i++) { h.push_back(store.create(Vec{}, 1.f)); }
+	ContactCache cache{};
+
+	std::vector<Collision> contacts{ contact(store.indexOf(h[2]), store.indexOf(h[3]), UP) };
+	cache.warmStart(store, contacts);
+	contacts[0].accumulatedImpulse = 5.f;
+	cache.update(store, contacts);
+
+	// removing a body moves the last one into its dense index, the pair is still found through its handles
+	store.destroy(h[0]);
+	ASSERT_NE(store.indexOf(h[3]), 3u);
+	std::vector<Collision> moved{ contact(store.indexOf(h[2]), store.indexOf(h[3]), UP) };
+	cache.warmStart(store, moved);
+	EXPECT_EQ(moved[0].accumulatedImpulse, 5.f);
+	cache.update(store, moved);
+
+	// a new body in a reused slot does not inherit the impulse of the destroyed one
+	store.destroy(h[3]);
+	const BodyHandle reused = store.create(Vec{}, 1.f);
+	ASSERT_EQ(reused.slot, h[3].slot);
+	std::vector<Collision> fresh{ contact(store.indexOf(h[2]), store.indexOf(reused), UP) };
+	cache.warmStart(store, fresh);
+	EXPECT_EQ(fresh[0].accumulatedImpulse, 0.f);
+	EXPECT_EQ(cache.getStats().misses, 1u);
+}
+
+TEST(ContactCache, MissingContactsAgeOut)
+{
+	BodyStore store{};
+	store.create(Vec{}, 1.f);
+	store.create(Vec{}, 1.f);
+	ContactCache cache{};
+	cache.maxAge = 3;
+
+	std::vector<Collision> contacts{ contact(0, 1, UP) };
+	cache.warmStart(store, contacts);
+	contacts[0].accumulatedImpulse = 3.f;
+	cache.update(store, contacts);
+
+	// kept for maxAge steps without the contact
+	std::vector<Collision> none{};
+	for (uint32_t step = 1; step <= 3; step++)
+	{
+		cache.warmStart(store, none);
+		cache.update(store, none);
+		EXPECT_EQ(cache.size(), 1u) << "step " << step;
+	}
+	// a contact that flickered back within that time is still warm started
+	std::vector<Collision> back{ contact(0, 1, UP) };
+	cache.warmStart(store, back);
+	EXPECT_EQ(back[0].accumulatedImpulse, 3.f);
+
+	// gone for one step more than maxAge, the entry is dropped
+	cache.clear();
+	cache.warmStart(store, contacts);
+	cache.update(store, contacts);
+	for (uint32_t step = 1; step <= 4; step++)
+	{
+		cache.warmStart(store, none);
+		cache.update(store, none);
+	}
+	EXPECT_EQ(cache.size(), 0u);
+	EXPECT_EQ(cache.getStats().aged, 1u);
+}
+
+TEST(ContactCache, DisabledNeverWarmStarts)
+{
+	BodyStore store{};
+	store.create(Vec{}, 1.f);
+	store.create(Vec{}, 1.f);
+	ContactCache cache{};
+	cache.enabled = false;
+
+	std::vector<Collision> contacts{ contact(0, 1, UP, 7.f) };
+	cache.warmStart(store, contacts);
+	EXPECT_EQ(contacts[0].accumulatedImpulse, 0.f);
+	contacts[0].accumulatedImpulse = 3.f;
+	cache.update(store, contacts);
+	EXPECT_EQ(cache.size(), 0u);
+}
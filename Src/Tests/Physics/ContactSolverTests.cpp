@@ -0,0 +1,114 @@
+#include "Core/Physics/ContactSolver.h"
+#include "Core/Physics/BodyStore.h"
+#include "Core/Physics/Broadphase.h"
+#include "Core/Physics/Narrowphase.h"
+#include "Core/Types/TaskPool.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+namespace
+{
+	// piles of 4x4x4 unit boxes, slightly jittered so contacts are not symmetric, on one static ground box
+	void buildPiles(BodyStore& store, int piles)
+	{
+		std::mt19937 rng{ 3 };
+		std::uniform_real_distribution<float> jitter{ -.05f, .05f };
+		const BodyHandle ground = store.create(Vec{ 0.f, -1.f, 0.f }, 0.f);
+		store.setCollider(ground, Collider::box(Vec{ 200.f, 1.f, 200.f }));
+		for (int p = 0; p < piles; p++)
+		{
+			const Vec base{ (p % 8) * 10.f - 35.f, 0.f, (p / 8) * 10.f - 35.f };
+			for (int i = 0; i < 64; i++)
+			{
+				const Vec offset{ (i % 4) * 1.01f + jitter(rng), (i / 16) * 1.01f + .52f, (i / 4 % 4) * 1.01f + jitter(rng) };
+				const BodyHandle h = store.create(base + offset, 1.f);
+				store.setCollider(h, Collider::box(Vec{ .5f, .5f, .5f }));
+				store.setAcceleration(h, Vec{ 0.f, -9.81f, 0.f });
+			}
+		}
+	}
+
+	// integrate, find contacts, optionally shuffle them, solve, like PhysicsScene without the extras
+	void run(BodyStore& store, ContactSolver& solver, int steps, bool shuffle)
+	{
+		Broadphase broadphase{};
+		Narrowphase narrowphase{};
+		std::vector<Collision> contacts{};
+		std::mt19937 rng{ 11 };
+		for (int step = 0; step < steps; step++)
+		{
+			store.integrate(1.f / 60.f);
+			broadphase.update(store);
+			contacts.clear();
+			narrowphase.generate(store, broadphase.getPairs(), contacts);
+			if (shuffle) { std::shuffle(contacts.begin(), contacts.end(), rng); }
+			solver.solve(store, contacts);
+		}
+	}
+
+	bool bitIdentical(const BodyStore& a, const BodyStore& b)
+	{
+		if (a.size() != b.size()) { return false; }
+		for (int c : { BodyStore::POS_X, BodyStore::POS_Y, BodyStore::POS_Z, BodyStore::VEL_X, BodyStore::VEL_Y, BodyStore::VEL_Z })
+		{
+			const auto component = static_cast<BodyStore::Component>(c);
+			if (std::memcmp(a.array(component), b.array(component), a.size() * sizeof(float)) != 0) { return false; }
+		}
+		return true;
+	}
+}
+
+TEST(ContactSolver, PoolMatchesSerialBitForBit)
+{
+	BodyStore serialStore{}, pooledStore{};
+	buildPiles(serialStore, 24);
+	buildPiles(pooledStore, 24);
+
+	TaskPool pool{ 3 };
+	ContactSolver serial{}, pooled{ &pool };
+	run(serialStore, serial, 60, false);
+	run(pooledStore, pooled, 60, false);
+
+	// enough islands and contacts to split the work into several tasks
+	EXPECT_GE(pooled.getStats().islands, 24u);
+	EXPECT_GT(pooled.getStats().tasks, 1u);
+	EXPECT_TRUE(bitIdentical(serialStore, pooledStore));
+}
+
+TEST(ContactSolver, DeterministicModeIgnoresContactOrder)
+{
+	BodyStore ordered{}, shuffled{};
+	buildPiles(ordered, 4);
+	buildPiles(shuffled, 4);
+
+	TaskPool pool{ 3 };
+	ContactSolver a{}, b{ &pool };
+	a.settings.deterministic = true;
+	b.settings.deterministic = true;
+	run(ordered, a, 60, false);
+	run(shuffled, b, 60, true);
+	EXPECT_TRUE(bitIdentical(ordered, shuffled));
+}
+
+TEST(ContactSolver, PileSettlesOnGround)
+{
+	BodyStore store{};
+	buildPiles(store, 1);
+	ContactSolver solver{};
+	run(store, solver, 240, false);
+
+	// the bottom layer rests on the ground (top at y = 0), nothing sank through or got thrown up
+	const float* y = store.array(BodyStore::POS_Y);
+	for (uint32_t i = 1; i < store.size(); i++)
+	{
+		EXPECT_GT(y[i], .4f) << "body " << i;
+		EXPECT_LT(y[i], 4.2f) << "body " << i;
+	}
+}
@@ -0,0 +1,129 @@
+#include "Core/Physics/ContinuousCollision.h"
+#include "Core/Physics/PhysicsScene.h"
+#include "Core/Physics/Rigidbody.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+using namespace Physics;
+
+namespace
+{
+	// first sample of the motion at which the shapes touch, the reference for the analytic sweeps
+	template<typename Touches>
+	float sampledImpact(const Vec& start, const Vec& displacement, Touches touches)
+	{
+		constexpr int SAMPLES = 20000;
+		for (int i = 0; i <= SAMPLES; i++)
+		{
+			const float t = static_cast<float>(i) / SAMPLES;
+			if (touches(start + displacement * t)) { return t; }
+		}
+		return -1.f;
+	}
+
+	/*	a thin static wall across x = wallX, a projectile fired at it from 2 m before, fast enough to cross
+	*	the wall and its own size several times over in one step, returns where the projectile ended up */
+	float fireAtWall(float wallX, const Collider& projectile, float speed)
+	{
+		PhysicsScene scene{};
+		scene.createBody(Vec{ wallX, 0.f, 0.f }, 0.f, Collider::box(Vec{ .05f, 5.f, 5.f }));
+		auto body = scene.createBody(Vec{ wallX - 2.f, 0.f, 0.f }, 1.f, projectile);
+		body->setDamping(1.f);
+		body->setVelocity(Vec{ speed, 0.f, 0.f });
+		for (int step = 0; step < 30; step++) { scene.simulate(1.f / 60.f); }
+		return body->getPosition().x;
+	}
+}
+
+TEST(ContinuousCollision, SweepsMatchSampling)
+{
+	std::mt19937 rng{ 21 };
+	std::uniform_real_distribution<float> coord{ -4.f, 4.f }, size{ .1f, 1.f }, reach{ .5f, 2.f };
+	int hits = 0;
+	for (int i = 0; i < 200; i++)
+	{
+		const Vec start{ coord(rng), coord(rng), coord(rng) };
+		// roughly towards the other body, so a good share of the cases hit
+		const Vec displacement = start * -reach(rng) + Vec{ coord(rng), coord(rng), coord(rng) } * .5f;
+		const float radii = size(rng) * 2.f;
+		const Vec halfExtents{ size(rng) * 2.f, size(rng) * 2.f, size(rng) * 2.f };
+
+		const float sphereT = sampledImpact(start, displacement, [radii](const Vec& p) { return Vec::dot(p, p) <= radii * radii; });
+		float t;
+		// a start that already overlaps is left to the discrete contact
+		if (sphereT > 0.f)
+		{
+			ASSERT_TRUE(ContinuousCollision::sweepSphereSphere(start, displacement, radii, t)) << i;
+			EXPECT_NEAR(t, sphereT, 1e-3f) << i;
+			hits++;
+		}
+		else if (sphereT < 0.f) { EXPECT_FALSE(ContinuousCollision::sweepSphereSphere(start, displacement, radii, t)) << i; }
+
+		const float boxT = sampledImpact(start, displacement, [&halfExtents](const Vec& p)
+		{
+			return std::abs(p.x) <= halfExtents.x && std::abs(p.y) <= halfExtents.y && std::abs(p.z) <= halfExtents.z;
+		});
+		if (boxT > 0.f)
+		{
+			ASSERT_TRUE(ContinuousCollision::sweepBox(start, displacement, halfExtents, t)) << i;
+			EXPECT_NEAR(t, boxT, 1e-3f) << i;
+			hits++;
+		}
+		else if (boxT < 0.f) { EXPECT_FALSE(ContinuousCollision::sweepBox(start, displacement, halfExtents, t)) << i; }
+	}
+	// the random cases are not all misses
+	EXPECT_GT(hits, 100);
+}
+
+TEST(ContinuousCollision, FastSphereStopsAtWallNearOrigin)
+{
+	// .1 m sphere at 600 m/s moves 10 m per step, past a 10 cm wall
+	const float x = fireAtWall(0.f, Collider::sphere(.1f), 600.f);
+	EXPECT_LT(x, 0.f);
+}
+
+TEST(ContinuousCollision, FastBoxStopsAtWallNearOrigin)
+{
+	const float x = fireAtWall(0.f, Collider::box(Vec{ .1f, .1f, .1f }), 450.f);
+	EXPECT_LT(x, 0.f);
+}
+
+TEST(ContinuousCollision, FastBodiesStopAtWallAtSectorScale)
+{
+	// float spacing at 48 km is about 4 mm, the sweeps run relative to the wall and still catch the impact
+	const float wallX = 48000.f;
+	EXPECT_LT(fireAtWall(wallX, Collider::sphere(.1f), 600.f), wallX);
+	EXPECT_LT(fireAtWall(wallX, Collider::box(Vec{ .1f, .1f, .1f }), 450.f), wallX);
+}
+
+TEST(ContinuousCollision, DisabledTunnels)
+{
+	// the setup of the tests above does tunnel without the sweeps, so they test something
+	for (float wallX : { 0.f, 48000.f })
+	{
+		PhysicsScene scene{};
+		scene.getContinuousCollision().settings.enabled = false;
+		scene.createBody(Vec{ wallX, 0.f, 0.f }, 0.f, Collider::box(Vec{ .05f, 5.f, 5.f }));
+		auto body = scene.createBody(Vec{ wallX - 2.f, 0.f, 0.f }, 1.f, Collider::sphere(.1f));
+		body->setDamping(1.f);
+		body->setVelocity(Vec{ 600.f, 0.f, 0.f });
+		for (int step = 0; step < 30; step++) { scene.simulate(1.f / 60.f); }
+		EXPECT_GT(body->getPosition().x, wallX);
+	}
+}
+
+TEST(ContinuousCollision, FastSpheresMeetingHeadOnDoNotPass)
+{
+	PhysicsScene scene{};
+	auto a = scene.createBody(Vec{ -3.f, 0.f, 0.f }, 1.f, Collider::sphere(.1f));
+	auto b = scene.createBody(Vec{ 3.f, 0.f, 0.f }, 1.f, Collider::sphere(.1f));
+	a->setDamping(1.f);
+	b->setDamping(1.f);
+	a->setVelocity(Vec{ 300.f, 0.f, 0.f });
+	b->setVelocity(Vec{ -300.f, 0.f, 0.f });
+	for (int step = 0; step < 30; step++) { scene.simulate(1.f / 60.f); }
+	EXPECT_LT(a->getPosition().x, b->getPosition().x);
+}
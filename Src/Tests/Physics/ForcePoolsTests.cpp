@@ -0,0 +1,120 @@
+#include "Core/Physics/ForcePools.h"
+#include "Core/Physics/ForceGenerator.h"
+#include "Core/Physics/Rigidbody.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+namespace
+{
+	Vec forceOf(const BodyStore& store, BodyHandle h) { return store.getVec(BodyStore::FORCE_X, store.indexOf(h)); }
+
+	void expectNear(const Vec& a, const Vec& b, float tolerance)
+	{
+		EXPECT_NEAR(a.x, b.x, tolerance);
+		EXPECT_NEAR(a.y, b.y, tolerance);
+		EXPECT_NEAR(a.z, b.z, tolerance);
+	}
+}
+
+TEST(SpringPool, MatchesSpringForceGenerator)
+{
+	BodyStore store{};
+	std::mt19937 rng{ 13 };
+	std::uniform_real_distribution<float> position{ -10.f, 10.f }, rest{ 0.f, 8.f }, k{ .5f, 50.f };
+
+	std::vector<std::shared_ptr<Rigidbody>> bodies{};
+	for (int i = 0; i < 100; i++) { bodies.push_back(std::make_shared<Rigidbody>(store, Vec{ position(rng), position(rng), position(rng) }, 1.f)); }
+
+	// one spring per pair of neighbours, stretched or compressed, against a generator applied to each end
+	SpringPool pool{};
+	std::vector<std::unique_ptr<SpringForceGenerator>> generators{};
+	for (size_t i = 0; i + 1 < bodies.size(); i += 2)
+	{
+		const float restLength = rest(rng), stiffness = k(rng);
+		pool.add(bodies[i]->getHandle(), bodies[i + 1]->getHandle(), restLength, stiffness);
+		generators.push_back(std::make_unique<SpringForceGenerator>(bodies[i + 1], restLength, stiffness));
+		generators.back()->addBody(bodies[i]);
+		generators.push_back(std::make_unique<SpringForceGenerator>(bodies[i], restLength, stiffness));
+		generators.back()->addBody(bodies[i + 1]);
+	}
+	EXPECT_EQ(pool.size(), 50u);
+
+	pool.apply(store);
+	std::vector<Vec> pooled{};
+	for (const auto& b : bodies) { pooled.push_back(forceOf(store, b->getHandle())); b->resetForces(); }
+	for (const auto& g : generators) { g->applyForces(1.f / 60.f); }
+
+	for (size_t i = 0; i < bodies.size(); i++)
+	{
+		const Vec expected = forceOf(store, bodies[i]->getHandle());
+		const float tolerance = 1e-4f * (1.f + std::sqrt(Vec::dot(expected, expected)));
+		expectNear(pooled[i], expected, tolerance);
+	}
+}
+
+TEST(SpringPool, DampingOpposesClosingSpeed)
+{
+	BodyStore store{};
+	const BodyHandle a = store.create(Vec{ 0.f, 0.f, 0.f }, 1.f);
+	const BodyHandle b = store.create(Vec{ 2.f, 0.f, 0.f }, 1.f);
+	store.setVelocity(a, Vec{ 1.f, 0.f, 0.f });
+	store.setVelocity(b, Vec{ -1.f, 0.f, 0.f });
+
+	// at rest length, so only damping acts: closing at 2 units/s along x
+	SpringPool pool{};
+	pool.add(a, b, 2.f, 10.f, 3.f);
+	pool.apply(store);
+	expectNear(forceOf(store, a), Vec{ -6.f, 0.f, 0.f }, 1e-5f);
+	expectNear(forceOf(store, b), Vec{ 6.f, 0.f, 0.f }, 1e-5f);
+}
+
+TEST(SpringPool, DropsDestroyedAndSkipsSleepingEnds)
+{
+	BodyStore store{};
+	const BodyHandle a = store.create(Vec{ 0.f, 0.f, 0.f }, 1.f);
+	const BodyHandle b = store.create(Vec{ 3.f, 0.f, 0.f }, 1.f);
+	const BodyHandle c = store.create(Vec{ 0.f, 4.f, 0.f }, 1.f);
+	SpringPool pool{};
+	pool.add(a, b, 1.f, 1.f);
+	pool.add(a, c, 1.f, 1.f);
+
+	// stretched by 2 along x, pulls a towards b, b is asleep and keeps no force
+	store.destroy(c);
+	store.sleep(b);
+	pool.apply(store);
+	EXPECT_EQ(pool.size(), 1u);
+	expectNear(forceOf(store, a), Vec{ 2.f, 0.f, 0.f }, 1e-5f);
+	expectNear(forceOf(store, b), Vec{ 0.f, 0.f, 0.f }, 0.f);
+}
+
+TEST(GravityPool, AppliesWeightToMovableBodies)
+{
+	BodyStore store{};
+	const BodyHandle heavy = store.create(Vec{}, 4.f);
+	const BodyHandle fixed = store.create(Vec{}, 0.f);
+	GravityPool pool{};
+	pool.add(heavy, Vec{ 0.f, -9.81f, 0.f });
+	pool.add(fixed, Vec{ 0.f, -9.81f, 0.f });
+	pool.apply(store);
+	expectNear(forceOf(store, heavy), Vec{ 0.f, -4.f * 9.81f, 0.f }, 1e-4f);
+	expectNear(forceOf(store, fixed), Vec{}, 0.f);
+}
+
+TEST(DragPool, LinearAndQuadratic)
+{
+	BodyStore store{};
+	const BodyHandle body = store.create(Vec{}, 1.f);
+	store.setVelocity(body, Vec{ 3.f, 0.f, 4.f }); // speed 5
+	DragPool pool{};
+	pool.add(body, .5f, .1f);
+	pool.apply(store);
+	// -v * (0.5 + 0.1 * 5)
+	expectNear(forceOf(store, body), Vec{ -3.f, 0.f, -4.f }, 1e-5f);
+}
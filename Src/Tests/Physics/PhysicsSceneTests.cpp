@@ -0,0 +1,49 @@
+#include "Core/Physics/PhysicsScene.h"
+#include "Core/Physics/Rigidbody.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace Physics;
+
+TEST(PhysicsScene, SphereComesToRestOnStaticBox)
+{
+	PhysicsScene scene{};
+	auto ground = scene.createBody(Vec{ 0.f, 0.f, 0.f }, 0.f, Collider::box(Vec{ 10.f, 1.f, 10.f }));
+	auto ball = scene.createBody(Vec{ 0.f, 5.f, 0.f }, 1.f, Collider::sphere(.5f));
+	ball->setAcceleration(Vec{ 0.f, -9.81f, 0.f });
+
+	for (int step = 0; step < 600; step++) { scene.simulate(1.f / 60.f); }
+
+	// resting on top of the box (surface at y = 1), neither sunk in nor bouncing
+	EXPECT_NEAR(ball->getPosition().y, 1.5f, .05f);
+	EXPECT_NEAR(ball->getVelocity().y, 0.f, .05f);
+	EXPECT_EQ(ground->getPosition().y, 0.f);
+}
+
+TEST(PhysicsScene, HeadOnHitConservesMomentum)
+{
+	PhysicsScene scene{};
+	auto a = scene.createBody(Vec{ -3.f, 0.f, 0.f }, 1.f, Collider::sphere(.5f));
+	auto b = scene.createBody(Vec{ 3.f, 0.f, 0.f }, 3.f, Collider::sphere(.5f));
+	a->setDamping(1.f);
+	b->setDamping(1.f);
+	a->setVelocity(Vec{ 6.f, 0.f, 0.f });
+	b->setVelocity(Vec{ -2.f, 0.f, 0.f });
+	const float before = a->getMass() * a->getVelocity().x + b->getMass() * b->getVelocity().x;
+
+	bool touched = false;
+	for (int step = 0; step < 120; step++)
+	{
+		scene.simulate(1.f / 60.f);
+		touched = touched || scene.getStats().contacts > 0;
+	}
+	ASSERT_TRUE(touched);
+
+	// they separate after the hit, with the total momentum unchanged
+	const float after = a->getMass() * a->getVelocity().x + b->getMass() * b->getVelocity().x;
+	EXPECT_NEAR(after, before, 1e-3f * std::abs(before));
+	EXPECT_LT(a->getVelocity().x, b->getVelocity().x);
+	EXPECT_LT(a->getPosition().x, b->getPosition().x);
+}
@@ -0,0 +1,168 @@
+#include "Core/Physics/SleepSystem.h"
+#include "Core/Physics/ForcePools.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Physics;
+
+namespace
+{
+	constexpr float STEP = 1.f / 60.f;
+
+	// contact between two bodies by handle, dense indices change whenever a body sleeps or wakes
+	Collision touching(const BodyStore& store, BodyHandle a, BodyHandle b)
+	{
+		Collision c{};
+		c.bodies = { store.indexOf(a), b.isValid() ? store.indexOf(b) : Collision::NO_BODY };
+		c.normal = Vec{ 0.f, 1.f, 0.f };
+		return c;
+	}
+
+	// runs updates until timeToSleep has passed, with the contacts rebuilt from handles every step
+	void rest(SleepSystem& sleep, BodyStore& store, const std::vector<std::pair<BodyHandle, BodyHandle>>& pairs, const SpringPool& springs)
+	{
+		const int steps = static_cast<int>(sleep.settings.timeToSleep / STEP) + 2;
+		for (int i = 0; i < steps; i++)
+		{
+			std::vector<Collision> contacts{};
+			for (const auto& p : pairs) { contacts.push_back(touching(store, p.first, p.second)); }
+			sleep.update(store, contacts, springs, STEP);
+		}
+	}
+}
+
+TEST(SleepSystem, SleepsBelowEnergyThresholdOnly)
+{
+	BodyStore store{};
+	SleepSystem sleep{};
+	const SpringPool springs{};
+	// threshold .5 * .05^2, about 5 cm/s
+	const BodyHandle slow = store.create(Vec{}, 1.f);
+	const BodyHandle fast = store.create(Vec{ 10.f, 0.f, 0.f }, 1.f);
+	store.setVelocity(slow, Vec{ .04f, 0.f, 0.f });
+	store.setVelocity(fast, Vec{ .06f, 0.f, 0.f });
+
+	// not before timeToSleep has passed
+	const int steps = static_cast<int>(sleep.settings.timeToSleep / STEP);
+	for (int i = 0; i < steps - 1; i++) { sleep.update(store, {}, springs, STEP); }
+	EXPECT_TRUE(store.isAwake(slow));
+
+	rest(sleep, store, {}, springs);
+	EXPECT_FALSE(store.isAwake(slow));
+	EXPECT_TRUE(store.isAwake(fast));
+	// sleeping clears the velocity, the body stays put when woken
+	EXPECT_EQ(store.getVelocity(slow).x, 0.f);
+	EXPECT_EQ(sleep.getStats().sleeping, 1u);
+	EXPECT_EQ(sleep.getStats().awake, 1u);
+}
+
+TEST(SleepSystem, MovementResetsSleepTimer)
+{
+	BodyStore store{};
+	SleepSystem sleep{};
+	const SpringPool springs{};
+	const BodyHandle body = store.create(Vec{}, 1.f);
+	const int steps = static_cast<int>(sleep.settings.timeToSleep / STEP);
+	for (int i = 0; i < 4 * steps; i++)
+	{
+		// a short burst of movement before the timer runs out starts it over
+		store.setVelocity(body, Vec{ i % (steps - 1) == 0 ? 1.f : 0.f, 0.f, 0.f });
+		sleep.update(store, {}, springs, STEP);
+		ASSERT_TRUE(store.isAwake(body)) << "step " << i;
+	}
+}
+
+TEST(SleepSystem, IslandSleepsOnlyWhenEveryBodyRests)
+{
+	BodyStore store{};
+	SleepSystem sleep{};
+	const SpringPool springs{};
+	const BodyHandle a = store.create(Vec{}, 1.f);
+	const BodyHandle b = store.create(Vec{}, 1.f);
+	const BodyHandle c = store.create(Vec{}, 1.f);
+	const std::vector<std::pair<BodyHandle, BodyHandle>> stack{ { b, a }, { c, b } };
+
+	// c keeps moving, so the stack a-b-c stays awake although a and b rest
+	const int steps = static_cast<int>(sleep.settings.timeToSleep / STEP) * 2;
+	for (int i = 0; i < steps; i++)
+	{
+		store.setVelocity(c, Vec{ 1.f, 0.f, 0.f });
+		std::vector<Collision> contacts{ touching(store, b, a), touching(store, c, b) };
+		sleep.update(store, contacts, springs, STEP);
+	}
+	EXPECT_TRUE(store.isAwake(a));
+	EXPECT_TRUE(store.isAwake(b));
+
+	store.setVelocity(c, Vec::zero());
+	rest(sleep, store, stack, springs);
+	EXPECT_FALSE(store.isAwake(a));
+	EXPECT_FALSE(store.isAwake(b));
+	EXPECT_FALSE(store.isAwake(c));
+	EXPECT_EQ(sleep.getStats().sleepingIslands, 1u);
+}
+
+TEST(SleepSystem, ContactWakesWholeIsland)
+{
+	BodyStore store{};
+	SleepSystem sleep{};
+	const SpringPool springs{};
+	const BodyHandle ground = store.create(Vec{}, 0.f);
+	const BodyHandle a = store.create(Vec{}, 1.f);
+	const BodyHandle b = store.create(Vec{}, 1.f);
+	const BodyHandle c = store.create(Vec{}, 1.f);
+	const BodyHandle other = store.create(Vec{ 5.f, 0.f, 0.f }, 1.f);
+	rest(sleep, store, { { a, ground }, { b, a }, { c, b }, { other, ground } }, springs);
+	ASSERT_EQ(store.getAwakeCount(), 0u);
+	EXPECT_EQ(sleep.getStats().sleepingIslands, 2u);
+
+	// a thrown body hits the top of the stack
+	const BodyHandle thrown = store.create(Vec{ 0.f, 3.f, 0.f }, 1.f);
+	store.setVelocity(thrown, Vec{ 0.f, -5.f, 0.f });
+	std::vector<Collision> contacts{ touching(store, thrown, c) };
+	sleep.update(store, contacts, springs, STEP);
+
+	// the whole stack wakes, not just c, the unrelated island and the ground keep sleeping
+	EXPECT_TRUE(store.isAwake(a));
+	EXPECT_TRUE(store.isAwake(b));
+	EXPECT_TRUE(store.isAwake(c));
+	EXPECT_FALSE(store.isAwake(other));
+	EXPECT_FALSE(store.isAwake(ground));
+	EXPECT_EQ(sleep.getStats().woken, 3u);
+	EXPECT_EQ(sleep.getStats().sleepingIslands, 1u);
+}
+
+TEST(SleepSystem, SpringWakesSleepingEnd)
+{
+	BodyStore store{};
+	SleepSystem sleep{};
+	SpringPool springs{};
+	const BodyHandle anchor = store.create(Vec{}, 1.f);
+	const BodyHandle sleeper = store.create(Vec{ 2.f, 0.f, 0.f }, 1.f);
+	const BodyHandle loose = store.create(Vec{ 9.f, 0.f, 0.f }, 1.f);
+	rest(sleep, store, {}, springs);
+	ASSERT_FALSE(store.isAwake(sleeper));
+
+	// waking one end through its handle, the spring then wakes the other
+	springs.add(anchor, sleeper, 1.f, 10.f);
+	store.setVelocity(anchor, Vec{ 1.f, 0.f, 0.f });
+	sleep.update(store, {}, springs, STEP);
+	EXPECT_TRUE(store.isAwake(sleeper));
+	EXPECT_FALSE(store.isAwake(loose));
+}
+
+TEST(SleepSystem, DisabledWakesEverything)
+{
+	BodyStore store{};
+	SleepSystem sleep{};
+	const SpringPool springs{};
+	for (int i = 0; i < 4; i++) { store.create(Vec{ static_cast<float>(i), 0.f, 0.f }, 1.f); }
+	rest(sleep, store, {}, springs);
+	ASSERT_EQ(store.getAwakeCount(), 0u);
+
+	sleep.settings.enabled = false;
+	sleep.update(store, {}, springs, STEP);
+	EXPECT_EQ(store.getAwakeCount(), 4u);
+	EXPECT_EQ(sleep.getStats().sleepingIslands, 0u);
+}
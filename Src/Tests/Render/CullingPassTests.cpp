@@ -0,0 +1,130 @@
+#include "Core/Render/CullingPass.h"
+
+#include <gtest/gtest.h>
+
+using namespace EngineCore;
+
+namespace
+{
+	/*	right-handed perspective with 0..1 depth, 90 degree vertical field of view, square aspect, near 1, far 100,
+	*	the camera sits at the origin looking down -z, so the frustum is |x| <= -z, |y| <= -z, -100 <= z <= -1 */
+	glm::mat4 knownProjection()
+	{
+		const float n = 1.f, f = 100.f;
+		glm::mat4 m{ 0.f };
+		m[0][0] = 1.f;
+		m[1][1] = 1.f;
+		m[2][2] = f / (n - f);
+		m[2][3] = -1.f;
+		m[3][2] = -(f * n) / (f - n);
+		return m;
+	}
+
+	// the same camera moved to eye (translation only)
+	glm::mat4 knownProjectionAt(const Vec& eye)
+	{
+		glm::mat4 view{ 1.f };
+		view[3] = glm::vec4(-eye.x, -eye.y, -eye.z, 1.f);
+		return knownProjection() * view;
+	}
+
+	struct Box { Vec min; Vec max; };
+}
+
+TEST(Frustum, PlanesOfKnownProjection)
+{
+	const Frustum f = Frustum::fromMatrix(knownProjection());
+	const float d = 0.70710678f; // side planes are at 45 degrees
+
+	// normals point inside, for the left plane x >= z that is (1, 0, -1) / sqrt 2
+	EXPECT_NEAR(f.planes[Frustum::Left].x, d, 1e-5f);
+	EXPECT_NEAR(f.planes[Frustum::Left].z, -d, 1e-5f);
+	EXPECT_NEAR(f.planes[Frustum::Right].x, -d, 1e-5f);
+	EXPECT_NEAR(f.planes[Frustum::Near].z, -1.f, 1e-5f);
+	EXPECT_NEAR(f.planes[Frustum::Near].w, -1.f, 1e-4f);
+	EXPECT_NEAR(f.planes[Frustum::Far].z, 1.f, 1e-5f);
+	EXPECT_NEAR(f.planes[Frustum::Far].w, 100.f, 1e-3f);
+}
+
+TEST(Frustum, KnownAABBs)
+{
+	const Frustum f = Frustum::fromMatrix(knownProjection());
+
+	const Box inside{ Vec{ -1.f, -1.f, -11.f }, Vec{ 1.f, 1.f, -9.f } };
+	const Box behind{ Vec{ -1.f, -1.f, 1.f }, Vec{ 1.f, 1.f, 3.f } };
+	const Box beforeNear{ Vec{ -.1f, -.1f, -.9f }, Vec{ .1f, .1f, -.5f } };
+	const Box beyondFar{ Vec{ -1.f, -1.f, -120.f }, Vec{ 1.f, 1.f, -101.f } };
+	const Box left{ Vec{ -30.f, -1.f, -11.f }, Vec{ -12.f, 1.f, -9.f } };
+	const Box above{ Vec{ -1.f, 12.f, -11.f }, Vec{ 1.f, 30.f, -9.f } };
+	EXPECT_TRUE(f.intersectsAABB(inside.min, inside.max));
+	EXPECT_FALSE(f.intersectsAABB(behind.min, behind.max));
+	EXPECT_FALSE(f.intersectsAABB(beforeNear.min, beforeNear.max));
+	EXPECT_FALSE(f.intersectsAABB(beyondFar.min, beyondFar.max));
+	EXPECT_FALSE(f.intersectsAABB(left.min, left.max));
+	EXPECT_FALSE(f.intersectsAABB(above.min, above.max));
+
+	// boxes crossing a plane, or containing the whole frustum, are kept
+	const Box acrossLeft{ Vec{ -30.f, -1.f, -11.f }, Vec{ -8.f, 1.f, -9.f } };
+	const Box acrossFar{ Vec{ -1.f, -1.f, -120.f }, Vec{ 1.f, 1.f, -90.f } };
+	const Box around{ Vec{ -500.f }, Vec{ 500.f } };
+	EXPECT_TRUE(f.intersectsAABB(acrossLeft.min, acrossLeft.max));
+	EXPECT_TRUE(f.intersectsAABB(acrossFar.min, acrossFar.max));
+	EXPECT_TRUE(f.intersectsAABB(around.min, around.max));
+}
+
+TEST(Frustum, KnownSpheres)
+{
+	const Frustum f = Frustum::fromMatrix(knownProjection());
+
+	EXPECT_TRUE(f.intersectsSphere(Vec{ 0.f, 0.f, -50.f }, 1.f));
+	EXPECT_FALSE(f.intersectsSphere(Vec{ 0.f, 0.f, 5.f }, 1.f));
+	// 2 units left of the left plane at z = -10 is 2 / sqrt 2 away from it
+	EXPECT_FALSE(f.intersectsSphere(Vec{ -12.f, 0.f, -10.f }, 1.3f));
+	EXPECT_TRUE(f.intersectsSphere(Vec{ -12.f, 0.f, -10.f }, 1.5f));
+}
+
+TEST(CullingPass, CollectsVisiblePrimitivesOfVisibleSectors)
+{
+	// camera far from the origin, the same boxes shifted with it must give the same answers
+	const Vec eye{ 1000.f, -200.f, 50.f };
+	CullingPass pass{};
+	pass.begin(knownProjectionAt(eye), eye);
+
+	EXPECT_TRUE(pass.testSector(eye + Vec{ -10.f, -10.f, -60.f }, eye + Vec{ 10.f, 10.f, -40.f }));
+	EXPECT_TRUE(pass.submit(eye + Vec{ 0.f, 0.f, -50.f }, 1.f, 7));
+	EXPECT_FALSE(pass.submit(eye + Vec{ 0.f, 0.f, 50.f }, 1.f, 8));
+	EXPECT_TRUE(pass.submit(eye + Vec{ 5.f, 5.f, -45.f }, 1.f, 9));
+	EXPECT_FALSE(pass.testSector(eye + Vec{ -10.f, -10.f, 40.f }, eye + Vec{ 10.f, 10.f, 60.f }));
+	pass.end();
+
+	EXPECT_EQ(pass.getVisible(), (std::vector<uint32_t>{ 7, 9 }));
+	const CullingPass::Stats& stats = pass.getStats();
+	EXPECT_EQ(stats.sectorsTested, 2u);
+	EXPECT_EQ(stats.sectorsVisible, 1u);
+	EXPECT_EQ(stats.primitivesTested, 3u);
+	EXPECT_EQ(stats.primitivesVisible, 2u);
+
+	// begin() starts a new frame
+	pass.begin(knownProjectionAt(eye), eye);
+	pass.end();
+	EXPECT_TRUE(pass.getVisible().empty());
+	EXPECT_EQ(pass.getStats().primitivesTested, 0u);
+}
+
+TEST(CullingPass, MaxDistance)
+{
+	CullingPass pass{};
+	pass.maxDistance = 30.f;
+	pass.begin(knownProjection(), Vec{});
+
+	// inside the frustum but past maxDistance, a sphere counts from its surface
+	EXPECT_TRUE(pass.submit(Vec{ 0.f, 0.f, -20.f }, 1.f, 0));
+	EXPECT_FALSE(pass.submit(Vec{ 0.f, 0.f, -40.f }, 1.f, 1));
+	EXPECT_TRUE(pass.submit(Vec{ 0.f, 0.f, -40.f }, 15.f, 2));
+	// a sector counts from its closest point
+	EXPECT_TRUE(pass.testSector(Vec{ -5.f, -5.f, -80.f }, Vec{ 5.f, 5.f, -25.f }));
+	EXPECT_FALSE(pass.testSector(Vec{ -5.f, -5.f, -80.f }, Vec{ 5.f, 5.f, -35.f }));
+	pass.end();
+
+	EXPECT_EQ(pass.getVisible(), (std::vector<uint32_t>{ 0, 2 }));
+}
@@ -0,0 +1,102 @@
+#include "Core/Types/CachedTransform.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace
+{
+	void expectMatrixNear(const glm::mat4& actual, const glm::mat4& expected, float tolerance)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			for (int r = 0; r < 4; r++) { EXPECT_NEAR(actual[c][r], expected[c][r], tolerance) << "column " << c << " row " << r; }
+		}
+	}
+
+	// upper 3x3 only, shaders ignore the rest of the normal matrix
+	void expectNormalMatrixNear(const glm::mat4& actual, const glm::mat4& model, float tolerance)
+	{
+		const glm::mat4 expected = glm::transpose(glm::inverse(model));
+		for (int c = 0; c < 3; c++)
+		{
+			for (int r = 0; r < 3; r++) { EXPECT_NEAR(actual[c][r], expected[c][r], tolerance) << "column " << c << " row " << r; }
+		}
+	}
+
+	Transform randomTransform(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> position{ -100.f, 100.f }, angle{ -3.1f, 3.1f }, scale{ .25f, 4.f };
+		return Transform{ Vec{ position(rng), position(rng), position(rng) }, Vec{ angle(rng), angle(rng), angle(rng) },
+			Vec{ scale(rng), scale(rng), scale(rng) } };
+	}
+}
+
+TEST(CachedTransform, MatchesTransformMat4)
+{
+	std::mt19937 rng{ 17 };
+	for (int i = 0; i < 1000; i++)
+	{
+		const Transform t = randomTransform(rng);
+		const CachedTransform cached{ t };
+		const glm::mat4 expected = t.mat4();
+		// relative to the matrix entries, translations reach 100
+		expectMatrixNear(cached.getMatrix(), expected, 1e-5f * 100.f);
+		expectNormalMatrixNear(cached.getNormalMatrix(), expected, 1e-4f * 4.f);
+		if (HasFailure()) { return; }
+	}
+}
+
+TEST(CachedTransform, TranslationPatchesWithoutRebuild)
+{
+	std::mt19937 rng{ 3 };
+	Transform t = randomTransform(rng);
+	CachedTransform cached{ t };
+	const glm::mat4 normal = cached.getNormalMatrix();
+	const uint32_t revision = cached.getRevision();
+
+	cached.translate(Vec{ 1.f, -2.f, 3.f });
+	t.translation += Vec{ 1.f, -2.f, 3.f };
+	EXPECT_NE(cached.getRevision(), revision);
+	expectMatrixNear(cached.getMatrix(), t.mat4(), 1e-3f);
+	EXPECT_EQ(cached.getNormalMatrix(), normal);
+	EXPECT_EQ(cached.getMatrix()[3], glm::vec4(t.translation.x, t.translation.y, t.translation.z, 1.f));
+}
+
+TEST(CachedTransform, RotationAndScaleRebuildOnUse)
+{
+	CachedTransform cached{};
+	expectMatrixNear(cached.getMatrix(), glm::mat4{ 1.f }, 0.f);
+
+	Transform t{ Vec{ 5.f, 0.f, 0.f }, Vec{ .4f, -1.2f, 2.f }, Vec{ 2.f, 1.f, .5f } };
+	cached.setTranslation(t.translation); // translation before rotation, the pending rebuild must still include it
+	cached.setRotationEuler(t.rotation);
+	cached.setScale(t.scale);
+	expectMatrixNear(cached.getMatrix(), t.mat4(), 1e-5f);
+	expectNormalMatrixNear(cached.getNormalMatrix(), t.mat4(), 1e-5f);
+}
+
+TEST(CachedTransform, ZeroScaleHasNoNaN)
+{
+	Transform t{ Vec{}, Vec{ .3f, .2f, .1f }, Vec{ 1.f, 0.f, 1.f } };
+	const CachedTransform cached{ t };
+	const glm::mat4& normal = cached.getNormalMatrix();
+	for (int c = 0; c < 4; c++)
+	{
+		for (int r = 0; r < 4; r++) { EXPECT_FALSE(std::isnan(normal[c][r])); }
+	}
+	expectMatrixNear(cached.getMatrix(), t.mat4(), 1e-6f);
+}
+
+TEST(CachedTransform, EulerRoundTrip)
+{
+	std::mt19937 rng{ 5 };
+	for (int i = 0; i < 1000; i++)
+	{
+		// the angles may come back different (another Euler triple for the same rotation), the matrix may not
+		const Transform t = randomTransform(rng);
+		const Transform back = CachedTransform{ t }.toTransform();
+		expectMatrixNear(back.mat4(), t.mat4(), 1e-3f);
+		if (HasFailure()) { return; }
+	}
+}
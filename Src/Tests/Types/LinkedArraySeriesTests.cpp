@@ -0,0 +1,179 @@
+#include "Core/Types/LinkedArraySeriesContainer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+	/*	like Primitive it holds a reference, so it has no assignment, unlike Primitive it can be move-constructed,
+	*	every live object is counted so leaks and double destruction show up */
+	struct Tracked
+	{
+		int& live;
+		int value;
+		std::unique_ptr<int> payload;
+
+		Tracked(int& live, int value) : live{ live }, value{ value }, payload{ std::make_unique<int>(value) } { live++; }
+		Tracked(Tracked&& other) noexcept : live{ other.live }, value{ other.value }, payload{ std::move(other.payload) } { live++; }
+		Tracked& operator=(const Tracked&) = delete;
+		~Tracked() { live--; }
+	};
+
+	// neither movable nor copyable, can only be erased with free lists
+	struct Pinned
+	{
+		int value;
+		explicit Pinned(int value) : value{ value } {}
+		Pinned(const Pinned&) = delete;
+		Pinned& operator=(const Pinned&) = delete;
+	};
+}
+
+TEST(LinkedArraySeries, AddressesStayStableWhileGrowing)
+{
+	LinkedArraySeries<int> series{ 4 };
+	std::vector<int*> addresses{};
+	for (int i = 0; i < 10000; i++) { addresses.push_back(&series.emplace_back(i)); }
+
+	EXPECT_EQ(series.size(), 10000u);
+	for (int i = 0; i < 10000; i++)
+	{
+		EXPECT_EQ(&series[i], addresses[i]);
+		EXPECT_EQ(*addresses[i], i);
+		EXPECT_EQ(series.indexOf(addresses[i]), static_cast<size_t>(i));
+	}
+	// chunks double, 4 + 8 + ... covers 10000 with 12 chunks
+	EXPECT_EQ(series.capacity(), 4u * ((1u << 12) - 1));
+
+	int expected = 0;
+	for (int v : series) { EXPECT_EQ(v, expected++); }
+	EXPECT_EQ(expected, 10000);
+}
+
+TEST(LinkedArraySeries, EraseMovesTheLastObjectWithoutAssignment)
+{
+	int live = 0;
+	{
+		LinkedArraySeries<Tracked> series{ 2 };
+		for (int i = 0; i < 10; i++) { series.emplace_back(live, i); }
+		Tracked* first = &series[0];
+
+		series.erase(0); // the last object (9) moves into slot 0
+		EXPECT_EQ(series.size(), 9u);
+		EXPECT_EQ(live, 9);
+		EXPECT_EQ(&series[0], first);
+		EXPECT_EQ(series[0].value, 9);
+		EXPECT_EQ(*series[0].payload, 9);
+
+		series.erase(series.size() - 1); // erasing the last one moves nothing
+		EXPECT_EQ(series.size(), 8u);
+		EXPECT_EQ(live, 8);
+		EXPECT_EQ(series.back().value, 7);
+	}
+	EXPECT_EQ(live, 0);
+}
+
+TEST(LinkedArraySeries, MatchesVectorUnderRandomOps)
+{
+	int live = 0;
+	{
+		LinkedArraySeries<Tracked> series{ 3 };
+		std::vector<int> reference{};
+		std::mt19937 rng{ 19 };
+		std::uniform_int_distribution<int> op{ 0, 9 };
+		for (int step = 0; step < 50000; step++)
+		{
+			const int o = op(rng);
+			if (o < 6 || reference.empty())
+			{
+				series.emplace_back(live, step);
+				reference.push_back(step);
+			}
+			else if (o < 9)
+			{
+				// erase by swap, the same on both sides
+				const size_t i = std::uniform_int_distribution<size_t>{ 0, reference.size() - 1 }(rng);
+				series.erase(i);
+				reference[i] = reference.back();
+				reference.pop_back();
+			}
+			else
+			{
+				series.pop_back();
+				reference.pop_back();
+			}
+			ASSERT_EQ(series.size(), reference.size());
+			ASSERT_EQ(live, static_cast<int>(reference.size()));
+		}
+		size_t i = 0;
+		for (const Tracked& t : series) { ASSERT_EQ(t.value, reference[i++]); }
+		EXPECT_EQ(i, reference.size());
+
+		series.clear();
+		EXPECT_EQ(live, 0);
+		EXPECT_TRUE(series.empty());
+		series.emplace_back(live, 1); // storage is kept
+		EXPECT_EQ(live, 1);
+	}
+	EXPECT_EQ(live, 0);
+}
+
+TEST(LinkedArraySeries, FreeListsNeverMoveObjects)
+{
+	LinkedArraySeries<Pinned, 24, true> series{ 4 };
+	std::vector<Pinned*> addresses{};
+	for (int i = 0; i < 100; i++) { addresses.push_back(&series.emplace_back(i)); }
+
+	// erase every third object, the others keep their address and slot index
+	for (size_t i = 0; i < 100; i += 3) { series.erase(i); }
+	EXPECT_EQ(series.size(), 66u);
+	EXPECT_EQ(series.slotCount(), 100u);
+	int visited = 0;
+	for (const Pinned& p : series)
+	{
+		EXPECT_NE(p.value % 3, 0);
+		EXPECT_EQ(&p, addresses[p.value]);
+		visited++;
+	}
+	EXPECT_EQ(visited, 66);
+
+	// emplace() fills the gaps before appending
+	for (int i = 0; i < 34; i++) { series.emplace(1000 + i); }
+	EXPECT_EQ(series.size(), 100u);
+	EXPECT_EQ(series.slotCount(), 100u);
+	series.emplace(2000);
+	EXPECT_EQ(series.slotCount(), 101u);
+}
+
+TEST(LinkedArraySeries, MoveHandsOverTheChunks)
+{
+	LinkedArraySeries<int> series{};
+	for (int i = 0; i < 100; i++) { series.emplace_back(i); }
+	int* third = &series[3];
+
+	LinkedArraySeries<int> moved{ std::move(series) };
+	EXPECT_EQ(moved.size(), 100u);
+	EXPECT_EQ(&moved[3], third);
+	EXPECT_TRUE(series.empty());
+
+	series = std::move(moved);
+	EXPECT_EQ(series.size(), 100u);
+	EXPECT_EQ(&series[3], third);
+}
+
+TEST(LinkedArraySeries, ReserveAllocatesUpFront)
+{
+	LinkedArraySeries<int> series{ 8 };
+	series.reserve(1000);
+	const size_t capacity = series.capacity();
+	EXPECT_GE(capacity, 1000u);
+	for (int i = 0; i < 1000; i++) { series.emplace_back(i); }
+	EXPECT_EQ(series.capacity(), capacity);
+
+	LinkedArraySeries<int, 2> small{ 1 };
+	EXPECT_THROW(small.reserve(4), std::runtime_error);
+}
@@ -0,0 +1,153 @@
+#include "Core/Types/SimdVector.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	std::vector<Vec> randomVecs(size_t count, unsigned seed)
+	{
+		std::mt19937 rng{ seed };
+		std::uniform_real_distribution<float> coord{ -50.f, 50.f };
+		std::vector<Vec> out(count);
+		for (Vec& v : out) { v = Vec{ coord(rng), coord(rng), coord(rng) }; }
+		return out;
+	}
+
+	void expectNear(const Vec& a, const Vec& b, float tolerance)
+	{
+		EXPECT_NEAR(a.x, b.x, tolerance);
+		EXPECT_NEAR(a.y, b.y, tolerance);
+		EXPECT_NEAR(a.z, b.z, tolerance);
+	}
+
+	float w(const Vec3A& v)
+	{
+		alignas(16) float f[4];
+		Simd::Quad::store(f, v.v);
+		return f[3];
+	}
+}
+
+TEST(SimdVector, Vec3AMatchesVec)
+{
+	const std::vector<Vec> a = randomVecs(64, 1), b = randomVecs(64, 2);
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		const Vec3A sa{ a[i] }, sb{ b[i] };
+		expectNear((sa + sb).toVec(), a[i] + b[i], 1e-4f);
+		expectNear((sa - sb).toVec(), a[i] - b[i], 1e-4f);
+		expectNear((sa * sb).toVec(), a[i] * b[i], 1e-2f);
+		expectNear((sa * 3.f).toVec(), a[i] * 3.f, 1e-4f);
+		EXPECT_NEAR(Vec3A::dot(sa, sb), Vec::dot(a[i], b[i]), 1e-2f);
+		EXPECT_NEAR(Vec3A::distanceSquared(sa, sb), Vec::distanceSquared(a[i], b[i]), 1e-1f);
+		EXPECT_NEAR(sa.length(), a[i].getMagnitude(), 1e-4f);
+		expectNear(Vec3A::min(sa, sb).toVec(), Vec{ std::min(a[i].x, b[i].x), std::min(a[i].y, b[i].y), std::min(a[i].z, b[i].z) }, 0.f);
+
+		// w stays 0, a division included
+		EXPECT_EQ(w(sa / sb), 0.f);
+		EXPECT_EQ(w(sa * 2.f - sb), 0.f);
+	}
+}
+
+TEST(SimdVector, CrossProduct)
+{
+	const Vec3A x{ 1.f, 0.f, 0.f }, y{ 0.f, 1.f, 0.f }, z{ 0.f, 0.f, 1.f };
+	expectNear(Vec3A::cross(x, y).toVec(), z.toVec(), 0.f);
+	expectNear(Vec3A::cross(y, z).toVec(), x.toVec(), 0.f);
+	expectNear(Vec3A::cross(z, x).toVec(), y.toVec(), 0.f);
+
+	const std::vector<Vec> a = randomVecs(64, 3), b = randomVecs(64, 4);
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		const Vec3A c = Vec3A::cross(Vec3A{ a[i] }, Vec3A{ b[i] });
+		expectNear(c.toVec(), Vec::cross(a[i], b[i]), 1e-2f);
+		EXPECT_EQ(w(c), 0.f);
+		// perpendicular to both inputs
+		EXPECT_NEAR(Vec3A::dot(c, Vec3A{ a[i] }) / (c.length() * a[i].getMagnitude() + 1.f), 0.f, 1e-4f);
+	}
+}
+
+TEST(SimdVector, NormalizeIsAccurateAndZeroesTinyVectors)
+{
+	for (const Vec& v : randomVecs(256, 5))
+	{
+		const Vec3A n = Vec3A{ v }.normalized();
+		EXPECT_NEAR(n.length(), 1.f, 1e-5f);
+		expectNear(n.toVec(), v.getNormalized(), 1e-5f);
+	}
+	EXPECT_EQ(Vec3A(1e-6f, 0.f, 0.f).normalized().length(), 0.f);
+	EXPECT_EQ(Vec3A{}.normalized().length(), 0.f);
+}
+
+TEST(SimdVector, Vec4Operations)
+{
+	const Vec4 a{ 1.f, 2.f, 3.f, 4.f }, b{ 5.f, 6.f, 7.f, 8.f };
+	EXPECT_EQ(Vec4::dot(a, b), 70.f);
+	const Vec4 s = a + b * 2.f;
+	EXPECT_EQ(s.x(), 11.f);
+	EXPECT_EQ(s.w(), 20.f);
+	float stored[4];
+	(-a).store(stored);
+	EXPECT_EQ(stored[2], -3.f);
+	EXPECT_EQ(Vec4::load(stored).y(), -2.f);
+	EXPECT_EQ(Vec4(Vec{ 1.f, 2.f, 3.f }, 9.f).w(), 9.f);
+}
+
+TEST(SimdVector, GlmConversions)
+{
+	const glm::vec3 g3{ 1.f, -2.f, 3.5f };
+	const glm::vec3 back3 = Vec3A{ g3 }.toGlm();
+	EXPECT_TRUE(back3 == g3);
+	EXPECT_EQ(w(Vec3A{ g3 }), 0.f);
+	const glm::vec4 g4{ 1.f, -2.f, 3.5f, 7.f };
+	const glm::vec4 back4 = Vec4{ g4 }.toGlm();
+	EXPECT_TRUE(back4 == g4);
+}
+
+TEST(SimdVector, BatchMatchesSingleOperations)
+{
+	constexpr size_t COUNT = 1001; // not a multiple of anything
+	const std::vector<Vec> a = randomVecs(COUNT, 6), b = randomVecs(COUNT, 7);
+	std::vector<Vec3A> sa(COUNT), sb(COUNT), out(COUNT);
+	VecBatch::toVec3A(a.data(), sa.data(), COUNT);
+	VecBatch::toVec3A(b.data(), sb.data(), COUNT);
+
+	VecBatch::cross(sa.data(), sb.data(), out.data(), COUNT);
+	for (size_t i = 0; i < COUNT; i++) { expectNear(out[i].toVec(), Vec::cross(a[i], b[i]), 1e-2f); }
+
+	VecBatch::scaleAdd(sa.data(), sb.data(), .5f, out.data(), COUNT);
+	for (size_t i = 0; i < COUNT; i++) { expectNear(out[i].toVec(), a[i] + b[i] * .5f, 1e-4f); }
+
+	std::vector<float> dots(COUNT);
+	VecBatch::dot(sa.data(), sb.data(), dots.data(), COUNT);
+	for (size_t i = 0; i < COUNT; i++) { EXPECT_NEAR(dots[i], Vec::dot(a[i], b[i]), 1e-2f); }
+
+	// in place
+	VecBatch::normalize(sa.data(), COUNT);
+	for (size_t i = 0; i < COUNT; i++) { expectNear(sa[i].toVec(), a[i].getNormalized(), 1e-5f); }
+
+	// back to Vec without writing past the end of the array
+	std::vector<Vec> converted(COUNT + 1, Vec{ 7.f, 7.f, 7.f });
+	VecBatch::toVec(sb.data(), converted.data(), COUNT);
+	for (size_t i = 0; i < COUNT; i++) { expectNear(converted[i], b[i], 0.f); }
+	expectNear(converted[COUNT], Vec{ 7.f, 7.f, 7.f }, 0.f);
+}
+
+TEST(SimdVector, TransformPointsMatchesGlm)
+{
+	const glm::mat4 m{ glm::vec4{ 0.f, 2.f, 0.f, 0.f }, glm::vec4{ -2.f, 0.f, 0.f, 0.f }, glm::vec4{ 0.f, 0.f, 3.f, 0.f }, glm::vec4{ 10.f, -5.f, 1.f, 1.f } };
+	const std::vector<Vec> points = randomVecs(100, 8);
+	std::vector<Vec3A> in(points.size()), out(points.size());
+	VecBatch::toVec3A(points.data(), in.data(), points.size());
+	VecBatch::transformPoints(m, in.data(), out.data(), points.size());
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		const glm::vec4 expected = m * glm::vec4{ points[i].x, points[i].y, points[i].z, 1.f };
+		expectNear(out[i].toVec(), Vec{ expected.x, expected.y, expected.z }, 1e-3f);
+		EXPECT_EQ(w(out[i]), 0.f);
+	}
+}
@@ -0,0 +1,52 @@
+#include "Core/Types/TaskPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(TaskPool, RunsEveryTaskExactlyOnce)
+{
+	// more threads than this machine may have cores, stealing still has to hand out each task once
+	TaskPool pool{ 4 };
+	ASSERT_EQ(pool.getThreadCount(), 5u);
+	for (uint32_t batch = 0; batch < 200; batch++)
+	{
+		const uint32_t count = 1 + batch * 7 % 300;
+		std::vector<std::atomic<uint32_t>> runs(count);
+		for (auto& r : runs) { r.store(0); }
+		pool.parallelFor(count, [&runs](uint32_t i) { runs[i].fetch_add(1); });
+		for (uint32_t i = 0; i < count; i++) { ASSERT_EQ(runs[i].load(), 1u) << "batch " << batch << " task " << i; }
+	}
+}
+
+TEST(TaskPool, WithoutWorkersRunsOnCaller)
+{
+	TaskPool pool{ 0 };
+	EXPECT_EQ(pool.getThreadCount(), 1u);
+	std::vector<uint32_t> order{};
+	pool.parallelFor(5, [&order](uint32_t i) { order.push_back(i); });
+	EXPECT_EQ(order, (std::vector<uint32_t>{ 0, 1, 2, 3, 4 }));
+}
+
+TEST(TaskPool, TaskExceptionReachesCallerAfterBatch)
+{
+	for (int threads : { 0, 3 })
+	{
+		TaskPool pool{ threads };
+		std::atomic<uint32_t> ran{ 0 };
+		EXPECT_THROW(pool.parallelFor(64, [&ran](uint32_t i)
+		{
+			ran.fetch_add(1);
+			if (i % 16 == 5) { throw std::runtime_error("task failed"); }
+		}), std::runtime_error);
+		// the failing tasks do not cancel the others
+		EXPECT_EQ(ran.load(), 64u);
+
+		// and the pool is usable afterwards, without rethrowing the old exception
+		ran.store(0);
+		EXPECT_NO_THROW(pool.parallelFor(64, [&ran](uint32_t) { ran.fetch_add(1); }));
+		EXPECT_EQ(ran.load(), 64u);
+	}
+}
@@ -0,0 +1,129 @@
+#include "Core/WorldSystem/FloatingOrigin.h"
+#include "Core/Types/CachedTransform.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace WorldSystem;
+
+namespace
+{
+	constexpr uint32_t S = 50000;
+
+	// stands in for a Primitive, rebaseOrigin only touches its transform
+	struct Object
+	{
+		WorldPosition position{};
+		CachedTransform transform{};
+		CachedTransform& getTransform() { return transform; }
+	};
+}
+
+TEST(FloatingOrigin, ObserverShiftIsExact)
+{
+	FloatingOrigin origin{ S };
+	Vec observer{ 1.5f * S, -1.25f * S, 10.f };
+
+	const SectorCoord shift = origin.getShift(observer);
+	EXPECT_EQ(shift, SectorCoord(1, -1, 0));
+	observer += origin.rebase(shift);
+
+	EXPECT_EQ(origin.getLocalSector(), SectorCoord(1, -1, 0));
+	EXPECT_EQ(observer.x, .5f * S);
+	EXPECT_EQ(observer.y, -.25f * S);
+	EXPECT_EQ(observer.z, 10.f);
+}
+
+TEST(FloatingOrigin, ShiftsOnlyAfterAFullSector)
+{
+	FloatingOrigin origin{ S };
+	EXPECT_EQ(origin.getShift(Vec{ S - 1.f, -(S - 1.f), 0.f }), SectorCoord(0, 0, 0));
+	EXPECT_EQ(origin.getShift(Vec{ S + 1.f, -(S + 1.f), 0.f }), SectorCoord(1, -1, 0));
+
+	// just past the boundary the observer is a sector behind the new origin, crossing back does not rebase again
+	Vec observer{ S + 1.f, 0.f, 0.f };
+	observer += origin.rebase(origin.getShift(observer));
+	EXPECT_EQ(observer.x, 1.f);
+	EXPECT_EQ(origin.getShift(Vec{ -1.f, 0.f, 0.f }), SectorCoord(0, 0, 0));
+	EXPECT_EQ(origin.getShift(Vec{ -(S + 1.f), 0.f, 0.f }), SectorCoord(-1, 0, 0));
+}
+
+TEST(FloatingOrigin, LocalAndWorldRoundTrip)
+{
+	FloatingOrigin origin{ S };
+	origin.setLocalSector(SectorCoord(1000000, -3, 7));
+
+	const WorldPosition position{ SectorCoord(1000001, -3, 6), Vec64(12.5, 250.25, 49999.5) };
+	const Vec local = origin.worldToLocal(position);
+	EXPECT_EQ(local.x, S + 12.5f);
+	EXPECT_EQ(local.y, 250.25f);
+	EXPECT_EQ(local.z, 49999.5f - S);
+
+	const WorldPosition back = origin.localToWorld(local);
+	EXPECT_EQ(back.sector, origin.getLocalSector());
+	EXPECT_EQ(origin.worldToLocal(back).x, local.x);
+	EXPECT_EQ(origin.sectorToLocal(SectorCoord(1000000, -2, 7)).y, static_cast<float>(S));
+}
+
+TEST(FloatingOrigin, PositionsStayStableAcrossRebase)
+{
+	FloatingOrigin origin{ S };
+	std::mt19937 rng{ 7 };
+	std::uniform_real_distribution<double> offset{ 0.0, S };
+	std::uniform_int_distribution<int> sector{ -2, 1 };
+
+	// objects in the sectors around the start, placed the way a sector load places them (relative to the current origin)
+	std::vector<Object> objects(4000);
+	for (Object& o : objects)
+	{
+		o.position.sector = SectorCoord(sector(rng), sector(rng), sector(rng));
+		o.position.offset = Vec64(offset(rng), offset(rng), offset(rng));
+		o.transform.setTranslation(origin.worldToLocal(o.position));
+		o.transform.setRotationEuler(Vec{ .3f, .2f, .1f });
+	}
+
+	/*	walk four sectors along x and back, twenty times, rebasing the way World::updateSectorCoord does,
+	*	objects get at most eight sectors from the origin, where a float step is 2^-5, a shift rounds at most once
+	*	so the error stays below that step however many rebases happen */
+	const float maxError = std::ldexp(1.f, -5);
+	Vec observer{};
+	uint32_t rebases = 0;
+	const auto step = [&](float dx)
+	{
+		observer.x += dx;
+		const SectorCoord shift = origin.getShift(observer);
+		if (shift == SectorCoord(0, 0, 0)) { return; }
+		const Vec delta = origin.rebase(shift);
+		observer += delta;
+		EXPECT_EQ(FloatingOrigin::shiftTransforms(objects, delta), objects.size());
+		rebases++;
+
+		for (const Object& o : objects)
+		{
+			const Vec expected = origin.worldToLocal(o.position);
+			const Vec& actual = o.transform.getTranslation();
+			ASSERT_NEAR(actual.x, expected.x, maxError);
+			ASSERT_NEAR(actual.y, expected.y, maxError);
+			ASSERT_NEAR(actual.z, expected.z, maxError);
+		}
+	};
+	for (int trip = 0; trip < 20; trip++)
+	{
+		for (int i = 0; i < 40; i++) { step(.1f * S); }
+		for (int i = 0; i < 40; i++) { step(-.1f * S); }
+	}
+	EXPECT_GE(rebases, 80u);
+
+	// the cached matrices followed their translations
+	for (const Object& o : objects)
+	{
+		const glm::vec4 column = o.transform.getMatrix()[3];
+		const Vec& t = o.transform.getTranslation();
+		EXPECT_EQ(column.x, t.x);
+		EXPECT_EQ(column.y, t.y);
+		EXPECT_EQ(column.z, t.z);
+	}
+}
@@ -0,0 +1,205 @@
+#include "Core/WorldSystem/SectorFile.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace WorldSystem;
+using Vertex = EngineCore::Primitive::Vertex;
+
+namespace
+{
+	const SectorCoord COORD{ 3, -1, 7 };
+
+	// two materials, an indexed primitive and a non-indexed one
+	SectorContent makeContent()
+	{
+		SectorContent content{};
+		content.materials.push_back(SectorContent::MaterialRef{ "Shaders/a.vert.spv", "Shaders/a.frag.spv" });
+		content.materials.push_back(SectorContent::MaterialRef{ "Shaders/b.vert.spv", "Shaders/b.frag.spv" });
+
+		content.primitives.emplace_back();
+		auto& indexed = content.primitives.back();
+		for (int i = 0; i < 4; i++) { indexed.mesh.vertices.push_back(Vertex{ glm::vec3(float(i), 0.f, 1.f) }); }
+		indexed.mesh.indices = { 0, 1, 2, 2, 3, 0 };
+		indexed.transform.translation = Vec{ 1.f, 2.f, 3.f };
+		indexed.transform.scale = Vec{ 2.f, 2.f, 2.f };
+		indexed.materialIndex = 1;
+
+		content.primitives.emplace_back();
+		auto& plain = content.primitives.back();
+		for (int i = 0; i < 3; i++) { plain.mesh.vertices.push_back(Vertex{ glm::vec3(0.f, float(i), 0.f) }); }
+		plain.transform.rotation = Vec{ 0.f, 1.5f, 0.f };
+		return content;
+	}
+
+	class SectorFileTest : public ::testing::Test
+	{
+	protected:
+		std::string path = ::testing::TempDir() + "sector_file_test.vsec";
+
+		std::vector<char> original{}; // bytes of the valid file, each case corrupts a copy
+
+		void SetUp() override
+		{
+			SectorFile::write(path, COORD, makeContent());
+			std::ifstream file{ path, std::ios::binary };
+			original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+		void TearDown() override { std::remove(path.c_str()); }
+
+		std::vector<char> load() const { return original; }
+		void store(const std::vector<char>& bytes) const
+		{
+			std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+			file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		}
+
+		SectorFile::Header& header(std::vector<char>& bytes) const { return *reinterpret_cast<SectorFile::Header*>(bytes.data()); }
+		SectorFile::SectionEntry& section(std::vector<char>& bytes, SectorFile::SectionType type) const
+		{
+			auto* toc = reinterpret_cast<SectorFile::SectionEntry*>(bytes.data() + sizeof(SectorFile::Header));
+			for (uint32_t i = 0; i < header(bytes).sectionCount; i++) { if (toc[i].type == static_cast<uint32_t>(type)) { return toc[i]; } }
+			throw std::logic_error("section not found");
+		}
+		SectorFile::PrimitiveRecord& primitive(std::vector<char>& bytes, uint32_t index) const
+		{
+			const auto& entry = section(bytes, SectorFile::SectionType::Primitives);
+			return reinterpret_cast<SectorFile::PrimitiveRecord*>(bytes.data() + entry.offset)[index];
+		}
+
+		void expectRejected(const std::vector<char>& bytes) const
+		{
+			store(bytes);
+			SectorContent content{};
+			EXPECT_THROW(SectorFile::read(path, COORD, content), std::runtime_error);
+		}
+	};
+}
+
+TEST_F(SectorFileTest, RoundTrip)
+{
+	const SectorContent expected = makeContent();
+	SectorContent content{};
+	ASSERT_TRUE(SectorFile::read(path, COORD, content));
+	ASSERT_NE(content.mapping, nullptr);
+
+	ASSERT_EQ(content.materials.size(), 2u);
+	EXPECT_EQ(content.materials[1].vertPath, "Shaders/b.vert.spv");
+	EXPECT_EQ(content.materials[1].fragPath, "Shaders/b.frag.spv");
+
+	ASSERT_EQ(content.primitives.size(), 2u);
+	for (size_t i = 0; i < 2; i++)
+	{
+		const auto& in = expected.primitives[i];
+		const auto& out = content.primitives[i];
+		EXPECT_EQ(out.materialIndex, in.materialIndex);
+		EXPECT_EQ(out.transform.translation.x, in.transform.translation.x);
+		EXPECT_EQ(out.transform.rotation.y, in.transform.rotation.y);
+		EXPECT_EQ(out.transform.scale.z, in.transform.scale.z);
+		ASSERT_EQ(out.mappedVertexCount, in.mesh.vertices.size());
+		EXPECT_EQ(memcmp(out.mappedVertices, in.mesh.vertices.data(), in.mesh.vertices.size() * sizeof(Vertex)), 0);
+		ASSERT_EQ(out.mappedIndexCount, in.mesh.indices.size());
+		if (out.mappedIndexCount) { EXPECT_EQ(memcmp(out.mappedIndices, in.mesh.indices.data(), in.mesh.indices.size() * sizeof(uint32_t)), 0); }
+		else { EXPECT_EQ(out.mappedIndices, nullptr); }
+	}
+}
+
+TEST_F(SectorFileTest, MissingFileIsNotAnError)
+{
+	SectorContent content{};
+	EXPECT_FALSE(SectorFile::read(path + ".missing", COORD, content));
+}
+
+TEST_F(SectorFileTest, RejectsWrongCoordinate)
+{
+	SectorContent content{};
+	EXPECT_THROW(SectorFile::read(path, SectorCoord(0, 0, 0), content), std::runtime_error);
+}
+
+TEST_F(SectorFileTest, RejectsTruncatedFile)
+{
+	std::vector<char> bytes = load();
+	bytes.resize(bytes.size() - SectorFile::SECTION_ALIGNMENT);
+	expectRejected(bytes);
+
+	// a header patched to the truncated size still leaves the last section out of range
+	header(bytes).fileSize = bytes.size();
+	expectRejected(bytes);
+
+	bytes.resize(sizeof(SectorFile::Header) / 2);
+	expectRejected(bytes);
+}
+
+TEST_F(SectorFileTest, RejectsTableOfContentsOutOfRange)
+{
+	std::vector<char> bytes = load();
+	header(bytes).sectionCount = 1000;
+	expectRejected(bytes);
+
+	bytes = load();
+	section(bytes, SectorFile::SectionType::Vertices).size = ~uint64_t(0) - 32; // offset + size wraps around
+	expectRejected(bytes);
+}
+
+// the TOC claims more elements than the section bytes hold, every section type
+TEST_F(SectorFileTest, RejectsElementCountLargerThanSection)
+{
+	const SectorFile::SectionType types[] = { SectorFile::SectionType::Primitives, SectorFile::SectionType::Materials,
+		SectorFile::SectionType::Strings, SectorFile::SectionType::Vertices, SectorFile::SectionType::Indices };
+	for (const auto type : types)
+	{
+		std::vector<char> bytes = load();
+		section(bytes, type).elementCount += 1000;
+		SCOPED_TRACE(static_cast<uint32_t>(type));
+		expectRejected(bytes);
+	}
+
+	// a primitive range inside the claimed vertex count but past the end of the section
+	std::vector<char> bytes = load();
+	auto& vertices = section(bytes, SectorFile::SectionType::Vertices);
+	vertices.elementCount += 1000;
+	primitive(bytes, 1).vertexCount = vertices.elementCount - static_cast<uint32_t>(primitive(bytes, 1).firstVertex);
+	expectRejected(bytes);
+}
+
+TEST_F(SectorFileTest, RejectsPrimitiveRangesOutOfRange)
+{
+	std::vector<char> bytes = load();
+	primitive(bytes, 0).vertexCount = 1000;
+	expectRejected(bytes);
+
+	// first + count wraps around to a small value
+	bytes = load();
+	primitive(bytes, 0).firstVertex = ~uint64_t(0) - 1;
+	expectRejected(bytes);
+
+	bytes = load();
+	primitive(bytes, 0).firstIndex = ~uint64_t(0);
+	expectRejected(bytes);
+}
+
+TEST_F(SectorFileTest, RejectsMaterialIndexOutOfRange)
+{
+	std::vector<char> bytes = load();
+	primitive(bytes, 1).materialIndex = 2;
+	expectRejected(bytes);
+}
+
+// files without materials use the default sector material, any index is accepted
+TEST_F(SectorFileTest, AcceptsAnyMaterialIndexWithoutMaterials)
+{
+	SectorContent content = makeContent();
+	content.materials.clear();
+	SectorFile::write(path, COORD, content);
+
+	SectorContent read{};
+	ASSERT_TRUE(SectorFile::read(path, COORD, read));
+	EXPECT_TRUE(read.materials.empty());
+	EXPECT_EQ(read.primitives[0].materialIndex, 1u);
+}
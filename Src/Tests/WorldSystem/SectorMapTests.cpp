@@ -0,0 +1,92 @@
+#include "Core/WorldSystem/SectorMap.h"
+#include "Core/Primitive.h" // destroying a Sector destroys its primitives
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <tuple>
+
+using namespace WorldSystem;
+
+namespace
+{
+	using CoordKey = std::tuple<intmax_t, intmax_t, intmax_t>;
+	CoordKey keyOf(const SectorCoord& c) { return { c.x, c.y, c.z }; }
+}
+
+TEST(SectorMap, FindInsertErase)
+{
+	SectorMap map{};
+	EXPECT_EQ(map.find(SectorCoord(1, 2, 3)), nullptr);
+
+	Sector& sector = map.insert(std::make_unique<Sector>(SectorCoord(1, 2, 3)));
+	EXPECT_EQ(map.find(SectorCoord(1, 2, 3)), &sector);
+	EXPECT_EQ(map.find(SectorCoord(3, 2, 1)), nullptr);
+	EXPECT_EQ(map.size(), 1u);
+
+	EXPECT_TRUE(map.erase(SectorCoord(1, 2, 3)));
+	EXPECT_FALSE(map.erase(SectorCoord(1, 2, 3)));
+	EXPECT_TRUE(map.empty());
+}
+
+TEST(SectorMap, HandlesSurviveRehash)
+{
+	SectorMap map{ 8 };
+	Sector* first = &map.insert(std::make_unique<Sector>(SectorCoord(0, 0, 0)));
+	for (intmax_t i = 1; i < 1000; i++) { map.insert(std::make_unique<Sector>(SectorCoord(i, -i, i * 3))); }
+
+	EXPECT_GE(map.capacity(), 1000u);
+	EXPECT_EQ(map.find(SectorCoord(0, 0, 0)), first);
+	EXPECT_EQ(first->coordinates, SectorCoord(0, 0, 0));
+}
+
+TEST(SectorMap, ExtractHandsOverOwnership)
+{
+	SectorMap map{};
+	Sector* sector = &map.insert(std::make_unique<Sector>(SectorCoord(-4, 0, 9)));
+	std::unique_ptr<Sector> owned = map.extract(SectorCoord(-4, 0, 9));
+	EXPECT_EQ(owned.get(), sector);
+	EXPECT_EQ(map.find(SectorCoord(-4, 0, 9)), nullptr);
+	EXPECT_EQ(map.extract(SectorCoord(-4, 0, 9)), nullptr);
+}
+
+// random inserts and erases in a small coordinate range, so probe chains collide and backward-shift deletion is exercised
+TEST(SectorMap, MatchesReferenceMap)
+{
+	SectorMap map{};
+	std::map<CoordKey, Sector*> reference{};
+	std::mt19937 rng{ 1 };
+
+	for (int i = 0; i < 200000; i++)
+	{
+		const SectorCoord coord(rng() % 21 - 10, rng() % 21 - 10, rng() % 5 - 2);
+		switch (rng() % 3)
+		{
+		case 0:
+			if (!map.find(coord)) { reference[keyOf(coord)] = &map.insert(std::make_unique<Sector>(coord)); }
+			break;
+		case 1:
+			ASSERT_EQ(map.erase(coord), reference.erase(keyOf(coord)) == 1);
+			break;
+		default:
+		{
+			auto it = reference.find(keyOf(coord));
+			ASSERT_EQ(map.find(coord), it == reference.end() ? nullptr : it->second);
+		}
+		}
+		ASSERT_EQ(map.size(), reference.size());
+	}
+
+	size_t visited = 0;
+	for (const Sector& sector : map)
+	{
+		EXPECT_EQ(reference.at(keyOf(sector.coordinates)), &sector);
+		visited++;
+	}
+	EXPECT_EQ(visited, map.size());
+
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(map.begin(), map.end());
+}
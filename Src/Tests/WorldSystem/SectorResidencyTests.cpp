@@ -0,0 +1,136 @@
+#include "Core/WorldSystem/SectorResidency.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <tuple>
+
+using namespace WorldSystem;
+
+namespace
+{
+	constexpr size_t SECTOR_BYTES = 1024;
+
+	/*	stands in for World: every frame the sectors within the allowed load radius are loaded (tracked),
+	*	then the selected evictions are unloaded, loads and evictions are counted per run */
+	class ResidencySim
+	{
+	public:
+		SectorResidency residency{};
+		std::set<std::tuple<intmax_t, intmax_t, intmax_t>> loaded{};
+		uint32_t loads = 0;
+		uint32_t evictions = 0;
+
+		void run(const SectorCoord& local, uint32_t loadRadius, int frames = 1)
+		{
+			for (int f = 0; f < frames; f++)
+			{
+				residency.nextFrame();
+				const intmax_t r = residency.getLoadRadius(loadRadius);
+				for (intmax_t x = -r; x <= r; x++) for (intmax_t y = -r; y <= r; y++) for (intmax_t z = -r; z <= r; z++)
+				{
+					const SectorCoord c = local + SectorCoord(x, y, z);
+					if (loaded.insert({ c.x, c.y, c.z }).second)
+					{
+						residency.track(c, SectorResidency::Footprint{ SECTOR_BYTES, SECTOR_BYTES });
+						loads++;
+					}
+					residency.touch(c);
+				}
+
+				std::vector<SectorCoord> out{};
+				residency.selectEvictions(local, loadRadius, out);
+				for (const auto& c : out)
+				{
+					EXPECT_NE(c, local) << "the local sector must never be evicted";
+					loaded.erase({ c.x, c.y, c.z });
+					residency.untrack(c);
+					evictions++;
+				}
+			}
+		}
+		void resetCounters() { loads = evictions = 0; }
+		bool isLoaded(const SectorCoord& c) const { return loaded.count({ c.x, c.y, c.z }) != 0; }
+	};
+}
+
+TEST(SectorResidency, UnloadsBeyondHysteresisRing)
+{
+	ResidencySim sim{};
+	sim.run(SectorCoord(0, 0, 0), 1);
+	EXPECT_EQ(sim.loaded.size(), 27u);
+
+	// one sector over, the old back ring is two rings away and stays inside the hysteresis ring
+	sim.run(SectorCoord(1, 0, 0), 1);
+	EXPECT_TRUE(sim.isLoaded(SectorCoord(-1, 0, 0)));
+	EXPECT_EQ(sim.evictions, 0u);
+
+	sim.run(SectorCoord(2, 0, 0), 1);
+	EXPECT_FALSE(sim.isLoaded(SectorCoord(-1, 0, 0)));
+	EXPECT_EQ(sim.evictions, 9u);
+	EXPECT_EQ(sim.residency.getStats().evictedByDistance, 9u);
+}
+
+TEST(SectorResidency, HoveringOnBoundaryDoesNotReload)
+{
+	ResidencySim sim{};
+	sim.run(SectorCoord(0, 0, 0), 1);
+	sim.run(SectorCoord(1, 0, 0), 1);
+	sim.resetCounters();
+
+	for (int i = 0; i < 100; i++) { sim.run(SectorCoord(i % 2, 0, 0), 1); }
+	EXPECT_EQ(sim.loads, 0u);
+	EXPECT_EQ(sim.evictions, 0u);
+}
+
+// over budget, sectors between the load and the unload ring go first, the load ring is kept
+TEST(SectorResidency, BudgetEvictsOutsideLoadRingFirst)
+{
+	ResidencySim sim{};
+	sim.residency.budget = SectorResidency::Budget{ 40 * SECTOR_BYTES, 40 * SECTOR_BYTES };
+	sim.run(SectorCoord(0, 0, 0), 1);
+	sim.run(SectorCoord(1, 0, 0), 1); // 27 + 9 behind
+
+	sim.residency.budget = SectorResidency::Budget{ 30 * SECTOR_BYTES, 30 * SECTOR_BYTES };
+	sim.resetCounters();
+	sim.run(SectorCoord(1, 0, 0), 1);
+	EXPECT_EQ(sim.evictions, 6u);
+	EXPECT_EQ(sim.residency.getLoadRadius(1), 1u);
+	for (intmax_t y = -1; y <= 1; y++) for (intmax_t z = -1; z <= 1; z++) { EXPECT_TRUE(sim.isLoaded(SectorCoord(2, y, z))); }
+	EXPECT_FALSE(sim.residency.isOverBudget());
+}
+
+// the load ring alone is over budget, evicting inside it would be reloaded next frame, the radius shrinks instead
+TEST(SectorResidency, BudgetBelowLoadRingDoesNotThrash)
+{
+	ResidencySim sim{};
+	sim.residency.budget = SectorResidency::Budget{ 60 * SECTOR_BYTES, 60 * SECTOR_BYTES }; // radius 2 needs 125
+	sim.run(SectorCoord(0, 0, 0), 2);
+	EXPECT_EQ(sim.residency.getLoadRadius(2), 1u);
+	EXPECT_EQ(sim.residency.getStats().droppedRings, 1u);
+	EXPECT_EQ(sim.loaded.size(), 27u);
+	EXPECT_FALSE(sim.residency.isOverBudget());
+
+	sim.resetCounters();
+	sim.run(SectorCoord(0, 0, 0), 2, 100);
+	EXPECT_EQ(sim.loads, 0u);
+	EXPECT_EQ(sim.evictions, 0u);
+}
+
+TEST(SectorResidency, LoadRadiusRegrowsWhenBudgetAllows)
+{
+	ResidencySim sim{};
+	sim.residency.budget = SectorResidency::Budget{ 60 * SECTOR_BYTES, 60 * SECTOR_BYTES };
+	sim.run(SectorCoord(0, 0, 0), 2, 10);
+	ASSERT_EQ(sim.residency.getLoadRadius(2), 1u);
+
+	sim.residency.budget = SectorResidency::Budget{ 200 * SECTOR_BYTES, 200 * SECTOR_BYTES };
+	sim.run(SectorCoord(0, 0, 0), 2, 2);
+	EXPECT_EQ(sim.residency.getLoadRadius(2), 2u);
+	EXPECT_EQ(sim.loaded.size(), 125u);
+	EXPECT_EQ(sim.residency.getStats().droppedRings, 0u);
+
+	sim.resetCounters();
+	sim.run(SectorCoord(0, 0, 0), 2, 100);
+	EXPECT_EQ(sim.loads + sim.evictions, 0u);
+}
@@ -0,0 +1,58 @@
+#include "Core/WorldSystem/SectorStreamer.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace WorldSystem;
+
+namespace
+{
+	// collects until count sectors finished, the loader threads run on their own
+	std::vector<SectorStreamer::FinishedSector> collect(SectorStreamer& streamer, size_t count)
+	{
+		std::vector<SectorStreamer::FinishedSector> out{};
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (out.size() < count && std::chrono::steady_clock::now() < deadline)
+		{
+			streamer.collectFinished(out, ~size_t(0));
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return out;
+	}
+}
+
+// a provider that throws does not stop the loader, the error is handed to the collecting thread with the sector
+TEST(SectorStreamer, ProviderErrorsAreReturnedWithTheSector)
+{
+	SectorStreamer streamer{ [](const SectorCoord& coord, SectorContent& content)
+		{
+			if (coord.x == 1) { throw std::runtime_error("broken sector file"); }
+			content.primitives.emplace_back();
+			return true;
+		}, 1 };
+	streamer.retarget(SectorCoord(0, 0, 0), 1, Vec{}, 100.f, [](const SectorCoord& c) { return c.y != 0 || c.z != 0; });
+
+	const auto finished = collect(streamer, 3); // (-1,0,0), (0,0,0), (1,0,0)
+	ASSERT_EQ(finished.size(), 3u);
+	for (const auto& f : finished)
+	{
+		if (f.coord.x == 1)
+		{
+			EXPECT_EQ(f.error, "broken sector file");
+			EXPECT_EQ(f.content, nullptr);
+		}
+		else
+		{
+			EXPECT_TRUE(f.error.empty());
+			ASSERT_NE(f.content, nullptr);
+			EXPECT_EQ(f.content->primitives.size(), 1u);
+		}
+	}
+
+	const auto stats = streamer.getStats();
+	EXPECT_EQ(stats.completed, 3u);
+	EXPECT_EQ(stats.failed, 1u);
+}